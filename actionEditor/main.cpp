@@ -32,6 +32,7 @@
 #include "NavMeshPath.h"
 #include "AnimatedDataCharacterNavMeshPlayer.h"
 #include "ShaderRegistry.h"
+#include "EffectSystem.h"
 #include "HighlightTile.h"
 using namespace Cute;
 
@@ -103,6 +104,7 @@ int main(int argc, char *argv[])
     cf_shader_directory("/assets/shaders");
     // Register and compile shaders at boot
     ShaderRegistry::registerAndLoadAll();
+    EffectSystem::initialize();
 
     // Load window configuration again using VFS for viewport and debug windows
     DataFile windowConfig("/assets/action-editor-window-config.json");
@@ -460,6 +462,7 @@ int main(int argc, char *argv[])
         {
             fpsWindow->beginFrame();
         }
+        ShaderRegistry::beginFrame();
 
         // Update app to handle window events and input (proper CF pattern)
         cf_app_update(NULL);
@@ -543,7 +546,7 @@ int main(int argc, char *argv[])
                             bool alreadyTracking = false;
                             for (const auto &window : characterInfoWindows)
                             {
-                                if (window->isTracking(entity))
+                                if (window->isTracking(entity->getHandle()))
                                 {
                                     alreadyTracking = true;
                                     break;
@@ -554,7 +557,7 @@ int main(int argc, char *argv[])
                             if (!alreadyTracking)
                             {
                                 std::string windowTitle = "Character Info: " + entity->getDataFilePath();
-                                auto newWindow = std::make_unique<DebugCharacterInfoWindow>(windowTitle, entity, level);
+                                auto newWindow = std::make_unique<DebugCharacterInfoWindow>(windowTitle, entity->getHandle(), level);
                                 characterInfoWindows.push_back(std::move(newWindow));
                                 printf("      Created debug window for entity\n");
                             }
@@ -795,6 +798,7 @@ int main(int argc, char *argv[])
         {
             fpsWindow->markSection("Player Input");
         }
+        level.updateAgentVisibility(cfCamera);
         level.updateAgents(dt);
 
         if (fpsWindow)
@@ -1032,6 +1036,10 @@ int main(int argc, char *argv[])
             playerCharacter.update(dt, moveVector);
             playerPosition = playerCharacter.getPosition();
         }
+
+        // Advance pooled visual effects and deliver their completion events
+        EffectSystem::update(dt);
+
         if (fpsWindow)
         {
             fpsWindow->markSection("Player Update");
@@ -1268,6 +1276,7 @@ int main(int argc, char *argv[])
 
     // Shutdown job system
     JobSystem::shutdown();
+    EffectSystem::shutdown();
 
     // Cleanup on-screen checks
     OnScreenChecks::shutdown();
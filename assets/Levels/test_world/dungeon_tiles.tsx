@@ -0,0 +1,4 @@
+<?xml version="1.0" encoding="UTF-8"?>
+<tileset version="1.10" tiledversion="1.11.1" name="dungeon_tiles" tilewidth="32" tileheight="32" tilecount="132" columns="11">
+ <image source="tiles/dungeon_tiles.png" width="368" height="384"/>
+</tileset>
@@ -8,12 +8,20 @@
 #include "HitBox.h"
 #include "../UI/ColorUtils.h"
 #include "EffectFactory.h"
+#include "EffectSystem.h"
 #include "../Effects/IGhostTrailEffect.h"
 #include "../Effects/GhostTrailRenderer.h"
+#include "SpriteDrawBuffer.h"
+#include "AnimationAssetCache.h"
+#include "EntityPrototypeCache.h"
 #include <cute_draw.h>
+#include <algorithm>
 
 using namespace Cute;
 
+// Tags for effects whose completion changes character state (see onEffectFinished)
+static const uint32_t EFFECT_TAG_HIT_REACTION = 1;
+
 // Helper function to get PNG dimensions
 static bool getPNGDimensions(const std::string &path, uint32_t &width, uint32_t &height)
 {
@@ -52,11 +60,14 @@ static bool getPNGDimensions(const std::string &path, uint32_t &width, uint32_t
 // Constructor
 AnimatedDataCharacter::AnimatedDataCharacter()
     : initialized(false), demoTime(0.0f), directionChangeTime(0.0f), animationChangeTime(0.0f),
-      currentAnimation("idle"), currentDirection(Direction::DOWN), currentFrame(0), frameTimer(0.0f),
+      idleAnimationId(INVALID_ANIMATION_ID), walkAnimationId(INVALID_ANIMATION_ID),
       position(v2(0, 0)), wasMoving(false), isDoingAction(false), hitboxDebugActive(false), hitboxSize(32.0f), hitboxDistance(0.0f),
-      hitboxShape(HitboxShape::SQUARE), level(nullptr), actionPointerA(0), actionPointerB(0), activeAction(nullptr), stageOfLife(StageOfLife::Alive),
-      inventory(1)
+      characterHitbox(nullptr), hitboxShape(HitboxShape::SQUARE), level(nullptr), actionPointerA(0), actionPointerB(0), activeAction(nullptr), stageOfLife(StageOfLife::Alive),
+      animationStepping(true), inventory(1)
 {
+    // Room for a few queued effects without growing during play
+    effectQueue.reserve(4);
+
     // Initialize input state
     for (int i = 0; i < 4; i++)
     {
@@ -71,6 +82,9 @@ AnimatedDataCharacter::AnimatedDataCharacter()
 // Destructor
 AnimatedDataCharacter::~AnimatedDataCharacter()
 {
+    // Return any pooled effects so no completion event targets this character
+    EffectSystem::releaseOwner(this);
+
     // Cleanup character hitbox if it exists
     if (characterHitbox)
     {
@@ -80,6 +94,122 @@ AnimatedDataCharacter::~AnimatedDataCharacter()
 } // Initialize the character with a folder path containing character.json
 bool AnimatedDataCharacter::init(const std::string &folderPath)
 {
+    // Instances of one entity type share everything loaded from its folder
+    std::shared_ptr<const EntityPrototype> entityPrototype = EntityPrototypeCache::get(folderPath);
+    if (!entityPrototype)
+    {
+        printf("AnimatedDataCharacter: ERROR: Failed to load entity type from %s\n", folderPath.c_str());
+        return false;
+    }
+
+    return initFromPrototype(entityPrototype);
+}
+
+// Create this instance's runtime state from a prototype (no file access)
+bool AnimatedDataCharacter::initFromPrototype(std::shared_ptr<const EntityPrototype> entityPrototype)
+{
+    if (!entityPrototype || !entityPrototype->animationTable)
+    {
+        return false;
+    }
+
+    prototype = entityPrototype;
+    hitboxSize = prototype->hitboxSize;
+    hitboxDistance = prototype->hitboxDistance;
+
+    // Innate actions (copies share their hitbox geometry with the prototype)
+    for (const Action &action : prototype->actions)
+    {
+        addAction(action);
+    }
+
+    // Create default character hitbox - a single tile at the bottom of the sprite
+    // This represents the character's physical footprint
+    std::vector<HitboxTile> characterHitboxTiles;
+    HitboxTile bottomTile;
+    bottomTile.x = 0;
+    bottomTile.y = 0; // At character position (bottom center)
+    bottomTile.delay = 0.0f;
+    bottomTile.damageModifier = 1.0f;
+    characterHitboxTiles.push_back(bottomTile);
+
+    // Create character hitbox from the single tile - this will be centered at the character's position
+    delete characterHitbox;
+    characterHitbox = new HitBox();
+    for (Direction direction : {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT})
+    {
+        characterHitbox->boxesByDirection[direction] = HitBox::buildFromTiles(characterHitboxTiles, hitboxSize, 0.0f, direction);
+        characterHitbox->boundingBoxByDirection[direction] = HitBox::buildBoundingBox(characterHitbox->boxesByDirection[direction], direction);
+    }
+
+    // Animation names were resolved once when the prototype was built
+    animationTable = prototype->animationTable;
+    idleAnimationId = prototype->idleAnimationId;
+    walkAnimationId = prototype->walkAnimationId;
+
+    // Set initial state
+    playback = AnimationPlayback();
+    playback.play(idleAnimationId);
+    setDirection(Direction::DOWN);
+
+    initialized = true;
+    return true;
+}
+
+// Switch to a reloaded entity type without respawning
+bool AnimatedDataCharacter::rebindPrototype(std::shared_ptr<const EntityPrototype> entityPrototype)
+{
+    if (!entityPrototype || !entityPrototype->animationTable)
+    {
+        return false;
+    }
+
+    // Actions are copies of the old prototype's, drop them (and any action in progress) first
+    actionsList.clear();
+    activeAction = nullptr;
+    isDoingAction = false;
+    actionPointerA = 0;
+    actionPointerB = 0;
+
+    Direction direction = getCurrentDirection();
+    if (!initFromPrototype(entityPrototype))
+    {
+        return false;
+    }
+    setDirection(direction);
+    return true;
+}
+
+// Return a released character to its initial state for another spawn
+bool AnimatedDataCharacter::resetForReuse(std::shared_ptr<const EntityPrototype> entityPrototype)
+{
+    // Effects still queued would complete on the next spawn's behalf
+    EffectSystem::releaseOwner(this);
+    effectQueue.clear();
+
+    position = v2(0, 0);
+    wasMoving = false;
+    stageOfLife = StageOfLife::Alive;
+    animationStepping = true;
+    level = nullptr;
+    inventory = Inventory(1);
+
+    // Actions, animations and hitbox come from the prototype as on a fresh init
+    if (!rebindPrototype(entityPrototype))
+    {
+        return false;
+    }
+    setDirection(Direction::DOWN);
+    return true;
+}
+
+// Load an entity type from a folder containing character.json
+bool AnimatedDataCharacter::loadPrototype(const std::string &folderPath, EntityPrototype &prototype)
+{
+    prototype.folderPath = folderPath;
+    prototype.sourcePaths.push_back(folderPath);
+    DataFile &datafile = prototype.characterData;
+
     // Construct path to character.json in the folder
     std::string characterFilePath = folderPath + "/character.json";
 
@@ -107,8 +237,11 @@ bool AnimatedDataCharacter::init(const std::string &folderPath)
                 std::string actionName = actionPath;
                 // Build full path to action folder
                 std::string fullPath = "/assets/DataFiles/Actions/" + actionName;
-                if (addAction(fullPath))
+                prototype.sourcePaths.push_back(fullPath);
+                Action action(fullPath);
+                if (action.contains("name"))
                 {
+                    prototype.actions.push_back(action);
                     printf("AnimatedDataCharacter: Loaded innate action '%s' from '%s'\n", actionName.c_str(), fullPath.c_str());
                 }
                 else
@@ -122,29 +255,11 @@ bool AnimatedDataCharacter::init(const std::string &folderPath)
     // Load hitbox size and distance if specified in JSON (used for actions)
     if (datafile.contains("hitbox_size") && datafile["hitbox_size"].is_number())
     {
-        hitboxSize = datafile["hitbox_size"];
+        prototype.hitboxSize = datafile["hitbox_size"];
     }
     if (datafile.contains("hitbox_distance") && datafile["hitbox_distance"].is_number())
     {
-        hitboxDistance = datafile["hitbox_distance"];
-    }
-
-    // Create default character hitbox - a single tile at the bottom of the sprite
-    // This represents the character's physical footprint
-    std::vector<HitboxTile> characterHitboxTiles;
-    HitboxTile bottomTile;
-    bottomTile.x = 0;
-    bottomTile.y = 0; // At character position (bottom center)
-    bottomTile.delay = 0.0f;
-    bottomTile.damageModifier = 1.0f;
-    characterHitboxTiles.push_back(bottomTile);
-
-    // Create character hitbox from the single tile - this will be centered at the character's position
-    characterHitbox = new HitBox();
-    for (Direction direction : {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT})
-    {
-        characterHitbox->boxesByDirection[direction] = HitBox::buildFromTiles(characterHitboxTiles, hitboxSize, 0.0f, direction);
-        characterHitbox->boundingBoxByDirection[direction] = HitBox::buildBoundingBox(characterHitbox->boxesByDirection[direction], direction);
+        prototype.hitboxDistance = datafile["hitbox_distance"];
     }
 
     std::string characterName = datafile["name"];
@@ -190,15 +305,43 @@ bool AnimatedDataCharacter::init(const std::string &folderPath)
         return false;
     }
 
-    std::string layerFilename = firstLayer["filename"];
     int tileSize = firstLayer["tile_size"];
 
     printf("AnimatedDataCharacter: Using %zu layers\n", layerFilenames.size());
     printf("AnimatedDataCharacter: Using tile size: %d\n", tileSize);
 
+    // Characters whose folders use the same sheets share one immutable animation table
+    prototype.animationTable = AnimationAssetCache::find(folderPath);
+    if (prototype.animationTable)
+    {
+        printf("AnimatedDataCharacter: Sharing cached animations for '%s'\n", folderPath.c_str());
+    }
+    else
+    {
+        prototype.animationTable = loadAnimationTable(folderPath, layerFilenames, tileSize);
+        if (!prototype.animationTable)
+        {
+            return false;
+        }
+    }
+
+    // Resolve animation names once, playback only uses ids from here on
+    prototype.idleAnimationId = prototype.animationTable->getAnimationId("idle");
+    prototype.walkAnimationId = prototype.animationTable->getAnimationId("walkcycle");
+
+    return true;
+}
+
+// Base path of the layered animation sheets (idle/, walkcycle/ subfolders)
+static const char *ANIMATION_SHEETS_BASE_PATH = "assets/Art/AnimationsSheets";
+
+// Resolve sheet layouts from the layer PNGs (frame counts come from the sheet dimensions)
+bool AnimatedDataCharacter::buildAnimationLayouts(const std::vector<std::string> &layerFilenames, int tileSize,
+                                                  std::vector<AnimationLayout> &layouts)
+{
     // Construct paths using the first layer filename from the datafile for dimension checking
-    std::string idle_body_path = "assets/Art/AnimationsSheets/idle/" + layerFilenames[0];
-    std::string walkcycle_body_path = "assets/Art/AnimationsSheets/walkcycle/" + layerFilenames[0];
+    std::string idle_body_path = std::string(ANIMATION_SHEETS_BASE_PATH) + "/idle/" + layerFilenames[0];
+    std::string walkcycle_body_path = std::string(ANIMATION_SHEETS_BASE_PATH) + "/walkcycle/" + layerFilenames[0];
 
     // Get dimensions for idle animation
     uint32_t idle_width = 0, idle_height = 0;
@@ -231,7 +374,7 @@ bool AnimatedDataCharacter::init(const std::string &folderPath)
            walkcycle_width, walkcycle_height, walkcycle_frames_per_direction, walkcycle_direction_count);
 
     // Define the animation layouts using computed values and all layer filenames
-    std::vector<AnimationLayout> layouts = {
+    layouts = {
         AnimationLayout(
             "idle", layerFilenames, tileSize, tileSize, idle_frames_per_direction, idle_direction_count,
             {Direction::UP, Direction::LEFT, Direction::DOWN, Direction::RIGHT}),
@@ -239,22 +382,68 @@ bool AnimatedDataCharacter::init(const std::string &folderPath)
             "walkcycle", layerFilenames, tileSize, tileSize, walkcycle_frames_per_direction, walkcycle_direction_count,
             {Direction::UP, Direction::LEFT, Direction::DOWN, Direction::RIGHT})};
 
-    // Load the animation table using our new system
-    animationTable = loader.loadAnimationTable("assets/Art/AnimationsSheets", layouts);
+    return true;
+}
+
+// Resolve sheet layouts and load the animation table
+std::shared_ptr<const AnimationTable> AnimatedDataCharacter::loadAnimationTable(const std::string &folderPath,
+                                                                                const std::vector<std::string> &layerFilenames,
+                                                                                int tileSize)
+{
+    std::vector<AnimationLayout> layouts;
+    if (!buildAnimationLayouts(layerFilenames, tileSize, layouts))
+    {
+        return nullptr;
+    }
+
+    // Load (or share) the animation table through the process-wide cache
+    std::shared_ptr<const AnimationTable> table = AnimationAssetCache::load(folderPath, ANIMATION_SHEETS_BASE_PATH, layouts);
 
-    if (animationTable.getAnimationNames().empty())
+    if (!table)
     {
         printf("AnimatedDataCharacter: Failed to load animations from skeleton assets\n");
+    }
+
+    return table;
+}
+
+// Decode a character's sheets ahead of init (used by level loading on worker threads)
+bool AnimatedDataCharacter::prefetchAssets(const std::string &folderPath)
+{
+    DataFile characterFile;
+    if (!characterFile.load(folderPath + "/character.json"))
+    {
+        printf("AnimatedDataCharacter: WARNING: Cannot prefetch assets, failed to load character.json from %s\n", folderPath.c_str());
         return false;
     }
 
-    // Set initial state
-    currentAnimation = "idle";
-    setDirection(Direction::DOWN);
-    currentFrame = 0;
-    frameTimer = 0.0f;
+    if (!characterFile.contains("layers") || !characterFile["layers"].is_array() || characterFile["layers"].empty() ||
+        !characterFile["layers"][0].contains("tile_size"))
+    {
+        return false;
+    }
 
-    initialized = true;
+    std::vector<std::string> layerFilenames;
+    for (const auto &layer : characterFile["layers"])
+    {
+        if (layer.contains("filename"))
+        {
+            layerFilenames.push_back(layer["filename"].get<std::string>());
+        }
+    }
+
+    if (layerFilenames.empty())
+    {
+        return false;
+    }
+
+    std::vector<AnimationLayout> layouts;
+    if (!buildAnimationLayouts(layerFilenames, characterFile["layers"][0]["tile_size"].get<int>(), layouts))
+    {
+        return false;
+    }
+
+    AnimationAssetCache::prefetch(ANIMATION_SHEETS_BASE_PATH, layouts);
     return true;
 }
 
@@ -264,28 +453,8 @@ void AnimatedDataCharacter::update(float dt, v2 moveVector)
     if (!initialized)
         return;
 
-    // Update visual effects
-    if (!effectQueue.empty())
-    {
-        auto &front = effectQueue.front();
-        if (front)
-        {
-            front->update(dt);
-            // If the effect supports ghost trails, feed it the current position.
-            if (auto ghost = dynamic_cast<IGhostTrailEffect *>(front.get()))
-            {
-                ghost->updateSubjectPosition(position);
-            }
-            if (!front->isActive())
-            {
-                effectQueue.pop_front();
-            }
-        }
-        else
-        {
-            effectQueue.pop_front();
-        }
-    }
+    // Visual effects are advanced by EffectSystem::update
+
     // Don't update if Dying or Dead
     if (stageOfLife == StageOfLife::Dying || stageOfLife == StageOfLife::Dead)
         return;
@@ -329,21 +498,11 @@ void AnimatedDataCharacter::update(float dt, v2 moveVector)
     // Auto-switch to walkcycle when moving, idle when stopping
     if (isMoving && !wasMoving)
     {
-        if (currentAnimation != "walkcycle")
-        {
-            currentAnimation = "walkcycle";
-            currentFrame = 0;
-            frameTimer = 0.0f;
-        }
+        playback.play(walkAnimationId);
     }
     else if (!isMoving && wasMoving)
     {
-        if (currentAnimation != "idle")
-        {
-            currentAnimation = "idle";
-            currentFrame = 0;
-            frameTimer = 0.0f;
-        }
+        playback.play(idleAnimationId);
     }
     wasMoving = isMoving;
 
@@ -355,7 +514,10 @@ void AnimatedDataCharacter::update(float dt, v2 moveVector)
     position.y += moveVector.y * dt;
 
     // Update animation
-    updateAnimation(dt);
+    if (animationStepping)
+    {
+        updateAnimation(dt);
+    }
 }
 
 // Handle input for demo controls
@@ -374,15 +536,15 @@ void AnimatedDataCharacter::handleInput()
     // Handle manual animation input (overrides auto-switching)
     if (animKey1)
     {
-        currentAnimation = "idle";
-        currentFrame = 0;
-        frameTimer = 0.0f;
+        playback.animation = idleAnimationId;
+        playback.frame = 0;
+        playback.timer = 0.0f;
     }
     else if (animKey2)
     {
-        currentAnimation = "walkcycle";
-        currentFrame = 0;
-        frameTimer = 0.0f;
+        playback.animation = walkAnimationId;
+        playback.frame = 0;
+        playback.timer = 0.0f;
     }
 
     // Handle R key - reset position
@@ -395,54 +557,16 @@ void AnimatedDataCharacter::handleInput()
 // Update animation state
 void AnimatedDataCharacter::updateAnimation(float dt)
 {
-    const Animation *anim = animationTable.getAnimation(currentAnimation);
-    if (!anim || anim->frames.empty())
-        return;
-
-    // Update frame timer
-    frameTimer += dt * 1000.0f; // Convert to milliseconds
-
-    // Find current frame
-    const AnimationFrame *currentAnimFrame = nullptr;
-    for (const auto &frame : anim->frames)
+    if (animationTable)
     {
-        if (frame.direction == currentDirection && frame.frameIndex == currentFrame)
-        {
-            currentAnimFrame = &frame;
-            break;
-        }
-    }
-
-    // If we found a frame, check if we should advance
-    if (currentAnimFrame && frameTimer >= currentAnimFrame->delay)
-    {
-        frameTimer = 0.0f;
-
-        // Advance to next frame - but handle idle vs animated differently
-        if (currentAnimation == "idle")
-        {
-            // Idle animations don't advance frames - they stay at frame 0 for each direction
-            currentFrame = 0;
-        }
-        else
-        {
-            // Walkcycle and other animations advance through frames within each direction
-            currentFrame++;
-
-            // For walkcycle: 9 frames per direction, so max frame index is 8
-            int maxFramesPerDirection = 9;
-            if (currentFrame >= maxFramesPerDirection)
-            {
-                currentFrame = 0;
-            }
-        }
+        animationTable->advance(&playback, 1, dt);
     }
 }
 
 // Cycle through directions
 void AnimatedDataCharacter::cycleDirection()
 {
-    int currentDir = static_cast<int>(currentDirection);
+    int currentDir = static_cast<int>(playback.direction);
     currentDir = (currentDir + 1) % 4;
     setDirection(static_cast<Direction>(currentDir));
 }
@@ -450,17 +574,9 @@ void AnimatedDataCharacter::cycleDirection()
 // Cycle through animations
 void AnimatedDataCharacter::cycleAnimation()
 {
-    if (currentAnimation == "idle")
-    {
-        currentAnimation = "walkcycle";
-    }
-    else
-    {
-        currentAnimation = "idle";
-    }
-
-    currentFrame = 0;
-    frameTimer = 0.0f;
+    playback.animation = (playback.animation == idleAnimationId) ? walkAnimationId : idleAnimationId;
+    playback.frame = 0;
+    playback.timer = 0.0f;
 }
 
 // Render the demo
@@ -508,23 +624,63 @@ void AnimatedDataCharacter::render(v2 renderPosition)
         renderHitbox();
 }
 
-// Render the current animation frame
-void AnimatedDataCharacter::renderCurrentFrame()
+// Queue the current frame at a specific position into a draw buffer
+void AnimatedDataCharacter::submitRender(SpriteDrawBuffer &buffer, v2 renderPosition, float depthY)
 {
-    const Animation *anim = animationTable.getAnimation(currentAnimation);
-    if (!anim || anim->frames.empty())
+    if (!initialized)
         return;
 
-    // Find the current frame for the current direction
-    const AnimationFrame *currentAnimFrame = nullptr;
-    for (const auto &frame : anim->frames)
+    // Don't render if Dead or dying
+    if (stageOfLife == StageOfLife::Dead || stageOfLife == StageOfLife::Dying)
+        return;
+
+    // Ghosts share the character's slot in the buffer so they stay right behind it
+    buffer.beginCharacter(depthY);
+    GhostTrailRenderer::submitGhostsForCharacter(*this, buffer);
+
+    const AnimationFrame *currentAnimFrame = findCurrentAnimationFrame();
+    if (currentAnimFrame)
     {
-        if (frame.direction == currentDirection && frame.frameIndex == currentFrame)
+        IVisualEffect *effect = getFrontEffect();
+        if (effect && !effect->isActive())
         {
-            currentAnimFrame = &frame;
-            break;
+            effect = nullptr;
         }
+        uint64_t effectKey = effect ? effectQueue.front().getKey() : 0;
+
+        if (!currentAnimFrame->spriteLayers.empty())
+        {
+            for (size_t i = 0; i < currentAnimFrame->spriteLayers.size(); ++i)
+            {
+                buffer.submit(&currentAnimFrame->spriteLayers[i], renderPosition, static_cast<uint32_t>(i), effect, effectKey);
+            }
+        }
+        else
+        {
+            // Fallback to legacy single sprite
+            buffer.submit(&currentAnimFrame->sprite, renderPosition, 0, effect, effectKey);
+        }
+    }
+
+    // The debug hitbox has to land on top of the sprites, so flush them first
+    if (!isDoingAction && hitboxDebugActive && characterHitbox)
+    {
+        buffer.flush();
+        renderHitbox();
     }
+}
+
+// Find the frame for the current animation, direction and frame index
+const AnimationFrame *AnimatedDataCharacter::findCurrentAnimationFrame() const
+{
+    return animationTable ? animationTable->getFrame(playback) : nullptr;
+}
+
+// Render the current animation frame
+void AnimatedDataCharacter::renderCurrentFrame()
+{
+    // Find the current frame for the current direction
+    const AnimationFrame *currentAnimFrame = findCurrentAnimationFrame();
 
     if (!currentAnimFrame)
         return;
@@ -550,20 +706,8 @@ void AnimatedDataCharacter::renderCurrentFrame()
 // Render the current animation frame at a specific position
 void AnimatedDataCharacter::renderCurrentFrameAt(v2 renderPosition)
 {
-    const Animation *anim = animationTable.getAnimation(currentAnimation);
-    if (!anim || anim->frames.empty())
-        return;
-
     // Find the current frame for the current direction
-    const AnimationFrame *currentAnimFrame = nullptr;
-    for (const auto &frame : anim->frames)
-    {
-        if (frame.direction == currentDirection && frame.frameIndex == currentFrame)
-        {
-            currentAnimFrame = &frame;
-            break;
-        }
-    }
+    const AnimationFrame *currentAnimFrame = findCurrentAnimationFrame();
 
     if (!currentAnimFrame)
         return;
@@ -619,18 +763,19 @@ void AnimatedDataCharacter::renderDebugInfo()
     char stateText[256];
 
     textPos.y -= 20;
-    snprintf(stateText, sizeof(stateText), "Animation: %s", currentAnimation.c_str());
+    const CompiledAnimation *compiledAnim = animationTable ? animationTable->getCompiled(playback.animation) : nullptr;
+    snprintf(stateText, sizeof(stateText), "Animation: %s", compiledAnim ? compiledAnim->name.c_str() : "none");
     draw_text(stateText, textPos);
 
     textPos.y -= 20;
     const char *directionNames[] = {"UP", "LEFT", "DOWN", "RIGHT"};
-    int dirIndex = static_cast<int>(currentDirection);
+    int dirIndex = static_cast<int>(playback.direction);
     const char *dirName = (dirIndex >= 0 && dirIndex < 4) ? directionNames[dirIndex] : "UNKNOWN";
     snprintf(stateText, sizeof(stateText), "Direction: %s (%d)", dirName, dirIndex);
     draw_text(stateText, textPos);
 
     textPos.y -= 20;
-    snprintf(stateText, sizeof(stateText), "Frame: %d", currentFrame);
+    snprintf(stateText, sizeof(stateText), "Frame: %d", playback.frame);
     draw_text(stateText, textPos);
 
     textPos.y -= 20;
@@ -647,7 +792,7 @@ void AnimatedDataCharacter::renderDebugInfo()
 // Check if demo is valid
 bool AnimatedDataCharacter::isValid() const
 {
-    return initialized && !animationTable.getAnimationNames().empty();
+    return initialized && animationTable && !animationTable->animations.empty();
 }
 
 // Get current position
@@ -663,12 +808,12 @@ void AnimatedDataCharacter::setPosition(v2 newPosition)
 
 Direction AnimatedDataCharacter::getCurrentDirection() const
 {
-    return currentDirection;
+    return playback.direction;
 }
 
 void AnimatedDataCharacter::setDirection(Direction direction)
 {
-    currentDirection = direction;
+    playback.direction = direction;
 }
 
 void AnimatedDataCharacter::setLevel(LevelV1 *levelPtr)
@@ -683,7 +828,8 @@ LevelV1 *AnimatedDataCharacter::getLevel() const
 
 const std::string &AnimatedDataCharacter::getDataFilePath() const
 {
-    return datafile.getpath();
+    static const std::string noPath;
+    return prototype ? prototype->characterData.getpath() : noPath;
 }
 
 HitBox *AnimatedDataCharacter::getHitbox() const
@@ -755,47 +901,70 @@ Action *AnimatedDataCharacter::getActiveAction() const
 
 IGhostTrailEffect *AnimatedDataCharacter::getActiveGhostTrailEffect() const
 {
-    if (!effectQueue.empty() && effectQueue.front())
+    if (!effectQueue.empty())
     {
-        return dynamic_cast<IGhostTrailEffect *>(effectQueue.front().get());
+        return EffectSystem::getGhostTrail(effectQueue.front());
+    }
+    return nullptr;
+}
+
+IVisualEffect *AnimatedDataCharacter::getFrontEffect() const
+{
+    if (!effectQueue.empty())
+    {
+        return EffectSystem::get(effectQueue.front());
     }
     return nullptr;
 }
 
 void AnimatedDataCharacter::triggerEffect(const std::string &name, int flashes, float totalDuration, float maxIntensity)
 {
-    auto effect = EffectFactory::makeEffect(name);
-    if (effect)
+    triggerEffect(EffectFactory::getEffectId(name), flashes, totalDuration, maxIntensity);
+}
+
+void AnimatedDataCharacter::triggerEffect(EffectId id, int flashes, float totalDuration, float maxIntensity, uint32_t tag)
+{
+    // Effects queue behind the running one and start when it finishes
+    EffectHandle handle = EffectSystem::create(id, this, tag, flashes, totalDuration, maxIntensity, effectQueue.empty());
+    if (handle.isValid())
     {
-        effect->trigger(flashes, totalDuration, maxIntensity);
-        effectQueue.push_back(std::move(effect));
+        effectQueue.push_back(handle);
     }
 }
 
-void AnimatedDataCharacter::triggerEffect(const std::string &name, int flashes, float totalDuration, float maxIntensity, std::function<void()> onComplete)
+void AnimatedDataCharacter::onEffectFinished(const EffectEvent &event)
 {
-    auto effect = EffectFactory::makeEffect(name);
-    if (effect)
+    auto it = std::find(effectQueue.begin(), effectQueue.end(), event.handle);
+    if (it != effectQueue.end())
+    {
+        bool wasFront = it == effectQueue.begin();
+        EffectSystem::release(event.handle);
+        effectQueue.erase(it);
+        if (wasFront && !effectQueue.empty())
+        {
+            EffectSystem::start(effectQueue.front());
+        }
+    }
+
+    if (event.tag == EFFECT_TAG_HIT_REACTION)
     {
-        effect->setOnComplete(std::move(onComplete));
-        effect->trigger(flashes, totalDuration, maxIntensity);
-        effectQueue.push_back(std::move(effect));
+        setStageOfLife(StageOfLife::Dying);
     }
 }
 
 void AnimatedDataCharacter::beginFrontEffect()
 {
-    if (!effectQueue.empty() && effectQueue.front())
+    if (IVisualEffect *effect = getFrontEffect())
     {
-        effectQueue.front()->beginDraw();
+        effect->beginDraw();
     }
 }
 
 void AnimatedDataCharacter::endFrontEffect()
 {
-    if (!effectQueue.empty() && effectQueue.front())
+    if (IVisualEffect *effect = getFrontEffect())
     {
-        effectQueue.front()->endDraw();
+        effect->endDraw();
     }
 }
 void AnimatedDataCharacter::renderActionHitbox()
@@ -837,7 +1006,7 @@ void AnimatedDataCharacter::renderHitbox()
     bool insideActionHitbox = false;
     if (level)
     {
-        CF_Aabb characterBox = characterHitbox->getBoundingBox(currentDirection, position);
+        CF_Aabb characterBox = characterHitbox->getBoundingBox(playback.direction, position);
         insideActionHitbox = level->isCharacterInActionHitbox(this, characterBox);
     }
 
@@ -847,8 +1016,8 @@ void AnimatedDataCharacter::renderHitbox()
         // Red if inside an action hitbox during warmup
         color = cf_make_color_rgb(255, 0, 0); // Red
     }
-    else if (level && level->checkAgentsInArea(characterHitbox->getBoxes(currentDirection, position),
-                                               characterHitbox->getBoundingBox(currentDirection, position), this))
+    else if (level && level->checkAgentsInArea(characterHitbox->getBoxes(playback.direction, position),
+                                               characterHitbox->getBoundingBox(playback.direction, position), this))
     {
         // Orange if other agents are detected nearby
         color = cf_make_color_rgb(255, 165, 0); // Orange
@@ -858,7 +1027,7 @@ void AnimatedDataCharacter::renderHitbox()
     cf_draw_push_color(color);
     cf_draw_push_antialias(false);
 
-    for (const auto &box : characterHitbox->getBoxes(currentDirection, position))
+    for (const auto &box : characterHitbox->getBoxes(playback.direction, position))
     {
         // Draw thick outline (thickness, chubbiness/rounding)
         cf_draw_box(box, 3.0f, 0.0f);
@@ -880,7 +1049,19 @@ bool AnimatedDataCharacter::addAction(const std::string &folderPath)
         return false;
     }
 
-    std::string actionName = newAction["name"];
+    return addAction(newAction);
+}
+
+// Add a copy of an already loaded action to the actions list
+bool AnimatedDataCharacter::addAction(const Action &action)
+{
+    if (!action.contains("name"))
+    {
+        printf("AnimatedDataCharacter: Failed to add action - no 'name' field found\n");
+        return false;
+    }
+
+    std::string actionName = action["name"];
 
     // Check if action with same name already exists
     for (const auto &existingAction : actionsList)
@@ -891,6 +1072,7 @@ bool AnimatedDataCharacter::addAction(const std::string &folderPath)
             return false;
         }
     }
+    Action newAction(action);
     // tell action about self
     newAction.setCharacter(this);
     // add to list
@@ -995,8 +1177,8 @@ void AnimatedDataCharacter::applyGlobalCooldown(float globalCooldownSeconds)
 void AnimatedDataCharacter::OnHit(AnimatedDataCharacter *character, Damage damage)
 {
     // Trigger red flash effect when hit
-    triggerEffect("red", 3, 1.0f, 0.80f, [this]()
-                  { this->setStageOfLife(StageOfLife::Dying); });
+    // The character starts dying once the flash finishes (see onEffectFinished)
+    triggerEffect(EffectId::Red, 3, 1.0f, 0.80f, EFFECT_TAG_HIT_REACTION);
 
     // Print debug message
     printf("AnimatedDataCharacter: Hit by character with damage value: %.2f\n", damage.value);
@@ -1035,4 +1217,13 @@ Inventory &AnimatedDataCharacter::getInventory()
 const Inventory &AnimatedDataCharacter::getInventory() const
 {
     return inventory;
-}
\ No newline at end of file
+}
+void AnimatedDataCharacter::setAnimationStepping(bool enabled)
+{
+    animationStepping = enabled;
+}
+
+bool AnimatedDataCharacter::getAnimationStepping() const
+{
+    return animationStepping;
+}
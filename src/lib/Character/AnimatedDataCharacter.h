@@ -7,6 +7,8 @@
 #include "HitBox.h"
 #include "Action.h"
 #include "IVisualEffect.h"
+#include "EffectFactory.h"
+#include "EffectSystem.h"
 #include "Damage.h"
 #include "../Items/Inventory.h"
 #include <memory>
@@ -29,7 +31,9 @@ class LevelV1;
 class HitBox;
 class Action;
 class IGhostTrailEffect;
+class SpriteDrawBuffer;
 class GhostTrailRenderer;
+struct EntityPrototype;
 
 // Demo class to showcase the new SpriteAnimationLoader system
 class AnimatedDataCharacter
@@ -39,8 +43,30 @@ public:
     virtual ~AnimatedDataCharacter();
 
     // Initialize the character with a folder path containing character.json
+    // The folder is only read once per process (see EntityPrototypeCache)
     bool init(const std::string &folderPath);
 
+    // Initialize the character from an already loaded entity type
+    bool initFromPrototype(std::shared_ptr<const EntityPrototype> entityPrototype);
+
+    // Switch a live character to a reloaded entity type (hot reload)
+    // Innate actions and animations are replaced; position, direction and stage of life are kept
+    virtual bool rebindPrototype(std::shared_ptr<const EntityPrototype> entityPrototype);
+
+    // Return a released character to its freshly initialized state for another spawn (object pools)
+    // Allocations such as the action list and effect queue are kept; the level pointer is cleared
+    virtual bool resetForReuse(std::shared_ptr<const EntityPrototype> entityPrototype);
+
+    // Get the entity type this character was created from (nullptr before init)
+    std::shared_ptr<const EntityPrototype> getPrototype() const { return prototype; }
+
+    // Load an entity type from a folder: character.json, innate actions and animations
+    static bool loadPrototype(const std::string &folderPath, EntityPrototype &prototype);
+
+    // Read a character folder's character.json and decode its animation sheets ahead of init
+    // Thread-safe; init on the main thread then only slices frames and uploads them
+    static bool prefetchAssets(const std::string &folderPath);
+
     // Update demo state with a move vector
     void update(float dt, v2 moveVector);
 
@@ -50,10 +76,17 @@ public:
     // Render the demo at a specific position
     void render(v2 renderPosition);
 
+    // Queue the current frame's sprites into a draw buffer instead of drawing them directly
+    // Ghost trails (and the debug hitbox) still draw immediately
+    void submitRender(SpriteDrawBuffer &buffer, v2 renderPosition, float depthY);
+
     // Visual FX: trigger an effect by name (replaces current effect)
     void triggerEffect(const std::string &name, int flashes = 3, float totalDuration = 2.0f, float maxIntensity = 0.85f);
-    // Visual FX: trigger with completion callback
-    void triggerEffect(const std::string &name, int flashes, float totalDuration, float maxIntensity, std::function<void()> onComplete);
+    // Visual FX: trigger by pre-resolved effect id (avoids the name lookup)
+    // tag is handed back through onEffectFinished when the effect completes
+    void triggerEffect(EffectId id, int flashes = 3, float totalDuration = 2.0f, float maxIntensity = 0.85f, uint32_t tag = 0);
+    // Visual FX: completion event from the EffectSystem for one of this character's effects
+    void onEffectFinished(const EffectEvent &event);
 
     // deprecated
     void handleInput();
@@ -99,6 +132,7 @@ public:
 
     // ActionsList management
     bool addAction(const std::string &folderPath);
+    bool addAction(const Action &action);
     bool removeAction(const std::string &actionName);
     const std::vector<Action> &getActions() const;
 
@@ -117,32 +151,32 @@ public:
     IGhostTrailEffect *getActiveGhostTrailEffect() const;
 
     // Stage of life management
-    void setStageOfLife(StageOfLife stage);
+    virtual void setStageOfLife(StageOfLife stage);
     StageOfLife getStageOfLife() const;
 
     // Inventory access
     Inventory &getInventory();
     const Inventory &getInventory() const;
 
+    // Animation stepping (disabled for agents simulated at reduced detail off screen)
+    void setAnimationStepping(bool enabled);
+    bool getAnimationStepping() const;
+
 protected:
     // Inventory - character's item inventory
     Inventory inventory;
 
 private:
-    // The animation loader
-    SpriteAnimationLoader loader;
+    // Entity type this character was created from (character.json, innate actions, animations)
+    std::shared_ptr<const EntityPrototype> prototype;
 
-    // DataFile containing character configuration
-    DataFile datafile;
+    // Animation table containing all skeleton animations (shared through AnimationAssetCache)
+    std::shared_ptr<const AnimationTable> animationTable;
 
-    // Animation table containing all skeleton animations
-    AnimationTable animationTable;
-
-    // Current animation state
-    std::string currentAnimation;
-    Direction currentDirection;
-    int currentFrame;
-    float frameTimer;
+    // Current animation state (ids resolved once against animationTable)
+    AnimationPlayback playback;
+    AnimationId idleAnimationId;
+    AnimationId walkAnimationId;
 
     // Demo state
     bool initialized;
@@ -166,6 +200,9 @@ private:
     // Stage of life
     StageOfLife stageOfLife;
 
+    // Whether update() advances animation frames
+    bool animationStepping;
+
     // Hitbox state
     bool hitboxDebugActive;
     float hitboxSize;
@@ -181,16 +218,23 @@ private:
     Action *activeAction; // Currently active action
 
     // Helper methods
+    static std::shared_ptr<const AnimationTable> loadAnimationTable(const std::string &folderPath,
+                                                                   const std::vector<std::string> &layerFilenames,
+                                                                   int tileSize);
+    static bool buildAnimationLayouts(const std::vector<std::string> &layerFilenames, int tileSize,
+                                      std::vector<AnimationLayout> &layouts);
     void cycleDirection();
     void cycleAnimation();
     void updateAnimation(float dt);
     void renderCurrentFrame();
     void renderCurrentFrameAt(v2 renderPosition);
+    const AnimationFrame *findCurrentAnimationFrame() const;
     void renderDebugInfo();
     void renderHitbox();
 
-    // Visual effects
-    std::deque<std::unique_ptr<IVisualEffect>> effectQueue;
+    // Visual effects (pooled in EffectSystem; only the front one runs)
+    std::vector<EffectHandle> effectQueue;
+    IVisualEffect *getFrontEffect() const;
     void beginFrontEffect();
     void endFrontEffect();
 
@@ -1,7 +1,8 @@
 #include "AnimatedDataCharacterNavMeshAgent.h"
-#include "JobSystem.h"
 #include "DataFile.h"
 #include "StateMachine.h"
+#include "EntityPrototypeCache.h"
+#include "LevelV1.h"
 #include <cute.h>
 #include <cstdio>
 
@@ -11,7 +12,6 @@ using namespace Cute;
 AnimatedDataCharacterNavMeshAgent::AnimatedDataCharacterNavMeshAgent()
     : AnimatedDataCharacter(), navmesh(nullptr), currentPolygon(-1),
       currentNavMeshPath(nullptr),
-      backgroundJobRunning(false), backgroundJobComplete(false),
       backgroundMoveVector(cf_v2(0.0f, 0.0f))
 {
 }
@@ -22,21 +22,61 @@ AnimatedDataCharacterNavMeshAgent::~AnimatedDataCharacterNavMeshAgent()
     // We don't own the navmesh, so we don't delete it
 }
 
-// Override init to also load state machines
+// Override init to also create state machines
 bool AnimatedDataCharacterNavMeshAgent::init(const std::string &folderPath)
 {
-    // Call parent init first
-    if (!AnimatedDataCharacter::init(folderPath))
+    // The entity type (including its state machine definitions) is loaded once per folder
+    std::shared_ptr<const EntityPrototype> entityPrototype = EntityPrototypeCache::get(folderPath);
+    if (!entityPrototype || !initFromPrototype(entityPrototype))
     {
+        printf("AnimatedDataCharacterNavMeshAgent: Failed to init from '%s'\n", folderPath.c_str());
         return false;
     }
 
-    // Load state machines from the same folder
-    loadStateMachinesFromFolder(folderPath);
+    if (entityPrototype->hasStateMachines)
+    {
+        createStateMachines(entityPrototype->stateMachines, entityPrototype->defaultStateMachine);
+    }
+
+    return true;
+}
+
+// Switch to a reloaded entity type, state machines restart from their default
+bool AnimatedDataCharacterNavMeshAgent::rebindPrototype(std::shared_ptr<const EntityPrototype> entityPrototype)
+{
+    if (!AnimatedDataCharacter::rebindPrototype(entityPrototype))
+    {
+        return false;
+    }
+
+    // Restart from the new definitions and drop the path the old states were following
+    stateMachineController.clear();
+    clearCurrentNavMeshPath();
+    if (entityPrototype->hasStateMachines)
+    {
+        createStateMachines(entityPrototype->stateMachines, entityPrototype->defaultStateMachine);
+    }
 
     return true;
 }
 
+// Return a released agent to its initial state (state machines restart through rebindPrototype)
+bool AnimatedDataCharacterNavMeshAgent::resetForReuse(std::shared_ptr<const EntityPrototype> entityPrototype)
+{
+    if (!AnimatedDataCharacter::resetForReuse(entityPrototype))
+    {
+        return false;
+    }
+
+    navmesh = nullptr;
+    currentPolygon = -1;
+    backgroundMoveVector = cf_v2(0.0f, 0.0f);
+    isOnScreen = true;
+    simulationLOD = SimulationLOD::Full;
+    handle = AgentHandle();
+    return true;
+}
+
 // Set the navmesh this agent is operating on
 void AnimatedDataCharacterNavMeshAgent::setNavMesh(NavMesh *navmesh)
 {
@@ -114,43 +154,14 @@ void AnimatedDataCharacterNavMeshAgent::update(float dt, v2 moveVector)
     }
 }
 
-// Background update - submits AI/pathfinding calculations to job system
-bool AnimatedDataCharacterNavMeshAgent::backgroundUpdate(float dt, bool isOnScreen)
+// Background AI step - called from an "Agent AI Batch" job
+v2 AnimatedDataCharacterNavMeshAgent::computeBackgroundMoveVector(float dt, bool isOnScreen)
 {
-    // Check if a job is already running
-    if (backgroundJobRunning.load())
+    if (isOnScreen)
     {
-        return false; // Job already in progress
+        return OnScreenBackgroundUpdateJob(dt);
     }
-
-    // Mark job as running and not complete
-    backgroundJobRunning.store(true);
-    backgroundJobComplete.store(false);
-
-    // Submit the calculation job to the job system with a name
-    JobSystem::submitJob([this, dt, isOnScreen]()
-                         {
-        if (isOnScreen)
-        {
-            this->OnScreenBackgroundUpdateJob(dt);
-        }
-        else
-        {
-            this->OffScreenBackgroundUpdateJob(dt);
-        }
-        
-        // Mark job as complete
-        this->backgroundJobComplete.store(true);
-        this->backgroundJobRunning.store(false); },
-                         "Agent AI Update");
-
-    return true; // Job submitted successfully
-}
-
-// Check if background job is complete
-bool AnimatedDataCharacterNavMeshAgent::isBackgroundUpdateComplete() const
-{
-    return backgroundJobComplete.load();
+    return OffScreenBackgroundUpdateJob(dt);
 }
 
 // Get the result of the background update
@@ -159,6 +170,12 @@ v2 AnimatedDataCharacterNavMeshAgent::getBackgroundMoveVector() const
     return backgroundMoveVector;
 }
 
+// Apply the result of a finished background update
+void AnimatedDataCharacterNavMeshAgent::setBackgroundMoveVector(v2 moveVector)
+{
+    backgroundMoveVector = moveVector;
+}
+
 // Get the current navigation path
 std::shared_ptr<NavMeshPath> AnimatedDataCharacterNavMeshAgent::getCurrentNavMeshPath()
 {
@@ -196,13 +213,12 @@ const StateMachineController *AnimatedDataCharacterNavMeshAgent::getStateMachine
 }
 
 // Background update job for on-screen agents (more detailed AI)
-void AnimatedDataCharacterNavMeshAgent::OnScreenBackgroundUpdateJob(float dt)
+v2 AnimatedDataCharacterNavMeshAgent::OnScreenBackgroundUpdateJob(float dt)
 {
     // Check if navmesh is available
     if (navmesh == nullptr)
     {
-        backgroundMoveVector = cf_v2(0.0f, 0.0f);
-        return;
+        return cf_v2(0.0f, 0.0f);
     }
 
     // Get current position
@@ -243,12 +259,13 @@ void AnimatedDataCharacterNavMeshAgent::OnScreenBackgroundUpdateJob(float dt)
 
             if (!currentNavMeshPath || !currentNavMeshPath->isValid())
             {
-                backgroundMoveVector = cf_v2(0.0f, 0.0f);
+                return cf_v2(0.0f, 0.0f);
             }
-            return;
+            // Keep the previous heading until the new path is followed next step
+            return backgroundMoveVector;
         }
 
-        // set a new backgroundMoveVector toward next waypoint
+        // new move vector toward next waypoint
         float dirX = nextWaypoint->x - currentPosition.x;
         float dirY = nextWaypoint->y - currentPosition.y;
 
@@ -260,7 +277,7 @@ void AnimatedDataCharacterNavMeshAgent::OnScreenBackgroundUpdateJob(float dt)
             dirY = (dirY / length) * 100.0f;
         }
 
-        backgroundMoveVector = cf_v2(dirX, dirY);
+        return cf_v2(dirX, dirY);
     }
     // else
     else
@@ -276,20 +293,83 @@ void AnimatedDataCharacterNavMeshAgent::OnScreenBackgroundUpdateJob(float dt)
             }
         }
 
-        backgroundMoveVector = cf_v2(0.0f, 0.0f);
+        return cf_v2(0.0f, 0.0f);
     }
 }
 
 // Background update job for off-screen agents (simplified AI)
-void AnimatedDataCharacterNavMeshAgent::OffScreenBackgroundUpdateJob(float dt)
+// Runs at a coarse time slice, so instead of steering toward the current waypoint it walks
+// the path by the distance covered in dt and returns the move vector that lands there
+v2 AnimatedDataCharacterNavMeshAgent::OffScreenBackgroundUpdateJob(float dt)
+{
+    const float moveSpeed = 100.0f; // Same speed as on-screen steering
+
+    // Check if navmesh is available
+    if (navmesh == nullptr || dt <= 0.0f)
+    {
+        return cf_v2(0.0f, 0.0f);
+    }
+
+    // Get current position
+    v2 agentPosition = getPosition();
+    CF_V2 currentPosition = cf_v2(agentPosition.x, agentPosition.y);
+
+    // No path to follow - get new path from current state
+    if (!currentNavMeshPath || !currentNavMeshPath->isValid() || currentNavMeshPath->isComplete())
+    {
+        StateMachine *currentStateMachine = stateMachineController.getCurrentStateMachine();
+        if (currentStateMachine)
+        {
+            State *currentState = currentStateMachine->getCurrentState();
+            if (currentState)
+            {
+                currentNavMeshPath = currentState->GetNewPath(*navmesh, currentPosition);
+            }
+        }
+
+        return cf_v2(0.0f, 0.0f);
+    }
+
+    // Walk along the path, consuming waypoints, until the distance for this slice is spent
+    float remaining = moveSpeed * dt;
+    CF_V2 walkedPosition = currentPosition;
+    while (remaining > 0.0f)
+    {
+        CF_V2 *waypoint = currentNavMeshPath->getCurrent();
+        if (waypoint == nullptr)
+        {
+            currentNavMeshPath->markComplete();
+            break;
+        }
+
+        float dirX = waypoint->x - walkedPosition.x;
+        float dirY = waypoint->y - walkedPosition.y;
+        float length = sqrt(dirX * dirX + dirY * dirY);
+        if (length <= remaining)
+        {
+            walkedPosition = *waypoint;
+            remaining -= length;
+            currentNavMeshPath->getNext();
+        }
+        else
+        {
+            walkedPosition.x += (dirX / length) * remaining;
+            walkedPosition.y += (dirY / length) * remaining;
+            remaining = 0.0f;
+        }
+    }
+
+    return cf_v2((walkedPosition.x - currentPosition.x) / dt,
+                 (walkedPosition.y - currentPosition.y) / dt);
+}
+
+void AnimatedDataCharacterNavMeshAgent::setStageOfLife(StageOfLife stage)
 {
-    OnScreenBackgroundUpdateJob(dt);
-    // TODO: Implement simplified AI for off-screen agents
-    // This might include:
-    // - Simpler pathfinding or path following
-    // - Basic behavior updates
-    // - Minimal state changes
-    // - Skip expensive calculations that won't be visible
+    AnimatedDataCharacter::setStageOfLife(stage);
+    if (getLevel())
+    {
+        getLevel()->onAgentStageChanged(handle, stage);
+    }
 }
 
 // Background AI calculation (runs in worker thread)
@@ -299,6 +379,23 @@ void AnimatedDataCharacterNavMeshAgent::calculateMoveVector(float dt)
 
 // Load state machines from a folder containing state_machines.json
 bool AnimatedDataCharacterNavMeshAgent::loadStateMachinesFromFolder(const std::string &folderPath)
+{
+    std::vector<nlohmann::json> definitions;
+    std::string defaultStateMachineName;
+    if (!loadStateMachineDefinitions(folderPath, definitions, defaultStateMachineName))
+    {
+        return false;
+    }
+
+    createStateMachines(definitions, defaultStateMachineName);
+    return true;
+}
+
+// Read state_machines.json and resolve state machines referenced by file name
+bool AnimatedDataCharacterNavMeshAgent::loadStateMachineDefinitions(const std::string &folderPath,
+                                                                    std::vector<nlohmann::json> &definitions,
+                                                                    std::string &defaultStateMachineName,
+                                                                    std::vector<std::string> *referencedFiles)
 {
     // Construct the path to state_machines.json
     std::string stateMachinesPath = folderPath + "/state_machines.json";
@@ -336,6 +433,10 @@ bool AnimatedDataCharacterNavMeshAgent::loadStateMachinesFromFolder(const std::s
             // The string is a filename - load the state machine from file
             std::string stateMachineName = stateMachineJson.get<std::string>();
             std::string stateMachinePath = "assets/DataFiles/StateMachines/" + stateMachineName + ".json";
+            if (referencedFiles)
+            {
+                referencedFiles->push_back(stateMachinePath);
+            }
 
             // Load the state machine file
             DataFile stateMachineFile;
@@ -345,23 +446,26 @@ bool AnimatedDataCharacterNavMeshAgent::loadStateMachinesFromFolder(const std::s
                 continue;
             }
 
-            // Create a StateMachine from the loaded file (DataFile inherits from nlohmann::json)
-            StateMachine stateMachine(stateMachineFile);
-
-            printf("  - Adding state machine from file: '%s'\n", stateMachine.getName().c_str());
-
-            // Set the agent for all states in this state machine
-            stateMachine.setAgent(this);
-
-            // Add it to the controller (move ownership)
-            stateMachineController.addStateMachine(std::move(stateMachine));
+            // DataFile inherits from nlohmann::json
+            definitions.push_back(static_cast<const nlohmann::json &>(stateMachineFile));
             continue;
         }
 
-        // Create a StateMachine from the JSON blob
-        StateMachine stateMachine(stateMachineJson);
+        definitions.push_back(stateMachineJson);
+    }
+
+    defaultStateMachineName = stateMachinesData["default_state_machine"].get<std::string>();
+    return true;
+}
 
-        printf("  - Adding state machine: '%s'\n", stateMachine.getName().c_str());
+// Create this agent's state machines (states hold per-agent runtime state)
+void AnimatedDataCharacterNavMeshAgent::createStateMachines(const std::vector<nlohmann::json> &definitions,
+                                                            const std::string &defaultStateMachineName)
+{
+    for (const auto &definition : definitions)
+    {
+        // Create a StateMachine from the JSON blob
+        StateMachine stateMachine(definition);
 
         // Set the agent for all states in this state machine
         stateMachine.setAgent(this);
@@ -371,15 +475,8 @@ bool AnimatedDataCharacterNavMeshAgent::loadStateMachinesFromFolder(const std::s
     }
 
     // Set the default state machine
-    std::string defaultStateMachineName = stateMachinesData["default_state_machine"];
-    if (stateMachineController.setCurrentStateMachine(defaultStateMachineName))
-    {
-        printf("  - Set default state machine to: '%s'\n", defaultStateMachineName.c_str());
-    }
-    else
+    if (!stateMachineController.setCurrentStateMachine(defaultStateMachineName))
     {
         printf("  - WARNING: Failed to set default state machine '%s'\n", defaultStateMachineName.c_str());
     }
-
-    return true;
 }
@@ -5,11 +5,28 @@
 #include "NavMesh.h"
 #include "NavMeshPath.h"
 #include "StateMachineController.h"
+#include "AgentHandle.h"
 #include <memory>
-#include <atomic>
 
 using namespace Cute;
 
+// Simulation level of detail for an agent, picked by LevelV1 every frame
+enum class SimulationLOD
+{
+    Full, // On screen: AI, animation and pathing every frame
+    Near, // Off screen but close: reduced tick rate, no animation stepping
+    Far   // Far away: time-sliced state machine stepping, path following by distance
+};
+
+// Tier thresholds for simulation LOD (loaded from the "SimulationLOD" section of window-config.json)
+struct SimulationLODConfig
+{
+    bool enabled = true;
+    float nearDistance = 1200.0f; // Off-screen agents closer than this to the player use Near
+    int nearTickInterval = 3;     // Near agents update once every N frames
+    int farTickInterval = 12;     // Far agents update once every N frames, staggered across agents
+};
+
 // Extended AnimatedDataCharacter that is aware of and tracks which NavMesh it is on
 class AnimatedDataCharacterNavMeshAgent : public AnimatedDataCharacter
 {
@@ -17,9 +34,15 @@ public:
     AnimatedDataCharacterNavMeshAgent();
     ~AnimatedDataCharacterNavMeshAgent();
 
-    // Override init to also load state machines
+    // Override init to also create state machines
     bool init(const std::string &folderPath);
 
+    // Also recreate the state machines from the reloaded definitions (restarting them)
+    bool rebindPrototype(std::shared_ptr<const EntityPrototype> entityPrototype) override;
+
+    // Also drop the navmesh, path and level state of the previous spawn
+    bool resetForReuse(std::shared_ptr<const EntityPrototype> entityPrototype) override;
+
     // Set the navmesh this agent is operating on
     void setNavMesh(NavMesh *navmesh);
 
@@ -41,16 +64,13 @@ public:
     // Override update to track navmesh position
     void update(float dt, v2 moveVector);
 
-    // Background update - submits AI/pathfinding calculations to job system
-    // Returns true if a background job was started, false if one is already running
-    bool backgroundUpdate(float dt, bool isOnScreen);
+    // Background AI/pathfinding step - runs on a worker thread as part of a batch
+    // (see LevelV1::updateAgents) and returns the move vector instead of storing it
+    v2 computeBackgroundMoveVector(float dt, bool isOnScreen);
 
-    // Check if background job is complete
-    bool isBackgroundUpdateComplete() const;
-
-    // Apply the result of the background update (should only be called if isBackgroundUpdateComplete())
-    // Returns the move vector calculated in the background
+    // Move vector from the last finished background step, applied by the main thread
     v2 getBackgroundMoveVector() const;
+    void setBackgroundMoveVector(v2 moveVector);
 
     // Get the current navigation path
     std::shared_ptr<NavMeshPath> getCurrentNavMeshPath();
@@ -69,14 +89,34 @@ public:
     // Load state machines from a folder containing state_machines.json
     bool loadStateMachinesFromFolder(const std::string &folderPath);
 
-    // Background update jobs for different scenarios
-    void OnScreenBackgroundUpdateJob(float dt);
-    void OffScreenBackgroundUpdateJob(float dt);
+    // Read the state machine definitions of a folder (state_machines.json plus referenced files)
+    // Referenced files are appended to referencedFiles if given
+    static bool loadStateMachineDefinitions(const std::string &folderPath, std::vector<nlohmann::json> &definitions,
+                                            std::string &defaultStateMachineName,
+                                            std::vector<std::string> *referencedFiles = nullptr);
+
+    // Create this agent's state machines from definitions and select the default one
+    void createStateMachines(const std::vector<nlohmann::json> &definitions, const std::string &defaultStateMachineName);
 
-    // On-screen visibility (set by OnScreenChecks worker)
+    // Background update jobs for different scenarios, returning the new move vector
+    v2 OnScreenBackgroundUpdateJob(float dt);
+    v2 OffScreenBackgroundUpdateJob(float dt);
+
+    // On-screen visibility (set by LevelV1::updateAgentVisibility)
     bool getIsOnScreen() const { return isOnScreen; }
     void setIsOnScreen(bool onScreen) { isOnScreen = onScreen; }
 
+    // Simulation LOD (set by LevelV1::updateAgents)
+    SimulationLOD getSimulationLOD() const { return simulationLOD; }
+    void setSimulationLOD(SimulationLOD lod) { simulationLOD = lod; }
+
+    // Handle of this agent in its level (null when not in a level)
+    AgentHandle getHandle() const { return handle; }
+    void setHandle(AgentHandle agentHandle) { handle = agentHandle; }
+
+    // Stage changes made outside update() (effects, debug tools) are mirrored into the level
+    void setStageOfLife(StageOfLife stage) override;
+
 private:
     // The navmesh this agent is on (non-owning pointer)
     NavMesh *navmesh;
@@ -90,16 +130,20 @@ private:
     // State machine controller for this agent
     StateMachineController stateMachineController;
 
-    // Background job state
-    std::atomic<bool> backgroundJobRunning;
-    std::atomic<bool> backgroundJobComplete;
+    // Last move vector produced by the background AI step (main thread only)
     v2 backgroundMoveVector;
 
     // Background AI calculation (runs in worker thread)
     void calculateMoveVector(float dt);
 
-    // On-screen visibility flag (updated by OnScreenChecks worker)
+    // On-screen visibility flag (updated by LevelV1::updateAgentVisibility)
     bool isOnScreen = true;
+
+    // Simulation LOD state
+    SimulationLOD simulationLOD = SimulationLOD::Full;
+
+    // Handle assigned by the level's AgentHandleTable
+    AgentHandle handle;
 };
 
 #endif // ANIMATED_DATA_CHARACTER_NAVMESH_AGENT_H
@@ -1,9 +1,193 @@
 #include "Coordinator.h"
 #include "AnimatedDataCharacterNavMeshAgent.h"
 #include "LevelV1.h"
+#include "JobSystem.h"
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
 #include <stdio.h>
 
+namespace
+{
+    // Read-only view of the near-player grid used while computing placements without the lock
+    struct PlacementSnapshot
+    {
+        int gridSize = 0;
+        int playerTileX = 0;
+        int playerTileY = 0;
+        float tileWidth = 1.0f;
+        float tileHeight = 1.0f;
+        std::vector<uint8_t> blockedTiles; // 1 if the tile is not available for planning
+    };
+
+    // Rotate hitbox tile coordinates based on direction (tiles are defined for facing RIGHT)
+    void rotateHitboxTile(const HitboxTile &tile, Direction direction, int &outX, int &outY)
+    {
+        switch (direction)
+        {
+        case Direction::RIGHT:
+            outX = tile.x;
+            outY = tile.y;
+            break;
+        case Direction::UP:
+            outX = -tile.y;
+            outY = tile.x;
+            break;
+        case Direction::LEFT:
+            outX = -tile.x;
+            outY = -tile.y;
+            break;
+        case Direction::DOWN:
+            outX = tile.y;
+            outY = -tile.x;
+            break;
+        }
+    }
+
+    // Flat index of a near-player tile, or -1 if outside the grid
+    int snapshotIndex(const PlacementSnapshot &snapshot, int nearX, int nearY)
+    {
+        int halfSize = snapshot.gridSize / 2;
+        int arrayX = nearX + halfSize;
+        int arrayY = nearY + halfSize;
+        if (arrayX < 0 || arrayX >= snapshot.gridSize || arrayY < 0 || arrayY >= snapshot.gridSize)
+        {
+            return -1;
+        }
+        return arrayY * snapshot.gridSize + arrayX;
+    }
+
+    // Find every placement where the agent's hitbox hits near the player on free tiles, ordered
+    // by target distance from the player and then by distance from the agent's current tile
+    // Only reads the snapshot and the shared tile span, so it can run on any worker
+    void computePlacementCandidates(AgentProcessData &data, const PlacementSnapshot &snapshot)
+    {
+        struct ScoredCandidate
+        {
+            int targetDistSq;
+            int agentDistSq;
+            int direction;
+            PlacementCandidate placement;
+        };
+
+        data.candidates.clear();
+        data.candidateCursor = 0;
+        data.placedCandidate = -1;
+
+        if (!data.hitboxTiles || data.hitboxTiles->empty() || snapshot.gridSize <= 0)
+        {
+            return;
+        }
+        const std::vector<HitboxTile> &hitboxTiles = *data.hitboxTiles;
+
+        // Calculate agent's current position in near-player coordinates
+        int agentCurrentNearX = static_cast<int>(std::round(data.position.x / snapshot.tileWidth)) - snapshot.playerTileX;
+        int agentCurrentNearY = static_cast<int>(std::round(data.position.y / snapshot.tileHeight)) - snapshot.playerTileY;
+
+        const Direction directions[] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+        int halfSize = snapshot.gridSize / 2;
+
+        // Walk target tiles closest to the player first, so the first target that reaches a
+        // placement is also its nearest one
+        std::vector<std::pair<int, std::pair<int, int>>> targetTilesByDist;
+        targetTilesByDist.reserve(static_cast<size_t>(snapshot.gridSize) * snapshot.gridSize);
+        for (int ny = -halfSize; ny <= halfSize; ++ny)
+        {
+            for (int nx = -halfSize; nx <= halfSize; ++nx)
+            {
+                targetTilesByDist.push_back({nx * nx + ny * ny, {nx, ny}});
+            }
+        }
+        std::stable_sort(targetTilesByDist.begin(), targetTilesByDist.end(),
+                         [](const auto &a, const auto &b)
+                         { return a.first < b.first; });
+
+        std::vector<ScoredCandidate> scored;
+        // Indexed by agentTile * 4 + direction: a placement only depends on those two, so each is
+        // checked once however many targets reach it
+        std::vector<uint8_t> seenPlacements(static_cast<size_t>(snapshot.gridSize) * snapshot.gridSize * 4, 0);
+
+        for (const auto &target : targetTilesByDist)
+        {
+            int targetDistSq = target.first;
+            int targetX = target.second.first;
+            int targetY = target.second.second;
+            for (int d = 0; d < 4; ++d)
+            {
+                for (const auto &hitboxTile : hitboxTiles)
+                {
+                    // Calculate where agent would need to be for this rotated hitbox tile to hit the target
+                    int rotatedX, rotatedY;
+                    rotateHitboxTile(hitboxTile, directions[d], rotatedX, rotatedY);
+                    int candidateAgentX = targetX - rotatedX;
+                    int candidateAgentY = targetY - rotatedY;
+
+                    int agentTile = snapshotIndex(snapshot, candidateAgentX, candidateAgentY);
+                    if (agentTile < 0 || snapshot.blockedTiles[agentTile])
+                    {
+                        continue; // Agent position is not available
+                    }
+
+                    int placementKey = agentTile * 4 + d;
+                    if (seenPlacements[placementKey])
+                    {
+                        continue; // Same placement already reached through another target
+                    }
+                    seenPlacements[placementKey] = 1;
+
+                    // Check if ALL tiles that this hitbox would occupy are available
+                    PlacementCandidate placement;
+                    placement.agentTile = agentTile;
+                    bool allTilesAvailable = true;
+                    for (const auto &checkTile : hitboxTiles)
+                    {
+                        int checkX, checkY;
+                        rotateHitboxTile(checkTile, directions[d], checkX, checkY);
+                        int index = snapshotIndex(snapshot, candidateAgentX + checkX, candidateAgentY + checkY);
+                        if (index < 0 || snapshot.blockedTiles[index])
+                        {
+                            allTilesAvailable = false;
+                            break;
+                        }
+                        if (index != agentTile &&
+                            std::find(placement.actionTiles.begin(), placement.actionTiles.end(), index) == placement.actionTiles.end())
+                        {
+                            placement.actionTiles.push_back(index);
+                        }
+                    }
+
+                    if (!allTilesAvailable)
+                    {
+                        continue; // Some tiles for this placement are not available
+                    }
+
+                    int dx = candidateAgentX - agentCurrentNearX;
+                    int dy = candidateAgentY - agentCurrentNearY;
+                    scored.push_back(ScoredCandidate{targetDistSq, dx * dx + dy * dy, d, std::move(placement)});
+                }
+            }
+        }
+
+        // Prioritize hitting tiles near the player, then the shortest move for the agent
+        std::stable_sort(scored.begin(), scored.end(),
+                         [](const ScoredCandidate &a, const ScoredCandidate &b)
+                         {
+                             if (a.targetDistSq != b.targetDistSq)
+                                 return a.targetDistSq < b.targetDistSq;
+                             return a.agentDistSq < b.agentDistSq;
+                         });
+
+        // Every candidate is kept: an agent whose best placements all go to closer agents still
+        // gets any free tile that remains, as in a serial greedy pass
+        data.candidates.reserve(scored.size());
+        for (ScoredCandidate &candidate : scored)
+        {
+            data.candidates.push_back(std::move(candidate.placement));
+        }
+    }
+}
+
 Coordinator::Coordinator()
     : m_nearPlayerTileGrid(7), m_player(nullptr), m_level(nullptr), m_lastPlayerTileX(INT_MIN), m_lastPlayerTileY(INT_MIN), m_agentListChanged(false), m_lastUpdateTimeMs(0.0) // Default to 7x7 grid
 {
@@ -32,64 +216,83 @@ void Coordinator::addAgent(AnimatedDataCharacterNavMeshAgent *agent)
     }
 
     std::lock_guard<std::mutex> lock(m_mutex);
+    addAgentLocked(agent, agent->getHandle());
+}
 
-    // Check if agent is already in the set (O(1) lookup)
-    if (m_agentSet.find(agent) != m_agentSet.end())
+void Coordinator::removeAgent(AgentHandle handle)
+{
+    if (handle.isNull())
     {
-        return; // Already coordinating this agent
+        return;
     }
 
-    // Add to both set and vector
-    m_agentSet.insert(agent);
-    m_agents.push_back(agent);
-    m_agentListChanged = true;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    removeAgentLocked(handle);
 }
 
-void Coordinator::removeAgent(AnimatedDataCharacterNavMeshAgent *agent)
+void Coordinator::applyVisibilityDeltas(const std::vector<VisibilityDelta> &deltas)
 {
-    if (!agent)
+    if (deltas.empty())
     {
         return;
     }
 
     std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &delta : deltas)
+    {
+        if (!delta.agent)
+        {
+            continue;
+        }
+
+        if (delta.visible)
+        {
+            addAgentLocked(delta.agent, delta.handle);
+        }
+        else
+        {
+            removeAgentLocked(delta.handle);
+        }
+    }
+}
 
-    // Check if agent is in the set
-    auto it = m_agentSet.find(agent);
-    if (it == m_agentSet.end())
+void Coordinator::addAgentLocked(AnimatedDataCharacterNavMeshAgent *agent, AgentHandle handle)
+{
+    // Check if agent is already coordinated (O(1) lookup)
+    if (m_agentIndices.find(handle.getKey()) != m_agentIndices.end())
     {
-        return; // Agent not being coordinated
+        return; // Already coordinating this agent
     }
 
-    // Clear any tiles in the near-player grid claimed by this agent
-    int halfSize = m_nearPlayerTileGrid.getGridSize() / 2;
-    for (int ny = -halfSize; ny <= halfSize; ++ny)
+    m_agentIndices[handle.getKey()] = m_agents.size();
+    m_agents.push_back(agent);
+    m_agentHandles.push_back(handle);
+    m_agentListChanged = true;
+}
+
+void Coordinator::removeAgentLocked(AgentHandle handle)
+{
+    auto it = m_agentIndices.find(handle.getKey());
+    if (it == m_agentIndices.end())
     {
-        for (int nx = -halfSize; nx <= halfSize; ++nx)
-        {
-            NearPlayerTile *tile = m_nearPlayerTileGrid.getTileMutable(nx, ny);
-            if (tile && tile->agent == agent)
-            {
-                tile->status = TileStatus::Empty;
-                tile->agent = nullptr;
-            }
-        }
+        return; // Agent not being coordinated
     }
+    size_t index = it->second;
+    m_agentIndices.erase(it);
 
-    // Remove from set
-    m_agentSet.erase(it);
+    // Clear any tiles in the near-player grid claimed by this agent (compares pointers only)
+    m_nearPlayerTileGrid.clearAgent(m_agents[index]);
 
-    // Remove from vector (preserve order not critical, so swap-and-pop for efficiency)
-    auto vecIt = std::find(m_agents.begin(), m_agents.end(), agent);
-    if (vecIt != m_agents.end())
+    // Order is not critical, swap-and-pop
+    size_t last = m_agents.size() - 1;
+    if (index != last)
     {
-        // Swap with last element and pop
-        if (vecIt != m_agents.end() - 1)
-        {
-            std::swap(*vecIt, m_agents.back());
-        }
-        m_agents.pop_back();
+        m_agents[index] = m_agents[last];
+        m_agentHandles[index] = m_agentHandles[last];
+        m_agentIndices[m_agentHandles[index].getKey()] = index;
     }
+    m_agents.pop_back();
+    m_agentHandles.pop_back();
     m_agentListChanged = true;
 }
 
@@ -109,7 +312,8 @@ void Coordinator::clear()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_agents.clear();
-    m_agentSet.clear();
+    m_agentHandles.clear();
+    m_agentIndices.clear();
 }
 
 void Coordinator::cullDyingAgents()
@@ -117,47 +321,20 @@ void Coordinator::cullDyingAgents()
     std::lock_guard<std::mutex> lock(m_mutex);
 
     // Collect agents to remove
-    std::vector<AnimatedDataCharacterNavMeshAgent *> agentsToRemove;
-    for (auto *agent : m_agents)
+    std::vector<AgentHandle> agentsToRemove;
+    for (size_t i = 0; i < m_agents.size(); ++i)
     {
+        AnimatedDataCharacterNavMeshAgent *agent = m_agents[i];
         if (agent && (agent->getStageOfLife() == StageOfLife::Dying || agent->getStageOfLife() == StageOfLife::Dead))
         {
-            agentsToRemove.push_back(agent);
+            agentsToRemove.push_back(m_agentHandles[i]);
         }
     }
 
     // Remove each dying/dead agent
-    for (auto *agent : agentsToRemove)
+    for (AgentHandle handle : agentsToRemove)
     {
-        // Clear any tiles in the near-player grid claimed by this agent
-        int halfSize = m_nearPlayerTileGrid.getGridSize() / 2;
-        for (int ny = -halfSize; ny <= halfSize; ++ny)
-        {
-            for (int nx = -halfSize; nx <= halfSize; ++nx)
-            {
-                NearPlayerTile *tile = m_nearPlayerTileGrid.getTileMutable(nx, ny);
-                if (tile && tile->agent == agent)
-                {
-                    tile->status = TileStatus::Empty;
-                    tile->agent = nullptr;
-                }
-            }
-        }
-
-        // Remove from set
-        m_agentSet.erase(agent);
-
-        // Remove from vector
-        auto vecIt = std::find(m_agents.begin(), m_agents.end(), agent);
-        if (vecIt != m_agents.end())
-        {
-            // Swap with last element and pop
-            if (vecIt != m_agents.end() - 1)
-            {
-                std::swap(*vecIt, m_agents.back());
-            }
-            m_agents.pop_back();
-        }
+        removeAgentLocked(handle);
     }
 
     if (!agentsToRemove.empty())
@@ -174,98 +351,171 @@ void Coordinator::update()
     // Remove any dying or dead agents first (acquires its own lock)
     cullDyingAgents();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<AgentProcessData> agentDataList;
+    std::unordered_set<AnimatedDataCharacterNavMeshAgent *> batchAgents;
+    PlacementSnapshot snapshot;
 
-    if (!m_player || !m_level)
+    // STEP 1: Gather agent data and a snapshot of the grid while holding the lock
+    // Hitbox tiles are shared immutable spans, so nothing is deep-copied here
     {
-        return;
-    }
-
-    // Check if player has moved to a different tile
-    v2 playerPosition = m_player->getPosition();
-    float tileWidth = static_cast<float>(m_level->getTileWidth());
-    float tileHeight = static_cast<float>(m_level->getTileHeight());
-    int currentPlayerTileX = static_cast<int>(std::round(playerPosition.x / tileWidth));
-    int currentPlayerTileY = static_cast<int>(std::round(playerPosition.y / tileHeight));
+        std::lock_guard<std::mutex> lock(m_mutex);
 
-    // Always update the near-player grid to keep it centered on the player
-    m_nearPlayerTileGrid.updatePlayerPosition(playerPosition.x, playerPosition.y, currentPlayerTileX, currentPlayerTileY);
-
-    // Early exit if player hasn't moved to a different tile AND agent list hasn't changed
-    if (currentPlayerTileX == m_lastPlayerTileX && currentPlayerTileY == m_lastPlayerTileY && !m_agentListChanged)
-    {
-        return;
-    }
+        if (!m_player || !m_level)
+        {
+            return;
+        }
 
-    // Update last player tile position
-    m_lastPlayerTileX = currentPlayerTileX;
-    m_lastPlayerTileY = currentPlayerTileY;
-    m_agentListChanged = false; // Reset the flag
+        // Check if player has moved to a different tile
+        v2 playerPosition = m_player->getPosition();
+        float tileWidth = static_cast<float>(m_level->getTileWidth());
+        float tileHeight = static_cast<float>(m_level->getTileHeight());
+        int currentPlayerTileX = static_cast<int>(std::round(playerPosition.x / tileWidth));
+        int currentPlayerTileY = static_cast<int>(std::round(playerPosition.y / tileHeight));
 
-    // STEP 1: Copy all agent data we need while holding the lock
-    // This prevents race conditions with main thread deleting/modifying agents
-    std::vector<AgentProcessData> agentDataList;
-    agentDataList.reserve(m_agents.size());
+        // Always update the near-player grid to keep it centered on the player
+        m_nearPlayerTileGrid.updatePlayerTile(currentPlayerTileX, currentPlayerTileY);
 
-    for (auto *agent : m_agents)
-    {
-        if (!agent)
+        // Early exit if player hasn't moved to a different tile AND agent list hasn't changed
+        if (currentPlayerTileX == m_lastPlayerTileX && currentPlayerTileY == m_lastPlayerTileY && !m_agentListChanged)
         {
-            continue;
+            return;
         }
-        // skip dying agents
-        if (agent->getStageOfLife() == StageOfLife::Dying || agent->getStageOfLife() == StageOfLife::Dead)
+
+        // Update last player tile position
+        m_lastPlayerTileX = currentPlayerTileX;
+        m_lastPlayerTileY = currentPlayerTileY;
+        m_agentListChanged = false; // Reset the flag
+
+        agentDataList.reserve(m_agents.size());
+        for (size_t i = 0; i < m_agents.size(); ++i)
         {
-            continue;
-        }
+            AnimatedDataCharacterNavMeshAgent *agent = m_agents[i];
+            if (!agent)
+            {
+                continue;
+            }
+            // skip dying agents
+            if (agent->getStageOfLife() == StageOfLife::Dying || agent->getStageOfLife() == StageOfLife::Dead)
+            {
+                continue;
+            }
 
-        AgentProcessData data;
-        data.agent = agent;
-        data.position = agent->getPosition();
-        data.hasValidAction = false;
+            AgentProcessData data;
+            data.agent = agent;
+            data.handle = m_agentHandles[i];
+            data.position = agent->getPosition();
+            data.hasValidAction = false;
 
-        // Calculate distance to player
-        float dx = data.position.x - playerPosition.x;
-        float dy = data.position.y - playerPosition.y;
-        data.distSq = dx * dx + dy * dy;
+            // Calculate distance to player
+            float dx = data.position.x - playerPosition.x;
+            float dy = data.position.y - playerPosition.y;
+            data.distSq = dx * dx + dy * dy;
 
-        // Try to copy hitbox tiles if action exists
-        Action *actionA = agent->getActionPointerA();
-        if (actionA)
-        {
-            HitBox *hitbox = actionA->getHitBox();
-            if (hitbox)
+            // Take a reference on the hitbox tiles if action exists
+            Action *actionA = agent->getActionPointerA();
+            if (actionA)
             {
-                // Make a deep copy of the tiles vector
-                const auto &tiles = hitbox->getTiles();
-                if (!tiles.empty())
+                HitBox *hitbox = actionA->getHitBox();
+                if (hitbox)
                 {
-                    data.hitboxTiles = tiles; // Vector copy
-                    data.hasValidAction = true;
-                    // printf("Agent %p: Copied %zu hitbox tiles (dist: %.2f)\n",
-                    //        (void *)agent, data.hitboxTiles.size(), std::sqrt(data.distSq));
+                    data.hitboxTiles = hitbox->getSharedTiles();
+                    data.hasValidAction = data.hitboxTiles && !data.hitboxTiles->empty();
                 }
             }
+
+            if (data.hasValidAction)
+            {
+                batchAgents.insert(agent);
+                agentDataList.push_back(std::move(data));
+            }
         }
 
-        agentDataList.push_back(data);
+        // Snapshot which tiles are taken; claims held by agents being re-planned are released
+        snapshot.gridSize = m_nearPlayerTileGrid.getGridSize();
+        snapshot.playerTileX = currentPlayerTileX;
+        snapshot.playerTileY = currentPlayerTileY;
+        snapshot.tileWidth = tileWidth;
+        snapshot.tileHeight = tileHeight;
+
+        int tileCount = m_nearPlayerTileGrid.getTileCount();
+        snapshot.blockedTiles.assign(tileCount, 0);
+        for (int i = 0; i < tileCount; ++i)
+        {
+            AnimatedDataCharacterNavMeshAgent *owner = m_nearPlayerTileGrid.getAgentAtIndex(i);
+            bool claimedByBatch = owner && batchAgents.count(owner) > 0;
+            if (m_nearPlayerTileGrid.getStatusAtIndex(i) != TileStatus::Empty && !claimedByBatch)
+            {
+                snapshot.blockedTiles[i] = 1;
+            }
+        }
     }
 
-    // STEP 2: Sort by distance (closest first)
+    // STEP 2: Sort by distance (closest first) - this order is the placement priority
+    // Ties are broken by position so the result does not depend on m_agents order
     std::sort(agentDataList.begin(), agentDataList.end(),
               [](const AgentProcessData &a, const AgentProcessData &b)
-              { return a.distSq < b.distSq; });
-
-    // STEP 3: Process using copied data (no agent pointer dereferencing)
-    for (const auto &data : agentDataList)
+              {
+                  if (a.distSq != b.distSq)
+                      return a.distSq < b.distSq;
+                  if (a.position.x != b.position.x)
+                      return a.position.x < b.position.x;
+                  return a.position.y < b.position.y;
+              });
+
+    // STEP 3: Compute candidate placements for every agent in parallel (read-only snapshot)
+    JobSystem::parallelFor(agentDataList.size(), 4, [&agentDataList, &snapshot](size_t begin, size_t end)
+                           {
+                               for (size_t i = begin; i < end; ++i)
+                               {
+                                   computePlacementCandidates(agentDataList[i], snapshot);
+                               } }, "Coordinator Candidates");
+
+    // STEP 4: Resolve conflicts through the tile reservation table
+    resolvePlacements(agentDataList, snapshot.blockedTiles);
+
+    // STEP 5: Apply the winning placements while holding the lock
     {
-        if (!data.hasValidAction || data.hitboxTiles.empty())
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // The grid was resized or re-centered meanwhile - the indices no longer line up, plan again
+        if (m_nearPlayerTileGrid.getGridSize() != snapshot.gridSize ||
+            m_nearPlayerTileGrid.getPlayerTileX() != snapshot.playerTileX ||
+            m_nearPlayerTileGrid.getPlayerTileY() != snapshot.playerTileY)
         {
-            continue;
+            m_agentListChanged = true;
+            return;
         }
 
-        // Process with copied tile data - no accessing agent internals
-        tryPlaceHitboxOnGrid(data.hitboxTiles, data.position, data.agent);
+        // Release previous claims of the re-planned agents
+        int tileCount = m_nearPlayerTileGrid.getTileCount();
+        for (int i = 0; i < tileCount; ++i)
+        {
+            AnimatedDataCharacterNavMeshAgent *owner = m_nearPlayerTileGrid.getAgentAtIndex(i);
+            if (owner && batchAgents.count(owner) > 0)
+            {
+                m_nearPlayerTileGrid.setTileAtIndex(i, TileStatus::Empty, nullptr);
+            }
+        }
+
+        for (const auto &data : agentDataList)
+        {
+            // Skip agents removed from coordination while we were planning
+            if (data.placedCandidate < 0 || m_agentIndices.find(data.handle.getKey()) == m_agentIndices.end())
+            {
+                continue;
+            }
+
+            const PlacementCandidate &placement = data.candidates[data.placedCandidate];
+
+            // Mark ALL hitbox tiles as PlannedAction
+            for (int index : placement.actionTiles)
+            {
+                m_nearPlayerTileGrid.setTileAtIndex(index, TileStatus::PlannedAction, data.agent);
+            }
+
+            // Mark the agent's required tile as PlannedOccupiedByAgent
+            m_nearPlayerTileGrid.setTileAtIndex(placement.agentTile, TileStatus::PlannedOccupiedByAgent, data.agent);
+        }
     }
 
     // get shapes that can be made from actions
@@ -290,6 +540,7 @@ void Coordinator::setNearPlayerTileGridSize(int gridSize)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_nearPlayerTileGrid.initialize(gridSize);
+    m_agentListChanged = true; // Re-plan every agent on the new grid
 }
 
 const AnimatedDataCharacter *Coordinator::getPlayer() const
@@ -316,14 +567,8 @@ void Coordinator::updateNearPlayerGrid(int playerTileX, int playerTileY)
         return;
     }
 
-    // Calculate world position from tile position
-    float tileWidth = static_cast<float>(m_level->getTileWidth());
-    float tileHeight = static_cast<float>(m_level->getTileHeight());
-    float playerWorldX = playerTileX * tileWidth;
-    float playerWorldY = playerTileY * tileHeight;
-
     // Update the grid
-    m_nearPlayerTileGrid.updatePlayerPosition(playerWorldX, playerWorldY, playerTileX, playerTileY);
+    m_nearPlayerTileGrid.updatePlayerTile(playerTileX, playerTileY);
 }
 
 void Coordinator::render() const
@@ -337,269 +582,114 @@ void Coordinator::render() const
     m_nearPlayerTileGrid.render(*m_level);
 }
 
-bool Coordinator::tryPlaceHitboxOnGrid(const std::vector<HitboxTile> &hitboxTiles, v2 agentPosition, AnimatedDataCharacterNavMeshAgent *agent)
+void Coordinator::resolvePlacements(std::vector<AgentProcessData> &agentDataList, std::vector<uint8_t> &blockedTiles)
 {
-    // NOTE: This method must be called with m_mutex held (called from update())
-    // Uses copied tile data to avoid accessing potentially deleted agent/action/hitbox objects
-    if (!m_level || !agent || hitboxTiles.empty())
-    {
-        return false;
-    }
+    const uint32_t freeTile = UINT32_MAX;
 
-    // printf("tryPlaceHitboxOnGrid: Processing %zu tiles for agent %p\n", hitboxTiles.size(), (void *)agent);
+    // Tile reservation table - each entry holds the best (lowest) priority that wants the tile
+    std::vector<std::atomic<uint32_t>> reservations(blockedTiles.size());
 
-    // Get access to the grid
-    NearPlayerTileGrid &grid = getNearPlayerTileGridMutable();
-
-    // First, clear any existing tiles claimed by this agent
-    int halfSize = grid.getGridSize() / 2;
-    for (int ny = -halfSize; ny <= halfSize; ++ny)
+    std::vector<uint32_t> pending;
+    pending.reserve(agentDataList.size());
+    for (size_t i = 0; i < agentDataList.size(); ++i)
     {
-        for (int nx = -halfSize; nx <= halfSize; ++nx)
+        if (!agentDataList[i].candidates.empty())
         {
-            NearPlayerTile *tile = grid.getTileMutable(nx, ny);
-            if (tile && tile->status != TileStatus::Empty && tile->agent == agent)
-            {
-                tile->status = TileStatus::Empty;
-                tile->agent = nullptr;
-                // printf("  Cleared previous claim by agent at tile (%d, %d)\n", nx, ny);
-            }
+            pending.push_back(static_cast<uint32_t>(i));
         }
     }
 
-    // Check if there are ANY empty tiles in the grid
-    bool hasEmptyTile = false;
-    for (int ny = -halfSize; ny <= halfSize && !hasEmptyTile; ++ny)
+    auto conflictsWithBlocked = [&blockedTiles](const PlacementCandidate &candidate)
     {
-        for (int nx = -halfSize; nx <= halfSize; ++nx)
+        if (blockedTiles[candidate.agentTile])
+            return true;
+        for (int index : candidate.actionTiles)
         {
-            const NearPlayerTile *tile = grid.getTile(nx, ny);
-            if (tile && tile->status == TileStatus::Empty)
-            {
-                hasEmptyTile = true;
-                break;
-            }
+            if (blockedTiles[index])
+                return true;
         }
-    }
-
-    if (!hasEmptyTile)
-    {
-        // printf("tryPlaceHitboxOnGrid: No empty tiles in grid\n");
-        return false;
-    }
-
-    if (hitboxTiles.empty())
-    {
         return false;
-    }
+    };
 
-    // Build list of target tiles sorted by distance from player (0,0)
-    // We want to prioritize hitting tiles near the player
-    std::vector<std::pair<int, std::pair<int, int>>> targetTilesByDist;
-    for (int ny = -halfSize; ny <= halfSize; ++ny)
+    auto reserve = [&reservations](int index, uint32_t priority)
     {
-        for (int nx = -halfSize; nx <= halfSize; ++nx)
+        uint32_t current = reservations[index].load(std::memory_order_relaxed);
+        while (priority < current &&
+               !reservations[index].compare_exchange_weak(current, priority, std::memory_order_relaxed))
         {
-            int distSq = nx * nx + ny * ny;
-            targetTilesByDist.push_back({distSq, {nx, ny}});
         }
-    }
+    };
 
-    // Sort by distance (closest to player first)
-    std::sort(targetTilesByDist.begin(), targetTilesByDist.end(),
-              [](const auto &a, const auto &b)
-              { return a.first < b.first; });
-
-    // Calculate agent's current tile position
-    float tileWidth = static_cast<float>(m_level->getTileWidth());
-    float tileHeight = static_cast<float>(m_level->getTileHeight());
-    int agentCurrentTileX = static_cast<int>(std::round(agentPosition.x / tileWidth));
-    int agentCurrentTileY = static_cast<int>(std::round(agentPosition.y / tileHeight));
-
-    // Get player tile position to convert to near-player coordinates
-    const NearPlayerTile *playerTile = grid.getTile(0, 0);
-    if (!playerTile)
-    {
-        return false;
-    }
-    int playerTileX = playerTile->tileX;
-    int playerTileY = playerTile->tileY;
-
-    // Convert agent's current position to near-player coordinates
-    int agentCurrentNearX = agentCurrentTileX - playerTileX;
-    int agentCurrentNearY = agentCurrentTileY - playerTileY;
-
-    // Find which hitbox tile, target tile, agent position, and facing direction would hit near the player
-    // while being closest to agent's current position
-    // Try all target tiles (sorted by distance to player) and all 4 directions
-    int bestAgentX = 0;
-    int bestAgentY = 0;
-    int bestTargetX = 0;
-    int bestTargetY = 0;
-    float bestAgentDistSq = -1.0f;
-    const HitboxTile *bestHitboxTile = nullptr;
-    Direction bestDirection = Direction::RIGHT;
-
-    // Try each target tile starting from closest to player
-    for (const auto &[targetDistSq, targetCoords] : targetTilesByDist)
+    while (!pending.empty())
     {
-        int targetX = targetCoords.first;
-        int targetY = targetCoords.second;
+        for (auto &reservation : reservations)
+        {
+            reservation.store(freeTile, std::memory_order_relaxed);
+        }
 
-        for (Direction direction : {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT})
+        // Propose: skip candidates that hit already claimed tiles, then reserve the tiles of every
+        // candidate the agent could still move on to, not only the current one. A closer agent
+        // that loses this round may take any of them later, as it would in a serial pass.
+        JobSystem::parallelFor(pending.size(), 8, [&](size_t begin, size_t end)
+                               {
+                                   for (size_t k = begin; k < end; ++k)
+                                   {
+                                       uint32_t priority = pending[k];
+                                       AgentProcessData &data = agentDataList[priority];
+                                       while (data.candidateCursor < data.candidates.size() &&
+                                              conflictsWithBlocked(data.candidates[data.candidateCursor]))
+                                       {
+                                           data.candidateCursor++;
+                                       }
+
+                                       for (size_t c = data.candidateCursor; c < data.candidates.size(); ++c)
+                                       {
+                                           const PlacementCandidate &candidate = data.candidates[c];
+                                           if (c != data.candidateCursor && conflictsWithBlocked(candidate))
+                                           {
+                                               continue;
+                                           }
+                                           reserve(candidate.agentTile, priority);
+                                           for (int index : candidate.actionTiles)
+                                           {
+                                               reserve(index, priority);
+                                           }
+                                       }
+                                   } }, "Coordinator Reserve");
+
+        // Commit: an agent wins if it holds every tile of its current candidate, so no closer
+        // pending agent can still claim one of them
+        // Winners never share tiles, so claiming them in order is deterministic
+        size_t remaining = 0;
+        for (uint32_t priority : pending)
         {
-            for (const auto &hitboxTile : hitboxTiles)
+            AgentProcessData &data = agentDataList[priority];
+            if (data.candidateCursor >= data.candidates.size())
             {
-                // Rotate the hitbox tile coordinates based on direction (tiles are defined for facing RIGHT)
-                v2 rotated;
-                switch (direction)
-                {
-                case Direction::RIGHT:
-                    rotated = cf_v2((float)hitboxTile.x, (float)hitboxTile.y);
-                    break;
-                case Direction::UP:
-                    rotated = cf_v2((float)-hitboxTile.y, (float)hitboxTile.x);
-                    break;
-                case Direction::LEFT:
-                    rotated = cf_v2((float)-hitboxTile.x, (float)-hitboxTile.y);
-                    break;
-                case Direction::DOWN:
-                    rotated = cf_v2((float)hitboxTile.y, (float)-hitboxTile.x);
-                    break;
-                }
-
-                // Calculate where agent would need to be for this rotated hitbox tile to hit the target
-                int candidateAgentX = targetX - (int)rotated.x;
-                int candidateAgentY = targetY - (int)rotated.y;
-
-                // Check if ALL tiles that this hitbox would occupy are available
-                bool allTilesAvailable = true;
-                for (const auto &checkTile : hitboxTiles)
-                {
-                    // Rotate this tile too
-                    v2 checkRotated;
-                    switch (direction)
-                    {
-                    case Direction::RIGHT:
-                        checkRotated = cf_v2((float)checkTile.x, (float)checkTile.y);
-                        break;
-                    case Direction::UP:
-                        checkRotated = cf_v2((float)-checkTile.y, (float)checkTile.x);
-                        break;
-                    case Direction::LEFT:
-                        checkRotated = cf_v2((float)-checkTile.x, (float)-checkTile.y);
-                        break;
-                    case Direction::DOWN:
-                        checkRotated = cf_v2((float)checkTile.y, (float)-checkTile.x);
-                        break;
-                    }
-
-                    int checkX = candidateAgentX + (int)checkRotated.x;
-                    int checkY = candidateAgentY + (int)checkRotated.y;
-
-                    const NearPlayerTile *tile = grid.getTile(checkX, checkY);
-                    if (!tile || tile->status != TileStatus::Empty)
-                    {
-                        allTilesAvailable = false;
-                        break;
-                    }
-                }
-
-                if (!allTilesAvailable)
-                {
-                    continue; // Some tiles for this placement are not available
-                }
-
-                // Also check if agent position is available
-                const NearPlayerTile *agentPosTile = grid.getTile(candidateAgentX, candidateAgentY);
-                if (!agentPosTile || agentPosTile->status != TileStatus::Empty)
-                {
-                    continue; // Agent position is not available
-                }
+                continue; // Nothing left to try
+            }
 
-                // Calculate distance from agent's current position
-                int dx = candidateAgentX - agentCurrentNearX;
-                int dy = candidateAgentY - agentCurrentNearY;
-                float distSq = static_cast<float>(dx * dx + dy * dy);
+            const PlacementCandidate &candidate = data.candidates[data.candidateCursor];
+            bool won = reservations[candidate.agentTile].load(std::memory_order_relaxed) == priority;
+            for (size_t t = 0; won && t < candidate.actionTiles.size(); ++t)
+            {
+                won = reservations[candidate.actionTiles[t]].load(std::memory_order_relaxed) == priority;
+            }
 
-                if (bestHitboxTile == nullptr || distSq < bestAgentDistSq)
+            if (won)
+            {
+                data.placedCandidate = static_cast<int>(data.candidateCursor);
+                blockedTiles[candidate.agentTile] = 1;
+                for (int index : candidate.actionTiles)
                 {
-                    bestAgentX = candidateAgentX;
-                    bestAgentY = candidateAgentY;
-                    bestTargetX = targetX;
-                    bestTargetY = targetY;
-                    bestAgentDistSq = distSq;
-                    bestHitboxTile = &hitboxTile;
-                    bestDirection = direction;
+                    blockedTiles[index] = 1;
                 }
             }
+            else
+            {
+                pending[remaining++] = priority; // A closer agent may still take a tile, try again next round
+            }
         }
-
-        // If we found a valid placement, stop searching (we prioritize hitting closer to player)
-        if (bestHitboxTile != nullptr)
-        {
-            break;
-        }
-    }
-
-    if (!bestHitboxTile)
-    {
-        // printf("tryPlaceHitboxOnGrid: No valid agent position found to hit player\n");
-        return false;
-    }
-
-    // printf("  Best hitbox tile relative position: (%d, %d)\n", bestHitboxTile->x, bestHitboxTile->y);
-    // printf("  Best direction: %d (0=Up, 1=Down, 2=Left, 3=Right)\n", (int)bestDirection);
-    // printf("  Best target tile: (%d, %d), distance from player: %.2f\n", bestTargetX, bestTargetY, std::sqrt((float)(bestTargetX * bestTargetX + bestTargetY * bestTargetY)));
-    // printf("  Agent current position: (%d, %d), best position: (%d, %d), distance: %.2f\n",
-    //        agentCurrentNearX, agentCurrentNearY, bestAgentX, bestAgentY, std::sqrt(bestAgentDistSq));
-
-    // Mark ALL hitbox tiles as PlannedAction (rotated for the best direction)
-    for (const auto &hitboxTile : hitboxTiles)
-    {
-        // Rotate the hitbox tile coordinates based on bestDirection
-        v2 rotated;
-        switch (bestDirection)
-        {
-        case Direction::RIGHT:
-            rotated = cf_v2((float)hitboxTile.x, (float)hitboxTile.y);
-            break;
-        case Direction::UP:
-            rotated = cf_v2((float)-hitboxTile.y, (float)hitboxTile.x);
-            break;
-        case Direction::LEFT:
-            rotated = cf_v2((float)-hitboxTile.x, (float)-hitboxTile.y);
-            break;
-        case Direction::DOWN:
-            rotated = cf_v2((float)hitboxTile.y, (float)-hitboxTile.x);
-            break;
-        }
-
-        // Calculate the actual tile position in near-player grid
-        int actionTileX = bestAgentX + (int)rotated.x;
-        int actionTileY = bestAgentY + (int)rotated.y;
-
-        NearPlayerTile *actionTile = grid.getTileMutable(actionTileX, actionTileY);
-        if (actionTile)
-        {
-            actionTile->status = TileStatus::PlannedAction;
-            actionTile->agent = agent;
-            // printf("  Marked tile (%d, %d) as PlannedAction for agent %p\n", actionTileX, actionTileY, (void *)agent);
-        }
+        pending.resize(remaining);
     }
-
-    int agentX = bestAgentX;
-    int agentY = bestAgentY;
-    // printf("  Agent should be at (%d, %d) to perform action\n", agentX, agentY);
-
-    // Mark the agent's required tile as PlannedOccupiedByAgent
-    NearPlayerTile *agentTile = grid.getTileMutable(agentX, agentY);
-    if (agentTile)
-    {
-        agentTile->status = TileStatus::PlannedOccupiedByAgent;
-        agentTile->agent = agent;
-        // printf("  Marked tile (%d, %d) as PlannedOccupiedByAgent for agent %p\n", agentX, agentY, (void *)agent);
-    }
-
-    return true;
 }
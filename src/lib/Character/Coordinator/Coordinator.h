@@ -3,10 +3,14 @@
 #include <vector>
 #include <mutex>
 #include <unordered_set>
+#include <unordered_map>
 #include <chrono>
+#include <memory>
+#include <cstdint>
 #include <cute.h>
 #include "NearPlayerTileGrid.h"
 #include "HitBox.h" // For HitboxTile
+#include "AgentHandle.h"
 
 using namespace Cute;
 
@@ -17,14 +21,35 @@ class LevelV1;
 class HitBox;
 class Action;
 
+// A possible hitbox placement for one agent, as flat near-player grid indices
+struct PlacementCandidate
+{
+    int agentTile;                // Tile the agent would stand on
+    std::vector<int> actionTiles; // Tiles the rotated hitbox would cover
+};
+
 // Structure to hold safe copies of agent data for processing
 struct AgentProcessData
 {
     AnimatedDataCharacterNavMeshAgent *agent; // Pointer for identification only
+    AgentHandle handle;                       // Checked against m_agentIndices before applying results
     v2 position;
-    std::vector<HitboxTile> hitboxTiles; // Copied tiles data
+    std::shared_ptr<const std::vector<HitboxTile>> hitboxTiles; // Shared immutable tiles (outlives the hitbox)
     bool hasValidAction;
     float distSq;
+
+    // Filled in by the parallel candidate phase, best candidate first
+    std::vector<PlacementCandidate> candidates;
+    size_t candidateCursor = 0; // Next candidate to propose
+    int placedCandidate = -1;   // Index of the candidate that won its tiles, -1 if none
+};
+
+// A single on-screen change produced by the visibility pass
+struct VisibilityDelta
+{
+    AnimatedDataCharacterNavMeshAgent *agent;
+    AgentHandle handle; // Identifies the agent; a pooled agent object gets a new handle per spawn
+    bool visible;       // true = entered the screen, false = left the screen (or is dying or despawned)
 };
 
 // Coordinator class manages on-screen agents that need coordination
@@ -42,9 +67,13 @@ public:
     // Thread-safe
     void addAgent(AnimatedDataCharacterNavMeshAgent *agent);
 
-    // Remove an agent from coordination
+    // Remove an agent from coordination (the agent object may already be gone)
+    // Thread-safe
+    void removeAgent(AgentHandle handle);
+
+    // Apply a batch of visibility changes under a single lock
     // Thread-safe
-    void removeAgent(AnimatedDataCharacterNavMeshAgent *agent);
+    void applyVisibilityDeltas(const std::vector<VisibilityDelta> &deltas);
 
     // Get all agents currently being coordinated
     // Returns a copy for thread safety
@@ -61,8 +90,8 @@ public:
     void cullDyingAgents();
 
     // Update all coordinated agents
-    // Thread-safe - acquires mutex and holds it during entire update
-    // Note: Agents should not be deleted by other threads during update
+    // Thread-safe - the mutex is only held while gathering agent data and applying results;
+    // candidate placements are computed in parallel and resolved through a tile reservation table
     void update();
 
     // Get the near-player tile grid
@@ -91,12 +120,21 @@ public:
     void render() const;
 
 private:
-    // Try to place hitbox tiles on the grid using copied data
-    // Returns true if placement was successful
-    bool tryPlaceHitboxOnGrid(const std::vector<HitboxTile> &hitboxTiles, v2 agentPosition, AnimatedDataCharacterNavMeshAgent *agent);
+    // Add/remove without locking (caller must hold m_mutex)
+    void addAgentLocked(AnimatedDataCharacterNavMeshAgent *agent, AgentHandle handle);
+    void removeAgentLocked(AgentHandle handle);
+
+    // Resolve conflicting candidates in rounds: every pending agent reserves the tiles of all of
+    // its remaining candidates with an atomic min on its priority (index in distSq order), and an
+    // agent whose current candidate holds all of its tiles wins. No closer agent can still end up
+    // on those tiles, so the result matches a serial greedy pass in priority order. The closest
+    // pending agent always wins, so this terminates.
+    // blockedTiles is updated with the tiles claimed by winners.
+    static void resolvePlacements(std::vector<AgentProcessData> &agentDataList, std::vector<uint8_t> &blockedTiles);
 
     std::vector<AnimatedDataCharacterNavMeshAgent *> m_agents;
-    std::unordered_set<AnimatedDataCharacterNavMeshAgent *> m_agentSet; // For O(1) lookup
+    std::vector<AgentHandle> m_agentHandles;                            // Parallel to m_agents
+    std::unordered_map<uint64_t, size_t> m_agentIndices;                // Handle key -> index in m_agents
     NearPlayerTileGrid m_nearPlayerTileGrid;                            // Grid of tiles around the player
     const AnimatedDataCharacter *m_player;                              // Non-owning pointer to the player
     LevelV1 *m_level;                                                   // Non-owning pointer to the level
@@ -104,5 +142,5 @@ private:
     int m_lastPlayerTileY;                                              // Last known player tile Y position
     bool m_agentListChanged;                                            // Flag to track if agents were added/removed
     double m_lastUpdateTimeMs;                                          // Last update execution time in milliseconds
-    mutable std::mutex m_mutex;                                         // Protects m_agents and m_agentSet
+    mutable std::mutex m_mutex;                                         // Protects m_agents, m_agentHandles and m_agentIndices
 };
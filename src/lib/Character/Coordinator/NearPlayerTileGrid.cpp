@@ -2,12 +2,13 @@
 #include "LevelV1.h"
 #include "HighlightTile.h"
 #include <stdio.h>
+#include <cstdlib>
 #include <cute.h>
 
 using namespace Cute;
 
 NearPlayerTileGrid::NearPlayerTileGrid(int gridSize)
-    : m_gridSize(0)
+    : m_gridSize(0), m_halfSize(0), m_originX(0), m_originY(0), m_playerTileX(0), m_playerTileY(0), m_hasPlayerTile(false)
 {
     initialize(gridSize);
 }
@@ -24,16 +25,26 @@ void NearPlayerTileGrid::initialize(int gridSize)
         gridSize = 7;
     }
 
-    m_gridSize = gridSize;
-    m_tiles.clear();
-    m_tiles.resize(gridSize * gridSize);
-
-    // Initialize all tiles to default values
-    for (int i = 0; i < gridSize * gridSize; ++i)
+    // The player sits on the center tile, so the grid needs an odd size
+    if (gridSize % 2 == 0)
     {
-        m_tiles[i] = NearPlayerTile{0.0f, 0.0f, 0, 0, 0, 0, TileStatus::Empty, nullptr};
+        printf("NearPlayerTileGrid: Grid size %d is even, using %d\n", gridSize, gridSize + 1);
+        gridSize += 1;
     }
 
+    m_gridSize = gridSize;
+    m_halfSize = gridSize / 2;
+    m_originX = 0;
+    m_originY = 0;
+
+    // Initialize all tiles to empty
+    m_status.assign(gridSize * gridSize, static_cast<uint8_t>(TileStatus::Empty));
+    m_agentSlots.assign(gridSize * gridSize, -1);
+    m_slotAgents.clear();
+    m_slotRefCounts.clear();
+    m_freeSlots.clear();
+    m_agentToSlot.clear();
+
     printf("NearPlayerTileGrid: Initialized with size %dx%d (%d tiles)\n",
            gridSize, gridSize, gridSize * gridSize);
 }
@@ -43,110 +54,270 @@ int NearPlayerTileGrid::getGridSize() const
     return m_gridSize;
 }
 
-const NearPlayerTile *NearPlayerTileGrid::getTile(int nearPlayerX, int nearPlayerY) const
+int NearPlayerTileGrid::getTileCount() const
+{
+    return m_gridSize * m_gridSize;
+}
+
+int NearPlayerTileGrid::getPlayerTileX() const
+{
+    return m_playerTileX;
+}
+
+int NearPlayerTileGrid::getPlayerTileY() const
+{
+    return m_playerTileY;
+}
+
+int NearPlayerTileGrid::getIndex(int nearPlayerX, int nearPlayerY) const
 {
-    int index = getIndex(nearPlayerX, nearPlayerY);
-    if (index < 0 || index >= static_cast<int>(m_tiles.size()))
+    // Convert from centered coordinates (-halfSize to +halfSize) to array indices (0 to gridSize-1)
+    int arrayX = nearPlayerX + m_halfSize;
+    int arrayY = nearPlayerY + m_halfSize;
+
+    // Bounds check
+    if (arrayX < 0 || arrayX >= m_gridSize || arrayY < 0 || arrayY >= m_gridSize)
     {
-        return nullptr;
+        return -1;
+    }
+
+    return arrayY * m_gridSize + arrayX;
+}
+
+int NearPlayerTileGrid::toStorageIndex(int index) const
+{
+    int arrayX = index % m_gridSize + m_originX;
+    int arrayY = index / m_gridSize + m_originY;
+    if (arrayX >= m_gridSize)
+        arrayX -= m_gridSize;
+    if (arrayY >= m_gridSize)
+        arrayY -= m_gridSize;
+    return arrayY * m_gridSize + arrayX;
+}
+
+NearPlayerTile NearPlayerTileGrid::getTile(int nearPlayerX, int nearPlayerY) const
+{
+    NearPlayerTile tile;
+    tile.nearPlayerTileX = nearPlayerX;
+    tile.nearPlayerTileY = nearPlayerY;
+    tile.tileX = m_playerTileX + nearPlayerX;
+    tile.tileY = m_playerTileY + nearPlayerY;
+
+    // TODO: Calculate world position based on tile size
+    // For now, using a placeholder tile size of 64.0f
+    const float tileSize = 64.0f;
+    tile.worldX = tile.tileX * tileSize;
+    tile.worldY = tile.tileY * tileSize;
+
+    tile.status = getStatus(nearPlayerX, nearPlayerY);
+    tile.agent = getAgent(nearPlayerX, nearPlayerY);
+    return tile;
+}
+
+TileStatus NearPlayerTileGrid::getStatus(int nearPlayerX, int nearPlayerY) const
+{
+    return getStatusAtIndex(getIndex(nearPlayerX, nearPlayerY));
+}
+
+AnimatedDataCharacterNavMeshAgent *NearPlayerTileGrid::getAgent(int nearPlayerX, int nearPlayerY) const
+{
+    return getAgentAtIndex(getIndex(nearPlayerX, nearPlayerY));
+}
+
+TileStatus NearPlayerTileGrid::getStatusAtIndex(int index) const
+{
+    if (index < 0 || index >= getTileCount())
+    {
+        return TileStatus::Empty;
     }
-    return &m_tiles[index];
+    return static_cast<TileStatus>(m_status[toStorageIndex(index)]);
 }
 
-NearPlayerTile *NearPlayerTileGrid::getTileMutable(int nearPlayerX, int nearPlayerY)
+AnimatedDataCharacterNavMeshAgent *NearPlayerTileGrid::getAgentAtIndex(int index) const
 {
-    int index = getIndex(nearPlayerX, nearPlayerY);
-    if (index < 0 || index >= static_cast<int>(m_tiles.size()))
+    if (index < 0 || index >= getTileCount())
     {
         return nullptr;
     }
-    return &m_tiles[index];
+    int32_t slot = m_agentSlots[toStorageIndex(index)];
+    return slot >= 0 ? m_slotAgents[slot] : nullptr;
 }
 
-const std::vector<NearPlayerTile> &NearPlayerTileGrid::getTiles() const
+void NearPlayerTileGrid::setTile(int nearPlayerX, int nearPlayerY, TileStatus status, AnimatedDataCharacterNavMeshAgent *agent)
 {
-    return m_tiles;
+    setTileAtIndex(getIndex(nearPlayerX, nearPlayerY), status, agent);
 }
 
-void NearPlayerTileGrid::updatePlayerPosition(float playerWorldX, float playerWorldY,
-                                              int playerTileX, int playerTileY)
+void NearPlayerTileGrid::setTileAtIndex(int index, TileStatus status, AnimatedDataCharacterNavMeshAgent *agent)
 {
-    // Calculate the offset to center the grid around the player
-    int halfSize = m_gridSize / 2;
+    if (index < 0 || index >= getTileCount())
+    {
+        return;
+    }
 
-    // Update each tile in the grid
-    for (int ny = -halfSize; ny <= halfSize; ++ny)
+    int storageIndex = toStorageIndex(index);
+    m_status[storageIndex] = static_cast<uint8_t>(status);
+    assignSlot(storageIndex, agent);
+}
+
+void NearPlayerTileGrid::assignSlot(int storageIndex, AnimatedDataCharacterNavMeshAgent *agent)
+{
+    int32_t oldSlot = m_agentSlots[storageIndex];
+    if (oldSlot >= 0 && m_slotAgents[oldSlot] == agent)
+    {
+        return;
+    }
+
+    // Release the previous agent's slot once it no longer owns any tile
+    if (oldSlot >= 0 && --m_slotRefCounts[oldSlot] == 0)
     {
-        for (int nx = -halfSize; nx <= halfSize; ++nx)
+        m_agentToSlot.erase(m_slotAgents[oldSlot]);
+        m_slotAgents[oldSlot] = nullptr;
+        m_freeSlots.push_back(oldSlot);
+    }
+
+    int32_t newSlot = -1;
+    if (agent)
+    {
+        auto it = m_agentToSlot.find(agent);
+        if (it != m_agentToSlot.end())
         {
-            int index = getIndex(nx, ny);
-            if (index < 0 || index >= static_cast<int>(m_tiles.size()))
-            {
-                continue;
-            }
+            newSlot = it->second;
+        }
+        else if (!m_freeSlots.empty())
+        {
+            newSlot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            m_slotAgents[newSlot] = agent;
+            m_agentToSlot[agent] = newSlot;
+        }
+        else
+        {
+            newSlot = static_cast<int32_t>(m_slotAgents.size());
+            m_slotAgents.push_back(agent);
+            m_slotRefCounts.push_back(0);
+            m_agentToSlot[agent] = newSlot;
+        }
+        m_slotRefCounts[newSlot]++;
+    }
 
-            NearPlayerTile &tile = m_tiles[index];
-            tile.nearPlayerTileX = nx;
-            tile.nearPlayerTileY = ny;
-            tile.tileX = playerTileX + nx;
-            tile.tileY = playerTileY + ny;
+    m_agentSlots[storageIndex] = newSlot;
+}
 
-            // TODO: Calculate world position based on tile size
-            // For now, using a placeholder tile size of 64.0f
-            const float tileSize = 64.0f;
-            tile.worldX = tile.tileX * tileSize;
-            tile.worldY = tile.tileY * tileSize;
+void NearPlayerTileGrid::clearAgent(AnimatedDataCharacterNavMeshAgent *agent)
+{
+    auto it = m_agentToSlot.find(agent);
+    if (it == m_agentToSlot.end())
+    {
+        return;
+    }
 
-            // Note: status and agent pointer are preserved during update
+    int32_t slot = it->second;
+    for (size_t i = 0; i < m_agentSlots.size(); ++i)
+    {
+        if (m_agentSlots[i] == slot)
+        {
+            m_status[i] = static_cast<uint8_t>(TileStatus::Empty);
+            assignSlot(static_cast<int>(i), nullptr);
         }
     }
 }
 
-int NearPlayerTileGrid::getIndex(int nearPlayerX, int nearPlayerY) const
+void NearPlayerTileGrid::clearRow(int nearPlayerY)
 {
-    // Convert from centered coordinates (-halfSize to +halfSize) to array indices (0 to gridSize-1)
-    int halfSize = m_gridSize / 2;
-    int arrayX = nearPlayerX + halfSize;
-    int arrayY = nearPlayerY + halfSize;
+    for (int nx = -m_halfSize; nx <= m_halfSize; ++nx)
+    {
+        setTile(nx, nearPlayerY, TileStatus::Empty, nullptr);
+    }
+}
 
-    // Bounds check
-    if (arrayX < 0 || arrayX >= m_gridSize || arrayY < 0 || arrayY >= m_gridSize)
+void NearPlayerTileGrid::clearColumn(int nearPlayerX)
+{
+    for (int ny = -m_halfSize; ny <= m_halfSize; ++ny)
     {
-        return -1;
+        setTile(nearPlayerX, ny, TileStatus::Empty, nullptr);
     }
+}
 
-    return arrayY * m_gridSize + arrayX;
+void NearPlayerTileGrid::updatePlayerTile(int playerTileX, int playerTileY)
+{
+    if (!m_hasPlayerTile)
+    {
+        m_playerTileX = playerTileX;
+        m_playerTileY = playerTileY;
+        m_hasPlayerTile = true;
+        return;
+    }
+
+    int dx = playerTileX - m_playerTileX;
+    int dy = playerTileY - m_playerTileY;
+    if (dx == 0 && dy == 0)
+    {
+        return;
+    }
+
+    m_playerTileX = playerTileX;
+    m_playerTileY = playerTileY;
+
+    // Jumped further than the grid is wide - nothing carries over
+    if (std::abs(dx) >= m_gridSize || std::abs(dy) >= m_gridSize)
+    {
+        for (int i = 0; i < getTileCount(); ++i)
+        {
+            setTileAtIndex(i, TileStatus::Empty, nullptr);
+        }
+        m_originX = 0;
+        m_originY = 0;
+        return;
+    }
+
+    // Shift the origin so every surviving tile keeps its world tile
+    m_originX = ((m_originX + dx) % m_gridSize + m_gridSize) % m_gridSize;
+    m_originY = ((m_originY + dy) % m_gridSize + m_gridSize) % m_gridSize;
+
+    // Clear only the newly exposed columns and rows (they still hold tiles that scrolled off)
+    for (int i = 0; i < std::abs(dx); ++i)
+    {
+        clearColumn(dx > 0 ? m_halfSize - i : -m_halfSize + i);
+    }
+    for (int i = 0; i < std::abs(dy); ++i)
+    {
+        clearRow(dy > 0 ? m_halfSize - i : -m_halfSize + i);
+    }
 }
 
 void NearPlayerTileGrid::render(const LevelV1 &level) const
 {
     // Render each tile in the grid with color based on status
-    for (const auto &tile : m_tiles)
+    for (int ny = -m_halfSize; ny <= m_halfSize; ++ny)
     {
-        CF_Color color;
-        float opacity;
-        float border_opacity = 0.2f;
-
-        switch (tile.status)
+        for (int nx = -m_halfSize; nx <= m_halfSize; ++nx)
         {
-        case TileStatus::PlannedAction:
-            // Dark pink for planned action
-            color = cf_make_color_rgb(199, 21, 133); // Medium violet red
-            opacity = 0.15f;
-            break;
-        case TileStatus::PlannedOccupiedByAgent:
-            // Purple for planned agent position
-            color = cf_make_color_rgb(128, 0, 128);
-            opacity = 0.15f;
-            break;
-        case TileStatus::Empty:
-        default:
-            // Light pink with lower opacity for empty
-            color = cf_make_color_rgb(255, 182, 193);
-            opacity = 0.1f;
-            break;
-        }
+            CF_Color color;
+            float opacity;
+            float border_opacity = 0.2f;
+
+            switch (getStatus(nx, ny))
+            {
+            case TileStatus::PlannedAction:
+                // Dark pink for planned action
+                color = cf_make_color_rgb(199, 21, 133); // Medium violet red
+                opacity = 0.15f;
+                break;
+            case TileStatus::PlannedOccupiedByAgent:
+                // Purple for planned agent position
+                color = cf_make_color_rgb(128, 0, 128);
+                opacity = 0.15f;
+                break;
+            case TileStatus::Empty:
+            default:
+                // Light pink with lower opacity for empty
+                color = cf_make_color_rgb(255, 182, 193);
+                opacity = 0.1f;
+                break;
+            }
 
-        highlightTile(level, tile.tileX, tile.tileY, color, border_opacity, opacity);
+            highlightTile(level, m_playerTileX + nx, m_playerTileY + ny, color, border_opacity, opacity);
+        }
     }
 }
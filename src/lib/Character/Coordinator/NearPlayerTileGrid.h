@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 // Forward declarations
@@ -7,7 +9,7 @@ class LevelV1;
 class AnimatedDataCharacterNavMeshAgent;
 
 // Tile status enum
-enum class TileStatus
+enum class TileStatus : uint8_t
 {
     Empty = 0,
     PlannedOccupiedByAgent = 1,
@@ -16,7 +18,7 @@ enum class TileStatus
     OccupiedByAction = 4
 };
 
-// Represents a single tile in the near-player grid
+// Snapshot of a single tile in the near-player grid (assembled on request, not stored)
 struct NearPlayerTile
 {
     float worldX;                             // World position X
@@ -31,6 +33,11 @@ struct NearPlayerTile
 
 // NearPlayerTileGrid manages an N x N grid of tiles around the player
 // The player is always at the center (0, 0) of this grid
+//
+// Storage is a toroidal ring buffer anchored to world tiles: when the player moves to a new
+// tile only the origin shifts and the newly exposed rows/columns are cleared, so claims stay on
+// the world tile they were made for. Tile state is kept SoA - a packed status byte per tile plus
+// an index into a small table of agents - which keeps large grids (31x31 and up) cheap to scan.
 class NearPlayerTileGrid
 {
 public:
@@ -38,33 +45,75 @@ public:
     NearPlayerTileGrid(int gridSize = 7);
     ~NearPlayerTileGrid();
 
-    // Initialize the grid with a specific size
+    // Initialize the grid with a specific size (odd sizes only, even sizes are rounded up)
+    // Clears all tiles
     void initialize(int gridSize);
 
     // Get the grid size (N for an N x N grid)
     int getGridSize() const;
 
-    // Get a tile at a specific near-player grid position
-    // Returns nullptr if out of bounds
-    const NearPlayerTile *getTile(int nearPlayerX, int nearPlayerY) const;
+    // Get the number of tiles (N * N)
+    int getTileCount() const;
 
-    // Get a mutable tile at a specific near-player grid position
-    // Returns nullptr if out of bounds
-    NearPlayerTile *getTileMutable(int nearPlayerX, int nearPlayerY);
+    // Get the player's tile position (the tile at near-player 0,0)
+    int getPlayerTileX() const;
+    int getPlayerTileY() const;
 
-    // Get all tiles
-    const std::vector<NearPlayerTile> &getTiles() const;
+    // Convert near-player grid coords to a row-major index in [0, getTileCount())
+    // Indices stay valid until the player changes tile. Returns -1 if out of bounds
+    int getIndex(int nearPlayerX, int nearPlayerY) const;
+
+    // Get a copy of the tile at a specific near-player grid position
+    // Out of bounds positions return an empty tile
+    NearPlayerTile getTile(int nearPlayerX, int nearPlayerY) const;
+
+    // Tile state by near-player position (Empty/nullptr if out of bounds)
+    TileStatus getStatus(int nearPlayerX, int nearPlayerY) const;
+    AnimatedDataCharacterNavMeshAgent *getAgent(int nearPlayerX, int nearPlayerY) const;
+
+    // Tile state by index from getIndex()
+    TileStatus getStatusAtIndex(int index) const;
+    AnimatedDataCharacterNavMeshAgent *getAgentAtIndex(int index) const;
+
+    // Set a tile's status and agent (ignored if out of bounds)
+    void setTile(int nearPlayerX, int nearPlayerY, TileStatus status, AnimatedDataCharacterNavMeshAgent *agent);
+    void setTileAtIndex(int index, TileStatus status, AnimatedDataCharacterNavMeshAgent *agent);
+
+    // Reset every tile claimed by an agent to Empty
+    void clearAgent(AnimatedDataCharacterNavMeshAgent *agent);
 
-    // Update the grid based on player's current world/tile position
-    void updatePlayerPosition(float playerWorldX, float playerWorldY, int playerTileX, int playerTileY);
+    // Re-center the grid on the player's tile, scrolling the ring buffer
+    void updatePlayerTile(int playerTileX, int playerTileY);
 
     // Render the grid tiles with highlighting
     void render(const LevelV1 &level) const;
 
 private:
-    int m_gridSize;                      // N for an N x N grid
-    std::vector<NearPlayerTile> m_tiles; // Flat array of tiles (size = gridSize * gridSize)
+    int m_gridSize; // N for an N x N grid
+    int m_halfSize; // N / 2
+    int m_originX;  // Ring buffer column holding near-player x = -halfSize
+    int m_originY;  // Ring buffer row holding near-player y = -halfSize
+    int m_playerTileX;
+    int m_playerTileY;
+    bool m_hasPlayerTile;
 
-    // Helper to convert near-player grid coords to flat array index
-    int getIndex(int nearPlayerX, int nearPlayerY) const;
+    // SoA tile state, indexed by ring buffer position
+    std::vector<uint8_t> m_status;     // TileStatus per tile
+    std::vector<int32_t> m_agentSlots; // Index into m_slotAgents, -1 if none
+
+    // Agents referenced by tiles, with per-slot tile counts so slots can be recycled
+    std::vector<AnimatedDataCharacterNavMeshAgent *> m_slotAgents;
+    std::vector<int32_t> m_slotRefCounts;
+    std::vector<int32_t> m_freeSlots;
+    std::unordered_map<AnimatedDataCharacterNavMeshAgent *, int32_t> m_agentToSlot;
+
+    // Convert an index from getIndex() to a ring buffer position
+    int toStorageIndex(int index) const;
+
+    // Point a stored tile at a new agent, keeping slot counts in sync
+    void assignSlot(int storageIndex, AnimatedDataCharacterNavMeshAgent *agent);
+
+    // Reset a full ring buffer row/column given in near-player coordinates
+    void clearRow(int nearPlayerY);
+    void clearColumn(int nearPlayerX);
 };
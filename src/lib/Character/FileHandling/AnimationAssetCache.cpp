@@ -0,0 +1,257 @@
+#include "AnimationAssetCache.h"
+#include "JobSystem.h"
+#include "Utils.h"
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace
+{
+    // Loaded tables by layout key
+    std::map<std::string, std::shared_ptr<const AnimationTable>> s_tables;
+
+    // Character folder -> layout key it resolved to
+    std::map<std::string, std::string> s_folderKeys;
+
+    // Layout key -> sheets the table was decoded from
+    std::map<std::string, std::vector<std::string>> s_tableSheets;
+
+    // Shared loader (one PNG cache for the whole process)
+    SpriteAnimationLoader s_loader;
+
+    size_t s_hits = 0;
+    size_t s_misses = 0;
+
+    std::mutex s_mutex;
+
+    std::vector<std::string> getLayoutSheets(const std::string &basePath, const std::vector<AnimationLayout> &layouts)
+    {
+        std::vector<std::string> sheetPaths;
+        for (const auto &layout : layouts)
+        {
+            for (const auto &filename : layout.filenames)
+            {
+                sheetPaths.push_back(SpriteAnimationLoader::getSheetPath(basePath, layout, filename));
+            }
+        }
+        return sheetPaths;
+    }
+}
+
+std::shared_ptr<const AnimationTable> AnimationAssetCache::find(const std::string &folderPath)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    auto folderIt = s_folderKeys.find(folderPath);
+    if (folderIt == s_folderKeys.end())
+    {
+        return nullptr;
+    }
+
+    auto tableIt = s_tables.find(folderIt->second);
+    if (tableIt == s_tables.end())
+    {
+        return nullptr;
+    }
+
+    s_hits++;
+    return tableIt->second;
+}
+
+std::shared_ptr<const AnimationTable> AnimationAssetCache::load(const std::string &folderPath,
+                                                                const std::string &basePath,
+                                                                const std::vector<AnimationLayout> &layouts)
+{
+    std::string key = makeKey(basePath, layouts);
+
+    // Held while loading so two callers never decode the same sheets
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    auto it = s_tables.find(key);
+    if (it != s_tables.end())
+    {
+        s_folderKeys[folderPath] = key;
+        s_hits++;
+        return it->second;
+    }
+
+    s_misses++;
+    auto table = std::make_shared<AnimationTable>(s_loader.loadAnimationTable(basePath, layouts));
+
+    // The sprites now own their pixels, the compressed PNG bytes are no longer needed
+    s_loader.clearCache();
+
+    if (table->animations.empty())
+    {
+        printf("AnimationAssetCache: WARNING: No animations loaded for '%s'\n", folderPath.c_str());
+        return nullptr;
+    }
+
+    printf("AnimationAssetCache: Loaded %zu animations for '%s'\n", table->animations.size(), folderPath.c_str());
+
+    s_tables[key] = table;
+    s_folderKeys[folderPath] = key;
+
+    s_tableSheets[key] = getLayoutSheets(basePath, layouts);
+    return table;
+}
+
+void AnimationAssetCache::prefetch(const std::string &basePath, const std::vector<AnimationLayout> &layouts)
+{
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        if (s_tables.find(makeKey(basePath, layouts)) != s_tables.end())
+        {
+            return;
+        }
+    }
+
+    std::vector<std::string> sheetPaths = getLayoutSheets(basePath, layouts);
+
+    // The loader's prefetch map has its own lock, s_mutex is not held while decoding
+    JobSystem::parallelFor(sheetPaths.size(), 1, [&](size_t begin, size_t end)
+                           {
+        for (size_t i = begin; i < end; i++)
+        {
+            s_loader.prefetchSheet(sheetPaths[i]);
+        } }, "PrefetchSheets", "general");
+}
+
+std::vector<std::string> AnimationAssetCache::invalidateSheets(const std::vector<std::string> &sheetPaths)
+{
+    std::set<std::string> changed;
+    for (const std::string &sheetPath : sheetPaths)
+    {
+        changed.insert(normalize_virtual_path(sheetPath));
+    }
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    std::set<std::string> droppedKeys;
+    for (auto it = s_tableSheets.begin(); it != s_tableSheets.end();)
+    {
+        bool uses = false;
+        for (const std::string &sheet : it->second)
+        {
+            uses = uses || changed.count(normalize_virtual_path(sheet)) > 0;
+        }
+
+        if (uses)
+        {
+            droppedKeys.insert(it->first);
+            s_tables.erase(it->first);
+            it = s_tableSheets.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    std::vector<std::string> folders;
+    for (auto it = s_folderKeys.begin(); it != s_folderKeys.end();)
+    {
+        if (droppedKeys.count(it->second) > 0)
+        {
+            folders.push_back(it->first);
+            it = s_folderKeys.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (!droppedKeys.empty())
+    {
+        printf("AnimationAssetCache: Dropped %zu tables (%zu character folders) for changed sheets\n",
+               droppedKeys.size(), folders.size());
+    }
+    return folders;
+}
+
+void AnimationAssetCache::prefetchSheets(const std::vector<std::string> &sheetPaths)
+{
+    std::set<std::string> changed;
+    for (const std::string &sheetPath : sheetPaths)
+    {
+        changed.insert(normalize_virtual_path(sheetPath));
+    }
+
+    // Prefetched sheets are looked up by the exact path the tables were loaded with
+    std::set<std::string> used;
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        for (const auto &[key, sheets] : s_tableSheets)
+        {
+            for (const std::string &sheet : sheets)
+            {
+                if (changed.count(normalize_virtual_path(sheet)) > 0)
+                {
+                    used.insert(sheet);
+                }
+            }
+        }
+    }
+    std::vector<std::string> usedSheets(used.begin(), used.end());
+
+    JobSystem::parallelFor(usedSheets.size(), 1, [&](size_t begin, size_t end)
+                           {
+        for (size_t i = begin; i < end; i++)
+        {
+            s_loader.prefetchSheet(usedSheets[i]);
+        } }, "PrefetchSheets", "general");
+}
+
+std::string AnimationAssetCache::makeKey(const std::string &basePath, const std::vector<AnimationLayout> &layouts)
+{
+    std::string key = basePath;
+    for (const auto &layout : layouts)
+    {
+        key += '|';
+        key += layout.name;
+        key += ':' + std::to_string(layout.frame_width) + 'x' + std::to_string(layout.frame_height);
+        key += ':' + std::to_string(layout.frames_per_row) + 'x' + std::to_string(layout.frames_per_col);
+        key += ':';
+        for (Direction direction : layout.directions)
+        {
+            key += static_cast<char>('0' + static_cast<int>(direction));
+        }
+        for (const auto &filename : layout.filenames)
+        {
+            key += ':';
+            key += filename;
+        }
+    }
+    return key;
+}
+
+void AnimationAssetCache::clear()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_tables.clear();
+    s_folderKeys.clear();
+    s_tableSheets.clear();
+    s_loader.clearCache();
+    s_loader.clearPrefetchedSheets();
+    s_hits = 0;
+    s_misses = 0;
+}
+
+size_t AnimationAssetCache::getTableCount()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_tables.size();
+}
+
+size_t AnimationAssetCache::getHitCount()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_hits;
+}
+
+size_t AnimationAssetCache::getMissCount()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_misses;
+}
@@ -0,0 +1,53 @@
+#ifndef ANIMATION_ASSET_CACHE_H
+#define ANIMATION_ASSET_CACHE_H
+
+#include "SpriteAnimationLoader.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Process-wide cache of loaded animation tables (flyweight).
+// Tables are immutable once loaded and shared by every character using the same sheets,
+// so each character only keeps its playback state. Sprites inside a table stay valid
+// for as long as any character holds the table.
+class AnimationAssetCache
+{
+public:
+    // Find the table a character folder resolved to earlier (nullptr if not loaded yet).
+    // Lets characters skip reading sheet dimensions when a folder was already loaded.
+    static std::shared_ptr<const AnimationTable> find(const std::string &folderPath);
+
+    // Get the table for a folder and its layouts, loading the sheets on first use.
+    // Folders whose layouts describe the same sheets share one table.
+    // Returns nullptr if no animation could be loaded.
+    static std::shared_ptr<const AnimationTable> load(const std::string &folderPath,
+                                                      const std::string &basePath,
+                                                      const std::vector<AnimationLayout> &layouts);
+
+    // Decode the sheets of a table that is not loaded yet, so a later load() only slices frames.
+    // Safe to call from worker threads; sheets are decoded in parallel on the JobSystem.
+    static void prefetch(const std::string &basePath, const std::vector<AnimationLayout> &layouts);
+
+    // Build the cache key for a set of layouts (sheet paths, frame sizes and directions)
+    static std::string makeKey(const std::string &basePath, const std::vector<AnimationLayout> &layouts);
+
+    // Drop the tables built from any of the given sheets (VFS paths, with or without the leading '/'),
+    // so the next load() decodes them again. Characters keep their old table until they reload.
+    // Returns the character folders that resolved to a dropped table.
+    static std::vector<std::string> invalidateSheets(const std::vector<std::string> &sheetPaths);
+
+    // Decode the given sheets ahead of a reload, skipping sheets no loaded table uses.
+    // Safe to call from worker threads.
+    static void prefetchSheets(const std::vector<std::string> &sheetPaths);
+
+    // Drop the cache's references (tables stay alive while characters still hold them)
+    // and any prefetched sheets that were never loaded
+    static void clear();
+
+    // Cache statistics
+    static size_t getTableCount();
+    static size_t getHitCount();
+    static size_t getMissCount();
+};
+
+#endif // ANIMATION_ASSET_CACHE_H
@@ -0,0 +1,132 @@
+#include "EntityPrototypeCache.h"
+#include "AnimatedDataCharacter.h"
+#include "AnimatedDataCharacterNavMeshAgent.h"
+#include "Utils.h"
+#include <map>
+#include <mutex>
+
+namespace
+{
+    // Built prototypes by folder path
+    std::map<std::string, std::shared_ptr<const EntityPrototype>> s_prototypes;
+
+    size_t s_hits = 0;
+    size_t s_misses = 0;
+
+    std::mutex s_mutex;
+}
+
+std::shared_ptr<const EntityPrototype> EntityPrototypeCache::get(const std::string &folderPath)
+{
+    // Held while building so a folder is never loaded twice
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    auto it = s_prototypes.find(folderPath);
+    if (it != s_prototypes.end())
+    {
+        s_hits++;
+        return it->second;
+    }
+
+    s_misses++;
+    std::shared_ptr<EntityPrototype> prototype = build(folderPath);
+    if (!prototype)
+    {
+        // Failures are not cached so a fixed file is picked up on the next spawn
+        return nullptr;
+    }
+
+    printf("EntityPrototypeCache: Built prototype for '%s' (%zu actions, %zu state machines)\n",
+           folderPath.c_str(), prototype->actions.size(), prototype->stateMachines.size());
+
+    s_prototypes[folderPath] = prototype;
+    return prototype;
+}
+
+std::shared_ptr<EntityPrototype> EntityPrototypeCache::build(const std::string &folderPath)
+{
+    auto prototype = std::make_shared<EntityPrototype>();
+
+    if (!AnimatedDataCharacter::loadPrototype(folderPath, *prototype))
+    {
+        printf("EntityPrototypeCache: WARNING: Failed to load entity type from '%s'\n", folderPath.c_str());
+        return nullptr;
+    }
+
+    // Optional, only navmesh agents create state machines from these
+    prototype->hasStateMachines = AnimatedDataCharacterNavMeshAgent::loadStateMachineDefinitions(
+        folderPath, prototype->stateMachines, prototype->defaultStateMachine, &prototype->sourcePaths);
+
+    return prototype;
+}
+
+std::vector<std::string> EntityPrototypeCache::findDependents(const std::string &assetPath)
+{
+    std::string path = normalize_virtual_path(assetPath);
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    std::vector<std::string> folders;
+    for (const auto &[folderPath, prototype] : s_prototypes)
+    {
+        for (const std::string &sourcePath : prototype->sourcePaths)
+        {
+            std::string source = normalize_virtual_path(sourcePath);
+            while (!source.empty() && source.back() == '/')
+            {
+                source.pop_back();
+            }
+            if (path == source || (path.size() > source.size() && path.compare(0, source.size(), source) == 0 &&
+                                   path[source.size()] == '/'))
+            {
+                folders.push_back(folderPath);
+                break;
+            }
+        }
+    }
+    return folders;
+}
+
+std::shared_ptr<const EntityPrototype> EntityPrototypeCache::reload(const std::string &folderPath)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    std::shared_ptr<EntityPrototype> prototype = build(folderPath);
+    if (!prototype)
+    {
+        printf("EntityPrototypeCache: WARNING: Reload of '%s' failed, keeping the previous prototype\n", folderPath.c_str());
+        return nullptr;
+    }
+
+    printf("EntityPrototypeCache: Reloaded prototype for '%s' (%zu actions, %zu state machines)\n",
+           folderPath.c_str(), prototype->actions.size(), prototype->stateMachines.size());
+
+    s_prototypes[folderPath] = prototype;
+    return prototype;
+}
+
+void EntityPrototypeCache::clear()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_prototypes.clear();
+    s_hits = 0;
+    s_misses = 0;
+}
+
+size_t EntityPrototypeCache::getPrototypeCount()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_prototypes.size();
+}
+
+size_t EntityPrototypeCache::getHitCount()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_hits;
+}
+
+size_t EntityPrototypeCache::getMissCount()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_misses;
+}
@@ -0,0 +1,75 @@
+#ifndef ENTITY_PROTOTYPE_CACHE_H
+#define ENTITY_PROTOTYPE_CACHE_H
+
+#include "DataFile.h"
+#include "Action.h"
+#include "SpriteAnimationLoader.h"
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Everything an entity type loads from its folder that is identical for every instance.
+// Built once per folder; spawning an agent only creates its runtime state from it.
+struct EntityPrototype
+{
+    std::string folderPath;
+
+    // Files and folders this prototype was read from (entity folder, action folders,
+    // referenced state machine files), used to find the prototypes a changed file affects
+    std::vector<std::string> sourcePaths;
+
+    // Parsed character.json
+    DataFile characterData;
+
+    // Character hitbox parameters (also used for actions)
+    float hitboxSize = 32.0f;
+    float hitboxDistance = 0.0f;
+
+    // Innate actions, copied into each instance (copies share the hitbox and hitbox data)
+    std::vector<Action> actions;
+
+    // Animations (shared through AnimationAssetCache)
+    std::shared_ptr<const AnimationTable> animationTable;
+    AnimationId idleAnimationId = INVALID_ANIMATION_ID;
+    AnimationId walkAnimationId = INVALID_ANIMATION_ID;
+
+    // State machine definitions from state_machines.json (states are created per instance)
+    bool hasStateMachines = false;
+    std::vector<nlohmann::json> stateMachines;
+    std::string defaultStateMachine;
+};
+
+// Process-wide cache of entity prototypes by folder path.
+// The first request for a folder reads character.json, the innate actions, state_machines.json
+// and the animation sheets; later requests return the same immutable prototype.
+// Must be used on the main thread (building a prototype creates the animation sprites).
+class EntityPrototypeCache
+{
+public:
+    // Get the prototype for an entity folder, building it on first use
+    // Returns nullptr if character.json or the animations could not be loaded
+    static std::shared_ptr<const EntityPrototype> get(const std::string &folderPath);
+
+    // Find the cached prototypes that read a file (the file itself or a folder containing it)
+    // Returns their folder paths
+    static std::vector<std::string> findDependents(const std::string &assetPath);
+
+    // Build a folder's prototype again and replace the cached one
+    // On failure the cached prototype is kept and nullptr is returned
+    static std::shared_ptr<const EntityPrototype> reload(const std::string &folderPath);
+
+    // Drop the cache's references (prototypes stay alive while agents still hold them)
+    static void clear();
+
+    // Cache statistics
+    static size_t getPrototypeCount();
+    static size_t getHitCount();
+    static size_t getMissCount();
+
+private:
+    // Load everything for one folder
+    static std::shared_ptr<EntityPrototype> build(const std::string &folderPath);
+};
+
+#endif // ENTITY_PROTOTYPE_CACHE_H
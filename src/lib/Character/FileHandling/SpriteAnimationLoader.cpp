@@ -58,6 +58,54 @@ void SpriteAnimationLoader::clearCache()
     pngCache.clear();
 }
 
+// Drop prefetched sheets that were never sliced
+void SpriteAnimationLoader::clearPrefetchedSheets()
+{
+    std::lock_guard<std::mutex> lock(prefetchMutex);
+    printf("SpriteAnimationLoader: Clearing %zu prefetched sheets\n", prefetchedSheets.size());
+    prefetchedSheets.clear();
+}
+
+// PhysFS requires absolute paths starting with /, animations are in subdirectories (idle/, walkcycle/)
+std::string SpriteAnimationLoader::getSheetPath(const std::string &base_path, const AnimationLayout &layout, const std::string &filename)
+{
+    return "/" + base_path + "/" + layout.name + "/" + filename;
+}
+
+// Read and decode a sheet without touching the PNG cache (runs on worker threads)
+bool SpriteAnimationLoader::prefetchSheet(const std::string &png_path)
+{
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        if (prefetchedSheets.find(png_path) != prefetchedSheets.end())
+        {
+            return true;
+        }
+    }
+
+    size_t file_size = 0;
+    void *file_data = cf_fs_read_entire_file_to_memory(png_path.c_str(), &file_size);
+    if (file_data == nullptr)
+    {
+        printf("SpriteAnimationLoader: Failed to read PNG file for prefetch: %s\n", png_path.c_str());
+        return false;
+    }
+
+    DecodedSheet sheet;
+    bool decoded = file_size > 0 && decodePNG(png_path, file_data, file_size, sheet);
+    cf_free(file_data);
+    if (!decoded)
+    {
+        return false;
+    }
+
+    decodeCount++;
+
+    std::lock_guard<std::mutex> lock(prefetchMutex);
+    prefetchedSheets.emplace(png_path, std::move(sheet));
+    return true;
+}
+
 // Load PNG file and cache it
 bool SpriteAnimationLoader::loadAndCachePNG(const std::string &png_path)
 {
@@ -142,43 +190,62 @@ size_t SpriteAnimationLoader::getCachedPNGCount() const
     return pngCache.size();
 }
 
-// Extract sprite frame from PNG using the proven system from tsx.cpp
-CF_Sprite SpriteAnimationLoader::extractSpriteFrame(const std::string &png_path,
-                                                    int frame_x, int frame_y,
-                                                    int frame_width, int frame_height)
+// Decode a whole PNG once into premultiplied RGBA (same decoding as tsx.cpp)
+bool SpriteAnimationLoader::decodeSheet(const std::string &png_path, DecodedSheet &sheet)
 {
-    printf("SpriteAnimationLoader: Extracting frame (%d, %d) size (%dx%d) from %s\n",
-           frame_x, frame_y, frame_width, frame_height, png_path.c_str());
+    // Take the sheet a worker already decoded
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        auto it = prefetchedSheets.find(png_path);
+        if (it != prefetchedSheets.end())
+        {
+            sheet = std::move(it->second);
+            prefetchedSheets.erase(it);
+            printf("SpriteAnimationLoader: Using prefetched sheet %s\n", png_path.c_str());
+            return true;
+        }
+    }
 
     // Ensure PNG is loaded and cached
     if (!loadAndCachePNG(png_path))
     {
-        printf("SpriteAnimationLoader: Failed to load PNG for frame extraction: %s\n", png_path.c_str());
-        return cf_sprite_defaults();
+        printf("SpriteAnimationLoader: Failed to load PNG for decoding: %s\n", png_path.c_str());
+        return false;
     }
 
     const std::vector<uint8_t> *png_data = getCachedPNG(png_path);
     if (!png_data || png_data->empty())
     {
         printf("SpriteAnimationLoader: No cached PNG data for: %s\n", png_path.c_str());
-        return cf_sprite_defaults();
+        return false;
+    }
+
+    if (!decodePNG(png_path, png_data->data(), png_data->size(), sheet))
+    {
+        return false;
     }
 
-    // Initialize libspng context (same as tsx.cpp)
+    decodeCount++;
+    return true;
+}
+
+bool SpriteAnimationLoader::decodePNG(const std::string &png_path, const void *png_data, size_t png_size, DecodedSheet &sheet)
+{
+    // Initialize libspng context
     spng_ctx *ctx = spng_ctx_new(0);
     if (ctx == nullptr)
     {
         printf("SpriteAnimationLoader: Failed to create spng context\n");
-        return cf_sprite_defaults();
+        return false;
     }
 
     // Set PNG data
-    int ret = spng_set_png_buffer(ctx, png_data->data(), png_data->size());
+    int ret = spng_set_png_buffer(ctx, png_data, png_size);
     if (ret != 0)
     {
         printf("SpriteAnimationLoader: spng_set_png_buffer error: %s\n", spng_strerror(ret));
         spng_ctx_free(ctx);
-        return cf_sprite_defaults();
+        return false;
     }
 
     // Get image header
@@ -188,111 +255,116 @@ CF_Sprite SpriteAnimationLoader::extractSpriteFrame(const std::string &png_path,
     {
         printf("SpriteAnimationLoader: spng_get_ihdr error: %s\n", spng_strerror(ret));
         spng_ctx_free(ctx);
-        return cf_sprite_defaults();
+        return false;
     }
 
-    printf("SpriteAnimationLoader: PNG dimensions: %dx%d, bit depth: %d, color type: %d\n",
-           ihdr.width, ihdr.height, ihdr.bit_depth, ihdr.color_type);
+    printf("SpriteAnimationLoader: Decoding %s: %dx%d, bit depth: %d, color type: %d\n",
+           png_path.c_str(), ihdr.width, ihdr.height, ihdr.bit_depth, ihdr.color_type);
 
-    // Validate frame bounds
-    if (frame_x + frame_width > (int)ihdr.width || frame_y + frame_height > (int)ihdr.height)
-    {
-        printf("SpriteAnimationLoader: Frame bounds exceed image dimensions. Frame: (%d,%d)+(%dx%d), Image: %dx%d\n",
-               frame_x, frame_y, frame_width, frame_height, ihdr.width, ihdr.height);
-        spng_ctx_free(ctx);
-        return cf_sprite_defaults();
-    }
-
-    // Decode to RGBA8 (same as tsx.cpp)
     size_t image_size;
     ret = spng_decoded_image_size(ctx, SPNG_FMT_RGBA8, &image_size);
-    if (ret != 0)
+    if (ret != 0 || image_size != static_cast<size_t>(ihdr.width) * ihdr.height * sizeof(CF_Pixel))
     {
         printf("SpriteAnimationLoader: spng_decoded_image_size error: %s\n", spng_strerror(ret));
         spng_ctx_free(ctx);
-        return cf_sprite_defaults();
+        return false;
     }
 
-    // Allocate buffer for the full image
-    std::vector<uint8_t> full_image(image_size);
-    ret = spng_decode_image(ctx, full_image.data(), image_size, SPNG_FMT_RGBA8, 0);
+    // Decode straight into the sheet's pixel buffer (CF_Pixel is RGBA8)
+    sheet.pixels.resize(static_cast<size_t>(ihdr.width) * ihdr.height);
+    ret = spng_decode_image(ctx, sheet.pixels.data(), image_size, SPNG_FMT_RGBA8, 0);
+    spng_ctx_free(ctx);
     if (ret != 0)
     {
         printf("SpriteAnimationLoader: spng_decode_image error: %s\n", spng_strerror(ret));
-        spng_ctx_free(ctx);
-        return cf_sprite_defaults();
+        sheet.pixels.clear();
+        return false;
     }
 
-    // Clean up libspng resources
-    spng_ctx_free(ctx);
+    sheet.width = static_cast<int>(ihdr.width);
+    sheet.height = static_cast<int>(ihdr.height);
 
-    // Create buffer for cropped frame (RGBA format)
-    std::vector<CF_Pixel> frame_pixels(frame_width * frame_height);
+    // Premultiply-at-load (rgb *= a), rounded to nearest: (x*a + 127)/255
+    for (CF_Pixel &pixel : sheet.pixels)
+    {
+        uint8_t a = pixel.colors.a;
+        pixel.colors.r = (uint8_t)((pixel.colors.r * a + 127) / 255);
+        pixel.colors.g = (uint8_t)((pixel.colors.g * a + 127) / 255);
+        pixel.colors.b = (uint8_t)((pixel.colors.b * a + 127) / 255);
+    }
 
-    // Copy the frame region from the full image (same logic as tsx.cpp)
+    return true;
+}
+
+// Copy one frame region out of a decoded sheet and create its sprite
+CF_Sprite SpriteAnimationLoader::sliceFrame(const DecodedSheet &sheet, int frame_x, int frame_y,
+                                            int frame_width, int frame_height, std::vector<CF_Pixel> &scratch)
+{
+    // Validate frame bounds
+    if (frame_x < 0 || frame_y < 0 || frame_width <= 0 || frame_height <= 0 ||
+        frame_x + frame_width > sheet.width || frame_y + frame_height > sheet.height)
+    {
+        printf("SpriteAnimationLoader: Frame bounds exceed image dimensions. Frame: (%d,%d)+(%dx%d), Image: %dx%d\n",
+               frame_x, frame_y, frame_width, frame_height, sheet.width, sheet.height);
+        return cf_sprite_defaults();
+    }
+
+    scratch.resize(static_cast<size_t>(frame_width) * frame_height);
     for (int y = 0; y < frame_height; y++)
     {
-        for (int x = 0; x < frame_width; x++)
-        {
-            int src_x = frame_x + x;
-            int src_y = frame_y + y;
-            int src_index = (src_y * ihdr.width + src_x) * 4; // 4 bytes per pixel (RGBA)
-            int dst_index = y * frame_width + x;
-
-            // Copy RGBA data with premultiply-at-load (rgb *= a)
-            uint8_t r = full_image[src_index + 0];
-            uint8_t g = full_image[src_index + 1];
-            uint8_t b = full_image[src_index + 2];
-            uint8_t a = full_image[src_index + 3];
-            // Round to nearest: (x*a + 127)/255
-            frame_pixels[dst_index].colors.r = (uint8_t)((r * a + 127) / 255);
-            frame_pixels[dst_index].colors.g = (uint8_t)((g * a + 127) / 255);
-            frame_pixels[dst_index].colors.b = (uint8_t)((b * a + 127) / 255);
-            frame_pixels[dst_index].colors.a = a;
-        }
+        const CF_Pixel *src = &sheet.pixels[static_cast<size_t>(frame_y + y) * sheet.width + frame_x];
+        memcpy(&scratch[static_cast<size_t>(y) * frame_width], src, frame_width * sizeof(CF_Pixel));
     }
 
-    // Create sprite from pixel data using Cute Framework (same as tsx.cpp)
-    CF_Sprite frame_sprite = cf_make_easy_sprite_from_pixels(frame_pixels.data(), frame_width, frame_height);
+    // Cute Framework packs easy sprites into shared atlas textures when drawing
+    return cf_make_easy_sprite_from_pixels(scratch.data(), frame_width, frame_height);
+}
 
-    printf("SpriteAnimationLoader: Successfully extracted frame (%d, %d) -> pixel region (%d, %d) size (%dx%d)\n",
-           frame_x, frame_y, frame_x, frame_y, frame_width, frame_height);
+// Extract a single sprite frame from a PNG
+CF_Sprite SpriteAnimationLoader::extractSpriteFrame(const std::string &png_path,
+                                                    int frame_x, int frame_y,
+                                                    int frame_width, int frame_height)
+{
+    DecodedSheet sheet;
+    if (!decodeSheet(png_path, sheet))
+    {
+        return cf_sprite_defaults();
+    }
 
-    return frame_sprite;
+    std::vector<CF_Pixel> scratch;
+    return sliceFrame(sheet, frame_x, frame_y, frame_width, frame_height, scratch);
 }
 
-// Load animation frames from sprite sheet using existing PNG system
+// Load animation frames from sprite sheet, decoding the sheet once
 std::vector<CF_Sprite> SpriteAnimationLoader::loadAnimationFrames(const std::string &png_path,
                                                                   const AnimationLayout &layout)
 {
-    printf("SpriteAnimationLoader: Loading animation frames for %s from %s\n",
-           layout.name.c_str(), png_path.c_str());
-
     std::vector<CF_Sprite> frames;
 
-    // Extract frames for each direction
-    for (int dir = 0; dir < layout.directions.size(); dir++)
+    DecodedSheet sheet;
+    if (!decodeSheet(png_path, sheet))
+    {
+        printf("SpriteAnimationLoader: Failed to decode sheet %s for animation %s\n",
+               png_path.c_str(), layout.name.c_str());
+        return frames;
+    }
+
+    frames.reserve(layout.directions.size() * layout.frames_per_row);
+    std::vector<CF_Pixel> scratch;
+
+    // Slice every frame from the decoded sheet, one row per direction
+    for (int dir = 0; dir < static_cast<int>(layout.directions.size()); dir++)
     {
         for (int frame = 0; frame < layout.frames_per_row; frame++)
         {
-            // Calculate frame coordinates (same logic as tile coordinates in tsx.cpp)
             int frame_x = frame * layout.frame_width;
             int frame_y = dir * layout.frame_height;
-
-            printf("SpriteAnimationLoader: Extracting frame %d, direction %d at (%d, %d)\n",
-                   frame, static_cast<int>(layout.directions[dir]), frame_x, frame_y);
-
-            // Use the existing working PNG extraction method
-            CF_Sprite frame_sprite = extractSpriteFrame(png_path, frame_x, frame_y,
-                                                        layout.frame_width, layout.frame_height);
-
-            // Assume the sprite creation succeeded if we got here
-            frames.push_back(frame_sprite);
-            printf("SpriteAnimationLoader: Added frame %zu\n", frames.size());
+            frames.push_back(sliceFrame(sheet, frame_x, frame_y, layout.frame_width, layout.frame_height, scratch));
         }
     }
 
-    printf("SpriteAnimationLoader: Loaded %zu frames for animation %s\n", frames.size(), layout.name.c_str());
+    printf("SpriteAnimationLoader: Loaded %zu frames for animation %s from %s\n",
+           frames.size(), layout.name.c_str(), png_path.c_str());
     return frames;
 }
 
@@ -500,9 +572,124 @@ const Animation *AnimationTable::getAnimation(const std::string &name) const
     return nullptr;
 }
 
+AnimationTable::AnimationTable(const AnimationTable &other)
+    : animations(other.animations), compiled(other.compiled), animationIds(other.animationIds)
+{
+    // Compiled frames point into animations, re-point them at our own copy
+    for (AnimationId id = 0; id < static_cast<AnimationId>(compiled.size()); id++)
+    {
+        compileAnimation(id);
+    }
+}
+
+AnimationTable &AnimationTable::operator=(const AnimationTable &other)
+{
+    if (this != &other)
+    {
+        animations = other.animations;
+        compiled = other.compiled;
+        animationIds = other.animationIds;
+        for (AnimationId id = 0; id < static_cast<AnimationId>(compiled.size()); id++)
+        {
+            compileAnimation(id);
+        }
+    }
+    return *this;
+}
+
 void AnimationTable::addAnimation(const std::string &name, const Animation &animation)
 {
+    // std::map nodes never move, so compiled frame pointers stay valid as animations are added
     animations[name] = animation;
+
+    AnimationId id;
+    auto it = animationIds.find(name);
+    if (it != animationIds.end())
+    {
+        id = it->second;
+    }
+    else
+    {
+        id = static_cast<AnimationId>(compiled.size());
+        animationIds[name] = id;
+        compiled.emplace_back();
+    }
+    compileAnimation(id);
+}
+
+void AnimationTable::compileAnimation(AnimationId id)
+{
+    CompiledAnimation &target = compiled[id];
+    auto nameIt = std::find_if(animationIds.begin(), animationIds.end(),
+                               [id](const auto &entry)
+                               { return entry.second == id; });
+    const Animation &source = animations.at(nameIt->first);
+
+    target.name = source.name.empty() ? nameIt->first : source.name;
+    target.advances = nameIt->first != "idle"; // Idle sheets hold frame 0 of each direction
+    target.framesPerDirection = 0;
+    for (const auto &frame : source.frames)
+    {
+        target.framesPerDirection = std::max(target.framesPerDirection, frame.frameIndex + 1);
+    }
+
+    target.frames.assign(static_cast<size_t>(DIRECTION_COUNT) * target.framesPerDirection, nullptr);
+    for (const auto &frame : source.frames)
+    {
+        int dir = static_cast<int>(frame.direction);
+        if (dir >= 0 && dir < DIRECTION_COUNT && frame.frameIndex >= 0)
+        {
+            const AnimationFrame *&slot = target.frames[dir * target.framesPerDirection + frame.frameIndex];
+            if (!slot)
+            {
+                slot = &frame; // First match wins, same as Animation::getFrame
+            }
+        }
+    }
+}
+
+AnimationId AnimationTable::getAnimationId(const std::string &name) const
+{
+    auto it = animationIds.find(name);
+    return it != animationIds.end() ? it->second : INVALID_ANIMATION_ID;
+}
+
+const CompiledAnimation *AnimationTable::getCompiled(AnimationId id) const
+{
+    if (id < 0 || id >= static_cast<AnimationId>(compiled.size()))
+    {
+        return nullptr;
+    }
+    return &compiled[id];
+}
+
+const AnimationFrame *AnimationTable::getFrame(const AnimationPlayback &playback) const
+{
+    const CompiledAnimation *anim = getCompiled(playback.animation);
+    return anim ? anim->getFrame(playback.direction, playback.frame) : nullptr;
+}
+
+void AnimationTable::advance(AnimationPlayback *playbacks, size_t count, float dt) const
+{
+    float dtMs = dt * 1000.0f;
+    for (size_t i = 0; i < count; i++)
+    {
+        AnimationPlayback &playback = playbacks[i];
+        const CompiledAnimation *anim = getCompiled(playback.animation);
+        if (!anim || anim->framesPerDirection == 0)
+            continue;
+
+        const AnimationFrame *frame = anim->getFrame(playback.direction, playback.frame);
+        if (!frame)
+            continue;
+
+        playback.timer += dtMs;
+        if (playback.timer >= frame->delay)
+        {
+            playback.timer = 0.0f;
+            playback.frame = anim->advances ? (playback.frame + 1) % anim->framesPerDirection : 0;
+        }
+    }
 }
 
 bool AnimationTable::hasAnimation(const std::string &name) const
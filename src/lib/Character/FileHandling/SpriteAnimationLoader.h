@@ -6,6 +6,8 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <atomic>
 
 using namespace Cute;
 
@@ -119,15 +121,87 @@ struct Animation
     void calculateDuration();
 };
 
+// Index of an animation inside an AnimationTable (resolve names once with getAnimationId)
+typedef int AnimationId;
+const AnimationId INVALID_ANIMATION_ID = -1;
+
+// Number of entries in the Direction enum
+const int DIRECTION_COUNT = 4;
+
+// Animation compiled to a dense [direction][frame] array for O(1) frame lookup
+struct CompiledAnimation
+{
+    std::string name;
+    int framesPerDirection;                    // Highest frame index + 1 over all directions
+    bool advances;                             // False for idle: holds frame 0 of each direction
+    std::vector<const AnimationFrame *> frames; // [direction * framesPerDirection + frame], nullptr if missing
+
+    CompiledAnimation() : framesPerDirection(0), advances(true) {}
+
+    // Get frame by direction and index (nullptr if out of range or missing)
+    const AnimationFrame *getFrame(Direction direction, int frameIndex) const
+    {
+        int dir = static_cast<int>(direction);
+        if (dir < 0 || dir >= DIRECTION_COUNT || frameIndex < 0 || frameIndex >= framesPerDirection)
+            return nullptr;
+        return frames[dir * framesPerDirection + frameIndex];
+    }
+};
+
+// Per-character playback state, kept plain so many can be packed and advanced together
+struct AnimationPlayback
+{
+    AnimationId animation; // Current animation
+    Direction direction;   // Current facing
+    int frame;             // Frame index within the direction
+    float timer;           // Time spent on the current frame in milliseconds
+
+    AnimationPlayback() : animation(INVALID_ANIMATION_ID), direction(Direction::DOWN), frame(0), timer(0.0f) {}
+
+    // Switch animation and restart it (no-op if already playing)
+    void play(AnimationId id)
+    {
+        if (animation != id)
+        {
+            animation = id;
+            frame = 0;
+            timer = 0.0f;
+        }
+    }
+};
+
 // Animation table structure
 struct AnimationTable
 {
     std::map<std::string, Animation> animations;
 
+    // Compiled animations indexed by AnimationId (ids are assigned in insertion order)
+    std::vector<CompiledAnimation> compiled;
+    std::map<std::string, AnimationId> animationIds;
+
+    AnimationTable() = default;
+    AnimationTable(const AnimationTable &other);
+    AnimationTable &operator=(const AnimationTable &other);
+    AnimationTable(AnimationTable &&other) = default;
+    AnimationTable &operator=(AnimationTable &&other) = default;
+
     // Get animation by name
     const Animation *getAnimation(const std::string &name) const;
 
-    // Add new animation
+    // Resolve an animation name to its id (INVALID_ANIMATION_ID if missing)
+    AnimationId getAnimationId(const std::string &name) const;
+
+    // Get compiled animation by id (nullptr if invalid)
+    const CompiledAnimation *getCompiled(AnimationId id) const;
+
+    // Get the frame a playback state currently shows (nullptr if none)
+    const AnimationFrame *getFrame(const AnimationPlayback &playback) const;
+
+    // Advance a contiguous run of playback states that use this table
+    // dt is in seconds, frame delays are in milliseconds
+    void advance(AnimationPlayback *playbacks, size_t count, float dt) const;
+
+    // Add new animation (compiles it and assigns an id on first add)
     void addAnimation(const std::string &name, const Animation &animation);
 
     // Check if animation exists
@@ -135,6 +209,10 @@ struct AnimationTable
 
     // Get all animation names
     std::vector<std::string> getAnimationNames() const;
+
+private:
+    // Rebuild the dense frame array of one compiled animation from animations
+    void compileAnimation(AnimationId id);
 };
 
 // Main sprite animation loader class that extends the existing PNG system
@@ -150,6 +228,33 @@ private:
     // Get cached PNG data
     const std::vector<uint8_t> *getCachedPNG(const std::string &png_path) const;
 
+    // A whole sprite sheet decoded to premultiplied RGBA, frames are sliced from it
+    struct DecodedSheet
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<CF_Pixel> pixels;
+    };
+
+    // Decode a PNG (loading it into the cache first) into premultiplied RGBA
+    // Uses the sheet decoded by prefetchSheet instead if there is one
+    bool decodeSheet(const std::string &png_path, DecodedSheet &sheet);
+
+    // Decode PNG bytes into premultiplied RGBA (png_path is only used for logging)
+    static bool decodePNG(const std::string &png_path, const void *png_data, size_t png_size, DecodedSheet &sheet);
+
+    // Sheets decoded ahead of time by prefetchSheet, consumed by decodeSheet
+    std::map<std::string, DecodedSheet> prefetchedSheets;
+    mutable std::mutex prefetchMutex;
+
+    // Copy one frame out of a decoded sheet and create its sprite
+    // scratch is reused between frames to avoid reallocating
+    static CF_Sprite sliceFrame(const DecodedSheet &sheet, int frame_x, int frame_y,
+                                int frame_width, int frame_height, std::vector<CF_Pixel> &scratch);
+
+    // Number of full PNG decodes performed (for benchmarking)
+    std::atomic<size_t> decodeCount{0};
+
 public:
     SpriteAnimationLoader();
     ~SpriteAnimationLoader();
@@ -179,15 +284,28 @@ public:
     AnimationTable loadAnimationTable(const std::string &base_path,
                                       const std::vector<AnimationLayout> &layouts);
 
+    // Get the VFS path of one layer of an animation's sheet (same path loadAnimationTable reads)
+    static std::string getSheetPath(const std::string &base_path, const AnimationLayout &layout, const std::string &filename);
+
+    // Read and decode a sheet ahead of loadAnimationTable (thread-safe, may run on worker threads)
+    // The decoded pixels are kept until loadAnimationTable slices frames from them
+    bool prefetchSheet(const std::string &png_path);
+
     // Clear PNG cache
     void clearCache();
 
+    // Drop sheets that were prefetched but never used
+    void clearPrefetchedSheets();
+
     // Get cache statistics
     size_t getCacheSize() const;
     size_t getCachedPNGCount() const;
 
     // Check if PNG is cached
     bool isPNGCached(const std::string &png_path) const;
+
+    // Get the number of full PNG decodes performed by this loader
+    size_t getDecodeCount() const { return decodeCount; }
 };
 
 // Predefined animation layouts for common sprite sheet formats
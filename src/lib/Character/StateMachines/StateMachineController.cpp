@@ -10,6 +10,13 @@ StateMachineController::~StateMachineController()
 {
 }
 
+void StateMachineController::clear()
+{
+    stateMachineList.clear();
+    currentStateMachineName.clear();
+    currentStateMachine = nullptr;
+}
+
 void StateMachineController::addStateMachine(StateMachine &&stateMachine)
 {
     std::string name = stateMachine.getName();
@@ -11,6 +11,9 @@ public:
     StateMachineController();
     ~StateMachineController();
 
+    // Remove all state machines
+    void clear();
+
     // Add a state machine to the list
     void addStateMachine(StateMachine &&stateMachine);
 
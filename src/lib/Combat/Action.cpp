@@ -7,14 +7,14 @@
 #include <unordered_set>
 
 // Constructor that takes a folder path and loads action.json from that folder
-Action::Action(const std::string &folderPath) : hasHitbox(false), hitbox(nullptr), hitboxSize(32.0f), hitboxDistance(0.0f), isActive(false), character(nullptr), warmup_timer(0.0f), cooldown_timer(0.0f), in_cooldown(false), damage(nullptr), hasDamage(false)
+Action::Action(const std::string &folderPath) : hasHitbox(false), hitboxSize(32.0f), hitboxDistance(0.0f), isActive(false), character(nullptr), warmup_timer(0.0f), cooldown_timer(0.0f), in_cooldown(false), damage(nullptr), hasDamage(false)
 {
     loadFromFolder(folderPath, hitboxSize, hitboxDistance);
 }
 
 // Constructor with custom hitbox size and distance
 Action::Action(const std::string &folderPath, float hitboxSize, float hitboxDistance)
-    : hasHitbox(false), hitbox(nullptr), hitboxSize(hitboxSize), hitboxDistance(hitboxDistance), isActive(false), character(nullptr), warmup_timer(0.0f), cooldown_timer(0.0f), in_cooldown(false), damage(nullptr), hasDamage(false)
+    : hasHitbox(false), hitboxSize(hitboxSize), hitboxDistance(hitboxDistance), isActive(false), character(nullptr), warmup_timer(0.0f), cooldown_timer(0.0f), in_cooldown(false), damage(nullptr), hasDamage(false)
 {
     loadFromFolder(folderPath, hitboxSize, hitboxDistance);
 }
@@ -22,11 +22,6 @@ Action::Action(const std::string &folderPath, float hitboxSize, float hitboxDist
 // Destructor
 Action::~Action()
 {
-    if (hitbox)
-    {
-        delete hitbox;
-        hitbox = nullptr;
-    }
     if (damage)
     {
         delete damage;
@@ -39,7 +34,7 @@ Action::Action(const Action &other)
     : DataFile(other), // Copy base class
       hitboxData(other.hitboxData),
       hasHitbox(other.hasHitbox),
-      hitbox(nullptr),
+      hitbox(other.hitbox),
       hitboxSize(other.hitboxSize),
       hitboxDistance(other.hitboxDistance),
       isActive(other.isActive),
@@ -50,11 +45,6 @@ Action::Action(const Action &other)
       damage(nullptr),
       hasDamage(other.hasDamage)
 {
-    // Deep copy the hitbox if it exists
-    if (other.hitbox && hasHitbox)
-    {
-        hitbox = HitBox::createHitBoxFromJson(hitboxData, hitboxSize, hitboxDistance);
-    }
     // Deep copy the damage if it exists
     if (other.damage && hasDamage)
     {
@@ -70,13 +60,6 @@ Action &Action::operator=(const Action &other)
         // Copy base class
         DataFile::operator=(other);
 
-        // Clean up existing hitbox
-        if (hitbox)
-        {
-            delete hitbox;
-            hitbox = nullptr;
-        }
-
         // Clean up existing damage
         if (damage)
         {
@@ -87,6 +70,7 @@ Action &Action::operator=(const Action &other)
         // Copy members
         hitboxData = other.hitboxData;
         hasHitbox = other.hasHitbox;
+        hitbox = other.hitbox;
         hitboxSize = other.hitboxSize;
         hitboxDistance = other.hitboxDistance;
         isActive = other.isActive;
@@ -96,12 +80,6 @@ Action &Action::operator=(const Action &other)
         in_cooldown = other.in_cooldown;
         hasDamage = other.hasDamage;
 
-        // Deep copy the hitbox if it exists
-        if (other.hitbox && hasHitbox)
-        {
-            hitbox = HitBox::createHitBoxFromJson(hitboxData, hitboxSize, hitboxDistance);
-        }
-
         // Deep copy the damage if it exists
         if (other.damage && hasDamage)
         {
@@ -152,21 +130,17 @@ bool Action::loadFromFolder(const std::string &folderPath, float hitboxSize, flo
 
     // Try to load hitbox.json if it exists
     std::string hitboxJsonPath = normalizedPath + "hitbox.json";
-    hasHitbox = hitboxData.load(hitboxJsonPath);
+    auto loadedHitboxData = std::make_shared<DataFile>();
+    hasHitbox = loadedHitboxData->load(hitboxJsonPath);
+    hitboxData = loadedHitboxData;
+    hitbox.reset();
 
     if (hasHitbox)
     {
         printf("Action: Loaded hitbox data from %s\n", hitboxJsonPath.c_str());
 
-        // Clean up existing hitbox if any
-        if (hitbox)
-        {
-            delete hitbox;
-            hitbox = nullptr;
-        }
-
         // Create HitBox from JSON data
-        hitbox = HitBox::createHitBoxFromJson(hitboxData, hitboxSize, hitboxDistance);
+        hitbox.reset(HitBox::createHitBoxFromJson(*hitboxData, hitboxSize, hitboxDistance));
 
         if (hitbox)
         {
@@ -185,7 +159,8 @@ bool Action::loadFromFolder(const std::string &folderPath, float hitboxSize, flo
 // Get hitbox data
 const DataFile &Action::getHitboxData() const
 {
-    return hitboxData;
+    static const DataFile emptyHitboxData;
+    return hitboxData ? *hitboxData : emptyHitboxData;
 }
 
 bool Action::hasHitboxData() const
@@ -195,7 +170,7 @@ bool Action::hasHitboxData() const
 
 HitBox *Action::getHitBox() const
 {
-    return hitbox;
+    return hitbox.get();
 }
 
 void Action::setActive(bool active)
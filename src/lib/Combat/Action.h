@@ -3,6 +3,7 @@
 #include "../FileHandling/DataFile.h"
 #include "Damage.h"
 #include <string>
+#include <memory>
 #include <cute.h>
 
 // Forward declarations
@@ -12,9 +13,10 @@ class AnimatedDataCharacter;
 class Action : public DataFile
 {
 private:
-    DataFile hitboxData;
+    // Hitbox data and geometry never change after loading, so copies of an action share them
+    std::shared_ptr<const DataFile> hitboxData;
     bool hasHitbox;
-    HitBox *hitbox;
+    std::shared_ptr<HitBox> hitbox;
     float hitboxSize;
     float hitboxDistance;
     bool isActive;
@@ -35,7 +37,8 @@ public:
     Action(const std::string &folderPath, float hitboxSize, float hitboxDistance);
     ~Action();
 
-    // Copy constructor and copy assignment operator for deep copying
+    // Copy constructor and copy assignment operator (runtime state and damage are copied,
+    // the hitbox and its data are shared)
     Action(const Action &other);
     Action &operator=(const Action &other);
 
@@ -25,6 +25,7 @@ HitBox *HitBox::createHitBoxFromJson(const DataFile &hitboxData, float hitboxSiz
         return nullptr;
     }
 
+    std::vector<HitboxTile> parsedTiles;
     for (const auto &tileJson : hitboxData["tiles"])
     {
         HitboxTile tile;
@@ -32,21 +33,28 @@ HitBox *HitBox::createHitBoxFromJson(const DataFile &hitboxData, float hitboxSiz
         tile.y = tileJson.value("y", 0);
         tile.delay = tileJson.value("delay", 0.0f);
         tile.damageModifier = tileJson.value("damage_modifier", 1.0f);
-        hitBox->tiles.push_back(tile);
+        parsedTiles.push_back(tile);
     }
+    hitBox->tiles = std::make_shared<const std::vector<HitboxTile>>(std::move(parsedTiles));
 
     // Build boxes for each direction
     for (Direction direction : {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT})
     {
-        hitBox->boxesByDirection[direction] = HitBox::buildFromTiles(hitBox->tiles, hitboxSize, hitboxDistance, direction);
+        hitBox->boxesByDirection[direction] = HitBox::buildFromTiles(*hitBox->tiles, hitboxSize, hitboxDistance, direction);
         hitBox->boundingBoxByDirection[direction] = HitBox::buildBoundingBox(hitBox->boxesByDirection[direction], direction);
     }
 
-    printf("HitBox: Created custom hitbox from JSON with %zu tiles\n", hitBox->tiles.size());
+    printf("HitBox: Created custom hitbox from JSON with %zu tiles\n", hitBox->tiles->size());
     return hitBox;
 }
 
 const std::vector<HitboxTile> &HitBox::getTiles() const
+{
+    static const std::vector<HitboxTile> emptyTiles;
+    return tiles ? *tiles : emptyTiles;
+}
+
+std::shared_ptr<const std::vector<HitboxTile>> HitBox::getSharedTiles() const
 {
     return tiles;
 }
@@ -86,9 +94,16 @@ HitBox *HitBox::createHitBox(HitboxShape shape, float hitboxSize, float hitboxDi
     return hitBox;
 }
 
+// Lookups never insert, so a HitBox shared by several actions can be queried concurrently
 std::vector<CF_Aabb> HitBox::getBoxes(Direction direction, v2 translation)
 {
-    std::vector<CF_Aabb> boxes = boxesByDirection[direction];
+    auto it = boxesByDirection.find(direction);
+    if (it == boxesByDirection.end())
+    {
+        return {};
+    }
+
+    std::vector<CF_Aabb> boxes = it->second;
     for (auto &box : boxes)
     {
         box.min += translation;
@@ -99,7 +114,8 @@ std::vector<CF_Aabb> HitBox::getBoxes(Direction direction, v2 translation)
 
 CF_Aabb HitBox::getBoundingBox(Direction direction, v2 translation)
 {
-    CF_Aabb boundingBox = boundingBoxByDirection[direction];
+    auto it = boundingBoxByDirection.find(direction);
+    CF_Aabb boundingBox = it != boundingBoxByDirection.end() ? it->second : CF_Aabb{};
     boundingBox.min += translation;
     boundingBox.max += translation;
     return boundingBox;
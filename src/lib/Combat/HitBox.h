@@ -4,6 +4,7 @@
 #include "SpriteAnimationLoader.h"
 #include "DataFile.h"
 #include <vector>
+#include <memory>
 
 // Forward declaration
 class AnimatedDataCharacter;
@@ -35,6 +36,8 @@ public:
     std::vector<CF_Aabb> getBoxes(Direction direction, v2 translation);
     CF_Aabb getBoundingBox(Direction direction, v2 translation);
     const std::vector<HitboxTile> &getTiles() const;
+    // Shared immutable view of the tiles, safe to hold across threads after the HitBox is gone
+    std::shared_ptr<const std::vector<HitboxTile>> getSharedTiles() const;
     void render(v2 characterPosition, Direction facingDirection, const class LevelV1 &level, CF_Color color,
                 float border_opacity = 0.9f, float fill_opacity = 0.4f);
 
@@ -48,7 +51,7 @@ public:
     static CF_Aabb buildBoundingBox(std::vector<CF_Aabb> boxes, Direction direction);
 
 private:
-    std::vector<HitboxTile> tiles;
+    std::shared_ptr<const std::vector<HitboxTile>> tiles;
     static v2 rotateCoordinate(int x, int y, Direction direction);
 };
 
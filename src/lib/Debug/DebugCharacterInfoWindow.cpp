@@ -9,15 +9,24 @@
 #include <imgui.h>
 
 DebugCharacterInfoWindow::DebugCharacterInfoWindow(const std::string &title,
-                                                   AnimatedDataCharacter *character,
-                                                   const LevelV1 &level)
-    : DebugWindow(title), m_character(character), m_level(level)
+                                                   AgentHandle agent,
+                                                   LevelV1 &level)
+    : DebugWindow(title), m_agent(agent), m_level(level)
 {
 }
 
 void DebugCharacterInfoWindow::render()
 {
-    if (!m_show || !m_character)
+    AnimatedDataCharacterNavMeshAgent *agent = m_level.resolveAgent(m_agent);
+    if (!agent)
+    {
+        // The agent was removed - close, together with the state machine windows pointing into it
+        m_stateMachineWindows.clear();
+        m_show = false;
+        return;
+    }
+
+    if (!m_show)
     {
         return;
     }
@@ -27,13 +36,13 @@ void DebugCharacterInfoWindow::render()
     // Display datafile path
     ImGui::Text("Datafile:");
     ImGui::Indent();
-    ImGui::TextWrapped("%s", m_character->getDataFilePath().c_str());
+    ImGui::TextWrapped("%s", agent->getDataFilePath().c_str());
     ImGui::Unindent();
 
     ImGui::Separator();
 
     // Get character world position
-    CF_V2 worldPos = m_character->getPosition();
+    CF_V2 worldPos = agent->getPosition();
 
     // Get tile dimensions from level
     int tileWidth = m_level.getTileWidth();
@@ -62,15 +71,15 @@ void DebugCharacterInfoWindow::render()
     ImGui::Separator();
 
     // Display current direction
-    ImGui::Text("Direction: %d", static_cast<int>(m_character->getCurrentDirection()));
+    ImGui::Text("Direction: %d", static_cast<int>(agent->getCurrentDirection()));
 
     ImGui::Separator();
 
     // Display action state
     ImGui::Text("Action State:");
     ImGui::Indent();
-    ImGui::Text("Doing Action: %s", m_character->getIsDoingAction() ? "Yes" : "No");
-    if (m_character->getActiveAction())
+    ImGui::Text("Doing Action: %s", agent->getIsDoingAction() ? "Yes" : "No");
+    if (agent->getActiveAction())
     {
         ImGui::Text("Active Action: Present");
     }
@@ -87,7 +96,7 @@ void DebugCharacterInfoWindow::render()
     ImGui::Indent();
 
     // Get current stage of life
-    StageOfLife currentStage = m_character->getStageOfLife();
+    StageOfLife currentStage = agent->getStageOfLife();
 
     // Create combo box with stage options (null-separated string)
     int currentStageIndex = static_cast<int>(currentStage);
@@ -97,7 +106,7 @@ void DebugCharacterInfoWindow::render()
     {
         // User changed the selection, update the character's stage
         StageOfLife newStage = static_cast<StageOfLife>(currentStageIndex);
-        m_character->setStageOfLife(newStage);
+        agent->setStageOfLife(newStage);
 
         // Close window if character was set to Dead
         if (newStage == StageOfLife::Dead)
@@ -110,87 +119,79 @@ void DebugCharacterInfoWindow::render()
 
     ImGui::Separator();
 
-    // Display state machine info if this is a NavMeshAgent
-    if (m_character != nullptr)
+    // Display state machine info
+    ImGui::Text("State Machine:");
+    ImGui::Indent();
+
+    StateMachineController *controller = agent->getStateMachineController();
+    if (controller)
     {
-        // TODO crashes if character is destroyed while window is open
-        AnimatedDataCharacterNavMeshAgent *agent = dynamic_cast<AnimatedDataCharacterNavMeshAgent *>(m_character);
-        if (agent)
+        const std::string &currentName = controller->getCurrentStateMachineName();
+        if (!currentName.empty())
+        {
+            ImGui::Text("Current: %s", currentName.c_str());
+        }
+        else
         {
-            ImGui::Text("State Machine:");
-            ImGui::Indent();
+            ImGui::Text("Current: None");
+        }
 
-            StateMachineController *controller = agent->getStateMachineController();
-            if (controller)
-            {
-                const std::string &currentName = controller->getCurrentStateMachineName();
-                if (!currentName.empty())
-                {
-                    ImGui::Text("Current: %s", currentName.c_str());
-                }
-                else
-                {
-                    ImGui::Text("Current: None");
-                }
+        const auto &machines = controller->getStateMachines();
+        ImGui::Text("Total Machines: %zu", machines.size());
 
-                const auto &machines = controller->getStateMachines();
-                ImGui::Text("Total Machines: %zu", machines.size());
+        // Show buttons for each state machine
+        ImGui::Separator();
+        ImGui::Text("State Machines:");
+        for (size_t i = 0; i < machines.size(); ++i)
+        {
+            // machines is a vector of StateMachine objects, not pointers
+            StateMachine *machine = const_cast<StateMachine *>(&machines[i]);
 
-                // Show buttons for each state machine
-                ImGui::Separator();
-                ImGui::Text("State Machines:");
-                for (size_t i = 0; i < machines.size(); ++i)
-                {
-                    // machines is a vector of StateMachine objects, not pointers
-                    StateMachine *machine = const_cast<StateMachine *>(&machines[i]);
+            const std::string &machineName = machine->getName();
+            ImGui::Text("  %s", machineName.c_str());
+            ImGui::SameLine();
 
-                    const std::string &machineName = machine->getName();
-                    ImGui::Text("  %s", machineName.c_str());
-                    ImGui::SameLine();
+            // Button to set this as the current state machine
+            char setCurrentLabel[128];
+            snprintf(setCurrentLabel, sizeof(setCurrentLabel), "Set Current##machine_%zu", i);
+            if (ImGui::Button(setCurrentLabel))
+            {
+                controller->setCurrentStateMachine(machineName);
+            }
+            ImGui::SameLine();
 
-                    // Button to set this as the current state machine
-                    char setCurrentLabel[128];
-                    snprintf(setCurrentLabel, sizeof(setCurrentLabel), "Set Current##machine_%zu", i);
-                    if (ImGui::Button(setCurrentLabel))
+            // Button to open debug window for this state machine
+            char buttonLabel[128];
+            snprintf(buttonLabel, sizeof(buttonLabel), "Debug##machine_%zu", i);
+            if (ImGui::Button(buttonLabel))
+            {
+                // Check if we already have a window for this state machine
+                bool found = false;
+                for (auto &window : m_stateMachineWindows)
+                {
+                    if (window->isTracking(machine))
                     {
-                        controller->setCurrentStateMachine(machineName);
+                        found = true;
+                        break;
                     }
-                    ImGui::SameLine();
+                }
 
-                    // Button to open debug window for this state machine
-                    char buttonLabel[128];
-                    snprintf(buttonLabel, sizeof(buttonLabel), "Debug##machine_%zu", i);
-                    if (ImGui::Button(buttonLabel))
-                    {
-                        // Check if we already have a window for this state machine
-                        bool found = false;
-                        for (auto &window : m_stateMachineWindows)
-                        {
-                            if (window->isTracking(machine))
-                            {
-                                found = true;
-                                break;
-                            }
-                        }
-
-                        // If not, create a new one
-                        if (!found)
-                        {
-                            std::string windowTitle = "State Machine: " + machineName;
-                            m_stateMachineWindows.push_back(
-                                std::make_unique<DebugStateMachineWindow>(windowTitle, machine));
-                        }
-                    }
+                // If not, create a new one
+                if (!found)
+                {
+                    std::string windowTitle = "State Machine: " + machineName;
+                    m_stateMachineWindows.push_back(
+                        std::make_unique<DebugStateMachineWindow>(windowTitle, machine));
                 }
             }
-            else
-            {
-                ImGui::Text("No controller");
-            }
-
-            ImGui::Unindent();
         }
     }
+    else
+    {
+        ImGui::Text("No controller");
+    }
+
+    ImGui::Unindent();
 
     ImGui::End();
 
@@ -208,12 +209,12 @@ void DebugCharacterInfoWindow::render()
         m_stateMachineWindows.end());
 }
 
-bool DebugCharacterInfoWindow::isTracking(const AnimatedDataCharacter *character) const
+bool DebugCharacterInfoWindow::isTracking(AgentHandle agent) const
 {
-    return m_character == character;
+    return m_agent == agent;
 }
 
-AnimatedDataCharacter *DebugCharacterInfoWindow::getCharacter() const
+AnimatedDataCharacterNavMeshAgent *DebugCharacterInfoWindow::getCharacter() const
 {
-    return m_character;
+    return m_level.resolveAgent(m_agent);
 }
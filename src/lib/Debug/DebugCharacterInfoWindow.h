@@ -1,30 +1,31 @@
 #pragma once
 #include "DebugWindow.h"
 #include "DebugStateMachineWindow.h"
+#include "AgentHandle.h"
 #include <vector>
 #include <memory>
 
 // Forward declarations
-class AnimatedDataCharacter;
+class AnimatedDataCharacterNavMeshAgent;
 class LevelV1;
 
 class DebugCharacterInfoWindow : public DebugWindow
 {
 public:
     DebugCharacterInfoWindow(const std::string &title,
-                             AnimatedDataCharacter *character,
-                             const LevelV1 &level);
+                             AgentHandle agent,
+                             LevelV1 &level);
     virtual ~DebugCharacterInfoWindow() = default;
     void render() override;
 
-    // Check if this window is tracking the given character
-    bool isTracking(const AnimatedDataCharacter *character) const;
+    // Check if this window is tracking the given agent
+    bool isTracking(AgentHandle agent) const;
 
-    // Get the tracked character pointer
-    AnimatedDataCharacter *getCharacter() const;
+    // Get the tracked agent (nullptr once it was removed from the level)
+    AnimatedDataCharacterNavMeshAgent *getCharacter() const;
 
 private:
-    AnimatedDataCharacter *m_character; // Non-owning pointer to the character
-    const LevelV1 &m_level;
+    AgentHandle m_agent; // Resolved every frame, the agent may be removed while the window is open
+    LevelV1 &m_level;
     std::vector<std::unique_ptr<DebugStateMachineWindow>> m_stateMachineWindows; // State machine debug windows
 };
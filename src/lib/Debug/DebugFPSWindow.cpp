@@ -1,6 +1,7 @@
 #include "DebugFPSWindow.h"
 #include <cute.h>
 #include <imgui.h>
+#include "ShaderRegistry.h"
 
 DebugFPSWindow::DebugFPSWindow(const std::string &title)
     : DebugWindow(title), m_totalFrameTime_ms(0.0), m_lowestFPSLast1000Frames(0.0f)
@@ -76,6 +77,12 @@ void DebugFPSWindow::render()
             }
             ImGui::Unindent();
         }
+        ImGui::Separator();
+
+        // Draw state changes issued through the shader registry this frame
+        const ShaderFrameStats &shaderStats = ShaderRegistry::getFrameStats();
+        ImGui::Text("Shader switches: %d", shaderStats.shaderSwitches);
+        ImGui::Text("Uniform uploads: %d (skipped %d)", shaderStats.uniformUploads, shaderStats.uniformUploadsSkipped);
 
         ImGui::End();
     }
@@ -1,6 +1,6 @@
 #include "DissolveEffect.h"
 
-DissolveEffect::DissolveEffect(CF_Shader shader)
+DissolveEffect::DissolveEffect(ShaderHandle shader)
 	: m_active(false)
 	, m_elapsed(0.0f)
 	, m_totalDuration(1.0f)
@@ -26,7 +26,6 @@ void DissolveEffect::update(float dt)
 	if (m_elapsed >= m_totalDuration) {
 		m_active = false;
 		m_elapsed = m_totalDuration;
-		invokeOnCompleteOnce();
 	}
 }
 
@@ -39,7 +38,7 @@ void DissolveEffect::beginDraw()
 {
 	m_shaderPushed = false;
 	if (!m_active) return;
-	if (m_shader.id == 0) return;
+	if (ShaderRegistry::get(m_shader).id == 0) return;
 
 	// threshold ramps 0..1 over duration
 	float t = (m_totalDuration > 0.0f) ? cf_clamp(m_elapsed / m_totalDuration, 0.0f, 1.0f) : 1.0f;
@@ -49,25 +48,23 @@ void DissolveEffect::beginDraw()
 	CF_Color edgeColor = cf_make_color_rgb(255, 120, 20); // warm edge
 	float edge[3] = { edgeColor.r, edgeColor.g, edgeColor.b };
 
-	cf_draw_push_shader(m_shader);
-	cf_draw_set_uniform("threshold", &threshold, CF_UNIFORM_TYPE_FLOAT, 1);
-	cf_draw_set_uniform("edgeWidth", &edgeWidth, CF_UNIFORM_TYPE_FLOAT, 1);
-	cf_draw_set_uniform("time", &time, CF_UNIFORM_TYPE_FLOAT, 1);
-	cf_draw_set_uniform("edgeColor", edge, CF_UNIFORM_TYPE_FLOAT, 3);
+	static const UniformHandle THRESHOLD_UNIFORM = ShaderRegistry::getUniformHandle("threshold");
+	static const UniformHandle EDGE_WIDTH_UNIFORM = ShaderRegistry::getUniformHandle("edgeWidth");
+	static const UniformHandle TIME_UNIFORM = ShaderRegistry::getUniformHandle("time");
+	static const UniformHandle EDGE_COLOR_UNIFORM = ShaderRegistry::getUniformHandle("edgeColor");
+
+	ShaderRegistry::pushShader(m_shader);
+	ShaderRegistry::setUniform(THRESHOLD_UNIFORM, &threshold, 1);
+	ShaderRegistry::setUniform(EDGE_WIDTH_UNIFORM, &edgeWidth, 1);
+	ShaderRegistry::setUniform(TIME_UNIFORM, &time, 1);
+	ShaderRegistry::setUniform(EDGE_COLOR_UNIFORM, edge, 3);
 	m_shaderPushed = true;
 }
 
 void DissolveEffect::endDraw()
 {
 	if (m_shaderPushed) {
-		cf_draw_pop_shader();
+		ShaderRegistry::popShader();
 		m_shaderPushed = false;
 	}
 }
-
-void DissolveEffect::setOnComplete(std::function<void()> callback)
-{
-	m_onComplete = std::move(callback);
-}
-
-
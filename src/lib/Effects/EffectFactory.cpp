@@ -5,25 +5,59 @@
 #include "DissolveEffect.h"
 #include "ShaderRegistry.h"
 
-std::unique_ptr<IVisualEffect> EffectFactory::makeEffect(const std::string& name)
+// Effect names, indexed by EffectId. Each effect's shader is registered under the same name.
+static const char* EFFECT_NAMES[(int)EffectId::Count] = {"red", "green", "trail", "dissolve"};
+
+EffectId EffectFactory::getEffectId(const std::string& name)
 {
-	if (name == "red")
+	for (int i = 0; i < (int)EffectId::Count; ++i)
 	{
-		return std::unique_ptr<IVisualEffect>(new RedFlashEffect(ShaderRegistry::get("red")));
+		if (name == EFFECT_NAMES[i])
+		{
+			return (EffectId)i;
+		}
 	}
-	if (name == "green")
+	return EffectId::Invalid;
+}
+
+ShaderHandle EffectFactory::getShaderHandle(EffectId id)
+{
+	if (id == EffectId::Invalid || id == EffectId::Count)
 	{
-		return std::unique_ptr<IVisualEffect>(new GreenFlashEffect(ShaderRegistry::get("green")));
+		return INVALID_SHADER_HANDLE;
 	}
-	if (name == "trail")
+
+	// Shader handles are stable, so resolve each effect's shader name only once.
+	static ShaderHandle s_effectShaders[(int)EffectId::Count] = {
+		INVALID_SHADER_HANDLE, INVALID_SHADER_HANDLE, INVALID_SHADER_HANDLE, INVALID_SHADER_HANDLE};
+	ShaderHandle& shader = s_effectShaders[(int)id];
+	if (shader == INVALID_SHADER_HANDLE)
 	{
-		return std::unique_ptr<IVisualEffect>(new TrailGhostEffect(ShaderRegistry::get("trail")));
+		shader = ShaderRegistry::getHandle(EFFECT_NAMES[(int)id]);
 	}
-	if (name == "dissolve")
+	return shader;
+}
+
+std::unique_ptr<IVisualEffect> EffectFactory::makeEffect(EffectId id)
+{
+	ShaderHandle shader = getShaderHandle(id);
+
+	switch (id)
 	{
-		return std::unique_ptr<IVisualEffect>(new DissolveEffect(ShaderRegistry::get("dissolve")));
+	case EffectId::Red:
+		return std::unique_ptr<IVisualEffect>(new RedFlashEffect(shader));
+	case EffectId::Green:
+		return std::unique_ptr<IVisualEffect>(new GreenFlashEffect(shader));
+	case EffectId::Trail:
+		return std::unique_ptr<IVisualEffect>(new TrailGhostEffect(shader));
+	case EffectId::Dissolve:
+		return std::unique_ptr<IVisualEffect>(new DissolveEffect(shader));
+	default:
+		return nullptr;
 	}
-	return nullptr;
 }
 
-
+std::unique_ptr<IVisualEffect> EffectFactory::makeEffect(const std::string& name)
+{
+	return makeEffect(getEffectId(name));
+}
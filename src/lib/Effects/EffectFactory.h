@@ -4,13 +4,30 @@
 #include <memory>
 #include <string>
 #include "IVisualEffect.h"
+#include "ShaderRegistry.h"
+
+// Integer identifiers for the built-in effects. Resolve names once with getEffectId().
+enum class EffectId : int
+{
+	Invalid = -1,
+	Red = 0,
+	Green,
+	Trail,
+	Dissolve,
+	Count
+};
 
 class EffectFactory
 {
 public:
+	// Map an effect name ("red", "green", "trail", "dissolve") to its id.
+	static EffectId getEffectId(const std::string& name);
+
+	// Shader registered for an effect (resolved once, then cached).
+	static ShaderHandle getShaderHandle(EffectId id);
+
+	static std::unique_ptr<IVisualEffect> makeEffect(EffectId id);
 	static std::unique_ptr<IVisualEffect> makeEffect(const std::string& name);
 };
 
 #endif // EFFECT_FACTORY_H
-
-
@@ -0,0 +1,259 @@
+#include "EffectSystem.h"
+#include "RedFlashEffect.h"
+#include "GreenFlashEffect.h"
+#include "TrailGhostEffect.h"
+#include "DissolveEffect.h"
+#include "../Character/AnimatedDataCharacter.h"
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+	struct EffectSlot
+	{
+		uint32_t generation = 0;
+		bool alive = false;
+		bool running = false;
+		AnimatedDataCharacter* owner = nullptr;
+		uint32_t tag = 0;
+	};
+
+	// Flat storage for one concrete effect type. Effects and slot state are parallel arrays.
+	template <typename T>
+	struct EffectPool
+	{
+		std::vector<T> effects;
+		std::vector<EffectSlot> slots;
+		std::vector<uint32_t> freeSlots;
+		size_t liveCount = 0;
+
+		void reserve(size_t capacity)
+		{
+			effects.reserve(capacity);
+			slots.reserve(capacity);
+			freeSlots.reserve(capacity);
+		}
+
+		uint32_t acquire(ShaderHandle shader)
+		{
+			uint32_t index;
+			if (!freeSlots.empty())
+			{
+				index = freeSlots.back();
+				freeSlots.pop_back();
+				effects[index] = T(shader);
+			}
+			else
+			{
+				index = (uint32_t)effects.size();
+				effects.push_back(T(shader));
+				slots.push_back(EffectSlot());
+			}
+
+			EffectSlot& slot = slots[index];
+			slot.generation++;
+			if (slot.generation == 0) slot.generation = 1; // 0 marks an invalid handle
+			slot.alive = true;
+			slot.running = false;
+			liveCount++;
+			return index;
+		}
+
+		void releaseSlot(uint32_t index)
+		{
+			EffectSlot& slot = slots[index];
+			if (!slot.alive) return;
+			slot.alive = false;
+			slot.running = false;
+			slot.owner = nullptr;
+			freeSlots.push_back(index);
+			liveCount--;
+		}
+
+		EffectSlot* find(EffectHandle handle)
+		{
+			if (handle.index >= slots.size()) return nullptr;
+			EffectSlot& slot = slots[handle.index];
+			if (!slot.alive || slot.generation != handle.generation) return nullptr;
+			return &slot;
+		}
+
+		void clear()
+		{
+			effects.clear();
+			slots.clear();
+			freeSlots.clear();
+			liveCount = 0;
+		}
+	};
+
+	EffectPool<RedFlashEffect> s_redPool;
+	EffectPool<GreenFlashEffect> s_greenPool;
+	EffectPool<TrailGhostEffect> s_trailPool;
+	EffectPool<DissolveEffect> s_dissolvePool;
+
+	std::vector<EffectEvent> s_events;      // Raised during the update pass
+	std::vector<EffectEvent> s_dispatching; // Being delivered (owners may raise new events meanwhile)
+
+	// Call func with the pool matching an effect type. Returns false for invalid types.
+	template <typename Func>
+	bool withPool(EffectId type, Func&& func)
+	{
+		switch (type)
+		{
+		case EffectId::Red: func(s_redPool); return true;
+		case EffectId::Green: func(s_greenPool); return true;
+		case EffectId::Trail: func(s_trailPool); return true;
+		case EffectId::Dissolve: func(s_dissolvePool); return true;
+		default: return false;
+		}
+	}
+
+	template <typename T>
+	void updatePool(EffectPool<T>& pool, EffectId type, float dt)
+	{
+		for (uint32_t i = 0; i < (uint32_t)pool.slots.size(); ++i)
+		{
+			EffectSlot& slot = pool.slots[i];
+			if (!slot.alive || !slot.running) continue;
+
+			// Concrete (final) type, so these calls don't go through the vtable.
+			T& effect = pool.effects[i];
+			effect.update(dt);
+			if constexpr (std::is_same_v<T, TrailGhostEffect>)
+			{
+				if (slot.owner) effect.updateSubjectPosition(slot.owner->getPosition());
+			}
+
+			if (!effect.isActive())
+			{
+				slot.running = false;
+				EffectHandle handle;
+				handle.index = i;
+				handle.generation = slot.generation;
+				handle.type = type;
+				s_events.push_back(EffectEvent{handle, slot.owner, slot.tag});
+			}
+		}
+	}
+}
+
+void EffectSystem::initialize(size_t capacityPerType)
+{
+	s_redPool.reserve(capacityPerType);
+	s_greenPool.reserve(capacityPerType);
+	s_trailPool.reserve(capacityPerType);
+	s_dissolvePool.reserve(capacityPerType);
+	s_events.reserve(capacityPerType);
+	s_dispatching.reserve(capacityPerType);
+}
+
+void EffectSystem::shutdown()
+{
+	s_redPool.clear();
+	s_greenPool.clear();
+	s_trailPool.clear();
+	s_dissolvePool.clear();
+	s_events.clear();
+	s_dispatching.clear();
+}
+
+EffectHandle EffectSystem::create(EffectId id, AnimatedDataCharacter* owner, uint32_t tag,
+                                  int flashes, float totalDuration, float maxIntensity, bool startNow)
+{
+	EffectHandle handle;
+	ShaderHandle shader = EffectFactory::getShaderHandle(id);
+	withPool(id, [&](auto& pool)
+	         {
+		uint32_t index = pool.acquire(shader);
+		EffectSlot& slot = pool.slots[index];
+		slot.owner = owner;
+		slot.tag = tag;
+		slot.running = startNow;
+		pool.effects[index].trigger(flashes, totalDuration, maxIntensity);
+
+		handle.index = index;
+		handle.generation = slot.generation;
+		handle.type = id; });
+	return handle;
+}
+
+void EffectSystem::start(EffectHandle handle)
+{
+	withPool(handle.type, [&](auto& pool)
+	         {
+		if (EffectSlot* slot = pool.find(handle)) slot->running = true; });
+}
+
+void EffectSystem::release(EffectHandle handle)
+{
+	withPool(handle.type, [&](auto& pool)
+	         {
+		if (pool.find(handle)) pool.releaseSlot(handle.index); });
+}
+
+void EffectSystem::releaseOwner(AnimatedDataCharacter* owner)
+{
+	if (!owner) return;
+
+	auto releaseFrom = [owner](auto& pool)
+	{
+		if (pool.liveCount == 0) return;
+		for (uint32_t i = 0; i < (uint32_t)pool.slots.size(); ++i)
+		{
+			if (pool.slots[i].alive && pool.slots[i].owner == owner) pool.releaseSlot(i);
+		}
+	};
+	releaseFrom(s_redPool);
+	releaseFrom(s_greenPool);
+	releaseFrom(s_trailPool);
+	releaseFrom(s_dissolvePool);
+}
+
+bool EffectSystem::isAlive(EffectHandle handle)
+{
+	bool alive = false;
+	withPool(handle.type, [&](auto& pool)
+	         { alive = pool.find(handle) != nullptr; });
+	return alive;
+}
+
+IVisualEffect* EffectSystem::get(EffectHandle handle)
+{
+	IVisualEffect* effect = nullptr;
+	withPool(handle.type, [&](auto& pool)
+	         {
+		if (pool.find(handle)) effect = &pool.effects[handle.index]; });
+	return effect;
+}
+
+IGhostTrailEffect* EffectSystem::getGhostTrail(EffectHandle handle)
+{
+	if (handle.type != EffectId::Trail || !s_trailPool.find(handle)) return nullptr;
+	return &s_trailPool.effects[handle.index];
+}
+
+void EffectSystem::update(float dt)
+{
+	updatePool(s_redPool, EffectId::Red, dt);
+	updatePool(s_greenPool, EffectId::Green, dt);
+	updatePool(s_trailPool, EffectId::Trail, dt);
+	updatePool(s_dissolvePool, EffectId::Dissolve, dt);
+
+	// Deliver completion events. Owners usually release the finished effect and start the
+	// next one in their queue; anything they raise now is delivered next update.
+	s_dispatching.swap(s_events);
+	for (const EffectEvent& event : s_dispatching)
+	{
+		if (event.owner && isAlive(event.handle))
+		{
+			event.owner->onEffectFinished(event);
+		}
+	}
+	s_dispatching.clear();
+}
+
+size_t EffectSystem::getLiveCount()
+{
+	return s_redPool.liveCount + s_greenPool.liveCount + s_trailPool.liveCount + s_dissolvePool.liveCount;
+}
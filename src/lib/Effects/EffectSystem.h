@@ -0,0 +1,83 @@
+#ifndef EFFECT_SYSTEM_H
+#define EFFECT_SYSTEM_H
+
+#include <cstddef>
+#include <cstdint>
+#include "EffectFactory.h"
+
+class AnimatedDataCharacter;
+class IVisualEffect;
+class IGhostTrailEffect;
+
+// Lightweight reference to a pooled effect. The generation detects stale handles after the
+// slot has been recycled, so characters can hold these by value.
+struct EffectHandle
+{
+	uint32_t index = 0;
+	uint32_t generation = 0; // 0 = never valid
+	EffectId type = EffectId::Invalid;
+
+	bool isValid() const { return generation != 0 && type != EffectId::Invalid; }
+	// Stable per live effect and grouped by type, 0 for an invalid handle
+	uint64_t getKey() const
+	{
+		return isValid() ? ((static_cast<uint64_t>(type) + 1) << 32) | index : 0;
+	}
+	bool operator==(const EffectHandle& other) const
+	{
+		return index == other.index && generation == other.generation && type == other.type;
+	}
+	bool operator!=(const EffectHandle& other) const { return !(*this == other); }
+};
+
+// Raised when a running effect finishes. Delivered to the owner through
+// AnimatedDataCharacter::onEffectFinished during EffectSystem::update.
+struct EffectEvent
+{
+	EffectHandle handle;
+	AnimatedDataCharacter* owner;
+	uint32_t tag; // Caller-defined value passed to create()
+};
+
+// Level-wide effect system. Each concrete effect type lives in its own typed pool (flat arrays
+// of effects plus slot state) and all running effects are advanced in one pass per pool.
+// Creating an effect reuses a free slot, so steady-state triggers never allocate.
+class EffectSystem
+{
+public:
+	// Reserve pool capacity up front (per effect type).
+	static void initialize(size_t capacityPerType = 64);
+
+	// Drop all effects and pending events.
+	static void shutdown();
+
+	// Create a pooled effect for owner. Effects that don't start immediately wait (frozen)
+	// until start() is called, which is how characters queue effects behind each other.
+	static EffectHandle create(EffectId id, AnimatedDataCharacter* owner, uint32_t tag,
+	                           int flashes, float totalDuration, float maxIntensity, bool startNow);
+
+	// Begin advancing a queued effect.
+	static void start(EffectHandle handle);
+
+	// Return the effect's slot to its pool (no event is raised).
+	static void release(EffectHandle handle);
+
+	// Release every effect owned by a character (call before the character is destroyed).
+	static void releaseOwner(AnimatedDataCharacter* owner);
+
+	// Check if a handle still refers to a live effect.
+	static bool isAlive(EffectHandle handle);
+
+	// Access a live effect for drawing; nullptr if the handle is stale.
+	static IVisualEffect* get(EffectHandle handle);
+	static IGhostTrailEffect* getGhostTrail(EffectHandle handle);
+
+	// Advance all running effects, feed trail effects their owner's position and
+	// deliver completion events to the owners.
+	static void update(float dt);
+
+	// Number of live (queued or running) effects across all pools.
+	static size_t getLiveCount();
+};
+
+#endif // EFFECT_SYSTEM_H
@@ -1,6 +1,7 @@
 #include "GhostTrailRenderer.h"
 #include "../Character/AnimatedDataCharacter.h"
 #include "IGhostTrailEffect.h"
+#include "SpriteDrawBuffer.h"
 #include <cute_draw.h>
 
 using namespace Cute;
@@ -13,32 +14,87 @@ void GhostTrailRenderer::renderGhostsForCharacter(AnimatedDataCharacter& charact
 	int count = ghost->getGhostCount();
 	if (count <= 0) return;
 
-	CF_Shader ghostShader = ghost->getGhostShader();
+	// Every ghost shows the character's current frame, so resolve it once.
+	const AnimationFrame* frame = character.findCurrentAnimationFrame();
+	if (!frame) return;
+
+	// Bind the shader once for the whole trail. Alpha rides in the vertex color and
+	// strength in the vertex attributes, so ghosts don't break the sprite batch.
+	ShaderHandle ghostShader = ghost->getGhostShader();
+	bool pushedShader = false;
+	if (ShaderRegistry::get(ghostShader).id != 0)
+	{
+		ShaderRegistry::pushShader(ghostShader);
+		pushedShader = true;
+	}
+
 	for (int i = 0; i < count; ++i)
 	{
 		v2 gp = ghost->getGhostPosition(i);
 		float a = ghost->getGhostAlpha(i);
 		float strength = ghost->getGhostStrength(i);
 
-		bool pushedShader = false;
-		if (ghostShader.id != 0)
+		// For premultiplied pipeline, scale rgb and a equally.
+		cf_draw_push_color(make_color(a, a, a, a));
+		cf_draw_push_vertex_attributes(strength, 0.0f, 0.0f, 0.0f);
+		cf_draw_push();
+		cf_draw_translate_v2(gp);
+
+		if (!frame->spriteLayers.empty())
 		{
-			cf_draw_push_shader(ghostShader);
-			cf_draw_set_uniform("strength", &strength, CF_UNIFORM_TYPE_FLOAT, 1);
-			pushedShader = true;
+			for (const auto& layerSprite : frame->spriteLayers)
+			{
+				if (layerSprite.w > 0 && layerSprite.h > 0)
+				{
+					cf_draw_sprite(&layerSprite);
+				}
+			}
+		}
+		else if (frame->sprite.w > 0 && frame->sprite.h > 0)
+		{
+			cf_draw_sprite(&frame->sprite);
 		}
-		// For premultiplied pipeline, scale rgb and a equally.
-		CF_Color ghostColor = make_color(a, a, a, a);
-		cf_draw_push_color(ghostColor);
 
-		// Use character's frame rendering helper at a specific world position.
-		cf_draw_push();
-		character.renderCurrentFrameAt(gp);
 		cf_draw_pop();
-
+		cf_draw_pop_vertex_attributes();
 		cf_draw_pop_color();
-		if (pushedShader) cf_draw_pop_shader();
 	}
+
+	if (pushedShader) ShaderRegistry::popShader();
 }
 
+void GhostTrailRenderer::submitGhostsForCharacter(AnimatedDataCharacter& character, SpriteDrawBuffer& buffer)
+{
+	IGhostTrailEffect* ghost = character.getActiveGhostTrailEffect();
+	if (!ghost) return;
 
+	int count = ghost->getGhostCount();
+	if (count <= 0) return;
+
+	const AnimationFrame* frame = character.findCurrentAnimationFrame();
+	if (!frame) return;
+
+	ShaderHandle ghostShader = ghost->getGhostShader();
+	uint32_t layerCount = frame->spriteLayers.empty() ? 1u : static_cast<uint32_t>(frame->spriteLayers.size());
+
+	for (int i = 0; i < count; ++i)
+	{
+		v2 gp = ghost->getGhostPosition(i);
+		float a = ghost->getGhostAlpha(i);
+		float strength = ghost->getGhostStrength(i);
+
+		// Order by ghost, then layer, so the buffer keeps the trail's draw order
+		uint32_t base = static_cast<uint32_t>(i) * layerCount;
+		if (!frame->spriteLayers.empty())
+		{
+			for (uint32_t l = 0; l < layerCount; ++l)
+			{
+				buffer.submitGhost(&frame->spriteLayers[l], gp, base + l, ghostShader, a, strength);
+			}
+		}
+		else
+		{
+			buffer.submitGhost(&frame->sprite, gp, base, ghostShader, a, strength);
+		}
+	}
+}
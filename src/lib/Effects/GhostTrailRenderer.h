@@ -2,11 +2,15 @@
 #define GHOST_TRAIL_RENDERER_H
 
 class AnimatedDataCharacter;
+class SpriteDrawBuffer;
 
 class GhostTrailRenderer
 {
 public:
 	static void renderGhostsForCharacter(AnimatedDataCharacter& character);
+	// Queue the trail into the character's slot of the buffer, behind its sprites.
+	// Call after buffer.beginCharacter for the character.
+	static void submitGhostsForCharacter(AnimatedDataCharacter& character, SpriteDrawBuffer& buffer);
 };
 
 #endif // GHOST_TRAIL_RENDERER_H
@@ -1,7 +1,7 @@
 #include "GreenFlashEffect.h"
 #include <cmath>
 
-GreenFlashEffect::GreenFlashEffect(CF_Shader shader)
+GreenFlashEffect::GreenFlashEffect(ShaderHandle shader)
 	: m_active(false)
 	, m_elapsed(0.0f)
 	, m_flashes(3)
@@ -27,7 +27,6 @@ void GreenFlashEffect::update(float dt)
 	m_elapsed += dt;
 	if (m_elapsed >= m_totalDuration) {
 		m_active = false;
-		invokeOnCompleteOnce();
 	}
 }
 
@@ -53,18 +52,19 @@ void GreenFlashEffect::beginDraw()
 {
 	m_shaderPushed = false;
 	if (!m_active) return;
-	if (m_shader.id == 0) return;
+	if (ShaderRegistry::get(m_shader).id == 0) return;
 	float intensity = computeIntensity();
 	if (intensity <= 0.0f) return;
-	cf_draw_push_shader(m_shader);
-	cf_draw_set_uniform("intensity", &intensity, CF_UNIFORM_TYPE_FLOAT, 1);
+	static const UniformHandle INTENSITY_UNIFORM = ShaderRegistry::getUniformHandle("intensity");
+	ShaderRegistry::pushShader(m_shader);
+	ShaderRegistry::setUniform(INTENSITY_UNIFORM, &intensity, 1);
 	m_shaderPushed = true;
 }
 
 void GreenFlashEffect::endDraw()
 {
 	if (m_shaderPushed) {
-		cf_draw_pop_shader();
+		ShaderRegistry::popShader();
 		m_shaderPushed = false;
 	}
 }
@@ -2,14 +2,15 @@
 #define GREEN_FLASH_EFFECT_H
 
 #include <cute.h>
-#include "VisualEffectBase.h"
+#include "IVisualEffect.h"
+#include "ShaderRegistry.h"
 
 using namespace Cute;
 
-class GreenFlashEffect : public VisualEffectBase
+class GreenFlashEffect final : public IVisualEffect
 {
 public:
-	GreenFlashEffect(CF_Shader shader);
+	GreenFlashEffect(ShaderHandle shader);
 
 	void trigger(int flashes = 3, float totalDuration = 2.0f, float maxIntensity = 0.85f) override;
 	void update(float dt) override;
@@ -25,7 +26,7 @@ private:
 	int m_flashes;
 	float m_totalDuration;
 	float m_maxIntensity;
-	CF_Shader m_shader;
+	ShaderHandle m_shader;
 	bool m_shaderPushed;
 };
 
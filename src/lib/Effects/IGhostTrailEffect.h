@@ -3,6 +3,7 @@
 
 #include <cute.h>
 #include <vector>
+#include "ShaderRegistry.h"
 
 using namespace Cute;
 
@@ -23,11 +24,11 @@ public:
 	// Alpha multiplier [0..1] for the i-th ghost (0 = oldest).
 	virtual float getGhostAlpha(int index) const = 0;
 
-	// Optional shader to use for ghost draws. Can be {0} for none.
-	virtual CF_Shader getGhostShader() const = 0;
+	// Optional shader to use for ghost draws. Can be INVALID_SHADER_HANDLE for none.
+	virtual ShaderHandle getGhostShader() const = 0;
 
 	// Optional per-ghost strength parameter for the ghost shader.
-	// If the shader expects a 'strength' float, return the value here.
+	// Passed to the shader per instance in params.x (vertex attributes).
 	virtual float getGhostStrength(int index) const = 0;
 };
 
@@ -1,8 +1,6 @@
 #ifndef I_VISUAL_EFFECT_H
 #define I_VISUAL_EFFECT_H
 
-#include <functional>
-
 class IVisualEffect
 {
 public:
@@ -11,9 +9,6 @@ public:
 	// Configure and start the effect.
 	virtual void trigger(int flashes, float totalDuration, float maxIntensity) = 0;
 
-	// Optional: called once when the effect completes.
-	virtual void setOnComplete(std::function<void()> callback) = 0;
-
 	// Advance timers.
 	virtual void update(float dt) = 0;
 
@@ -2,14 +2,15 @@
 #define RED_FLASH_EFFECT_H
 
 #include <cute.h>
-#include "VisualEffectBase.h"
+#include "IVisualEffect.h"
+#include "ShaderRegistry.h"
 
 using namespace Cute;
 
-class RedFlashEffect : public VisualEffectBase
+class RedFlashEffect final : public IVisualEffect
 {
 public:
-	RedFlashEffect(CF_Shader shader);
+	RedFlashEffect(ShaderHandle shader);
 
 	// Start a red flashing sequence.
 	void trigger(int flashes = 3, float totalDuration = 2.0f, float maxIntensity = 0.85f) override;
@@ -33,7 +34,7 @@ private:
 	int m_flashes;
 	float m_totalDuration;
 	float m_maxIntensity;
-	CF_Shader m_shader;
+	ShaderHandle m_shader;
 	bool m_shaderPushed;
 };
 
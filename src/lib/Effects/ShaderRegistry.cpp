@@ -1,9 +1,14 @@
 #include "ShaderRegistry.h"
 #include <utility>
 
-std::unordered_map<std::string, CF_Shader> ShaderRegistry::s_shaders;
+std::unordered_map<std::string, ShaderHandle> ShaderRegistry::s_handles;
+std::vector<CF_Shader> ShaderRegistry::s_shaders;
+std::unordered_map<std::string, UniformHandle> ShaderRegistry::s_uniformHandles;
+std::vector<ShaderRegistry::UniformCacheEntry> ShaderRegistry::s_uniforms;
+std::vector<ShaderHandle> ShaderRegistry::s_shaderStack;
+ShaderFrameStats ShaderRegistry::s_frameStats;
 
-void ShaderRegistry::registerAndLoad(const std::string& name, const char* filename)
+ShaderHandle ShaderRegistry::registerAndLoad(const std::string& name, const char* filename)
 {
 	// Compile/load draw shader now and store handle.
 	CF_Shader shader = cf_make_draw_shader(filename);
@@ -12,19 +17,47 @@ void ShaderRegistry::registerAndLoad(const std::string& name, const char* filena
 	} else {
 		printf("ShaderRegistry: Loaded shader '%s' from '%s'\n", name.c_str(), filename);
 	}
-	s_shaders[name] = shader;
+
+	// Re-registering a name reuses its handle so previously resolved handles stay valid.
+	auto it = s_handles.find(name);
+	if (it != s_handles.end()) {
+		s_shaders[it->second] = shader;
+		return it->second;
+	}
+
+	ShaderHandle handle = (ShaderHandle)s_shaders.size();
+	s_shaders.push_back(shader);
+	s_handles[name] = handle;
+	return handle;
 }
 
-CF_Shader ShaderRegistry::get(const std::string& name)
+ShaderHandle ShaderRegistry::getHandle(const std::string& name)
 {
-	auto it = s_shaders.find(name);
-	if (it == s_shaders.end()) return CF_Shader{0};
+	auto it = s_handles.find(name);
+	if (it == s_handles.end()) return INVALID_SHADER_HANDLE;
 	return it->second;
 }
 
+CF_Shader ShaderRegistry::get(ShaderHandle handle)
+{
+	if (handle < 0 || handle >= (int)s_shaders.size()) return CF_Shader{0};
+	return s_shaders[handle];
+}
+
+CF_Shader ShaderRegistry::get(const std::string& name)
+{
+	return get(getHandle(name));
+}
+
 void ShaderRegistry::clear()
 {
-	s_shaders.clear();
+	// Keep the name -> handle table so handles survive a reload; just drop the shaders.
+	for (auto& shader : s_shaders) {
+		shader = CF_Shader{0};
+	}
+	for (auto& uniform : s_uniforms) {
+		uniform.valid = false;
+	}
 }
 
 void ShaderRegistry::registerAndLoadAll()
@@ -35,4 +68,76 @@ void ShaderRegistry::registerAndLoadAll()
 	registerAndLoad("dissolve", "dissolve.shd");
 }
 
+UniformHandle ShaderRegistry::getUniformHandle(const char* name)
+{
+	auto it = s_uniformHandles.find(name);
+	if (it != s_uniformHandles.end()) return it->second;
+
+	UniformHandle handle = (UniformHandle)s_uniforms.size();
+	UniformCacheEntry entry;
+	entry.name = name;
+	s_uniforms.push_back(entry);
+	s_uniformHandles[name] = handle;
+	return handle;
+}
+
+void ShaderRegistry::pushShader(ShaderHandle handle)
+{
+	ShaderHandle previous = s_shaderStack.empty() ? INVALID_SHADER_HANDLE : s_shaderStack.back();
+	s_shaderStack.push_back(handle);
+	if (handle != previous) s_frameStats.shaderSwitches++;
+	cf_draw_push_shader(get(handle));
+}
 
+void ShaderRegistry::popShader()
+{
+	if (s_shaderStack.empty()) {
+		printf("ShaderRegistry: WARNING: popShader called with an empty shader stack\n");
+		return;
+	}
+
+	ShaderHandle popped = s_shaderStack.back();
+	s_shaderStack.pop_back();
+	ShaderHandle current = s_shaderStack.empty() ? INVALID_SHADER_HANDLE : s_shaderStack.back();
+	if (popped != current) s_frameStats.shaderSwitches++;
+	cf_draw_pop_shader();
+}
+
+void ShaderRegistry::setUniform(UniformHandle uniform, const float* values, int count)
+{
+	if (uniform < 0 || uniform >= (int)s_uniforms.size() || !values || count <= 0) return;
+	UniformCacheEntry& entry = s_uniforms[uniform];
+
+	// Uniforms are global draw state in CF, so an unchanged value never needs re-uploading.
+	if (count <= 4 && entry.valid && entry.count == count) {
+		bool same = true;
+		for (int i = 0; i < count; ++i) {
+			if (entry.values[i] != values[i]) { same = false; break; }
+		}
+		if (same) {
+			s_frameStats.uniformUploadsSkipped++;
+			return;
+		}
+	}
+
+	cf_draw_set_uniform(entry.name.c_str(), const_cast<float*>(values), CF_UNIFORM_TYPE_FLOAT, count);
+	s_frameStats.uniformUploads++;
+
+	entry.valid = count <= 4;
+	entry.count = count;
+	for (int i = 0; i < count && i < 4; ++i) entry.values[i] = values[i];
+}
+
+void ShaderRegistry::beginFrame()
+{
+	s_frameStats = ShaderFrameStats();
+	// Don't trust values across frames in case the renderer resets its uniform state.
+	for (auto& uniform : s_uniforms) {
+		uniform.valid = false;
+	}
+}
+
+const ShaderFrameStats& ShaderRegistry::getFrameStats()
+{
+	return s_frameStats;
+}
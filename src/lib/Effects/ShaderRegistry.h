@@ -4,21 +4,65 @@
 #include <cute.h>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 using namespace Cute;
 
+// Integer handle for a registered shader. Handles are indices into the registry and stay
+// valid across clear()/re-registration, so callers can resolve them once and keep them.
+typedef int ShaderHandle;
+static const ShaderHandle INVALID_SHADER_HANDLE = -1;
+
+// Integer handle for a uniform name, resolved once with getUniformHandle().
+typedef int UniformHandle;
+
+// Per-frame draw state counters.
+struct ShaderFrameStats
+{
+	int shaderSwitches = 0;        // Pushes/pops that changed the active shader
+	int uniformUploads = 0;        // cf_draw_set_uniform calls issued
+	int uniformUploadsSkipped = 0; // Uniform sets dropped because the value was unchanged
+};
+
 class ShaderRegistry
 {
 public:
-	static void registerAndLoad(const std::string& name, const char* filename);
+	static ShaderHandle registerAndLoad(const std::string& name, const char* filename);
+	static ShaderHandle getHandle(const std::string& name);
+	static CF_Shader get(ShaderHandle handle);
 	static CF_Shader get(const std::string& name);
 	static void clear();
 	static void registerAndLoadAll();
 
+	// Intern a uniform name (call once and keep the handle).
+	static UniformHandle getUniformHandle(const char* name);
+
+	// Shader stack wrappers around cf_draw_push_shader/cf_draw_pop_shader that keep stats.
+	static void pushShader(ShaderHandle handle);
+	static void popShader();
+
+	// Set a float uniform (count 1..4), skipping the upload if the cached value matches.
+	static void setUniform(UniformHandle uniform, const float* values, int count);
+
+	// Reset the frame stats and forget cached uniform values (call at the start of each frame).
+	static void beginFrame();
+	static const ShaderFrameStats& getFrameStats();
+
 private:
-	static std::unordered_map<std::string, CF_Shader> s_shaders;
+	struct UniformCacheEntry
+	{
+		std::string name;
+		float values[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+		int count = 0;
+		bool valid = false;
+	};
+
+	static std::unordered_map<std::string, ShaderHandle> s_handles;
+	static std::vector<CF_Shader> s_shaders;
+	static std::unordered_map<std::string, UniformHandle> s_uniformHandles;
+	static std::vector<UniformCacheEntry> s_uniforms;
+	static std::vector<ShaderHandle> s_shaderStack;
+	static ShaderFrameStats s_frameStats;
 };
 
 #endif // SHADER_REGISTRY_H
-
-
@@ -1,7 +1,8 @@
 #include "TrailGhostEffect.h"
 #include <algorithm>
+#include <cmath>
 
-TrailGhostEffect::TrailGhostEffect(CF_Shader ghostShader)
+TrailGhostEffect::TrailGhostEffect(ShaderHandle ghostShader)
 	: m_active(false)
 	, m_elapsed(0.0f)
 	, m_totalDuration(1.0f)
@@ -12,6 +13,8 @@ TrailGhostEffect::TrailGhostEffect(CF_Shader ghostShader)
 	, m_alphaDecay(0.78f)
 	, m_strengthDecay(0.85f)
 	, m_ghostShader(ghostShader)
+	, m_head(0)
+	, m_count(0)
 	, m_lastPushed(cf_v2(0.0f, 0.0f))
 	, m_hasLast(false)
 {
@@ -23,11 +26,12 @@ void TrailGhostEffect::trigger(int flashes, float totalDuration, float maxIntens
 	// flashes -> desired ghost count
 	// totalDuration -> how long the effect persists
 	// maxIntensity -> base alpha
-	m_maxGhosts = std::max(1, flashes);
+	m_maxGhosts = std::clamp(flashes, 1, MAX_GHOST_CAPACITY);
 	m_totalDuration = std::max(0.1f, totalDuration);
 	m_baseAlpha = cf_clamp(maxIntensity, 0.05f, 1.0f);
 
-	m_positions.clear();
+	m_head = 0;
+	m_count = 0;
 	m_elapsed = 0.0f;
 	m_recordTimer = 0.0f;
 	m_active = true;
@@ -40,8 +44,8 @@ void TrailGhostEffect::update(float dt)
 	m_elapsed += dt;
 	if (m_elapsed >= m_totalDuration) {
 		m_active = false;
-		m_positions.clear();
-		invokeOnCompleteOnce();
+		m_head = 0;
+		m_count = 0;
 		return;
 	}
 	// Position sampling is performed via updateSubjectPosition, called externally.
@@ -73,51 +77,51 @@ void TrailGhostEffect::updateSubjectPosition(v2 position)
 	m_recordTimer = m_recordInterval;
 
 	if (!m_hasLast || cf_len(cf_v2(position.x - m_lastPushed.x, position.y - m_lastPushed.y)) > 0.1f) {
-		// Push newest to back, oldest at front. Cap size.
-		m_positions.push_back(position);
+		// Write newest after the current tail; once full, drop the oldest by advancing the head.
+		m_positions[(m_head + m_count) % MAX_GHOST_CAPACITY] = position;
+		if (m_count < m_maxGhosts) {
+			m_count++;
+		} else {
+			m_head = (m_head + 1) % MAX_GHOST_CAPACITY;
+		}
 		m_lastPushed = position;
 		m_hasLast = true;
-		while ((int)m_positions.size() > m_maxGhosts) {
-			m_positions.pop_front();
-		}
 	}
 }
 
 int TrailGhostEffect::getGhostCount() const
 {
-	return (int)m_positions.size();
+	return m_count;
 }
 
 v2 TrailGhostEffect::getGhostPosition(int index) const
 {
-	if (index < 0 || index >= (int)m_positions.size()) return cf_v2(0.0f, 0.0f);
-	return m_positions[index];
+	if (index < 0 || index >= m_count) return cf_v2(0.0f, 0.0f);
+	return m_positions[(m_head + index) % MAX_GHOST_CAPACITY];
 }
 
 float TrailGhostEffect::getGhostAlpha(int index) const
 {
 	// Oldest at index 0 -> lowest alpha; newest at back -> higher alpha.
-	int n = (int)m_positions.size();
+	int n = m_count;
 	if (n == 0) return 0.0f;
 	// Map index 0..n-1 to depth 0..n-1 from oldest to newest
 	int depthFromNewest = (n - 1) - index;
-	float falloff = 1.0f;
-	for (int i = 0; i < depthFromNewest + 1; ++i) falloff *= m_alphaDecay;
+	float falloff = powf(m_alphaDecay, (float)(depthFromNewest + 1));
 	return cf_clamp(m_baseAlpha * falloff, 0.0f, 1.0f);
 }
 
-CF_Shader TrailGhostEffect::getGhostShader() const
+ShaderHandle TrailGhostEffect::getGhostShader() const
 {
 	return m_ghostShader;
 }
 
 float TrailGhostEffect::getGhostStrength(int index) const
 {
-	int n = (int)m_positions.size();
+	int n = m_count;
 	if (n == 0) return 0.0f;
 	int depthFromNewest = (n - 1) - index;
-	float strength = 1.0f;
-	for (int i = 0; i < depthFromNewest + 1; ++i) strength *= m_strengthDecay;
+	float strength = powf(m_strengthDecay, (float)(depthFromNewest + 1));
 	return cf_clamp(strength, 0.0f, 1.0f);
 }
 
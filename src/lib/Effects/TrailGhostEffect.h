@@ -1,14 +1,13 @@
 #ifndef TRAIL_GHOST_EFFECT_H
 #define TRAIL_GHOST_EFFECT_H
 
-#include "VisualEffectBase.h"
+#include "IVisualEffect.h"
 #include "IGhostTrailEffect.h"
-#include <deque>
 
-class TrailGhostEffect : public VisualEffectBase, public IGhostTrailEffect
+class TrailGhostEffect final : public IVisualEffect, public IGhostTrailEffect
 {
 public:
-	explicit TrailGhostEffect(CF_Shader ghostShader);
+	explicit TrailGhostEffect(ShaderHandle ghostShader);
 
 	// IVisualEffect
 	void trigger(int flashes, float totalDuration, float maxIntensity) override;
@@ -22,7 +21,7 @@ public:
 	int getGhostCount() const override;
 	v2 getGhostPosition(int index) const override;
 	float getGhostAlpha(int index) const override;
-	CF_Shader getGhostShader() const override;
+	ShaderHandle getGhostShader() const override;
 	float getGhostStrength(int index) const override;
 
 private:
@@ -36,8 +35,13 @@ private:
 	float m_alphaDecay;       // per-ghost alpha falloff
 	float m_strengthDecay;    // per-ghost shader strength falloff
 
-	CF_Shader m_ghostShader;
-	std::deque<v2> m_positions; // oldest at front, newest at back
+	// Fixed ring buffer of sampled positions; m_head is the oldest, indices wrap at capacity
+	static constexpr int MAX_GHOST_CAPACITY = 32;
+
+	ShaderHandle m_ghostShader;
+	v2 m_positions[MAX_GHOST_CAPACITY];
+	int m_head;
+	int m_count;
 	v2 m_lastPushed;
 	bool m_hasLast;
 };
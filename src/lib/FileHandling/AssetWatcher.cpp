@@ -0,0 +1,233 @@
+#include "AssetWatcher.h"
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+AssetWatcher::AssetWatcher() : inotifyFd(-1), debounceDelay(150)
+{
+}
+
+AssetWatcher::~AssetWatcher()
+{
+    stop();
+}
+
+bool AssetWatcher::start(const std::string &directory, const std::string &mountPoint)
+{
+    stop();
+
+#ifdef __linux__
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error))
+    {
+        printf("AssetWatcher: '%s' is not a directory\n", directory.c_str());
+        return false;
+    }
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0)
+    {
+        printf("AssetWatcher: inotify_init1 failed (errno %d)\n", errno);
+        return false;
+    }
+
+    rootDirectory = directory;
+    while (rootDirectory.size() > 1 && rootDirectory.back() == '/')
+    {
+        rootDirectory.pop_back();
+    }
+    this->mountPoint = mountPoint;
+
+    watchDirectoryTree("");
+    if (watchedDirectories.empty())
+    {
+        stop();
+        return false;
+    }
+
+    printf("AssetWatcher: Watching '%s' as '%s' (%zu directories)\n", rootDirectory.c_str(), mountPoint.c_str(),
+           watchedDirectories.size());
+    return true;
+#else
+    (void)directory;
+    (void)mountPoint;
+    printf("AssetWatcher: File watching is only supported on Linux\n");
+    return false;
+#endif
+}
+
+void AssetWatcher::stop()
+{
+#ifdef __linux__
+    if (inotifyFd >= 0)
+    {
+        // Closing the descriptor removes all of its watches
+        close(inotifyFd);
+    }
+#endif
+    inotifyFd = -1;
+    watchedDirectories.clear();
+    pendingChanges.clear();
+}
+
+void AssetWatcher::ignoreDirectory(const std::string &relativeDirectory)
+{
+    ignoredDirectories.insert(relativeDirectory);
+}
+
+bool AssetWatcher::isIgnored(const std::string &relativePath) const
+{
+    for (const std::string &directory : ignoredDirectories)
+    {
+        if (relativePath.compare(0, directory.size(), directory) == 0 &&
+            (relativePath.size() == directory.size() || relativePath[directory.size()] == '/'))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AssetWatcher::watchDirectoryTree(const std::string &relativeDirectory)
+{
+#ifdef __linux__
+    if (isIgnored(relativeDirectory))
+    {
+        return;
+    }
+
+    std::string directory = relativeDirectory.empty() ? rootDirectory : rootDirectory + "/" + relativeDirectory;
+
+    // Writes are seen once complete, renames cover editors that save through a temporary file
+    uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE_SELF | IN_ONLYDIR;
+    int watch = inotify_add_watch(inotifyFd, directory.c_str(), mask);
+    if (watch < 0)
+    {
+        printf("AssetWatcher: Failed to watch '%s' (errno %d)\n", directory.c_str(), errno);
+        return;
+    }
+    watchedDirectories[watch] = relativeDirectory;
+
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if (entry.is_directory(error))
+        {
+            std::string name = entry.path().filename().string();
+            watchDirectoryTree(relativeDirectory.empty() ? name : relativeDirectory + "/" + name);
+        }
+    }
+#else
+    (void)relativeDirectory;
+#endif
+}
+
+void AssetWatcher::readEvents()
+{
+#ifdef __linux__
+    alignas(inotify_event) char buffer[16 * 1024];
+    auto now = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            // EAGAIN: queue drained
+            return;
+        }
+
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            auto it = watchedDirectories.find(event->wd);
+            if (it == watchedDirectories.end())
+            {
+                continue;
+            }
+
+            if (event->mask & (IN_DELETE_SELF | IN_IGNORED))
+            {
+                watchedDirectories.erase(it);
+                continue;
+            }
+
+            if (event->len == 0)
+            {
+                continue;
+            }
+
+            std::string relativePath = it->second.empty() ? std::string(event->name) : it->second + "/" + event->name;
+            if (isIgnored(relativePath))
+            {
+                continue;
+            }
+
+            if (event->mask & IN_ISDIR)
+            {
+                // Created or moved in directories are watched too; files that landed in them before
+                // the watch was added are reported as changed
+                if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                {
+                    watchDirectoryTree(relativePath);
+
+                    std::error_code error;
+                    for (const auto &entry : std::filesystem::recursive_directory_iterator(rootDirectory + "/" + relativePath, error))
+                    {
+                        if (entry.is_regular_file(error))
+                        {
+                            std::string path = entry.path().lexically_relative(rootDirectory).generic_string();
+                            if (!isIgnored(path))
+                            {
+                                pendingChanges[mountPoint + "/" + path] = now;
+                            }
+                        }
+                    }
+                }
+                continue;
+            }
+
+            // IN_CREATE alone is followed by IN_CLOSE_WRITE once the file is written
+            if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+            {
+                pendingChanges[mountPoint + "/" + relativePath] = now;
+            }
+        }
+    }
+#endif
+}
+
+size_t AssetWatcher::poll(std::vector<std::string> &changedPaths)
+{
+    if (inotifyFd < 0)
+    {
+        return 0;
+    }
+
+    readEvents();
+
+    size_t count = 0;
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = pendingChanges.begin(); it != pendingChanges.end();)
+    {
+        if (now - it->second >= debounceDelay)
+        {
+            changedPaths.push_back(it->first);
+            count++;
+            it = pendingChanges.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return count;
+}
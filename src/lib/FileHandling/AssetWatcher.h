@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Watches the mounted content directory for modified files (inotify, Linux only)
+// Changes are reported as VFS paths under the mount point ("/assets/DataFiles/..."), once the
+// file has been quiet for the debounce delay so editors that write in several steps are seen once.
+// New subdirectories are watched as they appear. On other platforms start() returns false.
+class AssetWatcher
+{
+private:
+    int inotifyFd;
+    std::string rootDirectory; // Real directory being watched (no trailing slash)
+    std::string mountPoint;    // VFS mount point of rootDirectory ("/assets")
+
+    // Watch descriptor -> directory relative to rootDirectory ("" for the root)
+    std::map<int, std::string> watchedDirectories;
+
+    // Changed VFS paths waiting for the debounce delay, with the time of their last event
+    std::map<std::string, std::chrono::steady_clock::time_point> pendingChanges;
+    std::chrono::milliseconds debounceDelay;
+
+    // Directories (relative to rootDirectory) whose changes are never reported
+    std::set<std::string> ignoredDirectories;
+
+    // Add watches for a directory and all of its subdirectories
+    void watchDirectoryTree(const std::string &relativeDirectory);
+
+    // Read all queued inotify events into pendingChanges
+    void readEvents();
+
+    bool isIgnored(const std::string &relativePath) const;
+
+public:
+    AssetWatcher();
+    ~AssetWatcher();
+
+    AssetWatcher(const AssetWatcher &) = delete;
+    AssetWatcher &operator=(const AssetWatcher &) = delete;
+
+    // Start watching a real directory mounted at mountPoint
+    // Returns false if watching is unsupported or the directory cannot be watched
+    bool start(const std::string &directory, const std::string &mountPoint);
+
+    // Stop watching and drop pending changes
+    void stop();
+
+    bool isWatching() const { return inotifyFd >= 0; }
+
+    // Never report changes under a directory relative to the watched root (e.g. generated caches)
+    void ignoreDirectory(const std::string &relativeDirectory);
+
+    // Set how long a file must be quiet before its change is reported (default 150 ms)
+    void setDebounceDelay(std::chrono::milliseconds delay) { debounceDelay = delay; }
+
+    // Collect the files whose changes settled since the last poll (non-blocking)
+    // Returns the number of paths appended to changedPaths
+    size_t poll(std::vector<std::string> &changedPaths);
+};
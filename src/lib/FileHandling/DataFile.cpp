@@ -1,6 +1,13 @@
 #include "DataFile.h"
+#include "Utils.h"
 #include <fstream>
 #include <cute.h>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 // Constructor with path
 DataFile::DataFile(const std::string &path) : path(path)
@@ -8,40 +15,178 @@ DataFile::DataFile(const std::string &path) : path(path)
     load(path);
 }
 
+namespace
+{
+    // Sidecar header, followed by the MessagePack encoded document
+    struct BinaryCacheHeader
+    {
+        char magic[4]; // "YDFC"
+        uint32_t version;
+        uint64_t sourceModifiedTime;
+        uint64_t sourceSize;
+    };
+
+    // Bump whenever the sidecar layout changes, old sidecars are then rewritten
+    const uint32_t BINARY_CACHE_VERSION = 1;
+
+    struct CachedDocument
+    {
+        uint64_t sourceModifiedTime;
+        uint64_t sourceSize;
+        std::shared_ptr<const nlohmann::json> document;
+    };
+
+    std::atomic<bool> s_binaryCacheEnabled{false};
+
+    // OS path mounted at DATA_FILE_CACHE_MOUNT, sidecars are written there directly
+    std::mutex s_binaryCacheDirectoryMutex;
+    std::string s_binaryCacheDirectory;
+    std::atomic<bool> s_documentCacheEnabled{false};
+
+    std::mutex s_documentMutex;
+    std::unordered_map<std::string, CachedDocument> s_documents;
+
+    std::atomic<size_t> s_documentCacheHits{0};
+    std::atomic<size_t> s_binaryCacheHits{0};
+    std::atomic<size_t> s_textParses{0};
+
+    // Read a whole file through the VFS (false if missing or empty)
+    bool readFile(const std::string &path, std::vector<uint8_t> &bytes)
+    {
+        size_t file_size = 0;
+        void *file_data = cf_fs_read_entire_file_to_memory(path.c_str(), &file_size);
+        if (file_data == nullptr || file_size == 0)
+        {
+            if (file_data)
+                cf_free(file_data);
+            return false;
+        }
+
+        bytes.assign(static_cast<uint8_t *>(file_data), static_cast<uint8_t *>(file_data) + file_size);
+        cf_free(file_data);
+        return true;
+    }
+
+    bool hasBinaryCacheDirectory()
+    {
+        std::lock_guard<std::mutex> lock(s_binaryCacheDirectoryMutex);
+        return !s_binaryCacheDirectory.empty();
+    }
+
+    // OS path of a sidecar under the cache directory (empty if no directory is set)
+    // The VFS write directory is the asset tree (DataFile::save), so sidecars bypass it
+    std::string getBinaryCacheFilePath(const std::string &cachePath)
+    {
+        std::lock_guard<std::mutex> lock(s_binaryCacheDirectoryMutex);
+        if (s_binaryCacheDirectory.empty() || cachePath.empty())
+        {
+            return std::string();
+        }
+        return s_binaryCacheDirectory + cachePath.substr(strlen(DATA_FILE_CACHE_MOUNT));
+    }
+
+    // Write a sidecar into the cache directory, creating its directory first
+    void writeBinaryCache(const std::string &cachePath, const std::vector<uint8_t> &bytes)
+    {
+        std::string filePath = getBinaryCacheFilePath(cachePath);
+        if (filePath.empty())
+        {
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(filePath).parent_path(), error);
+
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size())))
+        {
+            printf("DataFile: Failed to write binary cache '%s'\n", filePath.c_str());
+        }
+    }
+}
+
 // Load JSON from file
 bool DataFile::load(const std::string &path)
 {
-    // Read the entire file using Cute Framework's VFS
-    size_t file_size = 0;
-    void *file_data = cf_fs_read_entire_file_to_memory(path.c_str(), &file_size);
-
-    if (file_data == nullptr || file_size == 0)
-        return false;
+    // The source's modification time and size validate both caches
+    CF_Stat stat;
+    bool hasStat = !Cute::is_error(cf_fs_stat(path.c_str(), &stat));
+    bool useDocumentCache = hasStat && s_documentCacheEnabled.load();
+    bool useBinaryCache = hasStat && s_binaryCacheEnabled.load() && hasBinaryCacheDirectory();
 
-    try
+    if (useDocumentCache)
     {
-        // Convert the raw data to a string and parse as JSON
-        std::string json_string(static_cast<char *>(file_data), file_size);
-        nlohmann::json::operator=(nlohmann::json::parse(json_string));
+        std::shared_ptr<const nlohmann::json> cached;
+        {
+            std::lock_guard<std::mutex> lock(s_documentMutex);
+            auto it = s_documents.find(path);
+            if (it != s_documents.end() && it->second.sourceModifiedTime == stat.last_modified_time &&
+                it->second.sourceSize == stat.size)
+            {
+                cached = it->second.document;
+            }
+        }
 
-        // Store the path after successful loading
-        this->path = path;
+        if (cached)
+        {
+            nlohmann::json::operator=(*cached);
+            this->path = path;
+            s_documentCacheHits++;
+            return true;
+        }
     }
-    catch (const nlohmann::json::parse_error &e)
+
+    nlohmann::json document;
+    bool loaded = false;
+
+    std::string cachePath = useBinaryCache ? getBinaryCachePath(path) : std::string();
+    if (!cachePath.empty())
     {
-        // Free memory and return false on parse error
-        cf_free(file_data);
-        return false;
+        std::vector<uint8_t> bytes;
+        if (readFile(cachePath, bytes) &&
+            decodeBinaryCache(bytes.data(), bytes.size(), stat.last_modified_time, stat.size, document))
+        {
+            loaded = true;
+            s_binaryCacheHits++;
+        }
     }
-    catch (...)
+
+    if (!loaded)
     {
-        // Free memory and return false on any other error
-        cf_free(file_data);
-        return false;
+        // Read the entire file using Cute Framework's VFS
+        std::vector<uint8_t> bytes;
+        if (!readFile(path, bytes))
+            return false;
+
+        try
+        {
+            // Parse the raw data as JSON
+            document = nlohmann::json::parse(bytes.begin(), bytes.end());
+            s_textParses++;
+        }
+        catch (...)
+        {
+            // Return false on parse or any other error
+            return false;
+        }
+
+        if (!cachePath.empty())
+        {
+            writeBinaryCache(cachePath, encodeBinaryCache(document, stat.last_modified_time, stat.size));
+        }
+    }
+
+    if (useDocumentCache)
+    {
+        auto shared = std::make_shared<const nlohmann::json>(document);
+        std::lock_guard<std::mutex> lock(s_documentMutex);
+        s_documents[path] = CachedDocument{stat.last_modified_time, stat.size, std::move(shared)};
     }
 
-    // Free the memory allocated by cf_fs_read_entire_file_to_memory
-    cf_free(file_data);
+    nlohmann::json::operator=(std::move(document));
+
+    // Store the path after successful loading
+    this->path = path;
     return true;
 }
 
@@ -112,4 +257,149 @@ const std::string &DataFile::getpath() const
 void DataFile::setpath(const std::string &path)
 {
     this->path = path;
-}
\ No newline at end of file
+}
+
+// Binary sidecar cache
+void DataFile::setBinaryCacheEnabled(bool enabled)
+{
+    s_binaryCacheEnabled.store(enabled);
+}
+
+bool DataFile::isBinaryCacheEnabled()
+{
+    return s_binaryCacheEnabled.load();
+}
+
+bool DataFile::setBinaryCacheDirectory(const std::string &directory)
+{
+    std::string path = directory;
+    while (path.size() > 1 && (path.back() == '/' || path.back() == '\\'))
+    {
+        path.pop_back();
+    }
+
+    CF_Result result = cf_fs_mount(path.c_str(), DATA_FILE_CACHE_MOUNT, true);
+    if (path.empty() || Cute::is_error(result))
+    {
+        printf("DataFile: Failed to mount binary cache directory '%s'\n", directory.c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(s_binaryCacheDirectoryMutex);
+    s_binaryCacheDirectory = path;
+    return true;
+}
+
+std::string DataFile::getBinaryCachePath(const std::string &path)
+{
+    if (!path.starts_with("/assets/"))
+    {
+        return std::string();
+    }
+    return std::string(DATA_FILE_CACHE_MOUNT "/") + DATA_FILE_CACHE_DIRECTORY + "/" + path.substr(8) + ".ydfc";
+}
+
+std::vector<uint8_t> DataFile::encodeBinaryCache(const nlohmann::json &document, uint64_t sourceModifiedTime, uint64_t sourceSize)
+{
+    BinaryCacheHeader header;
+    memcpy(header.magic, "YDFC", 4);
+    header.version = BINARY_CACHE_VERSION;
+    header.sourceModifiedTime = sourceModifiedTime;
+    header.sourceSize = sourceSize;
+
+    std::vector<uint8_t> bytes(sizeof(header));
+    memcpy(bytes.data(), &header, sizeof(header));
+    nlohmann::json::to_msgpack(document, bytes);
+    return bytes;
+}
+
+bool DataFile::decodeBinaryCache(const uint8_t *data, size_t size, uint64_t sourceModifiedTime, uint64_t sourceSize,
+                                 nlohmann::json &document)
+{
+    if (data == nullptr || size <= sizeof(BinaryCacheHeader))
+    {
+        return false;
+    }
+
+    BinaryCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, "YDFC", 4) != 0 || header.version != BINARY_CACHE_VERSION ||
+        header.sourceModifiedTime != sourceModifiedTime || header.sourceSize != sourceSize)
+    {
+        return false;
+    }
+
+    try
+    {
+        document = nlohmann::json::from_msgpack(data + sizeof(header), data + size);
+    }
+    catch (...)
+    {
+        return false;
+    }
+    return true;
+}
+
+// Document cache
+void DataFile::setDocumentCacheEnabled(bool enabled)
+{
+    s_documentCacheEnabled.store(enabled);
+    if (!enabled)
+    {
+        clearDocumentCache();
+    }
+}
+
+bool DataFile::isDocumentCacheEnabled()
+{
+    return s_documentCacheEnabled.load();
+}
+
+void DataFile::clearDocumentCache()
+{
+    std::lock_guard<std::mutex> lock(s_documentMutex);
+    s_documents.clear();
+}
+
+void DataFile::invalidateCachedDocument(const std::string &path)
+{
+    std::string relativePath = normalize_virtual_path(path);
+
+    {
+        std::lock_guard<std::mutex> lock(s_documentMutex);
+        for (auto it = s_documents.begin(); it != s_documents.end();)
+        {
+            if (normalize_virtual_path(it->first) == relativePath)
+            {
+                it = s_documents.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // Sidecars live outside the VFS write directory, remove them like writeBinaryCache writes them
+    std::string filePath = getBinaryCacheFilePath(getBinaryCachePath("/" + relativePath));
+    if (!filePath.empty())
+    {
+        std::error_code error;
+        std::filesystem::remove(filePath, error);
+    }
+}
+
+size_t DataFile::getDocumentCacheHits()
+{
+    return s_documentCacheHits.load();
+}
+
+size_t DataFile::getBinaryCacheHits()
+{
+    return s_binaryCacheHits.load();
+}
+
+size_t DataFile::getTextParseCount()
+{
+    return s_textParses.load();
+}
@@ -1,7 +1,15 @@
 #pragma once
 
 #include <nlohmann/json.hpp>
+#include <cstdint>
 #include <string>
+#include <vector>
+
+// VFS mount point of the binary sidecar directory (see DataFile::setBinaryCacheDirectory)
+#define DATA_FILE_CACHE_MOUNT "/cache"
+
+// Directory (under the sidecar mount) holding the binary sidecars of loaded JSON files
+#define DATA_FILE_CACHE_DIRECTORY "DataCache"
 
 class DataFile : public nlohmann::json
 {
@@ -13,6 +21,9 @@ public:
     DataFile(const std::string &path);
 
     // Load JSON from file
+    // With the document cache enabled, a file that did not change since it was last loaded is
+    // copied from memory; with the binary cache enabled, a current MessagePack sidecar is decoded
+    // instead of parsing the text, and a missing or stale sidecar is written after parsing
     bool load(const std::string &path);
     bool load(); // Load from stored path
 
@@ -23,4 +34,38 @@ public:
     // Get/Set path
     const std::string &getpath() const;
     void setpath(const std::string &path);
+
+    // Binary sidecar cache ("/assets/x.json" -> "/cache/DataCache/x.json.ydfc", off by default)
+    // Sidecars are validated against the source file's modification time and size
+    static void setBinaryCacheEnabled(bool enabled);
+    static bool isBinaryCacheEnabled();
+
+    // Mount an OS directory (e.g. the user directory) at DATA_FILE_CACHE_MOUNT to hold the sidecars
+    // Sidecars are neither read nor written until a directory is set; call before loading files
+    static bool setBinaryCacheDirectory(const std::string &directory);
+
+    // Process-wide cache of parsed documents, validated like the sidecars (off by default)
+    // Repeated loads of the same file (items, states, entity data) skip parsing entirely
+    static void setDocumentCacheEnabled(bool enabled);
+    static bool isDocumentCacheEnabled();
+    static void clearDocumentCache();
+
+    // Forget a file's cached document and sidecar ("/assets/x" and "assets/x" are the same file)
+    // Used when a file is known to have changed, e.g. rewritten within the same second at the same size
+    static void invalidateCachedDocument(const std::string &path);
+
+    // Cache statistics
+    static size_t getDocumentCacheHits();
+    static size_t getBinaryCacheHits();
+    static size_t getTextParseCount();
+
+    // Sidecar encoding: header (magic, version, source mtime and size) followed by MessagePack
+    static std::vector<uint8_t> encodeBinaryCache(const nlohmann::json &document, uint64_t sourceModifiedTime, uint64_t sourceSize);
+
+    // Decode a sidecar, returns false if it is malformed or was written for a different source
+    static bool decodeBinaryCache(const uint8_t *data, size_t size, uint64_t sourceModifiedTime, uint64_t sourceSize,
+                                  nlohmann::json &document);
+
+    // Get the sidecar path for a source path (empty if the source is not under "/assets/")
+    static std::string getBinaryCachePath(const std::string &path);
 };
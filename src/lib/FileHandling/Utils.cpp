@@ -8,11 +8,23 @@
 // #include <cute_file_system.h>
 using namespace Cute;
 
-void mount_content_directory_as(const char *dir)
+std::string get_content_directory_path()
 {
     CF_Path path = fs_get_base_directory();
     path.normalize();
     path += "/assets";
+    return path.c_str();
+}
+
+std::string normalize_virtual_path(const std::string &path)
+{
+    size_t start = path.find_first_not_of('/');
+    return start == std::string::npos ? std::string() : path.substr(start);
+}
+
+void mount_content_directory_as(const char *dir)
+{
+    std::string path = get_content_directory_path();
 
     // Mount the assets directory for reading
     CF_Result mount_result = fs_mount(path.c_str(), dir);
@@ -6,6 +6,12 @@
 
 void mount_content_directory_as(const char *dir);
 
+// Real (OS) path of the content directory mounted by mount_content_directory_as
+std::string get_content_directory_path();
+
+// Strip leading '/' so "/assets/x" and "assets/x" name the same VFS file
+std::string normalize_virtual_path(const std::string &path);
+
 // JSON utility function
 nlohmann::json ReadJson(const std::string &file_path);
 DataFile ReadDataFile(const std::string &file_path);
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "JobGraph.h"
+#include "JobSystem.h"
+#include <stdio.h>
+#include <exception>
+
+JobGraph::TaskId JobGraph::addTask(const std::string &name, std::function<void()> work, const std::vector<TaskId> &dependencies)
+{
+    return add(name, std::move(work), dependencies, false);
+}
+
+JobGraph::TaskId JobGraph::addMainThreadTask(const std::string &name, std::function<void()> work, const std::vector<TaskId> &dependencies)
+{
+    return add(name, std::move(work), dependencies, true);
+}
+
+JobGraph::TaskId JobGraph::add(const std::string &name, std::function<void()> work, const std::vector<TaskId> &dependencies, bool mainThread)
+{
+    TaskId id = static_cast<TaskId>(tasks.size());
+
+    Task task;
+    task.name = name;
+    task.work = std::move(work);
+    task.mainThread = mainThread;
+    task.dependencyCount = 0;
+    task.pendingDependencies = 0;
+
+    // Only earlier tasks can be dependencies, so the graph can never contain a cycle
+    for (TaskId dependency : dependencies)
+    {
+        if (dependency < 0 || dependency >= id)
+        {
+            printf("JobGraph: Task '%s' has invalid dependency %d, ignoring it\n", name.c_str(), dependency);
+            continue;
+        }
+        tasks[dependency].dependents.push_back(id);
+        task.dependencyCount++;
+    }
+
+    tasks.push_back(std::move(task));
+    return id;
+}
+
+void JobGraph::execute(TaskId id)
+{
+    Task &task = tasks[id];
+    if (!task.work)
+    {
+        return;
+    }
+
+    try
+    {
+        task.work();
+    }
+    catch (const std::exception &e)
+    {
+        printf("JobGraph: Task '%s' threw: %s\n", task.name.c_str(), e.what());
+    }
+    catch (...)
+    {
+        printf("JobGraph: Task '%s' threw an unknown exception\n", task.name.c_str());
+    }
+}
+
+void JobGraph::finish(TaskId id, std::vector<TaskId> &readyWorkerTasks)
+{
+    finishedTasks.push_back(id);
+
+    for (TaskId dependent : tasks[id].dependents)
+    {
+        if (--tasks[dependent].pendingDependencies == 0)
+        {
+            if (tasks[dependent].mainThread)
+            {
+                readyMainTasks.push_back(dependent);
+            }
+            else
+            {
+                readyWorkerTasks.push_back(dependent);
+            }
+        }
+    }
+}
+
+void JobGraph::submit(const std::vector<TaskId> &readyWorkerTasks)
+{
+    if (readyWorkerTasks.empty())
+    {
+        return;
+    }
+
+    for (TaskId id : readyWorkerTasks)
+    {
+        JobSystem::submitJob([this, id]()
+                             {
+            execute(id);
+
+            std::vector<TaskId> ready;
+            {
+                // run() cannot return before this lock is released, so the graph stays alive
+                std::lock_guard<std::mutex> lock(mutex);
+                finish(id, ready);
+                submit(ready);
+                finishedCondition.notify_one();
+            } }, tasks[id].name, "general");
+    }
+    JobSystem::kick();
+}
+
+void JobGraph::run(const ProgressCallback &progress)
+{
+    size_t total = tasks.size();
+    if (total == 0)
+    {
+        return;
+    }
+
+    // Serial fallback: ids are already a valid execution order
+    if (!JobSystem::isInitialized())
+    {
+        for (TaskId id = 0; id < static_cast<TaskId>(total); id++)
+        {
+            execute(id);
+            if (progress)
+            {
+                progress(static_cast<size_t>(id) + 1, total, tasks[id].name);
+            }
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finishedTasks.clear();
+    readyMainTasks.clear();
+
+    std::vector<TaskId> readyWorkerTasks;
+    for (TaskId id = 0; id < static_cast<TaskId>(total); id++)
+    {
+        tasks[id].pendingDependencies = tasks[id].dependencyCount;
+        if (tasks[id].dependencyCount == 0)
+        {
+            (tasks[id].mainThread ? readyMainTasks : readyWorkerTasks).push_back(id);
+        }
+    }
+    submit(readyWorkerTasks);
+
+    size_t reported = 0;
+    while (reported < total)
+    {
+        finishedCondition.wait(lock, [this]()
+                               { return !finishedTasks.empty() || !readyMainTasks.empty(); });
+
+        // Report progress without holding the lock (callbacks may draw a loading screen)
+        std::vector<TaskId> finished;
+        finished.swap(finishedTasks);
+        std::vector<TaskId> mainTasks;
+        mainTasks.swap(readyMainTasks);
+        lock.unlock();
+
+        for (TaskId id : finished)
+        {
+            reported++;
+            if (progress)
+            {
+                progress(reported, total, tasks[id].name);
+            }
+        }
+
+        for (TaskId id : mainTasks)
+        {
+            execute(id);
+
+            lock.lock();
+            std::vector<TaskId> ready;
+            finish(id, ready);
+            submit(ready);
+            lock.unlock();
+        }
+
+        lock.lock();
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// A set of tasks with dependencies, executed on the JobSystem pool
+// Tasks start as soon as all of their dependencies have finished. Main thread tasks
+// (e.g. GPU uploads) run on the thread that calls run() instead of a worker.
+// Without an initialized JobSystem every task runs on the calling thread in the order added.
+class JobGraph
+{
+public:
+    typedef int TaskId;
+
+    // Progress callback: tasks finished so far, total task count, name of the task that just finished
+    typedef std::function<void(size_t, size_t, const std::string &)> ProgressCallback;
+
+    JobGraph() = default;
+    JobGraph(const JobGraph &) = delete;
+    JobGraph &operator=(const JobGraph &) = delete;
+
+    // Add a task that runs on a worker thread
+    // dependencies must be ids returned by earlier calls
+    TaskId addTask(const std::string &name, std::function<void()> work, const std::vector<TaskId> &dependencies = {});
+
+    // Add a task that runs on the thread calling run()
+    TaskId addMainThreadTask(const std::string &name, std::function<void()> work, const std::vector<TaskId> &dependencies = {});
+
+    // Run every task and block until all have finished
+    // progress is invoked on the calling thread after each task
+    void run(const ProgressCallback &progress = nullptr);
+
+    size_t getTaskCount() const { return tasks.size(); }
+
+private:
+    struct Task
+    {
+        std::string name;
+        std::function<void()> work;
+        bool mainThread;
+        std::vector<TaskId> dependents; // Tasks waiting on this one
+        int dependencyCount;
+        int pendingDependencies; // Counts down while running
+    };
+
+    std::vector<Task> tasks;
+
+    // Run state (guarded by mutex while run() is active)
+    std::mutex mutex;
+    std::condition_variable finishedCondition;
+    std::vector<TaskId> finishedTasks;   // Finished but not yet reported to progress
+    std::vector<TaskId> readyMainTasks;  // Main thread tasks whose dependencies are done
+
+    TaskId add(const std::string &name, std::function<void()> work, const std::vector<TaskId> &dependencies, bool mainThread);
+
+    // Execute a task's work, catching exceptions so a failed task never stalls the graph
+    void execute(TaskId id);
+
+    // Mark a task finished and release its dependents (mutex must be held)
+    // Worker tasks that became ready are appended to readyWorkerTasks
+    void finish(TaskId id, std::vector<TaskId> &readyWorkerTasks);
+
+    // Submit worker tasks to the JobSystem and kick the pool
+    void submit(const std::vector<TaskId> &readyWorkerTasks);
+};
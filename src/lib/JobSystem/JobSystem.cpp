@@ -1,6 +1,9 @@
 #include "JobSystem.h"
 #include <thread>
+#include <atomic>
+#include <condition_variable>
 #include <stdio.h>
+#include <algorithm>
 
 // Static member initialization
 CF_Threadpool *JobSystem::s_threadpool = nullptr;
@@ -255,6 +258,86 @@ void JobSystem::kick()
     }
 }
 
+void JobSystem::parallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)> &work,
+                            const std::string &jobName, const std::string &label)
+{
+    if (count == 0 || !work)
+    {
+        return;
+    }
+
+    if (batchSize == 0)
+    {
+        batchSize = 1;
+    }
+
+    size_t batchCount = (count + batchSize - 1) / batchSize;
+
+    // Not worth dispatching - run on the calling thread
+    if (!s_initialized || batchCount == 1 || s_workerCount <= 1)
+    {
+        work(0, count);
+        return;
+    }
+
+    // Shared between the caller and helper jobs; helpers that start after the
+    // caller has returned find no batches left and never touch work
+    struct ParallelForState
+    {
+        std::function<void(size_t, size_t)> work;
+        size_t count;
+        size_t batchSize;
+        size_t batchCount;
+        std::atomic<size_t> nextBatch{0};
+        std::atomic<size_t> finishedBatches{0};
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+    };
+
+    auto state = std::make_shared<ParallelForState>();
+    state->work = work;
+    state->count = count;
+    state->batchSize = batchSize;
+    state->batchCount = batchCount;
+
+    auto runBatches = [](ParallelForState &st)
+    {
+        for (;;)
+        {
+            size_t batch = st.nextBatch.fetch_add(1);
+            if (batch >= st.batchCount)
+            {
+                return;
+            }
+
+            size_t begin = batch * st.batchSize;
+            size_t end = std::min(begin + st.batchSize, st.count);
+            st.work(begin, end);
+
+            if (st.finishedBatches.fetch_add(1) + 1 == st.batchCount)
+            {
+                std::lock_guard<std::mutex> lock(st.doneMutex);
+                st.doneCondition.notify_all();
+            }
+        }
+    };
+
+    // One helper per extra batch, capped by the pool size (the caller is the other worker)
+    size_t helperCount = std::min(batchCount - 1, static_cast<size_t>(s_workerCount - 1));
+    for (size_t i = 0; i < helperCount; ++i)
+    {
+        submitJob([state, runBatches]()
+                  { runBatches(*state); }, jobName, label);
+    }
+    kick();
+
+    runBatches(*state);
+
+    std::unique_lock<std::mutex> lock(state->doneMutex);
+    state->doneCondition.wait(lock, [&state]()
+                              { return state->finishedBatches.load() == state->batchCount; });
+}
+
 int JobSystem::getWorkerCount()
 {
     return s_workerCount;
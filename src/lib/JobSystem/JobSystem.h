@@ -32,6 +32,12 @@ public:
     // Kick all pending jobs without waiting (non-blocking)
     static void kick();
 
+    // Run work(begin, end) over [0, count) in batches of batchSize across the pool
+    // The calling thread works through batches too and returns once every batch is done,
+    // so it is safe to call from inside a running job (unlike kickAndWait)
+    static void parallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)> &work,
+                            const std::string &jobName = "Parallel For", const std::string &label = "general");
+
     // Get the number of worker threads
     static int getWorkerCount();
 
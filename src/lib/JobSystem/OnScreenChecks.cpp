@@ -3,11 +3,8 @@
 #include "CFNativeCamera.h"
 #include "LevelV1.h"
 #include "Coordinator.h"
-#include "AnimatedDataCharacterNavMeshAgent.h"
 #include <stdio.h>
 #include <atomic>
-#include <cmath>
-#include <unordered_set>
 
 namespace OnScreenChecks
 {
@@ -52,74 +49,7 @@ namespace OnScreenChecks
                         continue;
                     }
 
-                    // Get view bounds from camera (expanded slightly for edge cases)
-                    CF_Aabb viewBounds = s_camera->getViewBounds();
-                    viewBounds.min.x -= 64.0f;
-                    viewBounds.min.y -= 64.0f;
-                    viewBounds.max.x += 64.0f;
-                    viewBounds.max.y += 64.0f;
-
-                    const float agentHalfSize = 32.0f;
-
-                    // Query spatial grid for agents in/near the view area
-                    std::vector<size_t> nearbyAgents = s_level->getSpatialGrid().queryAABB(viewBounds);
-                    std::unordered_set<size_t> nearbySet(nearbyAgents.begin(), nearbyAgents.end());
-
-                    // Update all agents' visibility status
-                    size_t agentCount = s_level->getAgentCount();
-                    for (size_t i = 0; i < agentCount; ++i)
-                    {
-                        if (s_shutdownRequested.load())
-                            break;
-
-                        auto *agent = s_level->getAgent(i);
-                        if (!agent)
-                            continue;
-
-                        // If agent is not in the nearby set, mark as off-screen
-                        if (nearbySet.find(i) == nearbySet.end())
-                        {
-                            bool wasOnScreen = agent->getIsOnScreen();
-                            agent->setIsOnScreen(false);
-                            if (wasOnScreen)
-                            {
-                                s_coordinator.removeAgent(agent);
-                            }
-                            continue;
-                        }
-
-                        // Agent is nearby - do precise visibility check
-                        v2 agentPos = agent->getPosition();
-                        CF_Aabb agentBounds = cf_make_aabb(
-                            cf_v2(agentPos.x - agentHalfSize, agentPos.y - agentHalfSize),
-                            cf_v2(agentPos.x + agentHalfSize, agentPos.y + agentHalfSize));
-
-                        bool visible = s_camera->isVisible(agentBounds);
-                        bool wasOnScreen = agent->getIsOnScreen();
-                        agent->setIsOnScreen(visible);
-
-                        // Remove dying agents from coordinator
-                        if (agent->getStageOfLife() == StageOfLife::Dying)
-                        {
-                            if (wasOnScreen)
-                            {
-                                s_coordinator.removeAgent(agent);
-                            }
-                            continue;
-                        }
-
-                        // Update coordinator based on visibility change
-                        if (visible && !wasOnScreen)
-                        {
-                            s_coordinator.addAgent(agent);
-                        }
-                        else if (!visible && wasOnScreen)
-                        {
-                            s_coordinator.removeAgent(agent);
-                        }
-                    }
-
-                    // Update coordinator once after processing all agents
+                    // Visibility changes arrive from LevelV1::updateAgentVisibility on the main thread
                     s_coordinator.update();
                 }
 
@@ -12,7 +12,8 @@ class AnimatedDataCharacter;
 
 // On-screen checks job functions
 // These functions are designed to run on the "onscreenchecks" dedicated worker thread
-// The worker runs a continuous loop checking agent visibility
+// The worker runs a continuous loop updating the coordinator; agent visibility itself is
+// checked on the main thread by LevelV1::updateAgentVisibility, which feeds the coordinator
 
 namespace OnScreenChecks
 {
@@ -0,0 +1,478 @@
+#include "LevelPackage.h"
+#include "DataFile.h"
+#include <cute.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LEVEL_PACKAGE_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char LEVEL_PACKAGE_MAGIC[4] = {'Y', 'L', 'P', 'K'};
+
+// Sections start on 16-byte boundaries so typed pointers into the mapping are aligned
+static const size_t LEVEL_PACKAGE_ALIGNMENT = 16;
+
+static size_t alignSize(size_t value)
+{
+    return (value + LEVEL_PACKAGE_ALIGNMENT - 1) & ~(LEVEL_PACKAGE_ALIGNMENT - 1);
+}
+
+// Size of one record for each section (used to validate counts)
+static size_t getSectionRecordSize(LevelPackageSection section)
+{
+    switch (section)
+    {
+    case LevelPackageSection::Strings:
+        return sizeof(char);
+    case LevelPackageSection::Layers:
+        return sizeof(PackedLayer);
+    case LevelPackageSection::LayerData:
+        return sizeof(int32_t);
+    case LevelPackageSection::Tilesets:
+        return sizeof(PackedTileset);
+    case LevelPackageSection::TilesetPixels:
+        return sizeof(uint8_t);
+    case LevelPackageSection::NavPolygons:
+        return sizeof(PackedNavPoly);
+    case LevelPackageSection::NavVertices:
+        return sizeof(PackedVec2);
+    case LevelPackageSection::NavNeighbors:
+        return sizeof(int32_t);
+    case LevelPackageSection::NavEdges:
+        return sizeof(PackedNavEdge);
+    case LevelPackageSection::Entities:
+        return sizeof(PackedEntitySpawn);
+    default:
+        return 0;
+    }
+}
+
+// LevelPackage implementation
+LevelPackage::~LevelPackage()
+{
+    close();
+}
+
+bool LevelPackage::open(const std::string &path)
+{
+    close();
+
+#ifdef LEVEL_PACKAGE_USE_MMAP
+    // Resolve the virtual path to the file on disk, e.g. "/assets/Levels/x/level.ylpk"
+    // lives in the directory mounted as "/assets"
+    const char *actual_dir = cf_fs_get_actual_path(path.c_str());
+    size_t mount_end = path.find('/', 1);
+    if (actual_dir && mount_end != std::string::npos)
+    {
+        std::string real_path = std::string(actual_dir) + path.substr(mount_end);
+        int fd = ::open(real_path.c_str(), O_RDONLY);
+        if (fd >= 0)
+        {
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size > 0)
+            {
+                void *mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped != MAP_FAILED)
+                {
+                    mapping = mapped;
+                    base = static_cast<const uint8_t *>(mapped);
+                    size = static_cast<size_t>(st.st_size);
+                }
+            }
+            ::close(fd);
+        }
+    }
+
+    if (base)
+    {
+        return validate();
+    }
+#endif
+
+    // Not a plain file on disk (or no mmap), read it through the VFS instead
+    size_t file_size = 0;
+    void *file_data = cf_fs_read_entire_file_to_memory(path.c_str(), &file_size);
+    if (file_data == nullptr)
+    {
+        return false;
+    }
+
+    bool result = openBuffer(file_data, file_size);
+    cf_free(file_data);
+    return result;
+}
+
+bool LevelPackage::openBuffer(const void *data, size_t data_size)
+{
+    close();
+
+    if (!data || data_size == 0)
+    {
+        return false;
+    }
+
+    ownedData.assign(static_cast<const uint8_t *>(data), static_cast<const uint8_t *>(data) + data_size);
+    base = ownedData.data();
+    size = ownedData.size();
+    return validate();
+}
+
+void LevelPackage::close()
+{
+#ifdef LEVEL_PACKAGE_USE_MMAP
+    if (mapping)
+    {
+        munmap(mapping, size);
+    }
+#endif
+    mapping = nullptr;
+    ownedData.clear();
+    ownedData.shrink_to_fit();
+    base = nullptr;
+    size = 0;
+}
+
+bool LevelPackage::validate()
+{
+    if (size < sizeof(LevelPackageHeader))
+    {
+        printf("LevelPackage: File too small for header (%zu bytes)\n", size);
+        close();
+        return false;
+    }
+
+    const LevelPackageHeader &header = getHeader();
+    if (memcmp(header.magic, LEVEL_PACKAGE_MAGIC, sizeof(LEVEL_PACKAGE_MAGIC)) != 0)
+    {
+        printf("LevelPackage: Invalid magic\n");
+        close();
+        return false;
+    }
+
+    if (header.version != LEVEL_PACKAGE_VERSION)
+    {
+        printf("LevelPackage: Version %u does not match expected version %u\n", header.version, LEVEL_PACKAGE_VERSION);
+        close();
+        return false;
+    }
+
+    if (header.fileSize != size)
+    {
+        printf("LevelPackage: Size mismatch (header %llu, file %zu)\n",
+               static_cast<unsigned long long>(header.fileSize), size);
+        close();
+        return false;
+    }
+
+    for (size_t i = 0; i < static_cast<size_t>(LevelPackageSection::Count); i++)
+    {
+        const LevelPackageSectionEntry &entry = header.sections[i];
+        size_t record_size = getSectionRecordSize(static_cast<LevelPackageSection>(i));
+        bool in_bounds = entry.offset <= size && entry.size <= size - entry.offset;
+        if (!in_bounds || entry.offset % LEVEL_PACKAGE_ALIGNMENT != 0 || entry.count * record_size != entry.size)
+        {
+            printf("LevelPackage: Section %zu is corrupt\n", i);
+            close();
+            return false;
+        }
+    }
+
+    // Strings are referenced by offset, the blob must end with a terminator
+    const LevelPackageSectionEntry &strings = header.sections[static_cast<size_t>(LevelPackageSection::Strings)];
+    if (strings.size == 0 || base[strings.offset + strings.size - 1] != '\0')
+    {
+        printf("LevelPackage: String table is not terminated\n");
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+const char *LevelPackage::getString(uint32_t offset) const
+{
+    size_t count = 0;
+    const char *strings = getSection<char>(LevelPackageSection::Strings, count);
+    if (!strings || offset >= count)
+    {
+        return "";
+    }
+    return strings + offset;
+}
+
+const int32_t *LevelPackage::getLayerData(const PackedLayer &layer) const
+{
+    size_t count = 0;
+    const int32_t *data = getSection<int32_t>(LevelPackageSection::LayerData, count);
+    size_t tiles = static_cast<size_t>(layer.width) * static_cast<size_t>(layer.height);
+    if (!data || layer.firstTile > count || tiles > count - layer.firstTile)
+    {
+        return nullptr;
+    }
+    return data + layer.firstTile;
+}
+
+const uint8_t *LevelPackage::getTilesetPixels(const PackedTileset &tileset) const
+{
+    size_t count = 0;
+    const uint8_t *pixels = getSection<uint8_t>(LevelPackageSection::TilesetPixels, count);
+    size_t bytes = static_cast<size_t>(tileset.imageWidth) * static_cast<size_t>(tileset.imageHeight) * 4;
+    if (!pixels || bytes == 0 || tileset.firstPixelByte > count || bytes > count - tileset.firstPixelByte)
+    {
+        return nullptr;
+    }
+    return pixels + tileset.firstPixelByte;
+}
+
+std::vector<LevelEntitySpawn> LevelPackage::getEntitySpawns() const
+{
+    size_t count = 0;
+    const PackedEntitySpawn *records = getSection<PackedEntitySpawn>(LevelPackageSection::Entities, count);
+
+    std::vector<LevelEntitySpawn> spawns(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        spawns[i].path = getString(records[i].pathOffset);
+        spawns[i].name = getString(records[i].nameOffset);
+        spawns[i].hasPosition = records[i].hasPosition != 0;
+        spawns[i].tileX = records[i].tileX;
+        spawns[i].tileY = records[i].tileY;
+    }
+    return spawns;
+}
+
+// LevelPackageWriter implementation
+LevelPackageWriter::LevelPackageWriter()
+{
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LEVEL_PACKAGE_MAGIC, sizeof(LEVEL_PACKAGE_MAGIC));
+    header.version = LEVEL_PACKAGE_VERSION;
+
+    // Offset 0 is the empty string
+    strings.push_back('\0');
+}
+
+uint32_t LevelPackageWriter::addString(const std::string &value)
+{
+    if (value.empty())
+    {
+        return 0;
+    }
+
+    uint32_t offset = static_cast<uint32_t>(strings.size());
+    strings.insert(strings.end(), value.begin(), value.end());
+    strings.push_back('\0');
+    return offset;
+}
+
+void LevelPackageWriter::setMapInfo(const std::string &levelName, int mapWidth, int mapHeight, int tileWidth, int tileHeight)
+{
+    header.levelNameOffset = addString(levelName);
+    header.mapWidth = mapWidth;
+    header.mapHeight = mapHeight;
+    header.tileWidth = tileWidth;
+    header.tileHeight = tileHeight;
+}
+
+void LevelPackageWriter::addLayer(const std::string &name, int id, int width, int height, bool visible, float opacity,
+                                  const std::vector<int> &data)
+{
+    PackedLayer layer;
+    memset(&layer, 0, sizeof(layer));
+    layer.nameOffset = addString(name);
+    layer.id = id;
+    layer.width = width;
+    layer.height = height;
+    layer.visible = visible ? 1 : 0;
+    layer.opacity = opacity;
+    layer.firstTile = layerData.size();
+
+    // Always store exactly width * height tiles so readers can index without checks
+    size_t tiles = static_cast<size_t>(width) * static_cast<size_t>(height);
+    layerData.insert(layerData.end(), data.begin(), data.begin() + std::min(tiles, data.size()));
+    layerData.resize(layer.firstTile + tiles, 0);
+
+    layers.push_back(layer);
+}
+
+void LevelPackageWriter::addTileset(const std::string &name, const std::string &source, int firstGid, int tileWidth, int tileHeight,
+                                    int imageWidth, int imageHeight, const std::vector<uint8_t> &pixels)
+{
+    PackedTileset tileset;
+    memset(&tileset, 0, sizeof(tileset));
+    tileset.nameOffset = addString(name);
+    tileset.sourceOffset = addString(source);
+    tileset.firstGid = firstGid;
+    tileset.tileWidth = tileWidth;
+    tileset.tileHeight = tileHeight;
+
+    size_t bytes = static_cast<size_t>(imageWidth) * static_cast<size_t>(imageHeight) * 4;
+    if (bytes > 0 && pixels.size() == bytes)
+    {
+        tileset.imageWidth = imageWidth;
+        tileset.imageHeight = imageHeight;
+        tileset.firstPixelByte = tilesetPixels.size();
+        tilesetPixels.insert(tilesetPixels.end(), pixels.begin(), pixels.end());
+    }
+
+    tilesets.push_back(tileset);
+}
+
+void LevelPackageWriter::setNavMeshInfo(int gridWidth, int gridHeight, float worldX, float worldY)
+{
+    header.navGridWidth = gridWidth;
+    header.navGridHeight = gridHeight;
+    header.navWorldX = worldX;
+    header.navWorldY = worldY;
+}
+
+void LevelPackageWriter::addNavPolygon(const std::vector<PackedVec2> &vertices, const std::vector<int> &neighbors, PackedVec2 center)
+{
+    PackedNavPoly poly;
+    poly.firstVertex = static_cast<uint32_t>(navVertices.size());
+    poly.vertexCount = static_cast<uint32_t>(vertices.size());
+    poly.firstNeighbor = static_cast<uint32_t>(navNeighbors.size());
+    poly.neighborCount = static_cast<uint32_t>(neighbors.size());
+    poly.center = center;
+
+    navVertices.insert(navVertices.end(), vertices.begin(), vertices.end());
+    navNeighbors.insert(navNeighbors.end(), neighbors.begin(), neighbors.end());
+    navPolygons.push_back(poly);
+}
+
+void LevelPackageWriter::addNavEdge(PackedVec2 start, PackedVec2 end, int polyA, int polyB)
+{
+    PackedNavEdge edge;
+    edge.start = start;
+    edge.end = end;
+    edge.polyA = polyA;
+    edge.polyB = polyB;
+    navEdges.push_back(edge);
+}
+
+void LevelPackageWriter::addEntity(const LevelEntitySpawn &spawn)
+{
+    PackedEntitySpawn record;
+    memset(&record, 0, sizeof(record));
+    record.pathOffset = addString(spawn.path);
+    record.nameOffset = addString(spawn.name);
+    record.tileX = spawn.tileX;
+    record.tileY = spawn.tileY;
+    record.hasPosition = spawn.hasPosition ? 1 : 0;
+    entities.push_back(record);
+}
+
+std::vector<uint8_t> LevelPackageWriter::build() const
+{
+    LevelPackageHeader out_header = header;
+
+    // Section payloads in LevelPackageSection order
+    struct Payload
+    {
+        const void *data;
+        size_t size;
+        size_t count;
+    };
+    const Payload payloads[] = {
+        {strings.data(), strings.size(), strings.size()},
+        {layers.data(), layers.size() * sizeof(PackedLayer), layers.size()},
+        {layerData.data(), layerData.size() * sizeof(int32_t), layerData.size()},
+        {tilesets.data(), tilesets.size() * sizeof(PackedTileset), tilesets.size()},
+        {tilesetPixels.data(), tilesetPixels.size(), tilesetPixels.size()},
+        {navPolygons.data(), navPolygons.size() * sizeof(PackedNavPoly), navPolygons.size()},
+        {navVertices.data(), navVertices.size() * sizeof(PackedVec2), navVertices.size()},
+        {navNeighbors.data(), navNeighbors.size() * sizeof(int32_t), navNeighbors.size()},
+        {navEdges.data(), navEdges.size() * sizeof(PackedNavEdge), navEdges.size()},
+        {entities.data(), entities.size() * sizeof(PackedEntitySpawn), entities.size()},
+    };
+    static_assert(sizeof(payloads) / sizeof(payloads[0]) == static_cast<size_t>(LevelPackageSection::Count),
+                  "Every level package section needs a payload");
+
+    size_t offset = alignSize(sizeof(LevelPackageHeader));
+    for (size_t i = 0; i < static_cast<size_t>(LevelPackageSection::Count); i++)
+    {
+        out_header.sections[i].offset = offset;
+        out_header.sections[i].size = payloads[i].size;
+        out_header.sections[i].count = payloads[i].count;
+        offset = alignSize(offset + payloads[i].size);
+    }
+    out_header.fileSize = offset;
+
+    std::vector<uint8_t> bytes(offset, 0);
+    memcpy(bytes.data(), &out_header, sizeof(out_header));
+    for (size_t i = 0; i < static_cast<size_t>(LevelPackageSection::Count); i++)
+    {
+        if (payloads[i].size > 0)
+        {
+            memcpy(bytes.data() + out_header.sections[i].offset, payloads[i].data, payloads[i].size);
+        }
+    }
+
+    return bytes;
+}
+
+bool LevelPackageWriter::writeFile(const std::string &path) const
+{
+    std::vector<uint8_t> bytes = build();
+
+    // Paths are relative to the write directory, strip the "/assets/" mount point like DataFile::save
+    std::string write_path = path;
+    if (write_path.starts_with("/assets/"))
+    {
+        write_path = write_path.substr(8);
+    }
+
+    CF_Result result = cf_fs_write_entire_buffer_to_file(write_path.c_str(), bytes.data(), bytes.size());
+    if (Cute::is_error(result))
+    {
+        printf("LevelPackageWriter: Failed to write '%s' (write path: '%s')\n", path.c_str(), write_path.c_str());
+        return false;
+    }
+
+    printf("LevelPackageWriter: Wrote %zu bytes to '%s'\n", bytes.size(), path.c_str());
+    return true;
+}
+
+std::vector<LevelEntitySpawn> flattenEntitySpawns(const DataFile &entities)
+{
+    std::vector<LevelEntitySpawn> spawns;
+    if (!entities.contains("entities") || !entities["entities"].is_array())
+    {
+        return spawns;
+    }
+
+    for (const auto &entityEntry : entities["entities"])
+    {
+        if (!entityEntry.contains("path"))
+        {
+            printf("Warning: Entity missing 'path' field, skipping\n");
+            continue;
+        }
+
+        LevelEntitySpawn spawn;
+        spawn.path = entityEntry["path"].get<std::string>();
+        spawn.name = entityEntry.contains("name") ? entityEntry["name"].get<std::string>() : "unnamed";
+
+        // Position is in tile coordinates
+        if (entityEntry.contains("position"))
+        {
+            const auto &pos = entityEntry["position"];
+            if (pos.contains("x") && pos.contains("y"))
+            {
+                spawn.hasPosition = true;
+                spawn.tileX = pos["x"].get<float>();
+                spawn.tileY = pos["y"].get<float>();
+            }
+        }
+
+        spawns.push_back(spawn);
+    }
+
+    return spawns;
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class DataFile;
+
+// Cooked level package (written by the level_cook tool, loaded by LevelV1)
+//
+// Layout: LevelPackageHeader, then one 16-byte aligned block per section. Every record uses
+// fixed size fields, so loading is a single mapping of the file plus turning section offsets
+// into pointers. Strings live in one blob of NUL-terminated strings and are referenced by offset.
+// Values are stored in native (little-endian) byte order.
+
+// File name of the package inside a level directory
+#define LEVEL_PACKAGE_FILENAME "level.ylpk"
+
+// Bump whenever a record layout changes, old packages are then rejected and re-cooked
+const uint32_t LEVEL_PACKAGE_VERSION = 1;
+
+enum class LevelPackageSection : uint32_t
+{
+    Strings = 0,   // char blob
+    Layers,        // PackedLayer
+    LayerData,     // int32_t tile GIDs for all layers
+    Tilesets,      // PackedTileset
+    TilesetPixels, // uint8_t RGBA8 tileset images
+    NavPolygons,   // PackedNavPoly
+    NavVertices,   // PackedVec2
+    NavNeighbors,  // int32_t
+    NavEdges,      // PackedNavEdge
+    Entities,      // PackedEntitySpawn
+    Count
+};
+
+struct LevelPackageSectionEntry
+{
+    uint64_t offset; // Byte offset from the start of the file
+    uint64_t size;   // Size in bytes
+    uint64_t count;  // Number of records
+};
+
+struct LevelPackageHeader
+{
+    char magic[4]; // "YLPK"
+    uint32_t version;
+    uint64_t fileSize;
+
+    // Map properties
+    int32_t mapWidth;
+    int32_t mapHeight;
+    int32_t tileWidth;
+    int32_t tileHeight;
+    uint32_t levelNameOffset; // Into Strings
+
+    // Baked navmesh properties
+    int32_t navGridWidth;
+    int32_t navGridHeight;
+    float navWorldX;
+    float navWorldY;
+    uint32_t reserved;
+
+    LevelPackageSectionEntry sections[static_cast<size_t>(LevelPackageSection::Count)];
+};
+
+struct PackedLayer
+{
+    uint32_t nameOffset; // Into Strings
+    int32_t id;
+    int32_t width;
+    int32_t height;
+    uint32_t visible;
+    float opacity;
+    uint64_t firstTile; // Index of the layer's first GID in LayerData
+};
+
+struct PackedTileset
+{
+    uint32_t nameOffset;   // Into Strings
+    uint32_t sourceOffset; // Into Strings
+    int32_t firstGid;
+    int32_t tileWidth;
+    int32_t tileHeight;
+    int32_t imageWidth; // 0 if the image could not be baked
+    int32_t imageHeight;
+    uint32_t reserved;
+    uint64_t firstPixelByte; // Offset of the RGBA8 image in TilesetPixels
+};
+
+struct PackedVec2
+{
+    float x;
+    float y;
+};
+
+struct PackedNavPoly
+{
+    uint32_t firstVertex; // Into NavVertices
+    uint32_t vertexCount;
+    uint32_t firstNeighbor; // Into NavNeighbors
+    uint32_t neighborCount;
+    PackedVec2 center;
+};
+
+struct PackedNavEdge
+{
+    PackedVec2 start;
+    PackedVec2 end;
+    int32_t polyA;
+    int32_t polyB;
+};
+
+struct PackedEntitySpawn
+{
+    uint32_t pathOffset; // Into Strings
+    uint32_t nameOffset; // Into Strings
+    float tileX;
+    float tileY;
+    uint32_t hasPosition;
+    uint32_t reserved;
+};
+
+// Entity spawn record shared by the JSON and package load paths
+struct LevelEntitySpawn
+{
+    std::string path;
+    std::string name;
+    bool hasPosition;
+    float tileX;
+    float tileY;
+
+    LevelEntitySpawn() : hasPosition(false), tileX(0.0f), tileY(0.0f) {}
+};
+
+// Read-only view of a cooked level package
+class LevelPackage
+{
+public:
+    LevelPackage() = default;
+    ~LevelPackage();
+
+    LevelPackage(const LevelPackage &) = delete;
+    LevelPackage &operator=(const LevelPackage &) = delete;
+
+    // Open a package by virtual path (e.g. "/assets/Levels/x/level.ylpk")
+    // Maps the file directly when it lives on disk, otherwise reads it through the VFS
+    bool open(const std::string &path);
+
+    // Open a package from memory (the buffer is copied)
+    bool openBuffer(const void *data, size_t size);
+
+    // Release the mapping
+    void close();
+
+    bool isOpen() const { return base != nullptr; }
+    const LevelPackageHeader &getHeader() const { return *reinterpret_cast<const LevelPackageHeader *>(base); }
+
+    // Get a section as a typed array (nullptr and count 0 if empty)
+    template <typename T>
+    const T *getSection(LevelPackageSection section, size_t &count) const
+    {
+        const LevelPackageSectionEntry &entry = getHeader().sections[static_cast<size_t>(section)];
+        count = static_cast<size_t>(entry.count);
+        return count > 0 ? reinterpret_cast<const T *>(base + entry.offset) : nullptr;
+    }
+
+    // Get a string by offset into the string blob
+    const char *getString(uint32_t offset) const;
+
+    // Get a layer's GIDs (width * height values)
+    const int32_t *getLayerData(const PackedLayer &layer) const;
+
+    // Get a tileset's RGBA8 image (nullptr if not baked)
+    const uint8_t *getTilesetPixels(const PackedTileset &tileset) const;
+
+    // Rebuild the flattened entity spawn list
+    std::vector<LevelEntitySpawn> getEntitySpawns() const;
+
+private:
+    const uint8_t *base = nullptr;
+    size_t size = 0;
+    void *mapping = nullptr;        // mmap'd region (if mapped)
+    std::vector<uint8_t> ownedData; // Buffer copy (if not mapped)
+
+    // Check header, version and section bounds
+    bool validate();
+};
+
+// Builds a level package in memory
+class LevelPackageWriter
+{
+public:
+    LevelPackageWriter();
+
+    void setMapInfo(const std::string &levelName, int mapWidth, int mapHeight, int tileWidth, int tileHeight);
+
+    void addLayer(const std::string &name, int id, int width, int height, bool visible, float opacity,
+                  const std::vector<int> &data);
+
+    // pixels may be empty if the image could not be decoded
+    void addTileset(const std::string &name, const std::string &source, int firstGid, int tileWidth, int tileHeight,
+                    int imageWidth, int imageHeight, const std::vector<uint8_t> &pixels);
+
+    void setNavMeshInfo(int gridWidth, int gridHeight, float worldX, float worldY);
+
+    void addNavPolygon(const std::vector<PackedVec2> &vertices, const std::vector<int> &neighbors, PackedVec2 center);
+
+    void addNavEdge(PackedVec2 start, PackedVec2 end, int polyA, int polyB);
+
+    void addEntity(const LevelEntitySpawn &spawn);
+
+    // Serialize everything into one buffer
+    std::vector<uint8_t> build() const;
+
+    // Serialize and write through the VFS write directory (e.g. "/assets/Levels/x/level.ylpk")
+    bool writeFile(const std::string &path) const;
+
+private:
+    LevelPackageHeader header;
+    std::vector<char> strings;
+    std::vector<PackedLayer> layers;
+    std::vector<int32_t> layerData;
+    std::vector<PackedTileset> tilesets;
+    std::vector<uint8_t> tilesetPixels;
+    std::vector<PackedNavPoly> navPolygons;
+    std::vector<PackedVec2> navVertices;
+    std::vector<int32_t> navNeighbors;
+    std::vector<PackedNavEdge> navEdges;
+    std::vector<PackedEntitySpawn> entities;
+
+    uint32_t addString(const std::string &value);
+};
+
+// Flatten an entities.json document ({"entities": [{path, name, position{x,y}}]}) into spawn records
+std::vector<LevelEntitySpawn> flattenEntitySpawns(const DataFile &entities);
@@ -0,0 +1,244 @@
+#include "TileLayerData.h"
+#include <cstdio>
+#include <cstring>
+#include <zlib.h>
+#ifdef YANGEP_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace TileLayerData
+{
+    static inline bool isSeparator(char c)
+    {
+        return c == ',' || c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    bool parseCSV(const char *text, size_t expected_count, std::vector<int> &tile_data)
+    {
+        tile_data.clear();
+        if (expected_count > 0)
+        {
+            tile_data.reserve(expected_count);
+        }
+
+        if (!text)
+        {
+            return true;
+        }
+
+        const char *p = text;
+        while (true)
+        {
+            while (isSeparator(*p))
+            {
+                ++p;
+            }
+            if (*p == '\0')
+            {
+                break;
+            }
+
+            // GIDs are unsigned 32-bit (the top bits hold Tiled's flip flags)
+            uint32_t value = 0;
+            const char *start = p;
+            while (static_cast<unsigned>(*p - '0') < 10u)
+            {
+                value = value * 10u + static_cast<uint32_t>(*p - '0');
+                ++p;
+            }
+
+            if (p == start)
+            {
+                printf("Warning: Invalid character '%c' in CSV tile data at offset %zu\n", *p, static_cast<size_t>(p - text));
+                return false;
+            }
+
+            tile_data.push_back(static_cast<int>(value));
+        }
+
+        return true;
+    }
+
+    bool decodeBase64(const char *text, std::vector<uint8_t> &bytes)
+    {
+        // Reverse lookup table, 0xFF = not a base64 character
+        static const struct Table
+        {
+            uint8_t values[256];
+            Table()
+            {
+                memset(values, 0xFF, sizeof(values));
+                const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+                for (int i = 0; i < 64; i++)
+                {
+                    values[static_cast<uint8_t>(alphabet[i])] = static_cast<uint8_t>(i);
+                }
+            }
+        } table;
+
+        bytes.clear();
+        if (!text)
+        {
+            return true;
+        }
+        bytes.reserve(strlen(text) / 4 * 3);
+
+        uint32_t accumulator = 0;
+        int bits = 0;
+        int padding = 0;
+        for (const char *p = text; *p; ++p)
+        {
+            uint8_t c = static_cast<uint8_t>(*p);
+            if (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+            {
+                continue;
+            }
+            if (c == '=')
+            {
+                padding++;
+                continue;
+            }
+
+            uint8_t value = table.values[c];
+            if (value == 0xFF || padding > 0)
+            {
+                printf("Warning: Invalid base64 tile data at offset %zu\n", static_cast<size_t>(p - text));
+                return false;
+            }
+
+            accumulator = (accumulator << 6) | value;
+            bits += 6;
+            if (bits >= 8)
+            {
+                bits -= 8;
+                bytes.push_back(static_cast<uint8_t>((accumulator >> bits) & 0xFF));
+            }
+        }
+
+        // Leftover bits must be padding zeros (2 or 4 bits)
+        if (bits >= 6)
+        {
+            printf("Warning: Truncated base64 tile data\n");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool inflate(const std::vector<uint8_t> &compressed, size_t expected_size, std::vector<uint8_t> &bytes)
+    {
+        bytes.resize(expected_size);
+
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+        stream.next_in = const_cast<Bytef *>(compressed.data());
+        stream.avail_in = static_cast<uInt>(compressed.size());
+        stream.next_out = bytes.data();
+        stream.avail_out = static_cast<uInt>(bytes.size());
+
+        // 15 window bits + 32 enables automatic zlib/gzip header detection
+        if (inflateInit2(&stream, 15 + 32) != Z_OK)
+        {
+            printf("Warning: inflateInit2 failed for tile data\n");
+            return false;
+        }
+
+        int ret = ::inflate(&stream, Z_FINISH);
+        size_t produced = stream.total_out;
+        inflateEnd(&stream);
+
+        if (ret != Z_STREAM_END || produced != expected_size)
+        {
+            printf("Warning: Failed to inflate tile data (result %d, %zu of %zu bytes)\n", ret, produced, expected_size);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool decompressZstd(const std::vector<uint8_t> &compressed, size_t expected_size, std::vector<uint8_t> &bytes)
+    {
+#ifdef YANGEP_HAS_ZSTD
+        bytes.resize(expected_size);
+        size_t produced = ZSTD_decompress(bytes.data(), bytes.size(), compressed.data(), compressed.size());
+        if (ZSTD_isError(produced) || produced != expected_size)
+        {
+            printf("Warning: Failed to decompress zstd tile data (%s)\n",
+                   ZSTD_isError(produced) ? ZSTD_getErrorName(produced) : "size mismatch");
+            return false;
+        }
+        return true;
+#else
+        (void)compressed;
+        (void)expected_size;
+        (void)bytes;
+        printf("Warning: zstd tile data is not supported in this build\n");
+        return false;
+#endif
+    }
+
+    bool decode(const char *text, const std::string &encoding, const std::string &compression,
+                size_t expected_count, std::vector<int> &tile_data)
+    {
+        if (encoding == "csv")
+        {
+            return parseCSV(text, expected_count, tile_data);
+        }
+
+        if (encoding != "base64")
+        {
+            printf("Warning: Unsupported tile data encoding '%s'\n", encoding.c_str());
+            return false;
+        }
+
+        std::vector<uint8_t> decoded;
+        if (!decodeBase64(text, decoded))
+        {
+            return false;
+        }
+
+        // Each tile is a little-endian uint32
+        size_t expected_size = expected_count * 4;
+        std::vector<uint8_t> inflated;
+        const std::vector<uint8_t> *raw = &decoded;
+        if (compression == "zlib" || compression == "gzip")
+        {
+            if (!inflate(decoded, expected_size, inflated))
+            {
+                return false;
+            }
+            raw = &inflated;
+        }
+        else if (compression == "zstd")
+        {
+            if (!decompressZstd(decoded, expected_size, inflated))
+            {
+                return false;
+            }
+            raw = &inflated;
+        }
+        else if (!compression.empty())
+        {
+            printf("Warning: Unsupported tile data compression '%s'\n", compression.c_str());
+            return false;
+        }
+
+        if (raw->size() % 4 != 0)
+        {
+            printf("Warning: Binary tile data size %zu is not a multiple of 4\n", raw->size());
+            return false;
+        }
+
+        size_t count = raw->size() / 4;
+        tile_data.resize(count);
+        const uint8_t *src = raw->data();
+        for (size_t i = 0; i < count; i++, src += 4)
+        {
+            uint32_t gid = static_cast<uint32_t>(src[0]) | (static_cast<uint32_t>(src[1]) << 8) |
+                           (static_cast<uint32_t>(src[2]) << 16) | (static_cast<uint32_t>(src[3]) << 24);
+            tile_data[i] = static_cast<int>(gid);
+        }
+
+        return true;
+    }
+}
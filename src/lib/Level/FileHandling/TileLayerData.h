@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Decoders for the tile data of TMX <data> elements
+// All functions work directly on the text pugixml already holds in memory (no intermediate
+// strings) and write global tile IDs into tile_data, reusing its storage.
+namespace TileLayerData
+{
+    // Parse comma separated tile IDs (encoding="csv")
+    // expected_count is used to reserve space up front (0 if unknown)
+    // Returns false on a malformed value
+    bool parseCSV(const char *text, size_t expected_count, std::vector<int> &tile_data);
+
+    // Decode base64 text into bytes (whitespace is skipped)
+    // Returns false on an invalid character or truncated input
+    bool decodeBase64(const char *text, std::vector<uint8_t> &bytes);
+
+    // Inflate zlib or gzip compressed data (compression="zlib" / "gzip")
+    // expected_size is the exact decompressed size (4 bytes per tile)
+    bool inflate(const std::vector<uint8_t> &compressed, size_t expected_size, std::vector<uint8_t> &bytes);
+
+    // Decompress zstd compressed data (compression="zstd")
+    // Returns false if zstd support was not compiled in
+    bool decompressZstd(const std::vector<uint8_t> &compressed, size_t expected_size, std::vector<uint8_t> &bytes);
+
+    // Decode a <data> element's text given its encoding and compression attributes
+    // Supports csv and base64 (uncompressed, zlib, gzip, zstd)
+    // expected_count is width * height of the layer
+    bool decode(const char *text, const std::string &encoding, const std::string &compression,
+                size_t expected_count, std::vector<int> &tile_data);
+}
@@ -1,10 +1,12 @@
 #include "tmx.h"
 #include "DataFile.h"
 #include "CFNativeCamera.h"
+#include "JobSystem.h"
+#include "TileLayerData.h"
 #include <cute.h>
 #include <functional>
-#include <sstream>
 #include <algorithm>
+#include <cstring>
 
 tmx::tmx(const std::string &path) : path(path), map_width(0), map_height(0), tile_width(32), tile_height(32)
 {
@@ -109,16 +111,7 @@ bool tmx::loadTilesets()
         if (!tileset->source.empty())
         {
             // Construct full path to TSX file (relative to TMX file location)
-            std::string tsx_path;
-            size_t last_slash = path.find_last_of("/\\");
-            if (last_slash != std::string::npos)
-            {
-                tsx_path = path.substr(0, last_slash + 1) + tileset->source;
-            }
-            else
-            {
-                tsx_path = tileset->source;
-            }
+            std::string tsx_path = getTilesetSourcePath(*tileset);
 
             // Create and load the TSX file
             tileset->tsx_data = std::make_shared<tsx>(tsx_path);
@@ -172,18 +165,8 @@ bool tmx::loadLayers()
             continue;
         }
 
-        std::string encoding = data_node.attribute("encoding").value();
-
-        if (encoding == "csv" || encoding.empty())
-        {
-            // Parse CSV data
-            std::string csv_data = data_node.text().get();
-            parseCSVData(csv_data, layer->data);
-        }
-        else
+        if (!decodeLayerData(data_node, *layer))
         {
-            printf("Warning: Unsupported encoding '%s' for layer '%s'\n",
-                   encoding.c_str(), layer->name.c_str());
             continue;
         }
 
@@ -215,30 +198,60 @@ bool tmx::loadLayers()
     return !layers.empty() || !navmesh_layers.empty();
 }
 
-void tmx::parseCSVData(const std::string &csv_data, std::vector<int> &tile_data) const
+bool tmx::decodeLayerData(const pugi::xml_node &data_node, TMXLayer &layer) const
 {
-    tile_data.clear();
+    std::string encoding = data_node.attribute("encoding").value();
+    std::string compression = data_node.attribute("compression").value();
+    size_t expected_count = static_cast<size_t>(std::max(0, layer.width)) * std::max(0, layer.height);
 
-    std::istringstream stream(csv_data);
-    std::string line;
-
-    while (std::getline(stream, line))
+    bool decoded = false;
+    if (encoding.empty())
     {
-        std::istringstream line_stream(line);
-        std::string cell;
-
-        while (std::getline(line_stream, cell, ','))
+        // Plain XML: one <tile gid="..."/> per tile
+        layer.data.clear();
+        layer.data.reserve(expected_count);
+        for (pugi::xml_node tile_node : data_node.children("tile"))
         {
-            // Remove whitespace
-            cell.erase(std::remove_if(cell.begin(), cell.end(), ::isspace), cell.end());
-
-            if (!cell.empty())
-            {
-                int tile_id = std::stoi(cell);
-                tile_data.push_back(tile_id);
-            }
+            layer.data.push_back(static_cast<int>(tile_node.attribute("gid").as_uint(0)));
         }
+        decoded = true;
     }
+    else
+    {
+        // Decode straight from pugixml's text buffer
+        decoded = TileLayerData::decode(data_node.text().get(), encoding, compression, expected_count, layer.data);
+    }
+
+    if (!decoded)
+    {
+        printf("Warning: Failed to decode data (encoding '%s', compression '%s') for layer '%s'\n",
+               encoding.c_str(), compression.c_str(), layer.name.c_str());
+        layer.data.clear();
+        return false;
+    }
+
+    if (layer.data.size() != expected_count)
+    {
+        printf("Warning: Layer '%s' has %zu tiles, expected %zu\n",
+               layer.name.c_str(), layer.data.size(), expected_count);
+    }
+
+    layer.markModified();
+    return true;
+}
+
+void tmx::setMapProperties(const std::string &path, int map_width, int map_height, int tile_width, int tile_height)
+{
+    this->path = path;
+    this->map_width = map_width;
+    this->map_height = map_height;
+    this->tile_width = tile_width;
+    this->tile_height = tile_height;
+}
+
+void tmx::addTileset(std::shared_ptr<TMXTileset> tileset)
+{
+    tilesets.push_back(tileset);
 }
 
 std::shared_ptr<TMXTileset> tmx::findTilesetForGID(int gid) const
@@ -353,6 +366,48 @@ std::shared_ptr<TMXTileset> tmx::getTileset(int index) const
     return nullptr;
 }
 
+std::string tmx::getTilesetSourcePath(const TMXTileset &tileset) const
+{
+    if (tileset.source.empty())
+    {
+        return "";
+    }
+
+    size_t last_slash = path.find_last_of("/\\");
+    if (last_slash != std::string::npos)
+    {
+        return path.substr(0, last_slash + 1) + tileset.source;
+    }
+    return tileset.source;
+}
+
+std::shared_ptr<TMXTileset> tmx::loadTilesetCopy(const TMXTileset &current, const std::string &tsx_path)
+{
+    auto tileset = std::make_shared<TMXTileset>();
+    tileset->first_gid = current.first_gid;
+    tileset->source = current.source;
+    tileset->name = current.name;
+
+    tileset->tsx_data = std::make_shared<tsx>(tsx_path);
+    if (tileset->tsx_data->empty() || !tileset->decodeImage())
+    {
+        printf("Failed to reload tileset '%s' from %s\n", tileset->name.c_str(), tsx_path.c_str());
+        return nullptr;
+    }
+    return tileset;
+}
+
+bool tmx::replaceTileset(int index, std::shared_ptr<TMXTileset> tileset)
+{
+    if (!tileset || index < 0 || index >= static_cast<int>(tilesets.size()))
+    {
+        return false;
+    }
+
+    tilesets[index] = std::move(tileset);
+    return true;
+}
+
 CF_Sprite tmx::getTileAt(int layer_index, int map_x, int map_y) const
 {
     auto layer = getLayer(layer_index);
@@ -688,80 +743,157 @@ void tmx::renderAllLayers(const CFNativeCamera &camera, const DataFile &config,
     }
 
     // After rendering all layers, draw border highlights for configured layers
+    if (layer_border_highlight_map.empty() && layer_outer_border_highlight_map.empty())
+    {
+        return;
+    }
+
+    updateLayerBorderCaches(world_x, world_y);
+
+    CF_Aabb view_bounds = camera.getViewBounds();
+
     for (int i = 0; i < static_cast<int>(layers.size()); i++)
     {
-        if (i < static_cast<int>(layers.size()) && layers[i])
+        if (!layers[i] || i >= static_cast<int>(layer_border_cache.size()))
         {
-            const std::string &layer_name = layers[i]->name;
+            continue;
+        }
 
-            // Check if this layer should have border highlighting (cyan)
-            auto border_it = layer_border_highlight_map.find(layer_name);
-            if (border_it != layer_border_highlight_map.end() && border_it->second)
-            {
-                // Check if borders are cached for this layer
-                auto cache_it = layer_border_cache.find(i);
-                if (cache_it == layer_border_cache.end())
-                {
-                    // Not cached, calculate and cache the border edges
-                    layer_border_cache[i] = calculateLayerBorderEdges(i, world_x, world_y);
-                    printf("Cached border edges for layer '%s': %zu edges\n",
-                           layer_name.c_str(), layer_border_cache[i].size());
-                }
+        const LayerBorderCache &cache = layer_border_cache[i];
+        if (!cache.valid || cache.chunks_x == 0 || cache.chunks_y == 0)
+        {
+            continue;
+        }
+
+        // Find the chunks overlapping the view (same tile math as renderLayer, Y flipped to TMX)
+        float layer_top_world = world_y + (layers[i]->height * tile_height);
+        int start_x = std::max(0, (int)((view_bounds.min.x - world_x) / tile_width) - 1);
+        int end_x = std::min(layers[i]->width - 1, (int)((view_bounds.max.x - world_x) / tile_width) + 1);
+        int start_y = std::max(0, (int)((layer_top_world - view_bounds.max.y) / tile_height) - 1);
+        int end_y = std::min(layers[i]->height - 1, (int)((layer_top_world - view_bounds.min.y) / tile_height) + 1);
+        if (start_x > end_x || start_y > end_y)
+        {
+            continue;
+        }
 
-                // Draw the cached border edges in cyan
-                const auto &edges = layer_border_cache[i];
-                cf_draw_push_color(make_color(0.0f, 1.0f, 1.0f, 0.9f)); // Cyan, mostly opaque
-                for (const auto &edge : edges)
+        int start_chunk_x = start_x / BORDER_CHUNK_SIZE;
+        int end_chunk_x = end_x / BORDER_CHUNK_SIZE;
+        int start_chunk_y = start_y / BORDER_CHUNK_SIZE;
+        int end_chunk_y = end_y / BORDER_CHUNK_SIZE;
+
+        // Draw the cached border edges in cyan
+        if (!cache.chunk_edges.empty())
+        {
+            cf_draw_push_color(make_color(0.0f, 1.0f, 1.0f, 0.9f)); // Cyan, mostly opaque
+            for (int cy = start_chunk_y; cy <= end_chunk_y; cy++)
+            {
+                for (int cx = start_chunk_x; cx <= end_chunk_x; cx++)
                 {
-                    // Only draw if visible in camera
-                    if (camera.isVisible(edge))
+                    for (const auto &edge : cache.chunk_edges[cy * cache.chunks_x + cx])
                     {
                         cf_draw_quad(edge, 0.0f, 3.0f); // 3px thick outline
                     }
                 }
-                cf_draw_pop_color();
             }
+            cf_draw_pop_color();
+        }
 
-            // Check if this layer should have outer border highlighting (magenta)
-            auto outer_border_it = layer_outer_border_highlight_map.find(layer_name);
-            if (outer_border_it != layer_outer_border_highlight_map.end() && outer_border_it->second)
+        // Draw the cached outer border lines in magenta
+        if (!cache.chunk_lines.empty())
+        {
+            cf_draw_push_color(make_color(1.0f, 0.0f, 1.0f, 0.9f)); // Magenta, mostly opaque
+            for (int cy = start_chunk_y; cy <= end_chunk_y; cy++)
             {
-                // Check if outer border lines are cached for this layer
-                auto cache_it = layer_outer_border_cache.find(i);
-                if (cache_it == layer_outer_border_cache.end())
+                for (int cx = start_chunk_x; cx <= end_chunk_x; cx++)
                 {
-                    // Not cached, calculate and cache the outer border lines
-                    layer_outer_border_cache[i] = calculateLayerOuterBorderLines(i, world_x, world_y);
-                    printf("Cached outer border lines for layer '%s': %zu lines\n",
-                           layer_name.c_str(), layer_outer_border_cache[i].size());
-                }
-
-                // Draw the cached outer border lines in magenta
-                const auto &lines = layer_outer_border_cache[i];
-                cf_draw_push_color(make_color(1.0f, 0.0f, 1.0f, 0.9f)); // Magenta, mostly opaque
-                for (const auto &line : lines)
-                {
-                    // Create a small AABB around the line for visibility check
-                    CF_Aabb line_bounds;
-                    line_bounds.min = cf_v2(
-                        std::min(line.start.x, line.end.x) - 1,
-                        std::min(line.start.y, line.end.y) - 1);
-                    line_bounds.max = cf_v2(
-                        std::max(line.start.x, line.end.x) + 1,
-                        std::max(line.start.y, line.end.y) + 1);
-
-                    // Only draw if visible in camera
-                    if (camera.isVisible(line_bounds))
+                    for (const auto &line : cache.chunk_lines[cy * cache.chunks_x + cx])
                     {
                         cf_draw_line(line.start, line.end, 3.0f); // 3px thick line
                     }
                 }
-                cf_draw_pop_color();
             }
+            cf_draw_pop_color();
         }
     }
 }
 
+bool tmx::isBorderHighlighted(const std::string &layer_name) const
+{
+    auto it = layer_border_highlight_map.find(layer_name);
+    return it != layer_border_highlight_map.end() && it->second;
+}
+
+bool tmx::isOuterBorderHighlighted(const std::string &layer_name) const
+{
+    auto it = layer_outer_border_highlight_map.find(layer_name);
+    return it != layer_outer_border_highlight_map.end() && it->second;
+}
+
+void tmx::updateLayerBorderCaches(float world_x, float world_y) const
+{
+    if (layer_border_cache.size() != layers.size())
+    {
+        layer_border_cache.resize(layers.size());
+    }
+
+    // Collect the highlighted layers whose cached geometry is stale
+    std::vector<int> stale_layers;
+    for (int i = 0; i < static_cast<int>(layers.size()); i++)
+    {
+        const auto &layer = layers[i];
+        if (!layer || (!isBorderHighlighted(layer->name) && !isOuterBorderHighlighted(layer->name)))
+        {
+            continue;
+        }
+
+        const LayerBorderCache &cache = layer_border_cache[i];
+        if (!cache.valid || cache.version != layer->version ||
+            cache.world_x != world_x || cache.world_y != world_y)
+        {
+            stale_layers.push_back(i);
+        }
+    }
+
+    if (stale_layers.empty())
+    {
+        return;
+    }
+
+    // Each job only touches its own layer's cache entry
+    JobSystem::parallelFor(stale_layers.size(), 1, [&](size_t begin, size_t end)
+                           {
+        for (size_t s = begin; s < end; s++)
+        {
+            int index = stale_layers[s];
+            const TMXLayer &layer = *layers[index];
+            LayerBorderCache &cache = layer_border_cache[index];
+
+            cache = LayerBorderCache();
+            cache.version = layer.version;
+            cache.world_x = world_x;
+            cache.world_y = world_y;
+            cache.chunks_x = (layer.width + BORDER_CHUNK_SIZE - 1) / BORDER_CHUNK_SIZE;
+            cache.chunks_y = (layer.height + BORDER_CHUNK_SIZE - 1) / BORDER_CHUNK_SIZE;
+
+            if (layer.visible && isBorderHighlighted(layer.name))
+            {
+                calculateLayerBorderEdges(layer, world_x, world_y, cache);
+            }
+            if (layer.visible && isOuterBorderHighlighted(layer.name))
+            {
+                calculateLayerOuterBorderLines(layer, world_x, world_y, cache);
+            }
+            cache.valid = true;
+        } }, "TMX Layer Borders");
+
+    for (int index : stale_layers)
+    {
+        const LayerBorderCache &cache = layer_border_cache[index];
+        printf("Cached borders for layer '%s': %zu edges, %zu outer lines in %dx%d chunks\n",
+               layers[index]->name.c_str(), cache.edge_count, cache.line_count, cache.chunks_x, cache.chunks_y);
+    }
+}
+
 void tmx::setLayerHighlightConfig(const DataFile &config)
 {
     // Clear existing configuration
@@ -769,7 +901,6 @@ void tmx::setLayerHighlightConfig(const DataFile &config)
     layer_border_highlight_map.clear();
     layer_outer_border_highlight_map.clear();
     layer_border_cache.clear();
-    layer_outer_border_cache.clear();
 
     // Parse highlightLayers from config once
     if (config.contains("Debug") && config["Debug"].contains("highlightLayers"))
@@ -827,48 +958,31 @@ void tmx::setLayerHighlightConfig(const DataFile &config)
     printf("Configured layer outer border highlighting for %zu layers\n", layer_outer_border_highlight_map.size());
 }
 
-std::vector<CF_Aabb> tmx::calculateLayerBorderEdges(int layer_index, float world_x, float world_y) const
+void tmx::calculateLayerBorderEdges(const TMXLayer &layer, float world_x, float world_y, LayerBorderCache &cache) const
 {
-    std::vector<CF_Aabb> edges;
-
-    auto layer = getLayer(layer_index);
-    if (!layer || !layer->visible)
-    {
-        return edges;
-    }
+    cache.chunk_edges.assign(static_cast<size_t>(cache.chunks_x) * cache.chunks_y, std::vector<CF_Aabb>());
 
     // For each tile, check if it's on the border of the filled area
     // A tile is on the border if it's filled and has at least one empty neighbor
-    for (int y = 0; y < layer->height; y++)
+    for (int y = 0; y < layer.height; y++)
     {
-        for (int x = 0; x < layer->width; x++)
+        for (int x = 0; x < layer.width; x++)
         {
-            int gid = layer->getTileGID(x, y);
+            int gid = layer.getTileGID(x, y);
             if (gid == 0)
                 continue; // Skip empty tiles
 
-            // Check if this tile is on the border (has at least one empty neighbor or edge)
-            bool is_border = false;
-
-            // Check all 4 directions (up, down, left, right)
-            // Top
-            if (y == 0 || layer->getTileGID(x, y - 1) == 0)
-                is_border = true;
-            // Bottom
-            if (y == layer->height - 1 || layer->getTileGID(x, y + 1) == 0)
-                is_border = true;
-            // Left
-            if (x == 0 || layer->getTileGID(x - 1, y) == 0)
-                is_border = true;
-            // Right
-            if (x == layer->width - 1 || layer->getTileGID(x + 1, y) == 0)
-                is_border = true;
+            // Check all 4 directions (up, down, left, right), map edges count as empty
+            bool is_border = y == 0 || layer.getTileGID(x, y - 1) == 0 ||
+                             y == layer.height - 1 || layer.getTileGID(x, y + 1) == 0 ||
+                             x == 0 || layer.getTileGID(x - 1, y) == 0 ||
+                             x == layer.width - 1 || layer.getTileGID(x + 1, y) == 0;
 
             if (is_border)
             {
                 // Calculate world position for this border tile
                 float tile_world_x = world_x + (x * tile_width);
-                float tile_world_y = world_y + ((layer->height - 1 - y) * tile_height);
+                float tile_world_y = world_y + ((layer.height - 1 - y) * tile_height);
 
                 // Create AABB for this tile (centered, like the sprites)
                 float half_width = tile_width / 2.0f;
@@ -878,36 +992,30 @@ std::vector<CF_Aabb> tmx::calculateLayerBorderEdges(int layer_index, float world
                 tile_rect.min = cf_v2(tile_world_x - half_width, tile_world_y - half_height);
                 tile_rect.max = cf_v2(tile_world_x + half_width, tile_world_y + half_height);
 
-                edges.push_back(tile_rect);
+                int chunk = (y / BORDER_CHUNK_SIZE) * cache.chunks_x + (x / BORDER_CHUNK_SIZE);
+                cache.chunk_edges[chunk].push_back(tile_rect);
+                cache.edge_count++;
             }
         }
     }
-
-    return edges;
 }
 
-std::vector<EdgeLine> tmx::calculateLayerOuterBorderLines(int layer_index, float world_x, float world_y) const
+void tmx::calculateLayerOuterBorderLines(const TMXLayer &layer, float world_x, float world_y, LayerBorderCache &cache) const
 {
-    std::vector<EdgeLine> lines;
-
-    auto layer = getLayer(layer_index);
-    if (!layer || !layer->visible)
-    {
-        return lines;
-    }
+    cache.chunk_lines.assign(static_cast<size_t>(cache.chunks_x) * cache.chunks_y, std::vector<EdgeLine>());
 
     // For each tile, check which edges face empty space (are outer edges)
-    for (int y = 0; y < layer->height; y++)
+    for (int y = 0; y < layer.height; y++)
     {
-        for (int x = 0; x < layer->width; x++)
+        for (int x = 0; x < layer.width; x++)
         {
-            int gid = layer->getTileGID(x, y);
+            int gid = layer.getTileGID(x, y);
             if (gid == 0)
                 continue; // Skip empty tiles
 
             // Calculate world position for this tile
             float tile_world_x = world_x + (x * tile_width);
-            float tile_world_y = world_y + ((layer->height - 1 - y) * tile_height);
+            float tile_world_y = world_y + ((layer.height - 1 - y) * tile_height);
 
             // Calculate tile boundaries (centered, like the sprites)
             float half_width = tile_width / 2.0f;
@@ -918,47 +1026,39 @@ std::vector<EdgeLine> tmx::calculateLayerOuterBorderLines(int layer_index, float
             float bottom = tile_world_y - half_height;
             float top = tile_world_y + half_height;
 
+            // Lines go into the chunk of the tile that owns them
+            std::vector<EdgeLine> &lines = cache.chunk_lines[(y / BORDER_CHUNK_SIZE) * cache.chunks_x + (x / BORDER_CHUNK_SIZE)];
+            size_t previous_count = lines.size();
+
             // Check each edge and add a line if it faces empty space
 
             // Top edge (faces up)
-            if (y == 0 || layer->getTileGID(x, y - 1) == 0)
+            if (y == 0 || layer.getTileGID(x, y - 1) == 0)
             {
-                EdgeLine line;
-                line.start = cf_v2(left, top);
-                line.end = cf_v2(right, top);
-                lines.push_back(line);
+                lines.push_back({cf_v2(left, top), cf_v2(right, top)});
             }
 
             // Bottom edge (faces down)
-            if (y == layer->height - 1 || layer->getTileGID(x, y + 1) == 0)
+            if (y == layer.height - 1 || layer.getTileGID(x, y + 1) == 0)
             {
-                EdgeLine line;
-                line.start = cf_v2(left, bottom);
-                line.end = cf_v2(right, bottom);
-                lines.push_back(line);
+                lines.push_back({cf_v2(left, bottom), cf_v2(right, bottom)});
             }
 
             // Left edge (faces left)
-            if (x == 0 || layer->getTileGID(x - 1, y) == 0)
+            if (x == 0 || layer.getTileGID(x - 1, y) == 0)
             {
-                EdgeLine line;
-                line.start = cf_v2(left, bottom);
-                line.end = cf_v2(left, top);
-                lines.push_back(line);
+                lines.push_back({cf_v2(left, bottom), cf_v2(left, top)});
             }
 
             // Right edge (faces right)
-            if (x == layer->width - 1 || layer->getTileGID(x + 1, y) == 0)
+            if (x == layer.width - 1 || layer.getTileGID(x + 1, y) == 0)
             {
-                EdgeLine line;
-                line.start = cf_v2(right, bottom);
-                line.end = cf_v2(right, top);
-                lines.push_back(line);
+                lines.push_back({cf_v2(right, bottom), cf_v2(right, top)});
             }
+
+            cache.line_count += lines.size() - previous_count;
         }
     }
-
-    return lines;
 }
 
 void tmx::clearAllSpriteCaches()
@@ -973,6 +1073,70 @@ void tmx::clearAllSpriteCaches()
     }
 }
 
+int tmx::decodeTilesetImages()
+{
+    JobSystem::parallelFor(tilesets.size(), 1, [this](size_t begin, size_t end)
+                           {
+        for (size_t i = begin; i < end; i++)
+        {
+            if (tilesets[i])
+            {
+                tilesets[i]->decodeImage();
+            }
+        } }, "DecodeTilesets", "general");
+
+    int decoded = 0;
+    for (const auto &tileset : tilesets)
+    {
+        if (tileset && tileset->baked_pixels)
+        {
+            decoded++;
+        }
+    }
+
+    printf("Decoded %d of %d tileset images\n", decoded, static_cast<int>(tilesets.size()));
+    return decoded;
+}
+
+void tmx::collectTileGIDs(const TMXLayer &layer, std::set<int> &gids)
+{
+    for (int gid : layer.data)
+    {
+        if (gid != 0)
+        {
+            gids.insert(gid);
+        }
+    }
+}
+
+size_t tmx::createTileSprites(const std::set<int> &gids) const
+{
+    size_t created = 0;
+    for (int gid : gids)
+    {
+        auto tileset = findTilesetForGID(gid);
+        if (tileset && tileset->sprite_cache.find(gid) == tileset->sprite_cache.end())
+        {
+            tileset->getSpriteForGID(gid);
+            created++;
+        }
+    }
+    return created;
+}
+
+size_t tmx::createTileSprites()
+{
+    std::set<int> gids;
+    for (const auto &layer : layers)
+    {
+        if (layer)
+        {
+            collectTileGIDs(*layer, gids);
+        }
+    }
+    return createTileSprites(gids);
+}
+
 void tmx::mapToWorldCoords(int map_x, int map_y, float world_x, float world_y, float &tile_world_x, float &tile_world_y) const
 {
     // Convert from TMX coordinate system (0,0 top-left, Y down) to rendering system (Y up)
@@ -997,13 +1161,47 @@ bool tmx::worldToMapCoords(float world_x, float world_y, float base_world_x, flo
 }
 
 // TMXTileset implementation
-bool TMXTileset::containsGID(int gid) const
+bool TMXTileset::hasImage() const
+{
+    return baked_pixels != nullptr || (tsx_data && !tsx_data->empty());
+}
+
+bool TMXTileset::decodeImage()
 {
+    if (baked_pixels)
+    {
+        return true;
+    }
     if (!tsx_data || tsx_data->empty())
     {
         return false;
     }
 
+    auto pixels = std::make_shared<std::vector<uint8_t>>();
+    int image_width = 0;
+    int image_height = 0;
+    if (!tsx_data->decodeImage(*pixels, image_width, image_height))
+    {
+        printf("Failed to decode image of tileset '%s'\n", name.c_str());
+        return false;
+    }
+
+    baked_image_width = image_width;
+    baked_image_height = image_height;
+    baked_tile_width = tsx_data->getTileWidth();
+    baked_tile_height = tsx_data->getTileHeight();
+    baked_pixels = pixels->data();
+    baked_owner = pixels;
+    return true;
+}
+
+bool TMXTileset::containsGID(int gid) const
+{
+    if (!hasImage())
+    {
+        return false;
+    }
+
     // For now, assume tilesets have a reasonable upper limit
     // In a real implementation, you'd want to calculate this from the tileset image dimensions
     return gid >= first_gid && gid < first_gid + 1000; // Arbitrary limit for now
@@ -1011,7 +1209,7 @@ bool TMXTileset::containsGID(int gid) const
 
 bool TMXTileset::getLocalTileCoords(int gid, int &tile_x, int &tile_y) const
 {
-    if (!containsGID(gid) || !tsx_data || tsx_data->empty())
+    if (!containsGID(gid))
     {
         return false;
     }
@@ -1020,8 +1218,8 @@ bool TMXTileset::getLocalTileCoords(int gid, int &tile_x, int &tile_y) const
 
     // Calculate tile coordinates based on tileset layout
     // This assumes a standard grid layout
-    int tileset_width = tsx_data->getTileWidth();
-    int source_width = tsx_data->getSourceWidth();
+    int tileset_width = baked_pixels ? baked_tile_width : tsx_data->getTileWidth();
+    int source_width = baked_pixels ? baked_image_width : tsx_data->getSourceWidth();
     if (tileset_width <= 0)
         return false;
 
@@ -1035,7 +1233,7 @@ bool TMXTileset::getLocalTileCoords(int gid, int &tile_x, int &tile_y) const
 
 CF_Sprite TMXTileset::getSpriteForGID(int gid) const
 {
-    if (!containsGID(gid) || !tsx_data || tsx_data->empty())
+    if (!containsGID(gid))
     {
         return cf_sprite_defaults();
     }
@@ -1060,7 +1258,30 @@ CF_Sprite TMXTileset::getSpriteForGID(int gid) const
     // tile_y = 1;
     // Create the sprite using TSX
     printf("Creating sprite for GID %d at tile coords (%d, %d)\n", gid, tile_x, tile_y);
-    CF_Sprite sprite = tsx_data->getTile(tile_x, tile_y);
+    CF_Sprite sprite;
+    if (baked_pixels)
+    {
+        // Crop straight from the baked image (no file access or PNG decode)
+        int pixel_x = tile_x * baked_tile_width;
+        int pixel_y = tile_y * baked_tile_height;
+        if (pixel_x + baked_tile_width > baked_image_width || pixel_y + baked_tile_height > baked_image_height)
+        {
+            printf("Tile bounds exceed baked image dimensions for GID %d\n", gid);
+            return cf_sprite_defaults();
+        }
+
+        std::vector<CF_Pixel> tile_pixels(baked_tile_width * baked_tile_height);
+        for (int y = 0; y < baked_tile_height; y++)
+        {
+            const uint8_t *src = baked_pixels + (static_cast<size_t>(pixel_y + y) * baked_image_width + pixel_x) * 4;
+            memcpy(&tile_pixels[y * baked_tile_width], src, static_cast<size_t>(baked_tile_width) * 4);
+        }
+        sprite = cf_make_easy_sprite_from_pixels(tile_pixels.data(), baked_tile_width, baked_tile_height);
+    }
+    else
+    {
+        sprite = tsx_data->getTile(tile_x, tile_y);
+    }
 
     // Cache the sprite for future use
     sprite_cache[gid] = sprite;
@@ -1097,6 +1318,22 @@ int TMXLayer::getTileGID(int x, int y) const
     return 0;
 }
 
+bool TMXLayer::setTileGID(int x, int y, int gid)
+{
+    int index = y * width + x;
+    if (!isValidCoordinate(x, y) || index >= static_cast<int>(data.size()))
+    {
+        return false;
+    }
+
+    if (data[index] != gid)
+    {
+        data[index] = gid;
+        markModified();
+    }
+    return true;
+}
+
 bool TMXLayer::isValidCoordinate(int x, int y) const
 {
     // Valid coordinates are within bounds: 0 <= x < width, 0 <= y < height
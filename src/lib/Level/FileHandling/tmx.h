@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <set>
 #include <pugixml.hpp>
 #include <cute.h>
 #include "tsx.h"
@@ -13,6 +14,7 @@ struct TMXTileset;
 struct TMXLayer;
 class Camera;
 class DataFile;
+class LevelPackage;
 
 // Structure to represent a line segment (edge)
 struct EdgeLine
@@ -53,26 +55,63 @@ private:
     // Layer outer border highlighting configuration (layer name -> should highlight outer borders only)
     std::map<std::string, bool> layer_outer_border_highlight_map;
 
-    // Cached border edges for each layer (layer index -> vector of edge AABBs)
-    mutable std::map<int, std::vector<CF_Aabb>> layer_border_cache;
-
-    // Cached outer border edge lines for each layer (layer index -> vector of edge lines)
-    mutable std::map<int, std::vector<EdgeLine>> layer_outer_border_cache;
+    // Border highlight geometry for one layer, bucketed into chunks of
+    // BORDER_CHUNK_SIZE x BORDER_CHUNK_SIZE tiles (row-major, TMX Y-down)
+    struct LayerBorderCache
+    {
+        unsigned int version = 0;                          // TMXLayer::version the geometry was built from
+        bool valid = false;                                // False until built (or after invalidation)
+        float world_x = 0.0f;                              // World offset the geometry was built for
+        float world_y = 0.0f;
+        int chunks_x = 0;                                  // Chunk grid size
+        int chunks_y = 0;
+        size_t edge_count = 0;                             // Totals across all chunks (for logging)
+        size_t line_count = 0;
+        std::vector<std::vector<CF_Aabb>> chunk_edges;     // Border tile AABBs per chunk
+        std::vector<std::vector<EdgeLine>> chunk_lines;    // Outer border lines per chunk
+    };
+
+    // Cached border geometry (indexed by layer index)
+    mutable std::vector<LayerBorderCache> layer_border_cache;
 
     // Helper functions
     bool loadTilesets();
-    void parseCSVData(const std::string &csv_data, std::vector<int> &tile_data) const;
 
 protected:
     virtual bool loadLayers();
+
+    // Decode a layer's <data> element into layer.data (csv, base64 with optional zlib/gzip/zstd, or <tile> elements)
+    // Returns false if the encoding is unsupported or the data is malformed
+    bool decodeLayerData(const pugi::xml_node &data_node, TMXLayer &layer) const;
     std::shared_ptr<TMXTileset> findTilesetForGID(int gid) const;
 
+    // Set map properties and tilesets directly (used when loading from a cooked level package)
+    void setMapProperties(const std::string &path, int map_width, int map_height, int tile_width, int tile_height);
+    void addTileset(std::shared_ptr<TMXTileset> tileset);
+
+    // Collect the non-empty GIDs used by a layer
+    static void collectTileGIDs(const TMXLayer &layer, std::set<int> &gids);
+
+    // Create (and cache) the sprites for a set of GIDs, returns how many were created
+    size_t createTileSprites(const std::set<int> &gids) const;
+
 private:
-    // Calculate border edges for a layer (returns AABBs for each border tile)
-    std::vector<CF_Aabb> calculateLayerBorderEdges(int layer_index, float world_x, float world_y) const;
+    // Tiles per side of a border cache chunk
+    static constexpr int BORDER_CHUNK_SIZE = 16;
 
-    // Calculate outer border edge lines for a layer (returns individual edge lines)
-    std::vector<EdgeLine> calculateLayerOuterBorderLines(int layer_index, float world_x, float world_y) const;
+    // Check if a layer has border or outer border highlighting configured
+    bool isBorderHighlighted(const std::string &layer_name) const;
+    bool isOuterBorderHighlighted(const std::string &layer_name) const;
+
+    // Rebuild the border cache of every highlighted layer whose version or world offset changed
+    // Stale layers are rebuilt in parallel (one job per layer)
+    void updateLayerBorderCaches(float world_x, float world_y) const;
+
+    // Calculate border edges for a layer into the cache chunks (AABBs for each border tile)
+    void calculateLayerBorderEdges(const TMXLayer &layer, float world_x, float world_y, LayerBorderCache &cache) const;
+
+    // Calculate outer border edge lines for a layer into the cache chunks (individual edge lines)
+    void calculateLayerOuterBorderLines(const TMXLayer &layer, float world_x, float world_y, LayerBorderCache &cache) const;
 
 public:
     tmx() = default;
@@ -104,6 +143,17 @@ public:
     int getTilesetCount() const { return static_cast<int>(tilesets.size()); }
     std::shared_ptr<TMXTileset> getTileset(int index) const;
 
+    // Resolve a tileset's TSX path (relative to the map file), empty for inline tilesets
+    std::string getTilesetSourcePath(const TMXTileset &tileset) const;
+
+    // Load a fresh copy of a tileset (first GID, source and name) from a TSX and decode its image
+    // No GPU work, worker safe; used to hot reload edited tilesets
+    // Returns nullptr if the TSX or its image cannot be loaded
+    static std::shared_ptr<TMXTileset> loadTilesetCopy(const TMXTileset &tileset, const std::string &tsx_path);
+
+    // Replace a tileset, e.g. with a reloaded copy; tile sprites are recreated by createTileSprites
+    bool replaceTileset(int index, std::shared_ptr<TMXTileset> tileset);
+
     // Get a tile sprite at specific layer and map coordinates
     // Note: TMX uses (0,0) top-left, +Y down, but rendering converts to Y-up coordinate system
     CF_Sprite getTileAt(int layer_index, int map_x, int map_y) const;
@@ -143,6 +193,14 @@ public:
     // Configure layer highlighting from config (processes once and stores in map)
     void setLayerHighlightConfig(const class DataFile &config);
 
+    // Decode every tileset image in parallel (worker threads, no GPU work)
+    // Returns the number of tilesets that have an image afterwards
+    int decodeTilesetImages();
+
+    // Create the sprites of every tile used by the layers (main thread, uploads textures)
+    // Returns the number of distinct tiles created
+    virtual size_t createTileSprites();
+
     // Cache management
     void clearAllSpriteCaches();
 };
@@ -155,10 +213,27 @@ struct TMXTileset
     std::string name;              // Tileset name
     std::shared_ptr<tsx> tsx_data; // The actual tileset data
 
+    // Tileset image baked into a cooked level package or decoded by decodeImage (RGBA8),
+    // used instead of tsx_data when set
+    const uint8_t *baked_pixels;
+    int baked_image_width;
+    int baked_image_height;
+    int baked_tile_width;
+    int baked_tile_height;
+    std::shared_ptr<const void> baked_owner; // Keeps the pixels alive (mapped package or decoded buffer)
+
     // Tile sprite cache to avoid regenerating the same sprites
     mutable std::map<int, CF_Sprite> sprite_cache;
 
-    TMXTileset() : first_gid(0) {}
+    TMXTileset() : first_gid(0), baked_pixels(nullptr), baked_image_width(0), baked_image_height(0),
+                   baked_tile_width(0), baked_tile_height(0) {}
+
+    // Check if the tileset image is available (parsed TSX or baked pixels)
+    bool hasImage() const;
+
+    // Decode the TSX image once so tiles are cropped from memory instead of re-reading the PNG
+    // Does no GPU work, safe to call on a worker thread before any sprite is created
+    bool decodeImage();
 
     // Convert global ID to local tile coordinates
     bool getLocalTileCoords(int gid, int &tile_x, int &tile_y) const;
@@ -184,14 +259,22 @@ struct TMXLayer
     bool visible;          // Layer visibility
     float opacity;         // Layer opacity (0.0 - 1.0)
     std::vector<int> data; // Tile data (global IDs) in row-major order
+    unsigned int version;  // Bumped whenever data changes (invalidates derived caches)
 
-    TMXLayer() : id(0), width(0), height(0), visible(true), opacity(1.0f) {}
+    TMXLayer() : id(0), width(0), height(0), visible(true), opacity(1.0f), version(0) {}
 
     // Get tile global ID at specific layer coordinates
     // x: horizontal position (0 = leftmost)
     // y: vertical position (0 = topmost)
     int getTileGID(int x, int y) const;
 
+    // Set tile global ID at specific layer coordinates (bumps version)
+    // Returns false if the coordinates are out of bounds
+    bool setTileGID(int x, int y, int gid);
+
+    // Mark the tile data as changed after writing to data directly
+    void markModified() { version++; }
+
     // Check if coordinates are within layer bounds
     bool isValidCoordinate(int x, int y) const;
 };
@@ -468,3 +468,83 @@ int tsx::getSourceHeight() const
 
     return static_cast<int>(ihdr.height);
 }
+
+std::string tsx::getImagePath() const
+{
+    if (empty())
+    {
+        return "";
+    }
+
+    pugi::xml_node image_node = document_element().child("image");
+    std::string image_source = image_node ? image_node.attribute("source").value() : "";
+    if (image_source.empty())
+    {
+        return "";
+    }
+
+    // Image path is relative to the TSX file location
+    size_t last_slash = path.find_last_of("/\\");
+    if (last_slash != std::string::npos)
+    {
+        return path.substr(0, last_slash + 1) + image_source;
+    }
+    return image_source;
+}
+
+bool tsx::decodeImage(std::vector<uint8_t> &pixels, int &width, int &height) const
+{
+    std::string image_path = getImagePath();
+    if (image_path.empty())
+    {
+        printf("No image source found in TSX file\n");
+        return false;
+    }
+
+    size_t file_size = 0;
+    void *file_data = cf_fs_read_entire_file_to_memory(image_path.c_str(), &file_size);
+    if (file_data == nullptr)
+    {
+        printf("Failed to read PNG file: %s\n", image_path.c_str());
+        return false;
+    }
+
+    spng_ctx *ctx = spng_ctx_new(0);
+    if (ctx == nullptr)
+    {
+        printf("Failed to create spng context\n");
+        cf_free(file_data);
+        return false;
+    }
+
+    struct spng_ihdr ihdr;
+    size_t image_size = 0;
+    int ret = spng_set_png_buffer(ctx, file_data, file_size);
+    if (ret == 0)
+    {
+        ret = spng_get_ihdr(ctx, &ihdr);
+    }
+    if (ret == 0)
+    {
+        ret = spng_decoded_image_size(ctx, SPNG_FMT_RGBA8, &image_size);
+    }
+    if (ret == 0)
+    {
+        pixels.resize(image_size);
+        ret = spng_decode_image(ctx, pixels.data(), image_size, SPNG_FMT_RGBA8, 0);
+    }
+
+    spng_ctx_free(ctx);
+    cf_free(file_data);
+
+    if (ret != 0)
+    {
+        printf("Failed to decode PNG file %s: %s\n", image_path.c_str(), spng_strerror(ret));
+        pixels.clear();
+        return false;
+    }
+
+    width = static_cast<int>(ihdr.width);
+    height = static_cast<int>(ihdr.height);
+    return true;
+}
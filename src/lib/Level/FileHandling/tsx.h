@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <cstdint>
 #include <pugixml.hpp>
 #include <cute.h>
 
@@ -32,4 +34,10 @@ public:
     // Get source image dimensions
     int getSourceWidth() const;
     int getSourceHeight() const;
+
+    // Get the VFS path of the tileset image (empty if the TSX has no image)
+    std::string getImagePath() const;
+
+    // Decode the whole tileset image to RGBA8 (used when cooking level packages)
+    bool decodeImage(std::vector<uint8_t> &pixels, int &width, int &height) const;
 };
@@ -0,0 +1,75 @@
+#include "AgentComponents.h"
+
+void AgentComponents::add(const AnimatedDataCharacterNavMeshAgent &agent)
+{
+    positions.push_back(agent.getPosition());
+    moveVectors.push_back(agent.getBackgroundMoveVector());
+    directions.push_back(agent.getCurrentDirection());
+    stages.push_back(agent.getStageOfLife());
+    currentPolygons.push_back(agent.getCurrentPolygon());
+    animationStepping.push_back(agent.getAnimationStepping() ? 1 : 0);
+    onScreen.push_back(agent.getIsOnScreen() ? 1 : 0);
+    coordinated.push_back(0);
+    visibilityDirty.push_back(0);
+    lods.push_back(agent.getSimulationLOD());
+    lodTimes.push_back(0.0f);
+}
+
+namespace
+{
+    // Move the last element into index and drop the last element
+    template <typename T>
+    void swapRemove(std::vector<T> &values, size_t index)
+    {
+        values[index] = values.back();
+        values.pop_back();
+    }
+}
+
+void AgentComponents::remove(size_t index)
+{
+    if (index >= size())
+    {
+        return;
+    }
+
+    swapRemove(positions, index);
+    swapRemove(moveVectors, index);
+    swapRemove(directions, index);
+    swapRemove(stages, index);
+    swapRemove(currentPolygons, index);
+    swapRemove(animationStepping, index);
+    swapRemove(onScreen, index);
+    swapRemove(coordinated, index);
+    swapRemove(visibilityDirty, index);
+    swapRemove(lods, index);
+    swapRemove(lodTimes, index);
+}
+
+void AgentComponents::clear()
+{
+    positions.clear();
+    moveVectors.clear();
+    directions.clear();
+    stages.clear();
+    currentPolygons.clear();
+    animationStepping.clear();
+    onScreen.clear();
+    coordinated.clear();
+    visibilityDirty.clear();
+    lods.clear();
+    lodTimes.clear();
+}
+
+void AgentComponents::gather(size_t index, const AnimatedDataCharacterNavMeshAgent &agent)
+{
+    if (index >= size())
+    {
+        return;
+    }
+
+    positions[index] = agent.getPosition();
+    directions[index] = agent.getCurrentDirection();
+    stages[index] = agent.getStageOfLife();
+    currentPolygons[index] = agent.getCurrentPolygon();
+}
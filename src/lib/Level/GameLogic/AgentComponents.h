@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cute.h>
+#include <vector>
+#include <cstdint>
+#include "AnimatedDataCharacterNavMeshAgent.h"
+
+using namespace Cute;
+
+/**
+ * AgentComponents - Per-frame agent state stored as contiguous arrays (structure of arrays)
+ *
+ * Every array is parallel to LevelV1's agent list: element i belongs to agent i. The level's
+ * per-frame passes (simulation tier selection, visibility, spatial grid updates) sweep these
+ * arrays linearly instead of dereferencing every agent object.
+ *
+ * The agent objects stay authoritative. Their fields are gathered back into the arrays after
+ * the agent changed them (a tick, a spawn position, a stage of life change), and values picked
+ * by the level (simulation tier, animation stepping, visibility) are pushed to the agent only
+ * when they change.
+ */
+struct AgentComponents
+{
+    std::vector<v2> positions;
+    std::vector<v2> moveVectors; // Last background AI move vector
+    std::vector<Direction> directions;
+    std::vector<StageOfLife> stages;
+    std::vector<int> currentPolygons; // Navmesh polygon (-1 if off the mesh)
+    std::vector<uint8_t> animationStepping;
+    std::vector<uint8_t> onScreen;    // Inside the camera view
+    std::vector<uint8_t> coordinated; // In the Coordinator's on-screen set
+    std::vector<uint8_t> visibilityDirty; // Queued for a visibility re-check (see LevelV1::markVisibilityDirty)
+    std::vector<SimulationLOD> lods;
+    std::vector<float> lodTimes; // Time skipped by reduced-rate ticks, consumed on the next tick
+
+    /**
+     * Get the number of agents stored
+     */
+    size_t size() const { return positions.size(); }
+
+    /**
+     * Append an agent's state
+     * @param agent Agent being added at index size()
+     */
+    void add(const AnimatedDataCharacterNavMeshAgent &agent);
+
+    /**
+     * Remove the state at an index; the last agent's state moves into its place
+     * (mirrors the swap and pop of LevelV1's agent list)
+     * @param index Index of the removed agent
+     */
+    void remove(size_t index);
+
+    /**
+     * Remove all agent state
+     */
+    void clear();
+
+    /**
+     * Copy the fields an agent owns back into the arrays (after it changed them)
+     * @param index Index of the agent
+     * @param agent The agent at that index
+     */
+    void gather(size_t index, const AnimatedDataCharacterNavMeshAgent &agent);
+};
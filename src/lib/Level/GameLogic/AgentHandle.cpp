@@ -0,0 +1,87 @@
+#include "AgentHandle.h"
+
+AgentHandle AgentHandleTable::create()
+{
+    uint32_t slotIndex;
+    if (!freeSlots.empty())
+    {
+        slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        slotIndex = static_cast<uint32_t>(slots.size());
+        slots.push_back(Slot{AgentHandle::NULL_INDEX, 0});
+    }
+
+    Slot &slot = slots[slotIndex];
+    slot.denseIndex = static_cast<uint32_t>(denseSlots.size());
+    denseSlots.push_back(slotIndex);
+
+    AgentHandle handle;
+    handle.index = slotIndex;
+    handle.generation = slot.generation;
+    return handle;
+}
+
+void AgentHandleTable::remove(size_t denseIndex)
+{
+    if (denseIndex >= denseSlots.size())
+    {
+        return;
+    }
+
+    // The last agent takes the removed agent's place
+    uint32_t removedSlot = denseSlots[denseIndex];
+    uint32_t movedSlot = denseSlots.back();
+    denseSlots[denseIndex] = movedSlot;
+    slots[movedSlot].denseIndex = static_cast<uint32_t>(denseIndex);
+    denseSlots.pop_back();
+
+    // Outstanding handles to the removed agent stop resolving
+    slots[removedSlot].denseIndex = AgentHandle::NULL_INDEX;
+    slots[removedSlot].generation++;
+    freeSlots.push_back(removedSlot);
+}
+
+void AgentHandleTable::clear()
+{
+    for (uint32_t slotIndex : denseSlots)
+    {
+        slots[slotIndex].denseIndex = AgentHandle::NULL_INDEX;
+        slots[slotIndex].generation++;
+        freeSlots.push_back(slotIndex);
+    }
+    denseSlots.clear();
+}
+
+bool AgentHandleTable::isValid(AgentHandle handle) const
+{
+    return handle.index < slots.size() && slots[handle.index].generation == handle.generation &&
+           slots[handle.index].denseIndex != AgentHandle::NULL_INDEX;
+}
+
+size_t AgentHandleTable::getDenseIndex(AgentHandle handle) const
+{
+    return isValid(handle) ? slots[handle.index].denseIndex : SIZE_MAX;
+}
+
+size_t AgentHandleTable::getDenseIndexOfSlot(size_t slot) const
+{
+    if (slot >= slots.size() || slots[slot].denseIndex == AgentHandle::NULL_INDEX)
+    {
+        return SIZE_MAX;
+    }
+    return slots[slot].denseIndex;
+}
+
+AgentHandle AgentHandleTable::getHandle(size_t denseIndex) const
+{
+    AgentHandle handle;
+    if (denseIndex < denseSlots.size())
+    {
+        handle.index = denseSlots[denseIndex];
+        handle.generation = slots[handle.index].generation;
+    }
+    return handle;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * AgentHandle - Stable reference to an agent of a level (slot index plus generation)
+ *
+ * Unlike a pointer or an index into the agent list, a handle never silently refers to a
+ * different agent: once the agent is removed its slot's generation changes and the handle
+ * stops resolving. A default constructed handle is null.
+ */
+struct AgentHandle
+{
+    static constexpr uint32_t NULL_INDEX = UINT32_MAX;
+
+    uint32_t index = NULL_INDEX; // Slot in the AgentHandleTable
+    uint32_t generation = 0;     // Generation of the slot when the handle was created
+
+    bool isNull() const { return index == NULL_INDEX; }
+
+    /**
+     * Pack the handle into one value (for hashing and as a map key)
+     */
+    uint64_t getKey() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+
+    bool operator==(const AgentHandle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const AgentHandle &other) const { return !(*this == other); }
+};
+
+/**
+ * AgentHandleTable - Maps agent handles to positions in densely packed agent storage
+ *
+ * The storage owning the agents (LevelV1's agent list and its parallel arrays) stays packed:
+ * removing an agent moves the last one into its place (swap and pop) and the table follows
+ * the move, so handles of the other agents stay valid. Slots of removed agents are reused
+ * with a new generation. Resolving and validating a handle is O(1).
+ */
+class AgentHandleTable
+{
+private:
+    struct Slot
+    {
+        uint32_t denseIndex; // Position in the packed storage, NULL_INDEX while free
+        uint32_t generation;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::vector<uint32_t> denseSlots; // Packed position -> slot
+
+public:
+    /**
+     * Create a handle for an agent appended to the packed storage (at index size())
+     * @return The new handle
+     */
+    AgentHandle create();
+
+    /**
+     * Remove the handle of the agent at a packed index
+     * The last agent's handle moves to that index, mirroring a swap and pop of the storage.
+     * @param denseIndex Packed index of the removed agent
+     */
+    void remove(size_t denseIndex);
+
+    /**
+     * Invalidate every handle and empty the table
+     */
+    void clear();
+
+    /**
+     * Check if a handle still refers to an agent
+     */
+    bool isValid(AgentHandle handle) const;
+
+    /**
+     * Get the packed index of a handle's agent
+     * @return Packed index, or SIZE_MAX if the handle is null or stale
+     */
+    size_t getDenseIndex(AgentHandle handle) const;
+
+    /**
+     * Get the packed index of the agent in a slot (e.g. a SpatialGrid entity id)
+     * @return Packed index, or SIZE_MAX if the slot is free
+     */
+    size_t getDenseIndexOfSlot(size_t slot) const;
+
+    /**
+     * Get the handle of the agent at a packed index
+     * @return The handle, or a null handle if the index is out of range
+     */
+    AgentHandle getHandle(size_t denseIndex) const;
+
+    /**
+     * Get the number of live handles (the size of the packed storage)
+     */
+    size_t size() const { return denseSlots.size(); }
+};
@@ -0,0 +1,265 @@
+#include "AssetHotReloader.h"
+#include "LevelV1.h"
+#include "tmx.h"
+#include "tsx.h"
+#include "DataFile.h"
+#include "Utils.h"
+#include "JobSystem.h"
+#include "AnimatedDataCharacter.h"
+#include "AnimationAssetCache.h"
+#include "EntityPrototypeCache.h"
+#include <cstdio>
+#include <algorithm>
+#include <cctype>
+#include <set>
+#include <thread>
+
+// Lower case extension of a path including the dot ("" if none)
+static std::string getExtension(const std::string &path)
+{
+    size_t dot = path.find_last_of('.');
+    size_t slash = path.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        return "";
+    }
+
+    std::string extension = path.substr(dot);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c)
+                   { return static_cast<char>(std::tolower(c)); });
+    return extension;
+}
+
+// AssetHotReloader implementation
+AssetHotReloader::AssetHotReloader() : reloadCount(0)
+{
+}
+
+AssetHotReloader::~AssetHotReloader()
+{
+    // The job only touches its batch and the process-wide caches, but may still be running
+    while (batch && !batch->done.load())
+    {
+        std::this_thread::yield();
+    }
+}
+
+bool AssetHotReloader::start(const std::string &contentDirectory, const std::string &mountPoint)
+{
+    // Sidecars now go to the user directory, but older runs left some in the content directory
+    watcher.ignoreDirectory(DATA_FILE_CACHE_DIRECTORY);
+    return watcher.start(contentDirectory, mountPoint);
+}
+
+void AssetHotReloader::update(LevelV1 &level, const std::vector<AnimatedDataCharacter *> &characters)
+{
+    if (batch && batch->done.load())
+    {
+        applyBatch(level, characters);
+        batch.reset();
+    }
+
+    watcher.poll(queuedChanges);
+
+    if (!batch && !queuedChanges.empty())
+    {
+        std::vector<std::string> changedPaths;
+        changedPaths.swap(queuedChanges);
+        startBatch(level, changedPaths);
+    }
+}
+
+void AssetHotReloader::startBatch(const LevelV1 &level, const std::vector<std::string> &changedPaths)
+{
+    auto next = std::make_shared<ReloadBatch>();
+
+    std::set<std::string> changedTilesetFiles;
+    for (const std::string &path : std::set<std::string>(changedPaths.begin(), changedPaths.end()))
+    {
+        std::string extension = getExtension(path);
+        if (extension == ".json")
+        {
+            if (path.ends_with("/entities.json"))
+            {
+                printf("AssetHotReloader: %s changed, load the level again to apply it\n", path.c_str());
+                continue;
+            }
+
+            // Same second and size as the cached copy would pass validation, drop it explicitly
+            DataFile::invalidateCachedDocument(path);
+            next->dataPaths.push_back(path);
+        }
+        else if (extension == ".png")
+        {
+            next->imagePaths.push_back(path);
+            changedTilesetFiles.insert(normalize_virtual_path(path));
+        }
+        else if (extension == ".tsx")
+        {
+            changedTilesetFiles.insert(normalize_virtual_path(path));
+        }
+        else if (extension == ".tmx")
+        {
+            printf("AssetHotReloader: %s changed, load the level again to apply it\n", path.c_str());
+        }
+    }
+
+    // Tilesets of resident maps whose TSX or image changed (one load per TSX and first GID)
+    if (!changedTilesetFiles.empty())
+    {
+        for (LevelMap *map : level.getResidentMaps())
+        {
+            for (int i = 0; i < map->getTilesetCount(); ++i)
+            {
+                auto tileset = map->getTileset(i);
+                std::string sourcePath = tileset ? normalize_virtual_path(map->getTilesetSourcePath(*tileset)) : "";
+                if (sourcePath.empty())
+                {
+                    continue;
+                }
+
+                // Tilesets baked into a level package have no parsed TSX, read it for the image path
+                std::string imagePath = tileset->tsx_data ? tileset->tsx_data->getImagePath()
+                                                          : tsx(map->getTilesetSourcePath(*tileset)).getImagePath();
+                if (changedTilesetFiles.count(sourcePath) == 0 &&
+                    changedTilesetFiles.count(normalize_virtual_path(imagePath)) == 0)
+                {
+                    continue;
+                }
+
+                bool queued = std::any_of(next->tilesets.begin(), next->tilesets.end(), [&](const TilesetReload &reload)
+                                          { return reload.sourcePath == sourcePath && reload.request->first_gid == tileset->first_gid; });
+                if (!queued)
+                {
+                    TilesetReload reload;
+                    reload.sourcePath = sourcePath;
+                    reload.request = std::make_shared<TMXTileset>();
+                    reload.request->first_gid = tileset->first_gid;
+                    reload.request->source = tileset->source;
+                    reload.request->name = tileset->name;
+                    next->tilesets.push_back(reload);
+                }
+            }
+        }
+    }
+
+    if (next->dataPaths.empty() && next->imagePaths.empty() && next->tilesets.empty())
+    {
+        return;
+    }
+
+    printf("AssetHotReloader: Preparing %zu data files, %zu images and %zu tilesets\n",
+           next->dataPaths.size(), next->imagePaths.size(), next->tilesets.size());
+
+    batch = next;
+    auto job = [next]()
+    {
+        // Parse into the document cache, the main thread's reload then only copies
+        for (const std::string &path : next->dataPaths)
+        {
+            DataFile document;
+            if (!document.load(path))
+            {
+                printf("AssetHotReloader: Failed to parse %s\n", path.c_str());
+            }
+        }
+
+        AnimationAssetCache::prefetchSheets(next->imagePaths);
+
+        JobSystem::parallelFor(next->tilesets.size(), 1, [&](size_t begin, size_t end)
+                               {
+            for (size_t i = begin; i < end; i++)
+            {
+                TilesetReload &reload = next->tilesets[i];
+                reload.loaded = tmx::loadTilesetCopy(*reload.request, "/" + reload.sourcePath);
+            } }, "Reload Tilesets", "general");
+
+        next->done.store(true);
+    };
+
+    if (!JobSystem::isInitialized())
+    {
+        // No workers - prepare inline, the next update applies it
+        job();
+        return;
+    }
+
+    JobSystem::submitJob(job, "Prepare Asset Reload", "general");
+    JobSystem::kick();
+}
+
+void AssetHotReloader::applyBatch(LevelV1 &level, const std::vector<AnimatedDataCharacter *> &characters)
+{
+    // Entity types affected by the changed files (sheets are dropped from the animation cache here,
+    // after the job decoded their new contents)
+    std::set<std::string> folders;
+    for (const std::string &path : batch->dataPaths)
+    {
+        for (const std::string &folder : EntityPrototypeCache::findDependents(path))
+        {
+            folders.insert(folder);
+        }
+    }
+    if (!batch->imagePaths.empty())
+    {
+        for (const std::string &folder : AnimationAssetCache::invalidateSheets(batch->imagePaths))
+        {
+            folders.insert(folder);
+        }
+    }
+
+    size_t reboundCount = 0;
+    for (const std::string &folder : folders)
+    {
+        std::shared_ptr<const EntityPrototype> prototype = EntityPrototypeCache::reload(folder);
+        if (!prototype)
+        {
+            continue;
+        }
+
+        reboundCount += level.rebindAgents(folder, prototype);
+        for (AnimatedDataCharacter *character : characters)
+        {
+            if (character && character->getPrototype() && character->getPrototype()->folderPath == folder &&
+                character->rebindPrototype(prototype))
+            {
+                reboundCount++;
+            }
+        }
+    }
+
+    // Swap reloaded tilesets into the maps still resident, then recreate only their tiles
+    size_t refreshedMaps = 0;
+    for (LevelMap *map : level.getResidentMaps())
+    {
+        bool replaced = false;
+        for (int i = 0; i < map->getTilesetCount(); ++i)
+        {
+            auto tileset = map->getTileset(i);
+            if (!tileset)
+            {
+                continue;
+            }
+
+            std::string sourcePath = normalize_virtual_path(map->getTilesetSourcePath(*tileset));
+            for (const TilesetReload &reload : batch->tilesets)
+            {
+                if (reload.loaded && reload.sourcePath == sourcePath && reload.request->first_gid == tileset->first_gid)
+                {
+                    replaced = map->replaceTileset(i, reload.loaded) || replaced;
+                    break;
+                }
+            }
+        }
+
+        if (replaced)
+        {
+            level.refreshMapTiles(*map);
+            refreshedMaps++;
+        }
+    }
+
+    reloadCount++;
+    printf("AssetHotReloader: Reloaded %zu entity types (%zu characters rebound) and %zu maps' tiles\n",
+           folders.size(), reboundCount, refreshedMaps);
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include "AssetWatcher.h"
+
+// Forward declarations
+class LevelV1;
+class AnimatedDataCharacter;
+struct TMXTileset;
+
+/**
+ * AssetHotReloader - Reloads edited assets while the game runs
+ *
+ * Watches the mounted content directory (see AssetWatcher) and prepares each settled set of
+ * changes on the JobSystem:
+ * - JSON files (character.json, action.json, hitbox.json, state machines) are dropped from the
+ *   DataFile caches and parsed again
+ * - animation sheets used by loaded animation tables are decoded again
+ * - TSX files and tileset images used by resident maps are loaded and decoded again
+ *
+ * Once the job finished, update() swaps the results in at the start of a frame on the main
+ * thread. Only the entity prototypes that read a changed file are rebuilt and the agents created
+ * from them rebound, and only maps using a changed tileset recreate their tiles.
+ * Map layouts (TMX) and entities.json are not reloaded, they need the level to be loaded again.
+ */
+class AssetHotReloader
+{
+private:
+    /**
+     * A tileset of a resident map to load again
+     */
+    struct TilesetReload
+    {
+        std::string sourcePath;              // TSX path (normalized)
+        std::shared_ptr<TMXTileset> request; // First GID, source and name of the tileset
+        std::shared_ptr<TMXTileset> loaded;  // Set by the job, nullptr if loading failed
+    };
+
+    /**
+     * A set of changes being prepared on a worker
+     */
+    struct ReloadBatch
+    {
+        std::vector<std::string> dataPaths;  // Changed JSON files
+        std::vector<std::string> imagePaths; // Changed PNG files
+        std::vector<TilesetReload> tilesets;
+        std::atomic<bool> done{false};
+    };
+
+    AssetWatcher watcher;
+
+    // Changes seen while a batch was in flight, they start the next batch
+    std::vector<std::string> queuedChanges;
+
+    // Batch in flight (nullptr if none)
+    std::shared_ptr<ReloadBatch> batch;
+
+    size_t reloadCount;
+
+    /**
+     * Sort changed files into a batch and start preparing it on the JobSystem
+     * @param level Level whose resident maps are checked for changed tilesets
+     * @param changedPaths Changed VFS paths
+     */
+    void startBatch(const LevelV1 &level, const std::vector<std::string> &changedPaths);
+
+    /**
+     * Swap a prepared batch into the caches, the level and the given characters (main thread)
+     */
+    void applyBatch(LevelV1 &level, const std::vector<AnimatedDataCharacter *> &characters);
+
+public:
+    AssetHotReloader();
+
+    /**
+     * Destructor - waits for a batch still being prepared on the JobSystem
+     */
+    ~AssetHotReloader();
+
+    AssetHotReloader(const AssetHotReloader &) = delete;
+    AssetHotReloader &operator=(const AssetHotReloader &) = delete;
+
+    /**
+     * Start watching the content directory
+     * @param contentDirectory Real path of the content directory
+     * @param mountPoint VFS mount point of the content directory ("/assets")
+     * @return true if watching is supported and started
+     */
+    bool start(const std::string &contentDirectory, const std::string &mountPoint);
+
+    /**
+     * Check if the content directory is being watched
+     */
+    bool isWatching() const { return watcher.isWatching(); }
+
+    /**
+     * Apply a prepared batch and start preparing new changes. Call once per frame on the main
+     * thread, before the level updates its agents.
+     * @param level Current level
+     * @param characters Characters owned outside the level (e.g. the player) to rebind as well
+     */
+    void update(LevelV1 &level, const std::vector<AnimatedDataCharacter *> &characters);
+
+    /**
+     * Get the number of batches applied so far
+     */
+    size_t getReloadCount() const { return reloadCount; }
+};
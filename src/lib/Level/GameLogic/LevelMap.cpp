@@ -1,10 +1,11 @@
 #include "LevelMap.h"
 #include "DataFile.h"
 #include "CFNativeCamera.h"
+#include "NavMesh.h"
+#include "JobSystem.h"
 #include <cstdio>
 #include <algorithm>
 #include <cctype>
-#include <sstream>
 
 LevelMap::LevelMap(const std::string &path)
     : tmx() // Call default constructor, not the one that calls parse()
@@ -21,14 +22,10 @@ bool LevelMap::loadLayers()
     // Handles structure layers, navmesh layers, and regular layers
 
     pugi::xml_node map_node = document_element();
-    int regular_layer_count = 0;
-    int navmesh_layer_count = 0;
-    int structure_layer_count = 0;
-    int cut_bottom_count = 0;
-    int cut_top_count = 0;
-    int cut_right_count = 0;
-    int cut_left_count = 0;
 
+    // Read layer attributes in document order
+    std::vector<pugi::xml_node> data_nodes;
+    std::vector<std::shared_ptr<TMXLayer>> parsed_layers;
     for (pugi::xml_node layer_node : map_node.children("layer"))
     {
         auto layer = std::make_shared<TMXLayer>();
@@ -52,120 +49,305 @@ bool LevelMap::loadLayers()
             continue;
         }
 
-        std::string encoding = data_node.attribute("encoding").value();
+        data_nodes.push_back(data_node);
+        parsed_layers.push_back(layer);
+    }
 
-        if (encoding == "csv" || encoding.empty())
+    // Decode tile data of all layers in parallel (the XML document is only read)
+    std::vector<char> decoded(parsed_layers.size(), 0);
+    JobSystem::parallelFor(parsed_layers.size(), 1, [&](size_t begin, size_t end)
+                           {
+        for (size_t i = begin; i < end; i++)
         {
-            // Parse CSV data inline
-            std::string csv_data = data_node.text().get();
-            layer->data.clear();
+            decoded[i] = decodeLayerData(data_nodes[i], *parsed_layers[i]) ? 1 : 0;
+        } }, "DecodeLayers", "general");
 
-            std::istringstream stream(csv_data);
-            std::string line;
-            while (std::getline(stream, line))
-            {
-                std::istringstream line_stream(line);
-                std::string cell;
-                while (std::getline(line_stream, cell, ','))
-                {
-                    // Remove whitespace
-                    cell.erase(std::remove_if(cell.begin(), cell.end(), ::isspace), cell.end());
-                    if (!cell.empty())
-                    {
-                        int tile_id = std::stoi(cell);
-                        layer->data.push_back(tile_id);
-                    }
-                }
-            }
-        }
-        else
+    // Classify in document order so the render order is unchanged
+    for (size_t i = 0; i < parsed_layers.size(); i++)
+    {
+        if (!decoded[i])
         {
-            printf("Warning: Unsupported encoding '%s' for layer '%s'\n",
-                   encoding.c_str(), layer->name.c_str());
             continue;
         }
 
         printf("Layer '%s' loaded with %d tiles\n",
-               layer->name.c_str(), static_cast<int>(layer->data.size()));
+               parsed_layers[i]->name.c_str(), static_cast<int>(parsed_layers[i]->data.size()));
 
-        // Determine layer type based on name (case-insensitive)
-        std::string layer_name_lower = layer->name;
-        std::transform(layer_name_lower.begin(), layer_name_lower.end(), layer_name_lower.begin(), ::tolower);
+        addLayerByName(parsed_layers[i]);
+    }
 
-        // Check if this is a structure layer (starts with "structure" or "structure_")
-        bool is_structure_layer = (layer_name_lower.find("structure") == 0 ||
-                                   layer_name_lower.find("structure_") == 0 ||
-                                   layer_name_lower.find("structure ") == 0);
+    return printLayerSummary();
+}
 
-        if (is_structure_layer)
+size_t LevelMap::createTileSprites()
+{
+    std::set<int> gids;
+    for (const auto &layer : layers)
+    {
+        collectTileGIDs(*layer, gids);
+    }
+    for (const auto &structure : structures)
+    {
+        if (structure)
         {
-            // Create a StructureLayer from the TMXLayer and add to structures list
-            auto structureLayer = std::make_shared<StructureLayer>(*layer);
-            structures.push_back(structureLayer);
-            structure_layer_count++;
-            printf("  -> Added to structure layers\n");
-            continue; // Skip base class layer lists
+            collectTileGIDs(*structure->getTMXLayer(), gids);
         }
+    }
+
+    size_t created = tmx::createTileSprites(gids);
+    printf("LevelMap: Created %zu tile sprites\n", created);
+    return created;
+}
+
+void LevelMap::addLayerByName(const std::shared_ptr<TMXLayer> &layer)
+{
+    // Determine layer type based on name (case-insensitive)
+    std::string layer_name_lower = layer->name;
+    std::transform(layer_name_lower.begin(), layer_name_lower.end(), layer_name_lower.begin(), ::tolower);
+
+    // Check if this is a structure layer (starts with "structure" or "structure_")
+    bool is_structure_layer = (layer_name_lower.find("structure") == 0 ||
+                               layer_name_lower.find("structure_") == 0 ||
+                               layer_name_lower.find("structure ") == 0);
 
-        // Check if this is a cut layer
-        bool is_cut_bottom = (layer_name_lower.find("cutb") == 0);
-        bool is_cut_top = (layer_name_lower.find("cutt") == 0);
-        bool is_cut_right = (layer_name_lower.find("cutr") == 0);
-        bool is_cut_left = (layer_name_lower.find("cutl") == 0);
+    if (is_structure_layer)
+    {
+        // Create a StructureLayer from the TMXLayer and add to structures list
+        auto structureLayer = std::make_shared<StructureLayer>(*layer);
+        structures.push_back(structureLayer);
+        printf("  -> Added to structure layers\n");
+        return; // Skip base class layer lists
+    }
+
+    // Check if this is a cut layer
+    bool is_cut_bottom = (layer_name_lower.find("cutb") == 0);
+    bool is_cut_top = (layer_name_lower.find("cutt") == 0);
+    bool is_cut_right = (layer_name_lower.find("cutr") == 0);
+    bool is_cut_left = (layer_name_lower.find("cutl") == 0);
+
+    if (is_cut_bottom)
+    {
+        cut_bottom_layers.push_back(layer);
+        printf("  -> Added to cut bottom layers\n");
+    }
+    else if (is_cut_top)
+    {
+        cut_top_layers.push_back(layer);
+        printf("  -> Added to cut top layers\n");
+    }
+    else if (is_cut_right)
+    {
+        cut_right_layers.push_back(layer);
+        printf("  -> Added to cut right layers\n");
+    }
+    else if (is_cut_left)
+    {
+        cut_left_layers.push_back(layer);
+        printf("  -> Added to cut left layers\n");
+    }
+    else
+    {
+        // Check if this is a navmesh layer
+        bool is_navmesh_layer = (layer_name_lower.find("navmesh") == 0 ||
+                                 layer_name_lower.find("nav_") == 0);
 
-        if (is_cut_bottom)
+        if (is_navmesh_layer)
+        {
+            navmesh_layers.push_back(layer);
+            printf("  -> Added to navmesh layers\n");
+        }
+        else
         {
-            cut_bottom_layers.push_back(layer);
-            cut_bottom_count++;
-            printf("  -> Added to cut bottom layers\n");
+            layers.push_back(layer);
+            printf("  -> Added to regular layers\n");
         }
-        else if (is_cut_top)
+    }
+}
+
+bool LevelMap::printLayerSummary() const
+{
+    printf("Loaded %zu regular layers, %zu navmesh layers, %zu structure layers\n",
+           layers.size(), navmesh_layers.size(), structures.size());
+    printf("        %zu cut bottom, %zu cut top, %zu cut right, %zu cut left\n",
+           cut_bottom_layers.size(), cut_top_layers.size(), cut_right_layers.size(), cut_left_layers.size());
+
+    return !layers.empty() || !navmesh_layers.empty() || !structures.empty() ||
+           !cut_bottom_layers.empty() || !cut_top_layers.empty() ||
+           !cut_right_layers.empty() || !cut_left_layers.empty();
+}
+
+bool LevelMap::loadFromPackage(std::shared_ptr<const LevelPackage> package, const std::string &path)
+{
+    if (!package || !package->isOpen())
+    {
+        return false;
+    }
+
+    const LevelPackageHeader &header = package->getHeader();
+    setMapProperties(path, header.mapWidth, header.mapHeight, header.tileWidth, header.tileHeight);
+
+    printf("TMX Map properties (package): %dx%d tiles, %dx%d pixels per tile\n",
+           header.mapWidth, header.mapHeight, header.tileWidth, header.tileHeight);
+
+    // Tilesets point straight into the baked images, the package is kept alive by each tileset
+    size_t tileset_count = 0;
+    const PackedTileset *packed_tilesets = package->getSection<PackedTileset>(LevelPackageSection::Tilesets, tileset_count);
+    for (size_t i = 0; i < tileset_count; i++)
+    {
+        const PackedTileset &packed = packed_tilesets[i];
+        const uint8_t *pixels = package->getTilesetPixels(packed);
+        if (!pixels)
         {
-            cut_top_layers.push_back(layer);
-            cut_top_count++;
-            printf("  -> Added to cut top layers\n");
+            printf("Warning: Tileset '%s' has no baked image, skipping\n", package->getString(packed.nameOffset));
+            continue;
         }
-        else if (is_cut_right)
+
+        auto tileset = std::make_shared<TMXTileset>();
+        tileset->first_gid = packed.firstGid;
+        tileset->source = package->getString(packed.sourceOffset);
+        tileset->name = package->getString(packed.nameOffset);
+        tileset->baked_pixels = pixels;
+        tileset->baked_image_width = packed.imageWidth;
+        tileset->baked_image_height = packed.imageHeight;
+        tileset->baked_tile_width = packed.tileWidth;
+        tileset->baked_tile_height = packed.tileHeight;
+        tileset->baked_owner = package;
+        addTileset(tileset);
+    }
+
+    // Layers are copied out of the raw arrays (they stay editable at runtime)
+    size_t layer_count = 0;
+    const PackedLayer *packed_layers = package->getSection<PackedLayer>(LevelPackageSection::Layers, layer_count);
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        const PackedLayer &packed = packed_layers[i];
+        const int32_t *data = package->getLayerData(packed);
+        if (!data)
         {
-            cut_right_layers.push_back(layer);
-            cut_right_count++;
-            printf("  -> Added to cut right layers\n");
+            printf("Warning: Layer '%s' data is out of range, skipping\n", package->getString(packed.nameOffset));
+            continue;
         }
-        else if (is_cut_left)
+
+        auto layer = std::make_shared<TMXLayer>();
+        layer->id = packed.id;
+        layer->name = package->getString(packed.nameOffset);
+        layer->width = packed.width;
+        layer->height = packed.height;
+        layer->visible = packed.visible != 0;
+        layer->opacity = packed.opacity;
+        layer->data.assign(data, data + static_cast<size_t>(packed.width) * static_cast<size_t>(packed.height));
+
+        printf("Loading layer: id=%d, name=%s, size=%dx%d (package)\n",
+               layer->id, layer->name.c_str(), layer->width, layer->height);
+        addLayerByName(layer);
+    }
+
+    return getTilesetCount() > 0 && printLayerSummary();
+}
+
+bool LevelMap::writeToPackage(LevelPackageWriter &writer, const std::string &levelName) const
+{
+    writer.setMapInfo(levelName, getMapWidth(), getMapHeight(), getTileWidth(), getTileHeight());
+
+    // Tileset images are decoded once here so loading never touches the PNGs
+    for (int i = 0; i < getTilesetCount(); i++)
+    {
+        auto tileset = getTileset(i);
+        if (!tileset || !tileset->tsx_data)
         {
-            cut_left_layers.push_back(layer);
-            cut_left_count++;
-            printf("  -> Added to cut left layers\n");
+            continue;
         }
-        else
+
+        std::vector<uint8_t> pixels;
+        int image_width = 0;
+        int image_height = 0;
+        if (!tileset->tsx_data->decodeImage(pixels, image_width, image_height))
         {
-            // Check if this is a navmesh layer
-            bool is_navmesh_layer = (layer_name_lower.find("navmesh") == 0 ||
-                                     layer_name_lower.find("nav_") == 0);
+            printf("LevelMap: Failed to bake tileset '%s'\n", tileset->name.c_str());
+            return false;
+        }
 
-            if (is_navmesh_layer)
-            {
-                navmesh_layers.push_back(layer);
-                navmesh_layer_count++;
-                printf("  -> Added to navmesh layers\n");
-            }
-            else
+        writer.addTileset(tileset->name, tileset->source, tileset->first_gid,
+                          tileset->tsx_data->getTileWidth(), tileset->tsx_data->getTileHeight(),
+                          image_width, image_height, pixels);
+    }
+
+    // Every layer list is written, loading sorts them back by name
+    auto writeLayer = [&writer](const TMXLayer &layer)
+    {
+        writer.addLayer(layer.name, layer.id, layer.width, layer.height, layer.visible, layer.opacity, layer.data);
+    };
+
+    for (const auto &layer : layers)
+    {
+        writeLayer(*layer);
+    }
+    for (const auto &layer : navmesh_layers)
+    {
+        writeLayer(*layer);
+    }
+    for (const auto &structure : structures)
+    {
+        writeLayer(*structure->getTMXLayer());
+    }
+    for (const auto *cut_layers : {&cut_bottom_layers, &cut_top_layers, &cut_right_layers, &cut_left_layers})
+    {
+        for (const auto &layer : *cut_layers)
+        {
+            writeLayer(*layer);
+        }
+    }
+
+    return true;
+}
+
+bool LevelMap::buildNavMesh(NavMesh &navmesh, float worldX, float worldY) const
+{
+    if (getNavMeshLayerCount() == 0)
+    {
+        printf("LevelMap Warning: No navmesh layers found in level. Navigation mesh not created.\n");
+        return false;
+    }
+
+    auto navLayer = getNavMeshLayer(0);
+    printf("LevelMap: Building navmesh from layer: %s\n", navLayer->name.c_str());
+
+    navmesh.buildFromLayer(navLayer, getTileWidth(), getTileHeight(), worldX, worldY, false);
+    printf("LevelMap: NavMesh created with %d polygons\n", navmesh.getPolygonCount());
+
+    if (navmesh.getPolygonCount() == 0)
+    {
+        return false;
+    }
+
+    // Apply navmesh cuts from cut layers
+    int total_cuts = 0;
+    auto applyCuts = [&navmesh, &total_cuts](const std::vector<std::shared_ptr<TMXLayer>> &cut_layers, NavMeshCutEdge edge, const char *label)
+    {
+        for (const auto &cutLayer : cut_layers)
+        {
+            printf("LevelMap: Processing cut layer (%s): %s\n", label, cutLayer->name.c_str());
+            for (int y = 0; y < cutLayer->height; y++)
             {
-                layers.push_back(layer);
-                regular_layer_count++;
-                printf("  -> Added to regular layers\n");
+                for (int x = 0; x < cutLayer->width; x++)
+                {
+                    if (cutLayer->getTileGID(x, y) != 0) // Tile is marked for cut
+                    {
+                        navmesh.applyCut(x, y, edge);
+                        total_cuts++;
+                    }
+                }
             }
         }
-    }
+    };
 
-    printf("Loaded %d regular layers, %d navmesh layers, %d structure layers\n",
-           regular_layer_count, navmesh_layer_count, structure_layer_count);
-    printf("        %d cut bottom, %d cut top, %d cut right, %d cut left\n",
-           cut_bottom_count, cut_top_count, cut_right_count, cut_left_count);
+    applyCuts(cut_bottom_layers, NAV_CUT_EDGE_BOTTOM, "bottom");
+    applyCuts(cut_top_layers, NAV_CUT_EDGE_TOP, "top");
+    applyCuts(cut_right_layers, NAV_CUT_EDGE_RIGHT, "right");
+    applyCuts(cut_left_layers, NAV_CUT_EDGE_LEFT, "left");
 
-    return !layers.empty() || !navmesh_layers.empty() || !structures.empty() ||
-           !cut_bottom_layers.empty() || !cut_top_layers.empty() ||
-           !cut_right_layers.empty() || !cut_left_layers.empty();
+    printf("LevelMap: Applied %d navmesh cuts\n", total_cuts);
+    return true;
 }
 
 StructureLayer::StructureLayer(const TMXLayer &tmxLayer)
@@ -212,6 +394,24 @@ void LevelMap::addStructure(std::shared_ptr<StructureLayer> structure)
     structures.push_back(structure);
 }
 
+// Slight tile overscale that hides seams between tiles at the given zoom
+static float getTileOverlapScale(float camera_zoom)
+{
+    if (camera_zoom >= 4.0f)
+    {
+        return 1.05f;
+    }
+    else if (camera_zoom >= 2.0f)
+    {
+        return 1.03f;
+    }
+    else if (camera_zoom >= 1.5f)
+    {
+        return 1.015f;
+    }
+    return 1.01f;
+}
+
 void LevelMap::renderSingleLayer(std::shared_ptr<TMXLayer> layer, const CFNativeCamera &camera, const DataFile &config, float worldX, float worldY) const
 {
     if (!layer || !layer->visible)
@@ -287,23 +487,7 @@ void LevelMap::renderSingleLayer(std::shared_ptr<TMXLayer> layer, const CFNative
             cf_draw_translate_v2(cf_v2(tile_world_x, tile_world_y));
 
             // Calculate overlap based on zoom level to prevent seams
-            float overlap_scale;
-            if (camera_zoom >= 4.0f)
-            {
-                overlap_scale = 1.05f;
-            }
-            else if (camera_zoom >= 2.0f)
-            {
-                overlap_scale = 1.03f;
-            }
-            else if (camera_zoom >= 1.5f)
-            {
-                overlap_scale = 1.015f;
-            }
-            else
-            {
-                overlap_scale = 1.01f;
-            }
+            float overlap_scale = getTileOverlapScale(camera_zoom);
             cf_draw_scale(overlap_scale, overlap_scale);
 
             if (layer->opacity < 1.0f)
@@ -316,3 +500,109 @@ void LevelMap::renderSingleLayer(std::shared_ptr<TMXLayer> layer, const CFNative
         }
     }
 }
+
+void LevelMap::buildStructureSlices(float worldX, float worldY)
+{
+    int tileWidth = getTileWidth();
+    int tileHeight = getTileHeight();
+    size_t sliceCount = 0;
+
+    for (auto &structure : structures)
+    {
+        if (!structure)
+        {
+            continue;
+        }
+
+        structure->slices.clear();
+        for (int y = 0; y < structure->height; y++)
+        {
+            StructureRowSlice slice;
+            slice.layer = structure.get();
+            slice.row = y;
+            slice.worldY = worldY + static_cast<float>((structure->height - 1 - y) * tileHeight);
+
+            for (int x = 0; x < structure->width; x++)
+            {
+                int gid = structure->getTileGID(x, y);
+                if (gid == 0)
+                    continue; // Skip empty tiles
+
+                auto tileset = findTilesetForGID(gid);
+                if (!tileset)
+                    continue;
+
+                slice.tiles.push_back(StructureSliceTile{tileset->getSpriteForGID(gid), worldX + static_cast<float>(x * tileWidth)});
+            }
+
+            if (slice.tiles.empty())
+            {
+                continue;
+            }
+
+            // Tile sprites are drawn centered on their position, so pad by half a tile
+            float halfWidth = tileWidth / 2.0f;
+            float halfHeight = tileHeight / 2.0f;
+            slice.bounds = cf_make_aabb(cf_v2(slice.tiles.front().x - halfWidth, slice.worldY - halfHeight),
+                                        cf_v2(slice.tiles.back().x + halfWidth, slice.worldY + halfHeight));
+            structure->slices.push_back(std::move(slice));
+        }
+
+        sliceCount += structure->slices.size();
+    }
+
+    printf("LevelMap: Built %zu structure slices from %zu structure layers\n", sliceCount, structures.size());
+}
+
+void LevelMap::renderStructureSlice(const StructureRowSlice &slice, const CFNativeCamera &camera, float worldX, float worldY) const
+{
+    if (slice.tiles.empty() || (slice.layer && !slice.layer->visible))
+    {
+        return;
+    }
+
+    // Round the layer origin to zoom-aware pixel boundaries to prevent seams
+    float camera_zoom = camera.getZoom();
+    float rounded_world_x;
+    float rounded_world_y;
+    if (camera_zoom != 1.0f)
+    {
+        rounded_world_x = roundf(worldX * camera_zoom) / camera_zoom;
+        rounded_world_y = roundf(worldY * camera_zoom) / camera_zoom;
+    }
+    else
+    {
+        rounded_world_x = roundf(worldX);
+        rounded_world_y = roundf(worldY);
+    }
+
+    float tile_world_y = rounded_world_y + slice.worldY;
+    if (camera_zoom != 1.0f)
+    {
+        tile_world_y = roundf(tile_world_y * camera_zoom) / camera_zoom;
+    }
+
+    // Tiles are ordered by x, so only the run overlapping the view needs drawing
+    CF_Aabb view_bounds = camera.getViewBounds();
+    float min_x = view_bounds.min.x - rounded_world_x - getTileWidth();
+    float max_x = view_bounds.max.x - rounded_world_x + getTileWidth();
+    auto first = std::lower_bound(slice.tiles.begin(), slice.tiles.end(), min_x,
+                                  [](const StructureSliceTile &tile, float x)
+                                  { return tile.x < x; });
+
+    float overlap_scale = getTileOverlapScale(camera_zoom);
+    for (auto it = first; it != slice.tiles.end() && it->x <= max_x; ++it)
+    {
+        float tile_world_x = rounded_world_x + it->x;
+        if (camera_zoom != 1.0f)
+        {
+            tile_world_x = roundf(tile_world_x * camera_zoom) / camera_zoom;
+        }
+
+        cf_draw_push();
+        cf_draw_translate_v2(cf_v2(tile_world_x, tile_world_y));
+        cf_draw_scale(overlap_scale, overlap_scale);
+        cf_draw_sprite(&it->sprite);
+        cf_draw_pop();
+    }
+}
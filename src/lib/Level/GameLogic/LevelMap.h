@@ -1,12 +1,40 @@
 #pragma once
 
 #include "../FileHandling/tmx.h"
+#include "../FileHandling/LevelPackage.h"
 #include <vector>
 #include <memory>
 
 // Forward declarations
 class CFNativeCamera;
 class DataFile;
+class NavMesh;
+
+struct StructureLayer;
+
+/**
+ * StructureSliceTile - One prebuilt tile of a structure slice
+ */
+struct StructureSliceTile
+{
+    CF_Sprite sprite; // Sprite resolved from the tile GID at load time
+    float x;          // World X of the tile (layer-local plus the buildStructureSlices offset)
+};
+
+/**
+ * StructureRowSlice - One tile row of a structure layer
+ *
+ * Each row is depth sorted on its own so agents interleave correctly with
+ * structures that run up the screen (fences, walls).
+ */
+struct StructureRowSlice
+{
+    const StructureLayer *layer;           // Owning structure layer
+    int row;                               // TMX row (0 = topmost)
+    float worldY;                          // World Y of the row (layer-local plus offset), used as the depth key
+    CF_Aabb bounds;                        // Bounds of the row's non-empty tiles
+    std::vector<StructureSliceTile> tiles; // Non-empty tiles ordered by x
+};
 
 /**
  * StructureLayer - Extended TMX layer for game structures
@@ -24,6 +52,7 @@ struct StructureLayer
     float opacity;              // Layer opacity (0.0 - 1.0)
     std::vector<int> data;      // Tile data (global IDs) in row-major order
     int lowestWorldYCoordinate; // Lowest world Y coordinate for this structure layer
+    std::vector<StructureRowSlice> slices; // Per-row draw slices (built by LevelMap::buildStructureSlices)
 
 private:
     std::shared_ptr<TMXLayer> tmxLayer; // Original TMX layer for rendering
@@ -68,6 +97,12 @@ private:
     // Override to filter structure layers from regular layers
     bool loadLayers() override;
 
+    // Sort a loaded layer into the structure, cut, navmesh or regular layer lists by its name
+    void addLayerByName(const std::shared_ptr<TMXLayer> &layer);
+
+    // Print layer counts, returns true if any layer was loaded
+    bool printLayerSummary() const;
+
 public:
     /**
      * Default constructor
@@ -85,6 +120,39 @@ public:
      */
     ~LevelMap() = default;
 
+    /**
+     * Load the map from a cooked level package instead of parsing the TMX
+     * Tilesets keep a reference to the package and crop tiles from its baked images
+     * @param package Opened level package
+     * @param path TMX path the package was cooked from (used for logging)
+     * @return true if tilesets and layers were loaded
+     */
+    bool loadFromPackage(std::shared_ptr<const LevelPackage> package, const std::string &path);
+
+    /**
+     * Add map properties, baked tileset images and all layers to a level package
+     * @param writer Package being cooked
+     * @param levelName Level name stored in the package
+     * @return true on success, false if a tileset image could not be decoded
+     */
+    bool writeToPackage(LevelPackageWriter &writer, const std::string &levelName) const;
+
+    /**
+     * Build a navmesh from the first navmesh layer and apply the cut layers
+     * @param navmesh NavMesh to build into
+     * @param worldX World X offset of the map (e.g. a streamed world region)
+     * @param worldY World Y offset of the map
+     * @return true if the navmesh has polygons
+     */
+    bool buildNavMesh(NavMesh &navmesh, float worldX = 0.0f, float worldY = 0.0f) const;
+
+    /**
+     * Create the sprites of every tile used by the regular and structure layers
+     * Must run on the main thread (uploads textures), after decodeTilesetImages
+     * @return Number of distinct tiles created
+     */
+    size_t createTileSprites() override;
+
     /**
      * Get the number of structure layers
      * @return Number of structure layers
@@ -121,4 +189,21 @@ public:
      * @param worldY World Y offset
      */
     void renderSingleLayer(std::shared_ptr<TMXLayer> layer, const CFNativeCamera &camera, const DataFile &config, float worldX = 0.0f, float worldY = 0.0f) const;
+
+    /**
+     * Split every structure layer into per-row slices with prebuilt tile sprites
+     * Must be called after tilesets are loaded; rebuilding invalidates slice pointers
+     * @param worldX World X offset baked into the slices (e.g. a streamed world region)
+     * @param worldY World Y offset baked into the slices
+     */
+    void buildStructureSlices(float worldX = 0.0f, float worldY = 0.0f);
+
+    /**
+     * Render one structure row slice (tiles outside the camera's X range are skipped)
+     * @param slice The slice to render
+     * @param camera Camera to use for rendering
+     * @param worldX World X offset
+     * @param worldY World Y offset
+     */
+    void renderStructureSlice(const StructureRowSlice &slice, const CFNativeCamera &camera, float worldX = 0.0f, float worldY = 0.0f) const;
 };
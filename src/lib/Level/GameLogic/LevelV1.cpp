@@ -1,16 +1,30 @@
 #include "LevelV1.h"
 #include "CFNativeCamera.h"
 #include "JobSystem.h"
+#include "JobGraph.h"
 #include "OnScreenChecks.h"
 #include "Coordinator.h"
 #include "AnimatedDataCharacterNavMeshPlayer.h"
+#include "EntityPrototypeCache.h"
+#include "tsx.h"
 #include "../UI/ColorUtils.h"
 #include "../UI/HighlightTile.h"
 #include <cstdio>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <set>
+
+// Number of agents each background AI job works through
+static const size_t AGENT_AI_BATCH_SIZE = 16;
+
+// Despawned agents kept per entity type for reuse; beyond this they are deleted
+static const size_t MAX_POOLED_AGENTS_PER_TYPE = 64;
 
 // LevelV1 implementation
-LevelV1::LevelV1(const std::string &directoryPath)
-    : levelDirectory(directoryPath), levelName(""), levelMap(nullptr), navmesh(nullptr), entities(), details(), tileWidth(0), tileHeight(0), initialized(false), player(nullptr)
+LevelV1::LevelV1(const std::string &directoryPath, const LevelLoadProgressCallback &progress)
+    : levelDirectory(directoryPath), levelName(""), levelMap(nullptr), navmesh(nullptr), entities(), details(), tileWidth(0), tileHeight(0), initialized(false), player(nullptr), lodFrameCounter(0),
+      aiBatch(std::make_shared<AgentAIBatch>())
 {
     printf("LevelV1: Loading level from directory: %s\n", directoryPath.c_str());
 
@@ -45,8 +59,146 @@ LevelV1::LevelV1(const std::string &directoryPath)
         printf("LevelV1: Using extracted directory name: %s\n", levelName.c_str());
     }
 
+    // Prefer the cooked package (one mapped file), fall back to the TMX / JSON sources
+    auto loadStart = std::chrono::steady_clock::now();
+    std::vector<LevelEntitySpawn> spawns;
+    std::string packagePath = directoryPath + "/" + LEVEL_PACKAGE_FILENAME;
+    bool fromPackage = isPackageCurrent(packagePath) && loadFromPackage(packagePath, spawns);
+    if (!loadLevelData(fromPackage, spawns, progress))
+    {
+        return;
+    }
+
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+    printf("LevelV1: Loaded level from %s in %.2f ms (%d workers)\n", fromPackage ? "package" : "TMX/JSON", loadMs,
+           JobSystem::isInitialized() ? JobSystem::getWorkerCount() : 0);
+
+    // Mark as successfully initialized
+    initialized = true;
+    printf("LevelV1: Level '%s' initialized successfully\n", levelName.c_str());
+
+    // Build initial spatial grid with all agents
+    rebuildSpatialGrid();
+
+    // Split structures into per-row slices and add each slice to the rendered objects list
+    // so rows depth sort individually against agents (their worldY never changes)
+    levelMap->buildStructureSlices();
+    for (int i = 0; i < levelMap->getStructureCount(); ++i)
+    {
+        auto structure = levelMap->getStructure(i);
+        if (structure)
+        {
+            for (const StructureRowSlice &slice : structure->slices)
+            {
+                renderedObjects.add(ObjectRenderedByWorldPosition(&slice));
+            }
+        }
+    }
+
+    printf("LevelV1: Added %zu objects to rendered objects list\n", renderedObjects.getCount());
+
+    // Chunked world: regions stream in around the level map from now on
+    std::string worldPath = directoryPath + "/" + WORLD_LAYOUT_FILENAME;
+    CF_Stat worldStat;
+    if (!Cute::is_error(cf_fs_stat(worldPath.c_str(), &worldStat)))
+    {
+        auto streamer = std::make_unique<WorldStreamer>();
+        if (streamer->load(directoryPath, tileWidth, tileHeight))
+        {
+            streamer->setBaseNavMesh(navmesh.get());
+            worldStreamer = std::move(streamer);
+        }
+    }
+}
+
+bool LevelV1::isPackageCurrent(const std::string &packagePath) const
+{
+    CF_Stat packageStat;
+    if (Cute::is_error(cf_fs_stat(packagePath.c_str(), &packageStat)))
+    {
+        return false;
+    }
+
+    // A package older than any of its sources was cooked from outdated data
+    for (const std::string &source : {levelDirectory + "/" + levelName + ".tmx", levelDirectory + "/entities.json"})
+    {
+        CF_Stat sourceStat;
+        if (!Cute::is_error(cf_fs_stat(source.c_str(), &sourceStat)) &&
+            sourceStat.last_modified_time > packageStat.last_modified_time)
+        {
+            printf("LevelV1: Package %s is older than %s, ignoring it\n", packagePath.c_str(), source.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool LevelV1::loadFromPackage(const std::string &packagePath, std::vector<LevelEntitySpawn> &spawns)
+{
+    auto package = std::make_shared<LevelPackage>();
+    if (!package->open(packagePath))
+    {
+        printf("LevelV1 Warning: Could not open level package: %s\n", packagePath.c_str());
+        return false;
+    }
+
+    auto map = std::make_unique<LevelMap>();
+    if (!map->loadFromPackage(package, levelDirectory + "/" + levelName + ".tmx"))
+    {
+        printf("LevelV1 Warning: Level package %s is incomplete\n", packagePath.c_str());
+        return false;
+    }
+
+    // Tileset images are baked too, a package older than a TSX or its image was cooked from outdated art
+    CF_Stat packageStat;
+    if (!Cute::is_error(cf_fs_stat(packagePath.c_str(), &packageStat)))
+    {
+        for (int i = 0; i < map->getTilesetCount(); ++i)
+        {
+            auto tileset = map->getTileset(i);
+            std::string tsxPath = tileset ? map->getTilesetSourcePath(*tileset) : "";
+            if (tsxPath.empty())
+            {
+                continue;
+            }
+
+            for (const std::string &source : {tsxPath, tsx(tsxPath).getImagePath()})
+            {
+                CF_Stat sourceStat;
+                if (!source.empty() && !Cute::is_error(cf_fs_stat(source.c_str(), &sourceStat)) &&
+                    sourceStat.last_modified_time > packageStat.last_modified_time)
+                {
+                    printf("LevelV1: Package %s is older than %s, ignoring it\n", packagePath.c_str(), source.c_str());
+                    return false;
+                }
+            }
+        }
+    }
+
+    levelMap = std::move(map);
+    tileWidth = levelMap->getTileWidth();
+    tileHeight = levelMap->getTileHeight();
+    printf("LevelV1: Loaded level package from: %s\n", packagePath.c_str());
+
+    // The navmesh was built and cut when cooking
+    navmesh = std::make_unique<NavMesh>();
+    if (!navmesh->loadFromPackage(*package))
+    {
+        printf("LevelV1 Warning: Level package has no navmesh. Navigation mesh not created.\n");
+    }
+
+    // Spawn records are already flattened, entities.json is not read
+    spawns = package->getEntitySpawns();
+    entities = DataFile();
+    entities["entities"] = nlohmann::json::array();
+    return true;
+}
+
+void LevelV1::loadEntitiesFromSources(std::vector<LevelEntitySpawn> &spawns)
+{
     // Load entities.json
-    std::string entitiesPath = directoryPath + "/entities.json";
+    std::string entitiesPath = levelDirectory + "/entities.json";
     try
     {
         entities = DataFile(entitiesPath);
@@ -59,9 +211,13 @@ LevelV1::LevelV1(const std::string &directoryPath)
         entities = DataFile();
         entities["entities"] = nlohmann::json::array();
     }
+    spawns = flattenEntitySpawns(entities);
+}
 
+bool LevelV1::loadMapFromSources()
+{
     // Load TMX level map
-    std::string tmxPath = directoryPath + "/" + levelName + ".tmx";
+    std::string tmxPath = levelDirectory + "/" + levelName + ".tmx";
     try
     {
         levelMap = std::make_unique<LevelMap>(tmxPath);
@@ -78,227 +234,371 @@ LevelV1::LevelV1(const std::string &directoryPath)
     catch (const std::exception &e)
     {
         printf("LevelV1 Error: Could not load TMX map from %s: %s\n", tmxPath.c_str(), e.what());
-        return;
+        levelMap.reset();
+        return false;
     }
 
-    // Initialize NavMesh
-    navmesh = std::make_unique<NavMesh>();
+    return true;
+}
+
+bool LevelV1::loadLevelData(bool fromPackage, std::vector<LevelEntitySpawn> &spawns, const LevelLoadProgressCallback &progress)
+{
+    JobGraph graph;
 
-    // Build NavMesh from TMX navmesh layer if available
-    if (levelMap->getNavMeshLayerCount() > 0)
+    // Tasks producing the map, navmesh and spawn records (already done when loaded from a package)
+    std::vector<JobGraph::TaskId> mapReady;
+    std::vector<JobGraph::TaskId> spawnsReady;
+    std::vector<JobGraph::TaskId> navmeshReady;
+    if (!fromPackage)
     {
-        auto navLayer = levelMap->getNavMeshLayer(0);
-        printf("LevelV1: Building navmesh from layer: %s\n", navLayer->name.c_str());
+        JobGraph::TaskId entitiesTask = graph.addTask("Load entities", [this, &spawns]()
+                                                      { loadEntitiesFromSources(spawns); });
+        JobGraph::TaskId mapTask = graph.addTask("Load TMX map", [this]()
+                                                 { loadMapFromSources(); });
+
+        // Build NavMesh from the TMX navmesh layer and cut layers
+        JobGraph::TaskId navmeshTask = graph.addTask("Build navmesh", [this]()
+                                                     {
+            navmesh = std::make_unique<NavMesh>();
+            if (levelMap)
+            {
+                levelMap->buildNavMesh(*navmesh);
+            } }, {mapTask});
 
-        navmesh->buildFromLayer(navLayer, tileWidth, tileHeight, 0.0f, 0.0f, false);
-        printf("LevelV1: NavMesh created with %d polygons\n", navmesh->getPolygonCount());
+        mapReady = {mapTask};
+        spawnsReady = {entitiesTask};
+        navmeshReady = {navmeshTask};
     }
-    else
+
+    // Tileset PNGs are decoded on workers, the sprites are created on this thread afterwards
+    JobGraph::TaskId tilesetsTask = graph.addTask("Decode tilesets", [this]()
+                                                  {
+        if (levelMap)
+        {
+            levelMap->decodeTilesetImages();
+        } }, mapReady);
+    JobGraph::TaskId spritesTask = graph.addMainThreadTask("Create tile sprites", [this]()
+                                                           {
+        if (levelMap)
+        {
+            levelMap->createTileSprites();
+        } }, {tilesetsTask});
+
+    // Decode each entity type's sheets once, agents then only slice and upload frames
+    JobGraph::TaskId assetsTask = graph.addTask("Load entity assets", [&spawns]()
+                                                { prefetchEntityAssets(spawns); }, spawnsReady);
+
+    std::vector<JobGraph::TaskId> spawnDependencies = navmeshReady;
+    spawnDependencies.push_back(assetsTask);
+    spawnDependencies.push_back(spritesTask);
+    graph.addMainThreadTask("Spawn entities", [this, &spawns]()
+                            {
+        if (levelMap)
+        {
+            spawnEntities(spawns);
+        } }, spawnDependencies);
+
+    graph.run([&progress](size_t completed, size_t total, const std::string &step)
+              {
+        printf("LevelV1: Load step '%s' done (%zu/%zu)\n", step.c_str(), completed, total);
+        if (progress)
+        {
+            progress(static_cast<float>(completed) / static_cast<float>(total), step);
+        } });
+
+    return levelMap != nullptr;
+}
+
+void LevelV1::prefetchEntityAssets(const std::vector<LevelEntitySpawn> &spawns)
+{
+    std::set<std::string> uniquePaths;
+    for (const LevelEntitySpawn &spawn : spawns)
     {
-        printf("LevelV1 Warning: No navmesh layers found in level. Navigation mesh not created.\n");
+        uniquePaths.insert(spawn.path);
     }
 
-    // Apply navmesh cuts from cut layers
-    if (navmesh->getPolygonCount() > 0)
+    std::vector<std::string> paths(uniquePaths.begin(), uniquePaths.end());
+    JobSystem::parallelFor(paths.size(), 1, [&paths](size_t begin, size_t end)
+                           {
+        for (size_t i = begin; i < end; i++)
+        {
+            AnimatedDataCharacter::prefetchAssets(paths[i]);
+        } }, "PrefetchEntityAssets", "general");
+
+    printf("LevelV1: Prefetched assets for %zu entity types\n", paths.size());
+}
+
+void LevelV1::spawnEntities(const std::vector<LevelEntitySpawn> &spawns)
+{
+    printf("LevelV1: Creating %zu agents from spawn records...\n", spawns.size());
+    auto spawnStart = std::chrono::steady_clock::now();
+    size_t prototypeBuilds = EntityPrototypeCache::getMissCount();
+
+    for (const LevelEntitySpawn &spawn : spawns)
     {
-        int total_cuts = 0;
+        printf("LevelV1: Creating agent '%s' from: %s\n", spawn.name.c_str(), spawn.path.c_str());
 
-        // Process bottom edge cuts
-        for (const auto &cutLayer : levelMap->getCutBottomLayers())
+        // Create the agent
+        auto agent = createAgentFromFile(spawn.path);
+        if (!agent)
         {
-            printf("LevelV1: Processing cut layer (bottom): %s\n", cutLayer->name.c_str());
-            for (int y = 0; y < cutLayer->height; y++)
-            {
-                for (int x = 0; x < cutLayer->width; x++)
-                {
-                    int gid = cutLayer->getTileGID(x, y);
-                    if (gid != 0) // Tile is marked for cut
-                    {
-                        navmesh->applyCut(x, y, NAV_CUT_EDGE_BOTTOM);
-                        total_cuts++;
-                    }
-                }
-            }
+            printf("LevelV1 Error: Failed to create agent '%s'\n", spawn.name.c_str());
+            continue;
         }
 
-        // Process top edge cuts
-        for (const auto &cutLayer : levelMap->getCutTopLayers())
+        // Set position if provided (position is in tile coordinates)
+        if (spawn.hasPosition)
         {
-            printf("LevelV1: Processing cut layer (top): %s\n", cutLayer->name.c_str());
-            for (int y = 0; y < cutLayer->height; y++)
-            {
-                for (int x = 0; x < cutLayer->width; x++)
-                {
-                    int gid = cutLayer->getTileGID(x, y);
-                    if (gid != 0)
-                    {
-                        navmesh->applyCut(x, y, NAV_CUT_EDGE_TOP);
-                        total_cuts++;
-                    }
-                }
-            }
+            // Convert tile coordinates to world pixel coordinates
+            float worldX = spawn.tileX * tileWidth;
+            float worldY = spawn.tileY * tileHeight;
+
+            agent->setPosition(cf_v2(worldX, worldY));
+            gatherAgentComponents(agent);
+            printf("LevelV1:   Set agent position to tile (%.1f, %.1f) = world (%.1f, %.1f)\n",
+                   spawn.tileX, spawn.tileY, worldX, worldY);
         }
 
-        // Process right edge cuts
-        for (const auto &cutLayer : levelMap->getCutRightLayers())
+        printf("LevelV1:   Agent '%s' created successfully\n", spawn.name.c_str());
+    }
+
+    double spawnMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - spawnStart).count();
+    printf("LevelV1: Created %zu agents from spawn records in %.2f ms (%zu prototypes built)\n", agents.size(), spawnMs,
+           EntityPrototypeCache::getMissCount() - prototypeBuilds);
+}
+
+LevelV1::~LevelV1()
+{
+    waitForAgentAIBatch();
+}
+
+void LevelV1::updateWorldStreaming(v2 cameraPosition, v2 playerPosition)
+{
+    if (!worldStreamer)
+    {
+        return;
+    }
+
+    std::vector<WorldRegion *> loaded;
+    std::vector<WorldRegion *> unloading;
+    worldStreamer->update({cameraPosition, playerPosition}, loaded, unloading);
+
+    for (WorldRegion *region : unloading)
+    {
+        detachWorldRegion(*region);
+    }
+    for (WorldRegion *region : loaded)
+    {
+        attachWorldRegion(*region);
+    }
+
+    // Despawned agents are removed by updateAgents, a region's navmesh is released after its last agent
+    for (const auto &region : worldStreamer->getRegions())
+    {
+        if (region->state == WorldRegionState::Unloading && !isNavMeshInUse(region->navmesh.get()))
         {
-            printf("LevelV1: Processing cut layer (right): %s\n", cutLayer->name.c_str());
-            for (int y = 0; y < cutLayer->height; y++)
-            {
-                for (int x = 0; x < cutLayer->width; x++)
-                {
-                    int gid = cutLayer->getTileGID(x, y);
-                    if (gid != 0)
-                    {
-                        navmesh->applyCut(x, y, NAV_CUT_EDGE_RIGHT);
-                        total_cuts++;
-                    }
-                }
-            }
+            worldStreamer->releaseRegion(*region);
         }
+    }
+}
 
-        // Process left edge cuts
-        for (const auto &cutLayer : levelMap->getCutLeftLayers())
+void LevelV1::attachWorldRegion(WorldRegion &region)
+{
+    for (int i = 0; i < region.map->getStructureCount(); ++i)
+    {
+        auto structure = region.map->getStructure(i);
+        if (structure)
         {
-            printf("LevelV1: Processing cut layer (left): %s\n", cutLayer->name.c_str());
-            for (int y = 0; y < cutLayer->height; y++)
+            for (const StructureRowSlice &slice : structure->slices)
             {
-                for (int x = 0; x < cutLayer->width; x++)
-                {
-                    int gid = cutLayer->getTileGID(x, y);
-                    if (gid != 0)
-                    {
-                        navmesh->applyCut(x, y, NAV_CUT_EDGE_LEFT);
-                        total_cuts++;
-                    }
-                }
+                renderedObjects.add(ObjectRenderedByWorldPosition(&slice));
             }
         }
-
-        printf("LevelV1: Applied %d navmesh cuts\n", total_cuts);
     }
 
-    // Create agents from entities.json
-    if (entities.contains("entities") && entities["entities"].is_array())
+    size_t spawned = 0;
+    for (const LevelEntitySpawn &spawn : region.spawns)
     {
-        printf("LevelV1: Creating agents from entities.json...\n");
-
-        for (const auto &entityEntry : entities["entities"])
+        auto agent = createAgentFromFile(spawn.path);
+        if (!agent)
         {
-            // Check if entity has required fields
-            if (!entityEntry.contains("path"))
-            {
-                printf("LevelV1 Warning: Entity missing 'path' field, skipping\n");
-                continue;
-            }
-
-            std::string entityPath = entityEntry["path"].get<std::string>();
-            std::string entityName = entityEntry.contains("name") ? entityEntry["name"].get<std::string>() : "unnamed";
-
-            printf("LevelV1: Creating agent '%s' from: %s\n", entityName.c_str(), entityPath.c_str());
+            printf("LevelV1 Error: Failed to create region agent '%s'\n", spawn.name.c_str());
+            continue;
+        }
 
-            // Create the agent
-            auto agent = createAgentFromFile(entityPath);
+        // Region spawn positions are in region local tiles
+        if (spawn.hasPosition)
+        {
+            agent->setPosition(cf_v2(region.worldX + spawn.tileX * tileWidth, region.worldY + spawn.tileY * tileHeight));
+        }
+        agent->setNavMesh(region.navmesh.get());
+        gatherAgentComponents(agent);
+        spawned++;
+    }
 
-            if (agent)
-            {
-                // Set position if provided (position is in tile coordinates)
-                if (entityEntry.contains("position"))
-                {
-                    const auto &pos = entityEntry["position"];
-                    if (pos.contains("x") && pos.contains("y"))
-                    {
-                        // Get tile coordinates
-                        float tileX = pos["x"].get<float>();
-                        float tileY = pos["y"].get<float>();
-
-                        // Convert tile coordinates to world pixel coordinates
-                        // Multiply by tile dimensions to get world position
-                        float worldX = tileX * tileWidth;
-                        float worldY = tileY * tileHeight;
-
-                        agent->setPosition(cf_v2(worldX, worldY));
-                        printf("LevelV1:   Set agent position to tile (%.1f, %.1f) = world (%.1f, %.1f)\n",
-                               tileX, tileY, worldX, worldY);
-                    }
-                }
+    printf("LevelV1: Region (%d, %d) attached with %zu agents\n", region.gridX, region.gridY, spawned);
+}
 
-                printf("LevelV1:   Agent '%s' created successfully\n", entityName.c_str());
-            }
-            else
+void LevelV1::detachWorldRegion(WorldRegion &region)
+{
+    for (int i = 0; i < region.map->getStructureCount(); ++i)
+    {
+        auto structure = region.map->getStructure(i);
+        if (structure)
+        {
+            for (const StructureRowSlice &slice : structure->slices)
             {
-                printf("LevelV1 Error: Failed to create agent '%s'\n", entityName.c_str());
+                renderedObjects.remove(ObjectRenderedByWorldPosition(&slice));
             }
         }
-
-        printf("LevelV1: Created %zu agents from entities.json\n", agents.size());
     }
-    else
+
+    // The agents leave with the region, they do not die
+    for (auto &agent : agents)
     {
-        printf("LevelV1: No entities array found in entities.json\n");
+        if (agent && agent->getNavMesh() == region.navmesh.get())
+        {
+            despawnAgent(agent->getHandle());
+        }
     }
+}
 
-    // Mark as successfully initialized
-    initialized = true;
-    printf("LevelV1: Level '%s' initialized successfully\n", levelName.c_str());
-
-    // Build initial spatial grid with all agents
-    rebuildSpatialGrid();
+std::vector<LevelMap *> LevelV1::getResidentMaps() const
+{
+    std::vector<LevelMap *> maps;
+    if (levelMap)
+    {
+        maps.push_back(levelMap.get());
+    }
+    if (worldStreamer)
+    {
+        for (const auto &region : worldStreamer->getRegions())
+        {
+            if (region->state == WorldRegionState::Loaded && region->map)
+            {
+                maps.push_back(region->map.get());
+            }
+        }
+    }
+    return maps;
+}
 
-    // Add all structures to the rendered objects list
-    // Calculate their worldY positions once since they never move
-    for (size_t i = 0; i < levelMap->getStructureCount(); ++i)
+void LevelV1::refreshMapTiles(LevelMap &map)
+{
+    // Slices hold copies of the old tile sprites and their pointers are about to be invalidated
+    for (int i = 0; i < map.getStructureCount(); ++i)
     {
-        auto structure = levelMap->getStructure(i);
+        auto structure = map.getStructure(i);
         if (structure)
         {
-            ObjectRenderedByWorldPosition structureObj(structure.get());
-
-            // Calculate worldY for this structure (only done once)
-            float minWorldY = 999999.0f;
-            bool foundTile = false;
-
-            for (int y = 0; y < structure->height; y++)
+            for (const StructureRowSlice &slice : structure->slices)
             {
-                for (int x = 0; x < structure->width; x++)
-                {
-                    int gid = structure->getTileGID(x, y);
-                    if (gid != 0) // Non-empty tile
-                    {
-                        // Convert tile coordinates to world coordinates
-                        float worldY = ((structure->height - 1 - y) * tileHeight);
-                        if (worldY < minWorldY)
-                        {
-                            minWorldY = worldY;
-                        }
-                        foundTile = true;
-                    }
-                }
+                renderedObjects.remove(ObjectRenderedByWorldPosition(&slice));
             }
+        }
+    }
+
+    map.createTileSprites();
 
-            if (foundTile)
+    // Region slices carry the region's world offset
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+    if (worldStreamer && &map != levelMap.get())
+    {
+        for (const auto &region : worldStreamer->getRegions())
+        {
+            if (region->map.get() == &map)
             {
-                structureObj.setWorldY(minWorldY);
+                offsetX = region->worldX;
+                offsetY = region->worldY;
             }
-            else
+        }
+    }
+    map.buildStructureSlices(offsetX, offsetY);
+
+    for (int i = 0; i < map.getStructureCount(); ++i)
+    {
+        auto structure = map.getStructure(i);
+        if (structure)
+        {
+            for (const StructureRowSlice &slice : structure->slices)
             {
-                structureObj.setWorldY(0.0f);
+                renderedObjects.add(ObjectRenderedByWorldPosition(&slice));
             }
+        }
+    }
+}
 
-            renderedObjects.add(structureObj);
+size_t LevelV1::rebindAgents(const std::string &folderPath, std::shared_ptr<const EntityPrototype> prototype)
+{
+    // Background AI steps read the agents' actions and state machines
+    waitForAgentAIBatch();
+
+    // The Coordinator's worker reads the actions of the agents it tracks, take them out while
+    // their actions are replaced and put them back afterwards (one batch each way)
+    std::vector<VisibilityDelta> departures;
+    for (size_t i = 0; i < agents.size(); ++i)
+    {
+        auto *agent = agents[i].get();
+        if (agentComponents.coordinated[i] && agent->getPrototype() && agent->getPrototype()->folderPath == folderPath)
+        {
+            departures.push_back(VisibilityDelta{agent, agent->getHandle(), false});
         }
     }
+    Coordinator *coordinator = OnScreenChecks::getCoordinator();
+    if (coordinator)
+    {
+        coordinator->applyVisibilityDeltas(departures);
+    }
 
-    // Add all agents to the rendered objects list
+    size_t rebound = 0;
     for (auto &agent : agents)
     {
-        if (agent)
+        if (agent && agent->getPrototype() && agent->getPrototype()->folderPath == folderPath &&
+            agent->rebindPrototype(prototype))
         {
-            renderedObjects.add(ObjectRenderedByWorldPosition(agent.get()));
+            rebound++;
         }
     }
 
-    printf("LevelV1: Added %zu objects to rendered objects list\n", renderedObjects.getCount());
+    if (coordinator)
+    {
+        std::vector<VisibilityDelta> arrivals;
+        arrivals.reserve(departures.size());
+        for (const VisibilityDelta &departure : departures)
+        {
+            arrivals.push_back(VisibilityDelta{departure.agent, departure.handle, true});
+        }
+        coordinator->applyVisibilityDeltas(arrivals);
+    }
+    return rebound;
+}
+
+bool LevelV1::isNavMeshInUse(const NavMesh *navmesh) const
+{
+    for (const auto &agent : agents)
+    {
+        if (agent && agent->getNavMesh() == navmesh)
+        {
+            return true;
+        }
+    }
+
+    const AnimatedDataCharacterNavMeshPlayer *navMeshPlayer = dynamic_cast<const AnimatedDataCharacterNavMeshPlayer *>(player);
+    return navMeshPlayer && navMeshPlayer->getNavMesh() == navmesh;
+}
+
+NavMesh *LevelV1::getNavMeshAt(v2 point)
+{
+    if (worldStreamer && !(navmesh && navmesh->isWalkable(point)))
+    {
+        NavMesh *regionNavMesh = worldStreamer->getNavMeshAt(point);
+        if (regionNavMesh)
+        {
+            return regionNavMesh;
+        }
+    }
+    return navmesh.get();
 }
 
 AnimatedDataCharacterNavMeshAgent *LevelV1::addAgent(std::unique_ptr<AnimatedDataCharacterNavMeshAgent> agent)
@@ -319,22 +619,36 @@ AnimatedDataCharacterNavMeshAgent *LevelV1::addAgent(std::unique_ptr<AnimatedDat
     agent->setLevel(this);
 
     agents.push_back(std::move(agent));
+    AgentHandle handle = agentHandles.create();
+    agents.back()->setHandle(handle);
+    agentComponents.add(*agents.back());
 
-    // Add to spatial grid
-    size_t agentIndex = agents.size() - 1;
+    // Add to spatial grid (keyed by the handle's slot, which survives other agents' removal)
     v2 agentPos = agents.back()->getPosition();
-    spatialGrid.insert(agentIndex, agentPos, 32.0f);
+    spatialGrid.insert(handle.index, agentPos, 32.0f);
+    spatialGridPositions.push_back(agentPos);
+    markVisibilityDirty(agents.size() - 1);
 
-    // Add to rendered objects list
-    renderedObjects.add(ObjectRenderedByWorldPosition(agents.back().get()));
-
-    printf("LevelV1: Added agent (total: %zu, rendered objects: %zu)\n", agents.size(), renderedObjects.getCount());
+    printf("LevelV1: Added agent (total: %zu)\n", agents.size());
 
     return agents.back().get();
 }
 
 AnimatedDataCharacterNavMeshAgent *LevelV1::createAgentFromFile(const std::string &entityDataPath)
 {
+    // Recycle a despawned agent of this entity type (pools are keyed like EntityPrototypeCache)
+    auto pool = agentPools.find(entityDataPath);
+    if (pool != agentPools.end() && !pool->second.empty())
+    {
+        std::unique_ptr<AnimatedDataCharacterNavMeshAgent> agent = std::move(pool->second.back());
+        pool->second.pop_back();
+        if (agent->resetForReuse(EntityPrototypeCache::get(entityDataPath)))
+        {
+            return addAgent(std::move(agent));
+        }
+        printf("LevelV1 Warning: Failed to reuse pooled agent for: %s\n", entityDataPath.c_str());
+    }
+
     auto agent = std::make_unique<AnimatedDataCharacterNavMeshAgent>();
 
     if (!agent->init(entityDataPath))
@@ -371,117 +685,472 @@ const AnimatedDataCharacterNavMeshAgent *LevelV1::getAgent(size_t index) const
 
 void LevelV1::clearAgents()
 {
+    // Background AI jobs may still be reading these agents
+    waitForAgentAIBatch();
+    aiBatch->agents.clear();
+    aiBatch->handles.clear();
+    aiBatch->hasResults = false;
+
+    despawnQueue.clear();
     agents.clear();
+    agentHandles.clear();
+    agentComponents.clear();
     spatialGrid.clear();
+    spatialGridPositions.clear();
+    visibilityDirtyAgents.clear();
+    hasVisibilityCells = false;
     printf("LevelV1: Cleared all agents\n");
 }
 
 void LevelV1::updateAgents(float dt)
 {
+    AgentComponents &components = agentComponents;
 
-    // TODO this!!!!!!
-    // all of this is assuming agents are on screen, todo cull based on camera and do different for offscreen agents
-
-    // Track indices of dead agents to remove
-    std::vector<size_t> agentsToRemove;
-
-    // Update agents with move vectors (using results from background jobs)
-    for (size_t i = 0; i < agents.size(); ++i)
+    // Apply the move vectors from the last AI batch once all of its jobs have finished
+    if (aiBatch->hasResults && aiBatch->pendingJobs.load() == 0)
     {
-        auto &agent = agents[i];
-        if (agent)
+        for (size_t k = 0; k < aiBatch->handles.size(); ++k)
         {
-            // Check if agent is dead and mark for removal
-            if (agent->getStageOfLife() == StageOfLife::Dead)
-            {
-                agentsToRemove.push_back(i);
-                continue;
-            }
-            // skip dying agents for now
-            if (agent->getStageOfLife() == StageOfLife::Dying)
+            size_t index = agentHandles.getDenseIndex(aiBatch->handles[k]);
+            if (index == SIZE_MAX)
             {
                 continue;
             }
+            agents[index]->setBackgroundMoveVector(aiBatch->moveVectors[k]);
+            components.moveVectors[index] = aiBatch->moveVectors[k];
+        }
+        aiBatch->hasResults = false;
+    }
+
+    // Safe point: no AI job is running, remove the agents that died since the last frame
+    processDespawnQueue();
+
+    // Agents that ticked this frame and the (accumulated) time they ticked with
+    std::vector<std::pair<AgentHandle, float>> tickedAgents;
+    tickedAgents.reserve(agents.size());
+
+    lodFrameCounter++;
+    v2 playerPosition = player ? player->getPosition() : v2(0.0f, 0.0f);
+    float nearDistanceSq = simulationLODConfig.nearDistance * simulationLODConfig.nearDistance;
+    bool lodEnabled = simulationLODConfig.enabled && player;
+    size_t agentCount = components.size();
+
+    // Pick every agent's simulation tier: on screen is always full rate
+    // Branch free over the component arrays so the compiler can vectorize it
+    for (size_t i = 0; i < agentCount; ++i)
+    {
+        float dx = components.positions[i].x - playerPosition.x;
+        float dy = components.positions[i].y - playerPosition.y;
+        SimulationLOD offScreenLOD = (dx * dx + dy * dy <= nearDistanceSq) ? SimulationLOD::Near : SimulationLOD::Far;
+        components.lods[i] = (!lodEnabled || components.onScreen[i]) ? SimulationLOD::Full : offScreenLOD;
+        components.lodTimes[i] += dt;
+    }
 
-            // Always use the last computed background move vector
-            // This allows agents to keep moving while their next job is being processed
-            v2 moveVector = agent->getBackgroundMoveVector();
+    int nearTickInterval = std::max(1, simulationLODConfig.nearTickInterval);
+    int farTickInterval = std::max(1, simulationLODConfig.farTickInterval);
 
-            agent->update(dt, moveVector);
+    // Tick the agents due this frame; only those are dereferenced
+    for (size_t i = 0; i < agentCount; ++i)
+    {
+        // Dead agents wait in the despawn queue, skip dying agents for now
+        StageOfLife stage = components.stages[i];
+        if (stage == StageOfLife::Dead || stage == StageOfLife::Dying)
+        {
+            continue;
         }
+
+        // Reduced tiers only tick on their slice, staggered by index to spread the work
+        SimulationLOD lod = components.lods[i];
+        int tickInterval = 1;
+        if (lod == SimulationLOD::Near)
+            tickInterval = nearTickInterval;
+        else if (lod == SimulationLOD::Far)
+            tickInterval = farTickInterval;
+
+        if ((lodFrameCounter + i) % static_cast<uint64_t>(tickInterval) != 0)
+        {
+            continue;
+        }
+        float tickDt = components.lodTimes[i];
+        components.lodTimes[i] = 0.0f;
+
+        auto *agent = agents[i].get();
+        if (!agent)
+        {
+            continue;
+        }
+        agent->setSimulationLOD(lod);
+
+        // Nobody sees off-screen animation frames
+        uint8_t stepping = lod == SimulationLOD::Full ? 1 : 0;
+        if (components.animationStepping[i] != stepping)
+        {
+            agent->setAnimationStepping(stepping != 0);
+            components.animationStepping[i] = stepping;
+        }
+
+        // Always use the last computed background move vector
+        // This allows agents to keep moving while their next job is being processed
+        agent->update(tickDt, components.moveVectors[i]);
+        components.gather(i, *agent);
+
+        tickedAgents.emplace_back(agentHandles.getHandle(i), tickDt);
     }
 
     // Update spatial grid with new positions
     updateSpatialGrid();
 
-    // Remove dead agents before starting background jobs
-    if (agentsToRemove.size() > 0)
+    // Dispatch background AI for the agents that ticked this frame, one job per slice
+    // If the previous batch is still running these agents keep their last move vector
+    if (!aiBatch->hasResults && !tickedAgents.empty())
     {
-        // Remove in reverse order to maintain correct indices
-        for (auto it = agentsToRemove.rbegin(); it != agentsToRemove.rend(); ++it)
+        AgentAIBatch &batch = *aiBatch;
+        size_t count = tickedAgents.size();
+        batch.agents.resize(count);
+        batch.handles.resize(count);
+        batch.tickDts.resize(count);
+        batch.detailed.resize(count);
+        batch.moveVectors.assign(count, v2(0.0f, 0.0f));
+        for (size_t k = 0; k < count; ++k)
+        {
+            size_t index = agentHandles.getDenseIndex(tickedAgents[k].first);
+            batch.agents[k] = agents[index].get();
+            batch.handles[k] = tickedAgents[k].first;
+            batch.tickDts[k] = tickedAgents[k].second;
+            // Far agents get the coarse off-screen job (path following by distance)
+            batch.detailed[k] = components.lods[index] != SimulationLOD::Far ? 1 : 0;
+        }
+
+        auto runSlice = [](AgentAIBatch &work, size_t begin, size_t end)
         {
-            size_t index = *it;
-            if (index < agents.size())
+            for (size_t k = begin; k < end; ++k)
             {
-                auto *agentPtr = agents[index].get();
+                work.moveVectors[k] = work.agents[k]->computeBackgroundMoveVector(work.tickDts[k], work.detailed[k] != 0);
+            }
+        };
 
-                // CRITICAL: Remove from coordinator BEFORE deleting
-                // This prevents background thread from accessing deleted memory
-                // Try to get coordinator and remove agent if available
-                try
-                {
-                    Coordinator *coordinator = OnScreenChecks::getCoordinator();
-                    if (coordinator)
-                    {
-                        coordinator->removeAgent(agentPtr);
-                    }
-                }
-                catch (...)
-                {
-                    // Coordinator not available (e.g., in tests), skip removal
-                }
+        batch.hasResults = true;
+        if (!JobSystem::isInitialized())
+        {
+            // No workers (e.g. tests) - run inline, results are applied next frame as usual
+            runSlice(batch, 0, count);
+        }
+        else
+        {
+            size_t jobCount = (count + AGENT_AI_BATCH_SIZE - 1) / AGENT_AI_BATCH_SIZE;
+            batch.pendingJobs.store(jobCount);
+            for (size_t begin = 0; begin < count; begin += AGENT_AI_BATCH_SIZE)
+            {
+                size_t end = std::min(begin + AGENT_AI_BATCH_SIZE, count);
+                JobSystem::submitJob([work = aiBatch, runSlice, begin, end]()
+                                     {
+                    runSlice(*work, begin, end);
+                    work->pendingJobs.fetch_sub(1); },
+                                     "Agent AI Batch");
+            }
+
+            // Kick off all pending jobs (non-blocking)
+            JobSystem::kick();
+        }
+    }
+}
+
+void LevelV1::waitForAgentAIBatch() const
+{
+    while (aiBatch && aiBatch->pendingJobs.load() > 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void LevelV1::gatherAgentComponents(const AnimatedDataCharacterNavMeshAgent *agent)
+{
+    if (agent)
+    {
+        size_t index = agentHandles.getDenseIndex(agent->getHandle());
+        agentComponents.gather(index, *agent);
+
+        // Moved outside updateAgents (e.g. spawn positioning), the grid only catches up later
+        markVisibilityDirty(index);
+    }
+}
+
+std::unique_ptr<AnimatedDataCharacterNavMeshAgent> LevelV1::removeAgentAt(size_t index)
+{
+    if (index >= agents.size())
+    {
+        return nullptr;
+    }
 
-                // Remove from rendered objects list
-                renderedObjects.remove(ObjectRenderedByWorldPosition(agentPtr));
+    // Only the removed agent leaves the grid; the agent taking its index keeps its slot id
+    spatialGrid.remove(agentHandles.getHandle(index).index, spatialGridPositions[index], 32.0f);
+
+    // Swap and pop every parallel array
+    std::unique_ptr<AnimatedDataCharacterNavMeshAgent> removed = std::move(agents[index]);
+    size_t last = agents.size() - 1;
+    if (index != last)
+    {
+        agents[index] = std::move(agents[last]);
+        spatialGridPositions[index] = spatialGridPositions[last];
+    }
+    agents.pop_back();
+    spatialGridPositions.pop_back();
+    agentComponents.remove(index);
+    agentHandles.remove(index);
+    return removed;
+}
 
-                // Remove from agents list (this deletes the agent)
-                agents.erase(agents.begin() + index);
-                printf("LevelV1: Removed dead agent at index %zu\n", index);
+void LevelV1::processDespawnQueue()
+{
+    // Jobs of an AI batch still read their agents, try again next frame
+    if (despawnQueue.empty() || aiBatch->pendingJobs.load() > 0)
+    {
+        return;
+    }
+
+    // Leave the coordinator in one batch before the agents are detached
+    // This prevents background thread from accessing a recycled agent
+    std::vector<VisibilityDelta> departures;
+    for (AgentHandle handle : despawnQueue)
+    {
+        size_t index = agentHandles.getDenseIndex(handle);
+        if (index != SIZE_MAX && agentComponents.coordinated[index])
+        {
+            departures.push_back(VisibilityDelta{agents[index].get(), handle, false});
+            agentComponents.coordinated[index] = 0;
+        }
+    }
+    Coordinator *coordinator = OnScreenChecks::getCoordinator();
+    if (coordinator && !departures.empty())
+    {
+        coordinator->applyVisibilityDeltas(departures);
+    }
+
+    // Handles resolve again after every removal, so duplicates and stale entries are skipped
+    size_t removed = 0;
+    for (AgentHandle handle : despawnQueue)
+    {
+        size_t index = agentHandles.getDenseIndex(handle);
+        if (index == SIZE_MAX)
+        {
+            continue;
+        }
+
+        std::unique_ptr<AnimatedDataCharacterNavMeshAgent> agent = removeAgentAt(index);
+        removed++;
+
+        std::shared_ptr<const EntityPrototype> prototype = agent->getPrototype();
+        if (prototype)
+        {
+            auto &pool = agentPools[prototype->folderPath];
+            if (pool.size() < MAX_POOLED_AGENTS_PER_TYPE)
+            {
+                agent->setLevel(nullptr);
+                agent->setHandle(AgentHandle());
+                pool.push_back(std::move(agent));
             }
         }
+    }
+    despawnQueue.clear();
+
+    if (removed > 0)
+    {
+        printf("LevelV1: Removed %zu despawned agents\n", removed);
+    }
+}
+
+size_t LevelV1::getPooledAgentCount() const
+{
+    size_t count = 0;
+    for (const auto &pool : agentPools)
+    {
+        count += pool.second.size();
+    }
+    return count;
+}
+
+void LevelV1::clearAgentPools()
+{
+    agentPools.clear();
+}
+
+void LevelV1::despawnAgent(AgentHandle handle)
+{
+    if (agentHandles.isValid(handle))
+    {
+        despawnQueue.push_back(handle);
+    }
+}
+
+void LevelV1::onAgentStageChanged(AgentHandle handle, StageOfLife stage)
+{
+    size_t index = agentHandles.getDenseIndex(handle);
+    if (index < agentComponents.size())
+    {
+        agentComponents.stages[index] = stage;
+
+        // A dying agent leaves the coordinator even where its cells are skipped as unchanged
+        markVisibilityDirty(index);
+        if (stage == StageOfLife::Dead)
+        {
+            despawnAgent(handle);
+        }
+    }
+}
 
-        // Rebuild spatial grid after removal
-        rebuildSpatialGrid();
+AnimatedDataCharacterNavMeshAgent *LevelV1::resolveAgent(AgentHandle handle)
+{
+    size_t index = agentHandles.getDenseIndex(handle);
+    return index < agents.size() ? agents[index].get() : nullptr;
+}
+
+const AnimatedDataCharacterNavMeshAgent *LevelV1::resolveAgent(AgentHandle handle) const
+{
+    size_t index = agentHandles.getDenseIndex(handle);
+    return index < agents.size() ? agents[index].get() : nullptr;
+}
+
+void LevelV1::markVisibilityDirty(size_t index)
+{
+    if (index < agentComponents.size() && !agentComponents.visibilityDirty[index])
+    {
+        agentComponents.visibilityDirty[index] = 1;
+        visibilityDirtyAgents.push_back(agentHandles.getHandle(index));
     }
+}
 
-    // trigger background updates for all agents
-    // these will finish on their own and update the agent as needed
-    for (auto &agent : agents)
+void LevelV1::checkAgentVisibility(size_t index, CF_Aabb view, std::vector<VisibilityDelta> &deltas)
+{
+    const float agentHalfSize = 32.0f;
+
+    AgentComponents &components = agentComponents;
+
+    // Same overlap test as CFNativeCamera::isVisible
+    v2 position = components.positions[index];
+    uint8_t visible = (position.x + agentHalfSize >= view.min.x && position.x - agentHalfSize <= view.max.x &&
+                       position.y + agentHalfSize >= view.min.y && position.y - agentHalfSize <= view.max.y)
+                          ? 1
+                          : 0;
+
+    // Write back only the changes; dying agents leave the coordinator
+    uint8_t coordinated = (visible && components.stages[index] != StageOfLife::Dying) ? 1 : 0;
+    if (visible == components.onScreen[index] && coordinated == components.coordinated[index])
     {
-        if (agent)
+        return;
+    }
+
+    AnimatedDataCharacterNavMeshAgent *agent = agents[index].get();
+    if (visible != components.onScreen[index])
+    {
+        agent->setIsOnScreen(visible != 0);
+        components.onScreen[index] = visible;
+    }
+    if (coordinated != components.coordinated[index])
+    {
+        deltas.push_back(VisibilityDelta{agent, agent->getHandle(), coordinated != 0});
+        components.coordinated[index] = coordinated;
+    }
+}
+
+void LevelV1::updateAgentVisibility(const CFNativeCamera &camera)
+{
+    AgentComponents &components = agentComponents;
+    size_t count = components.size();
+    CF_Aabb view = camera.getViewBounds();
+
+    SpatialGrid::CellRect nearby = spatialGrid.getCellRect(view);
+    SpatialGrid::CellRect covered = spatialGrid.getCoveredCellRect(view);
+
+    visibilityCandidates.clear();
+    if (!hasVisibilityCells)
+    {
+        // No previous pass to diff against (first frame or grid rebuilt), check everyone
+        for (size_t i = 0; i < count; ++i)
         {
-            // Don't start background job for dying agents
-            if (agent->getStageOfLife() == StageOfLife::Dying)
+            visibilityCandidates.push_back(i);
+        }
+    }
+    else
+    {
+        // Cells in the union of the previous and current view rectangles, except cells that
+        // were completely on screen both times: every agent touching one stayed visible
+        int minX = std::min(nearby.minX, visibleCells.minX);
+        int minY = std::min(nearby.minY, visibleCells.minY);
+        int maxX = std::max(nearby.maxX, visibleCells.maxX);
+        int maxY = std::max(nearby.maxY, visibleCells.maxY);
+
+        for (int y = minY; y <= maxY; ++y)
+        {
+            for (int x = minX; x <= maxX; ++x)
             {
-                continue;
+                if (!nearby.contains(x, y) && !visibleCells.contains(x, y))
+                    continue;
+                if (covered.contains(x, y) && coveredCells.contains(x, y))
+                    continue;
+
+                spatialGrid.queryCell(x, y, visibilityCandidates);
             }
+        }
 
-            // Try to start a background job for this agent
-            agent->backgroundUpdate(dt, true); // TODO change to false if offscreen
+        // Grid entries are handle slots
+        for (size_t &candidate : visibilityCandidates)
+        {
+            candidate = agentHandles.getDenseIndexOfSlot(candidate);
         }
     }
 
-    // Kick off all pending jobs (non-blocking)
-    JobSystem::kick();
+    // Agents that were added, crossed a cell boundary or changed stage of life since the last pass
+    for (AgentHandle handle : visibilityDirtyAgents)
+    {
+        size_t index = agentHandles.getDenseIndex(handle);
+        if (index < count)
+        {
+            components.visibilityDirty[index] = 0;
+            visibilityCandidates.push_back(index);
+        }
+    }
+    visibilityDirtyAgents.clear();
+
+    // Agents spanning several cells show up more than once
+    std::sort(visibilityCandidates.begin(), visibilityCandidates.end());
+    visibilityCandidates.erase(std::unique(visibilityCandidates.begin(), visibilityCandidates.end()),
+                               visibilityCandidates.end());
+
+    std::vector<VisibilityDelta> deltas;
+    for (size_t index : visibilityCandidates)
+    {
+        if (index < count)
+        {
+            checkAgentVisibility(index, view, deltas);
+        }
+    }
+
+    hasVisibilityCells = true;
+    visibleCells = nearby;
+    coveredCells = covered;
+
+    if (!deltas.empty())
+    {
+        Coordinator *coordinator = OnScreenChecks::getCoordinator();
+        if (coordinator)
+        {
+            coordinator->applyVisibilityDeltas(deltas);
+        }
+    }
+}
+
+void LevelV1::setSimulationLODConfig(const SimulationLODConfig &config)
+{
+    simulationLODConfig = config;
 }
 
 void LevelV1::cullDyingAgents()
 {
-    for (auto &agent : agents)
+    for (size_t i = 0; i < agentComponents.size(); ++i)
     {
-        if (agent && agent->getStageOfLife() == StageOfLife::Dying)
+        if (agentComponents.stages[i] == StageOfLife::Dying)
         {
-            agent->setStageOfLife(StageOfLife::Dead);
+            agents[i]->setStageOfLife(StageOfLife::Dead);
         }
     }
 }
@@ -506,13 +1175,14 @@ void LevelV1::renderAgentActions(const CFNativeCamera &camera, const AnimatedDat
     // Query spatial grid for agents in view area
     std::vector<size_t> nearbyAgents = spatialGrid.queryAABB(viewBounds);
 
-    for (size_t agentIndex : nearbyAgents)
+    for (size_t slot : nearbyAgents)
     {
+        size_t agentIndex = agentHandles.getDenseIndexOfSlot(slot);
         if (agentIndex >= agents.size())
             continue;
 
         auto &agent = agents[agentIndex];
-        if (agent && agent->getIsOnScreen())
+        if (agent && agentComponents.onScreen[agentIndex])
         {
             // Skip dying agents
             if (agent->getStageOfLife() == StageOfLife::Dying)
@@ -612,19 +1282,20 @@ void LevelV1::renderAgents(const CFNativeCamera &camera)
     std::vector<size_t> nearbyAgents = spatialGrid.queryAABB(viewBounds);
     checkedCount = static_cast<int>(nearbyAgents.size());
 
-    for (size_t agentIndex : nearbyAgents)
+    for (size_t slot : nearbyAgents)
     {
+        size_t agentIndex = agentHandles.getDenseIndexOfSlot(slot);
         if (agentIndex >= agents.size())
             continue;
 
         auto &agent = agents[agentIndex];
         if (agent)
         {
-            // Check if agent is marked as on-screen by OnScreenChecks worker
-            if (agent->getIsOnScreen())
+            // Check if agent is marked as on-screen by updateAgentVisibility
+            if (agentComponents.onScreen[agentIndex])
             {
-                v2 agentPos = agent->getPosition();
-                agent->render(agentPos);
+                v2 agentPos = agentComponents.positions[agentIndex];
+                agent->submitRender(spriteDrawBuffer, agentPos, agentPos.y);
                 renderedCount++;
             }
             else
@@ -634,6 +1305,8 @@ void LevelV1::renderAgents(const CFNativeCamera &camera)
         }
     }
 
+    spriteDrawBuffer.flush();
+
     // Debug output: show how many agents were checked vs total
     // printf("LevelV1: checked %d/%zu agents, rendered: %d, culled: %d\n",
     //        checkedCount, agents.size(), renderedCount, culledCount);
@@ -647,6 +1320,11 @@ void LevelV1::renderLayers(const CFNativeCamera &camera, const DataFile &config,
     }
 
     levelMap->renderAllLayers(camera, config, worldX, worldY);
+
+    if (worldStreamer)
+    {
+        worldStreamer->renderLayers(camera, config, worldX, worldY);
+    }
 }
 
 void LevelV1::render(const CFNativeCamera &camera, const DataFile &config, AnimatedDataCharacter *player, float worldX, float worldY)
@@ -664,43 +1342,42 @@ void LevelV1::render(const CFNativeCamera &camera, const DataFile &config, Anima
     {
         renderPlayerAvailableActions(camera, player);
     }
-    // 3. All objects sorted by world Y position (structures, agents, player)
-    renderedObjects.sort();
-
-    renderedObjects.forEach([&](ObjectRenderedByWorldPosition &obj)
-                            {
-        if (obj.getType() == 1) // NavMeshAgent
+    // 3. All visible objects sorted by world Y position (structures, agents, player)
+    // Characters are queued into the sprite draw buffer and flushed whenever a structure
+    // slice sorts between them, so each run of characters is submitted as a few batches
+    renderedObjects.buildRenderQueue(camera, worldX, worldY, &agentComponents);
+    spriteDrawBuffer.resetStats();
+
+    renderedObjects.forEachQueued([&](ObjectRenderedByWorldPosition &obj)
+                                  {
+        if (obj.getType() == 2) // PlayerCharacter
         {
-            auto agent = obj.asNavMeshAgent();
-            if (agent && agent->getIsOnScreen())
-            {
-                //skip dying agents
-                if (agent->getStageOfLife() == StageOfLife::Dying)
-                {
-                    return;
-                }
-                v2 agentPos = agent->getPosition();
-                agent->render(agentPos);
-            }
+            auto playerChar = obj.asPlayerCharacter();
+            v2 playerPos = playerChar->getPosition();
+            playerChar->submitRender(spriteDrawBuffer, playerPos, obj.getWorldY());
         }
-        else if (obj.getType() == 2) // PlayerCharacter
+        else if (obj.getType() == 3) // StructureRowSlice
         {
-            auto playerChar = obj.asPlayerCharacter();
-            if (playerChar)
-            {
-                v2 playerPos = playerChar->getPosition();
-                playerChar->render(playerPos);
-            }
+            spriteDrawBuffer.flush();
+            levelMap->renderStructureSlice(*obj.asStructureSlice(), camera, worldX, worldY);
         }
         else if (obj.getType() == 0) // StructureLayer
         {
+            spriteDrawBuffer.flush();
             auto structure = obj.asStructureLayer();
-            if (structure && structure->getTMXLayer())
+            if (structure->getTMXLayer())
             {
                 // Render the structure layer using the level map's renderSingleLayer method
                 levelMap->renderSingleLayer(structure->getTMXLayer(), camera, config, worldX, worldY);
             }
-        } });
+        } },
+                                  [&](size_t agentIndex)
+                                  {
+        v2 agentPos = agentComponents.positions[agentIndex];
+        agents[agentIndex]->submitRender(spriteDrawBuffer, agentPos,
+                                         WorldPositionRenderedObjectsList::getCharacterWorldY(agentPos)); });
+
+    spriteDrawBuffer.flush();
 }
 
 void LevelV1::debugPrint() const
@@ -754,8 +1431,9 @@ bool LevelV1::checkAgentsInArea(const std::vector<CF_Aabb> &areas, CF_Aabb areas
     // Use spatial grid to narrow down which agents to check
     std::vector<size_t> nearbyAgents = spatialGrid.queryAABB(areasBounds);
 
-    for (size_t agentIndex : nearbyAgents)
+    for (size_t slot : nearbyAgents)
     {
+        size_t agentIndex = agentHandles.getDenseIndexOfSlot(slot);
         if (agentIndex >= agents.size())
             continue;
 
@@ -828,8 +1506,9 @@ std::vector<AnimatedDataCharacterNavMeshAgent *> LevelV1::get_entities_at(int ti
     std::vector<size_t> nearbyAgents = spatialGrid.queryAABB(tile_bounds);
 
     // Check each nearby agent to see if they're actually in the tile bounds
-    for (size_t agentIndex : nearbyAgents)
+    for (size_t slot : nearbyAgents)
     {
+        size_t agentIndex = agentHandles.getDenseIndexOfSlot(slot);
         if (agentIndex >= agents.size())
             continue;
 
@@ -961,22 +1640,44 @@ std::vector<AnimatedDataCharacter *> LevelV1::getCharactersInActionHitbox(const
 
 void LevelV1::updateSpatialGrid()
 {
-    // For simplicity, rebuild the grid each frame
-    // This is efficient enough for hundreds of agents
-    // For thousands, we'd want to track previous positions and use update()
-    rebuildSpatialGrid();
+    // Indices are out of sync (agents added/removed without a rebuild)
+    if (spatialGridPositions.size() != agents.size())
+    {
+        rebuildSpatialGrid();
+        return;
+    }
+
+    // Move only the agents whose position changed since the last update
+    // SpatialGrid::update() skips agents that stay inside the same cells
+    const std::vector<v2> &positions = agentComponents.positions;
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        v2 pos = positions[i];
+        v2 &lastPos = spatialGridPositions[i];
+        if (pos.x != lastPos.x || pos.y != lastPos.y)
+        {
+            // A cell crossing can take the agent into or out of the view
+            if (spatialGrid.update(agentHandles.getHandle(i).index, lastPos, pos, 32.0f))
+            {
+                markVisibilityDirty(i);
+            }
+            lastPos = pos;
+        }
+    }
 }
 
 void LevelV1::rebuildSpatialGrid()
 {
     spatialGrid.clear();
+    spatialGridPositions.assign(agents.size(), cf_v2(0.0f, 0.0f));
 
-    for (size_t i = 0; i < agents.size(); ++i)
+    const std::vector<v2> &positions = agentComponents.positions;
+    for (size_t i = 0; i < positions.size(); ++i)
     {
-        if (agents[i])
-        {
-            v2 pos = agents[i]->getPosition();
-            spatialGrid.insert(i, pos, 32.0f);
-        }
+        spatialGrid.insert(agentHandles.getHandle(i).index, positions[i], 32.0f);
+        spatialGridPositions[i] = positions[i];
     }
+
+    // The next visibility pass has no cells to diff against
+    hasVisibilityCells = false;
 }
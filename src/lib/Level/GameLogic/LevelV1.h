@@ -3,16 +3,31 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
 #include "LevelMap.h"
 #include "NavMesh.h"
 #include "DataFile.h"
 #include "SpatialGrid.h"
+#include "AgentComponents.h"
+#include "AgentHandle.h"
 #include "AnimatedDataCharacterNavMeshAgent.h"
 #include "WorldPositionRenderedObjectsList.h"
+#include "SpriteDrawBuffer.h"
+#include "WorldStreamer.h"
 
 // Forward declarations
 class CFNativeCamera;
 class AnimatedDataCharacter;
+struct VisibilityDelta;
+
+/**
+ * Level load progress callback, invoked on the loading thread after each load step
+ * @param progress Fraction of load steps finished (0.0 - 1.0)
+ * @param step Name of the step that just finished
+ */
+typedef std::function<void(float progress, const std::string &step)> LevelLoadProgressCallback;
 
 /**
  * LevelV1 - A level loader and manager class
@@ -22,6 +37,17 @@ class AnimatedDataCharacter;
  * - NavMesh from the TMX navmesh layer
  * - entities.json data file
  * - details.json data file
+ *
+ * If the directory holds an up to date cooked package (level.ylpk, see tools/level_cook),
+ * the map, baked navmesh and entity spawns are loaded from it instead of the TMX and JSON.
+ *
+ * Loading runs as a JobGraph: map parsing, navmesh building, tileset decoding and per entity
+ * type asset decoding run on worker threads, tile sprite creation and agent spawning (GPU
+ * uploads) run on the constructing thread once their inputs are ready.
+ *
+ * If the directory also holds a world layout (world.json, see WorldStreamer), the level map
+ * stays resident and the world's regions are streamed in and out around the camera and
+ * player by updateWorldStreaming, each with its own navmesh and agents.
  */
 class LevelV1
 {
@@ -37,18 +63,108 @@ private:
     DataFile entities;
     DataFile details;
 
-    // NavMesh agents in this level
+    // NavMesh agents in this level, packed: removing one moves the last agent into its place
     std::vector<std::unique_ptr<AnimatedDataCharacterNavMeshAgent>> agents;
 
-    // Spatial partitioning grid for efficient queries
+    // Stable handles of the agents (see AgentHandle)
+    AgentHandleTable agentHandles;
+
+    // Spatial partitioning grid for efficient queries (entity ids are agent handle slots)
     SpatialGrid spatialGrid;
 
+    // Agent positions as last inserted into the spatial grid (parallel to agents)
+    std::vector<v2> spatialGridPositions;
+
+    // Hot per-frame agent state as contiguous arrays (parallel to agents)
+    AgentComponents agentComponents;
+
+    // Cell rectangles of the last visibility pass: cells overlapping the view and cells
+    // completely inside it. The next pass only re-checks agents in cells that changed.
+    bool hasVisibilityCells = false;
+    SpatialGrid::CellRect visibleCells;
+    SpatialGrid::CellRect coveredCells;
+
+    // Agents to re-check on the next visibility pass whatever their cells (added, crossed a
+    // cell boundary or changed stage of life), and scratch dense indices for updateAgentVisibility
+    std::vector<AgentHandle> visibilityDirtyAgents;
+    std::vector<size_t> visibilityCandidates;
+
     // List of all objects to render sorted by world Y position
     WorldPositionRenderedObjectsList renderedObjects;
 
+    // Deferred character sprite draws, grouped by shader and texture within depth bands
+    SpriteDrawBuffer spriteDrawBuffer;
+
     // Player character reference for hitbox checking (non-owning)
     const AnimatedDataCharacter *player;
 
+    // Simulation LOD tiers for agents and the frame counter used to stagger reduced-rate ticks
+    SimulationLODConfig simulationLODConfig;
+    uint64_t lodFrameCounter;
+
+    // Background AI work for one frame, split into contiguous slices of agents per job
+    // Jobs write moveVectors; the main thread applies them on a later frame once pendingJobs is 0
+    struct AgentAIBatch
+    {
+        std::vector<AnimatedDataCharacterNavMeshAgent *> agents;
+        std::vector<AgentHandle> handles; // Results of agents despawned in the meantime are dropped
+        std::vector<float> tickDts;
+        std::vector<uint8_t> detailed; // 1 = on-screen (detailed) AI, 0 = coarse off-screen AI
+        std::vector<v2> moveVectors;
+        std::atomic<size_t> pendingJobs{0};
+        bool hasResults = false; // Submitted but not yet applied (main thread only)
+    };
+    std::shared_ptr<AgentAIBatch> aiBatch;
+
+    // Block until the in-flight AI batch (if any) has finished
+    void waitForAgentAIBatch() const;
+
+    // Copy an agent's fields into agentComponents after they were changed outside its update
+    void gatherAgentComponents(const AnimatedDataCharacterNavMeshAgent *agent);
+
+    // Queue the agent at an index for the next visibility pass (once until that pass)
+    void markVisibilityDirty(size_t index);
+
+    // Re-test one agent against the view, recording a Coordinator change in deltas
+    void checkAgentVisibility(size_t index, CF_Aabb view, std::vector<VisibilityDelta> &deltas);
+
+    // Take the agent at an index out of the level: swap and pop of the agent list and every
+    // parallel array, removing it from the spatial grid without a rebuild
+    std::unique_ptr<AnimatedDataCharacterNavMeshAgent> removeAgentAt(size_t index);
+
+    // Handles of agents that died or were despawned, removed by processDespawnQueue
+    // (may hold duplicates and stale handles)
+    std::vector<AgentHandle> despawnQueue;
+
+    // Despawned agents kept for reuse by createAgentFromFile, keyed by entity folder
+    std::unordered_map<std::string, std::vector<std::unique_ptr<AnimatedDataCharacterNavMeshAgent>>> agentPools;
+
+    // Remove the queued agents once no background AI job references them,
+    // recycling them into agentPools
+    void processDespawnQueue();
+
+    // Streamed world regions (only when the level has a world layout)
+    std::unique_ptr<WorldStreamer> worldStreamer;
+
+    /**
+     * Spawn a region's agents on its navmesh and add its structure slices to the rendered objects
+     * @param region Region that just finished loading
+     */
+    void attachWorldRegion(WorldRegion &region);
+
+    /**
+     * Remove a region's structure slices and despawn its agents
+     * @param region Region that started unloading
+     */
+    void detachWorldRegion(WorldRegion &region);
+
+    /**
+     * Check if any agent or the player still uses a navmesh
+     * @param navmesh NavMesh to look for
+     * @return true if it is still referenced
+     */
+    bool isNavMeshInUse(const NavMesh *navmesh) const;
+
     // TMX tile dimensions (cached for convenience)
     int tileWidth;
     int tileHeight;
@@ -56,17 +172,66 @@ private:
     // Initialization status
     bool initialized;
 
+    /**
+     * Check that a cooked package exists and is newer than the TMX and entities.json
+     * @param packagePath Path to the level package
+     * @return true if the package can be used
+     */
+    bool isPackageCurrent(const std::string &packagePath) const;
+
+    /**
+     * Load the map, baked navmesh and spawn records from a cooked level package
+     * @param packagePath Path to the level package
+     * @param spawns Receives the entity spawn records
+     * @return true on success, false to fall back to loadFromSources
+     */
+    bool loadFromPackage(const std::string &packagePath, std::vector<LevelEntitySpawn> &spawns);
+
+    /**
+     * Load entities.json and flatten it into spawn records
+     * @param spawns Receives the entity spawn records
+     */
+    void loadEntitiesFromSources(std::vector<LevelEntitySpawn> &spawns);
+
+    /**
+     * Parse the TMX map
+     * @return true if the TMX map was loaded
+     */
+    bool loadMapFromSources();
+
+    /**
+     * Run the level load graph (map, navmesh, tilesets, entity assets, tile sprites, spawning)
+     * @param fromPackage true if loadFromPackage already provided the map, navmesh and spawns
+     * @param spawns Entity spawn records (filled by the graph when loading from sources)
+     * @param progress Optional progress callback
+     * @return true if the level map is available
+     */
+    bool loadLevelData(bool fromPackage, std::vector<LevelEntitySpawn> &spawns, const LevelLoadProgressCallback &progress);
+
+    /**
+     * Decode the animation sheets of every distinct entity type in the spawn records
+     * @param spawns Entity spawn records
+     */
+    static void prefetchEntityAssets(const std::vector<LevelEntitySpawn> &spawns);
+
+    /**
+     * Create agents for the spawn records
+     * @param spawns Entity spawn records
+     */
+    void spawnEntities(const std::vector<LevelEntitySpawn> &spawns);
+
 public:
     /**
      * Constructor - initializes all level components from a directory
      * @param directoryPath Path to the level directory (e.g., "/assets/Levels/test_two")
+     * @param progress Optional callback reporting load progress
      */
-    explicit LevelV1(const std::string &directoryPath);
+    explicit LevelV1(const std::string &directoryPath, const LevelLoadProgressCallback &progress = nullptr);
 
     /**
-     * Destructor
+     * Destructor - waits for background AI jobs that still reference agents
      */
-    ~LevelV1() = default;
+    ~LevelV1();
 
     /**
      * Check if the level was successfully initialized
@@ -95,7 +260,58 @@ public:
     const NavMesh &getNavMesh() const { return *navmesh; }
 
     /**
-     * Get the entities data file
+     * Get the navmesh covering a world point: a loaded world region's where it is walkable,
+     * otherwise the level navmesh
+     * @param point World position
+     * @return NavMesh to move on at that point
+     */
+    NavMesh *getNavMeshAt(v2 point);
+
+    /**
+     * Check if the level streams world regions (has a world layout)
+     * @return true if world streaming is active
+     */
+    bool hasWorldStreaming() const { return worldStreamer != nullptr; }
+
+    /**
+     * Get the world streamer (nullptr without a world layout)
+     * @return Pointer to the world streamer
+     */
+    WorldStreamer *getWorldStreamer() { return worldStreamer.get(); }
+    const WorldStreamer *getWorldStreamer() const { return worldStreamer.get(); }
+
+    /**
+     * Stream world regions around the camera and player: spawns the agents of regions that
+     * finished loading, removes those of unloaded regions and releases their data once unused.
+     * Does nothing without a world layout. Call once per frame before updateAgents.
+     * @param cameraPosition Camera position in world space
+     * @param playerPosition Player position in world space
+     */
+    void updateWorldStreaming(v2 cameraPosition, v2 playerPosition);
+
+    /**
+     * Get the maps currently resident: the level map and the map of every loaded world region
+     * @return Non-owning pointers, valid until the next updateWorldStreaming
+     */
+    std::vector<LevelMap *> getResidentMaps() const;
+
+    /**
+     * Recreate a resident map's tile sprites and structure slices after its tilesets were replaced
+     * @param map Map returned by getResidentMaps
+     */
+    void refreshMapTiles(LevelMap &map);
+
+    /**
+     * Switch the agents created from an entity folder to a reloaded prototype (hot reload)
+     * Waits for the running background AI batch first.
+     * @param folderPath Entity folder the prototype was built from
+     * @param prototype Reloaded prototype
+     * @return Number of agents rebound
+     */
+    size_t rebindAgents(const std::string &folderPath, std::shared_ptr<const EntityPrototype> prototype);
+
+    /**
+     * Get the entities data file (empty when loaded from a cooked package)
      * @return Reference to the entities DataFile
      */
     DataFile &getEntities() { return entities; }
@@ -129,6 +345,7 @@ public:
 
     /**
      * Create and add a NavMesh agent from an entity data file
+     * Reuses a despawned agent of the same entity type when one is pooled
      * @param entityDataPath Path to the entity JSON file
      * @return Raw pointer to the created agent, or nullptr if creation failed
      */
@@ -147,8 +364,15 @@ public:
     SpatialGrid &getSpatialGrid() { return spatialGrid; }
     const SpatialGrid &getSpatialGrid() const { return spatialGrid; }
 
+    /**
+     * Get the character sprite draw buffer (for draw statistics)
+     * @return Reference to the sprite draw buffer
+     */
+    const SpriteDrawBuffer &getSpriteDrawBuffer() const { return spriteDrawBuffer; }
+
     /**
      * Update the spatial grid with current agent positions
+     * Sweeps the agent positions; only agents that crossed a cell boundary touch the grid
      * Call this after agents have moved
      */
     void updateSpatialGrid();
@@ -167,6 +391,16 @@ public:
     AnimatedDataCharacterNavMeshAgent *getAgent(size_t index);
     const AnimatedDataCharacterNavMeshAgent *getAgent(size_t index) const;
 
+    /**
+     * Get the agent a handle refers to
+     * Indices change when agents are removed; hold a handle (AnimatedDataCharacterNavMeshAgent::getHandle)
+     * to refer to an agent across frames.
+     * @param handle Handle of the agent
+     * @return Pointer to the agent, or nullptr if it was removed
+     */
+    AnimatedDataCharacterNavMeshAgent *resolveAgent(AgentHandle handle);
+    const AnimatedDataCharacterNavMeshAgent *resolveAgent(AgentHandle handle) const;
+
     /**
      * Remove all agents from the level
      */
@@ -213,16 +447,77 @@ public:
 
     /**
      * Update all agents in the level
+     * On-screen agents run every frame; off-screen agents are ticked at the reduced
+     * rates of their simulation LOD tier with the time they skipped.
+     * Background AI for the agents that ticked is dispatched in batches of contiguous
+     * agents per job; the resulting move vectors are applied on a following frame.
      * @param dt Delta time in seconds
      */
     void updateAgents(float dt);
 
+    /**
+     * Update which agents are inside the camera view
+     * Only agents in spatial grid cells whose visibility could have changed are re-tested:
+     * cells entering or leaving the view or on its edge, skipping cells that were completely
+     * on screen before and after, plus agents queued by markVisibilityDirty. The first pass
+     * and the pass after a grid rebuild sweep every agent. Only agents whose visibility changed
+     * are written to (setIsOnScreen) and handed to the Coordinator. Call once per frame before
+     * updateAgents.
+     * @param camera Camera whose view bounds are tested
+     */
+    void updateAgentVisibility(const CFNativeCamera &camera);
+
+    /**
+     * Remove an agent from the level without it dying (e.g. its world region unloads)
+     * The agent leaves at the start of the next updateAgents, once no background AI job uses it.
+     * @param handle Handle of the agent (ignored if stale)
+     */
+    void despawnAgent(AgentHandle handle);
+
+    /**
+     * Mirror an agent's stage of life change into agentComponents (called by the agent)
+     * The agent is re-checked by the next visibility pass; dead agents are queued for removal at
+     * the start of the next updateAgents
+     * @param handle The agent's handle (ignored if stale)
+     * @param stage The new stage of life
+     */
+    void onAgentStageChanged(AgentHandle handle, StageOfLife stage);
+
+    /**
+     * Get the per-frame agent state arrays
+     * @return Reference to the component arrays (parallel to the agent indices)
+     */
+    const AgentComponents &getAgentComponents() const { return agentComponents; }
+
+    /**
+     * Set the simulation LOD tier thresholds used by updateAgents
+     * @param config Tier configuration (see SimulationLODConfig)
+     */
+    void setSimulationLODConfig(const SimulationLODConfig &config);
+
+    /**
+     * Get the simulation LOD tier thresholds
+     * @return Reference to the current configuration
+     */
+    const SimulationLODConfig &getSimulationLODConfig() const { return simulationLODConfig; }
+
     /**
      * Set all dying agents to dead state
      * This will cause them to be removed on the next updateAgents call
      */
     void cullDyingAgents();
 
+    /**
+     * Get the number of despawned agents pooled for reuse (all entity types)
+     * @return Number of pooled agents
+     */
+    size_t getPooledAgentCount() const;
+
+    /**
+     * Delete the pooled agents (e.g. after a wave, to give the memory back)
+     */
+    void clearAgentPools();
+
     /**
      * Render all layers of the level map (tiles only)
      * @param camera Camera to use for rendering
@@ -1,5 +1,6 @@
 #include "NavMesh.h"
 #include "tmx.h"
+#include "LevelPackage.h"
 #include "CFNativeCamera.h"
 #include <algorithm>
 #include <cmath>
@@ -24,6 +25,7 @@ void NavMesh::clear()
 {
     polygons.clear();
     edges.clear();
+    portals.clear();
     bounds = make_aabb(cf_v2(0, 0), cf_v2(0, 0));
 }
 
@@ -201,6 +203,119 @@ void NavMesh::applyCut(int tile_x, int tile_y, NavMeshCutEdge edge)
     }
 }
 
+void NavMesh::loadBaked(std::vector<NavPoly> baked_polygons, std::vector<NavEdge> baked_edges,
+                        int tile_width, int tile_height, float world_x, float world_y,
+                        int grid_width, int grid_height)
+{
+    clear();
+
+    this->tile_width = tile_width;
+    this->tile_height = tile_height;
+    this->world_x = world_x;
+    this->world_y = world_y;
+    this->grid_width = grid_width;
+    this->grid_height = grid_height;
+
+    polygons = std::move(baked_polygons);
+    edges = std::move(baked_edges);
+
+    float min_x = FLT_MAX, min_y = FLT_MAX;
+    float max_x = -FLT_MAX, max_y = -FLT_MAX;
+    for (const NavPoly &poly : polygons)
+    {
+        for (const CF_V2 &vertex : poly.vertices)
+        {
+            min_x = std::min(min_x, vertex.x);
+            min_y = std::min(min_y, vertex.y);
+            max_x = std::max(max_x, vertex.x);
+            max_y = std::max(max_y, vertex.y);
+        }
+    }
+
+    if (!polygons.empty())
+    {
+        bounds = make_aabb(cf_v2(min_x, min_y), cf_v2(max_x, max_y));
+    }
+
+    printf("NavMesh: Loaded baked mesh with %d polygons and %d edges\n",
+           getPolygonCount(), getEdgeCount());
+}
+
+void NavMesh::writeToPackage(LevelPackageWriter &writer) const
+{
+    writer.setNavMeshInfo(grid_width, grid_height, world_x, world_y);
+
+    std::vector<PackedVec2> vertices;
+    for (const NavPoly &poly : polygons)
+    {
+        vertices.clear();
+        for (const CF_V2 &vertex : poly.vertices)
+        {
+            vertices.push_back({vertex.x, vertex.y});
+        }
+        writer.addNavPolygon(vertices, poly.neighbors, {poly.center.x, poly.center.y});
+    }
+
+    for (const NavEdge &edge : edges)
+    {
+        writer.addNavEdge({edge.start.x, edge.start.y}, {edge.end.x, edge.end.y}, edge.poly_a, edge.poly_b);
+    }
+}
+
+bool NavMesh::loadFromPackage(const LevelPackage &package)
+{
+    size_t poly_count = 0;
+    size_t vertex_count = 0;
+    size_t neighbor_count = 0;
+    size_t edge_count = 0;
+    const PackedNavPoly *packed_polys = package.getSection<PackedNavPoly>(LevelPackageSection::NavPolygons, poly_count);
+    const PackedVec2 *packed_vertices = package.getSection<PackedVec2>(LevelPackageSection::NavVertices, vertex_count);
+    const int32_t *packed_neighbors = package.getSection<int32_t>(LevelPackageSection::NavNeighbors, neighbor_count);
+    const PackedNavEdge *packed_edges = package.getSection<PackedNavEdge>(LevelPackageSection::NavEdges, edge_count);
+
+    if (poly_count == 0)
+    {
+        return false;
+    }
+
+    std::vector<NavPoly> baked_polygons(poly_count);
+    for (size_t i = 0; i < poly_count; i++)
+    {
+        const PackedNavPoly &packed = packed_polys[i];
+        if (packed.firstVertex + static_cast<size_t>(packed.vertexCount) > vertex_count ||
+            packed.firstNeighbor + static_cast<size_t>(packed.neighborCount) > neighbor_count)
+        {
+            printf("NavMesh: Baked polygon %zu is out of range\n", i);
+            return false;
+        }
+
+        NavPoly &poly = baked_polygons[i];
+        poly.vertices.reserve(packed.vertexCount);
+        for (uint32_t v = 0; v < packed.vertexCount; v++)
+        {
+            const PackedVec2 &vertex = packed_vertices[packed.firstVertex + v];
+            poly.vertices.push_back(cf_v2(vertex.x, vertex.y));
+        }
+        poly.neighbors.assign(packed_neighbors + packed.firstNeighbor,
+                              packed_neighbors + packed.firstNeighbor + packed.neighborCount);
+        poly.center = cf_v2(packed.center.x, packed.center.y);
+    }
+
+    std::vector<NavEdge> baked_edges;
+    baked_edges.reserve(edge_count);
+    for (size_t i = 0; i < edge_count; i++)
+    {
+        const PackedNavEdge &packed = packed_edges[i];
+        baked_edges.push_back(NavEdge(cf_v2(packed.start.x, packed.start.y), cf_v2(packed.end.x, packed.end.y),
+                                      packed.polyA, packed.polyB));
+    }
+
+    const LevelPackageHeader &header = package.getHeader();
+    loadBaked(std::move(baked_polygons), std::move(baked_edges), header.tileWidth, header.tileHeight,
+              header.navWorldX, header.navWorldY, header.navGridWidth, header.navGridHeight);
+    return true;
+}
+
 CF_V2 NavMesh::tileToWorld(int tile_x, int tile_y, float world_x, float world_y) const
 {
     // Convert from TMX tile coordinates to world coordinates (centered on tile)
@@ -459,6 +574,26 @@ static bool lineSegmentsIntersect(CF_V2 p1, CF_V2 p2, CF_V2 p3, CF_V2 p4)
     return false;
 }
 
+// Check if two points coincide (within the edge matching tolerance)
+static bool pointsMatch(CF_V2 a, CF_V2 b)
+{
+    const float EPSILON = 0.1f;
+    return std::fabs(a.x - b.x) < EPSILON && std::fabs(a.y - b.y) < EPSILON;
+}
+
+// Check if a boundary edge was stitched to an adjacent mesh
+static bool isPortalEdge(const std::vector<NavPortal> &portals, const NavEdge &edge)
+{
+    for (const auto &portal : portals)
+    {
+        if (pointsMatch(portal.edge.start, edge.start) && pointsMatch(portal.edge.end, edge.end))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool NavMesh::crossesBoundaryEdge(CF_V2 start, CF_V2 end) const
 {
     // Check each edge in the navmesh
@@ -513,7 +648,7 @@ bool NavMesh::crossesBoundaryEdge(CF_V2 start, CF_V2 end) const
         // If this is a boundary edge, check if the movement path crosses it
         if (is_boundary)
         {
-            if (lineSegmentsIntersect(start, end, edge.start, edge.end))
+            if (lineSegmentsIntersect(start, end, edge.start, edge.end) && !isPortalEdge(portals, edge))
             {
                 return true;
             }
@@ -523,6 +658,97 @@ bool NavMesh::crossesBoundaryEdge(CF_V2 start, CF_V2 end) const
     return false;
 }
 
+// Check if an edge lies on one of a mesh's bounds lines (only those can touch another region's mesh)
+static bool isEdgeOnBounds(const NavEdge &edge, CF_Aabb bounds)
+{
+    const float EPSILON = 0.1f;
+    bool vertical = std::fabs(edge.start.x - edge.end.x) < EPSILON;
+    bool horizontal = std::fabs(edge.start.y - edge.end.y) < EPSILON;
+    if (vertical)
+    {
+        return std::fabs(edge.start.x - bounds.min.x) < EPSILON || std::fabs(edge.start.x - bounds.max.x) < EPSILON;
+    }
+    if (horizontal)
+    {
+        return std::fabs(edge.start.y - bounds.min.y) < EPSILON || std::fabs(edge.start.y - bounds.max.y) < EPSILON;
+    }
+    return false;
+}
+
+int NavMesh::stitchPortals(NavMesh &other)
+{
+    if (&other == this || polygons.empty() || other.polygons.empty())
+    {
+        return 0;
+    }
+
+    // Meshes must at least touch for any edge to be shared
+    const float EPSILON = 0.1f;
+    if (bounds.max.x + EPSILON < other.bounds.min.x || other.bounds.max.x + EPSILON < bounds.min.x ||
+        bounds.max.y + EPSILON < other.bounds.min.y || other.bounds.max.y + EPSILON < bounds.min.y)
+    {
+        return 0;
+    }
+
+    std::vector<const NavEdge *> seam;
+    for (const auto &edge : edges)
+    {
+        if (isEdgeOnBounds(edge, bounds))
+        {
+            seam.push_back(&edge);
+        }
+    }
+
+    std::vector<const NavEdge *> otherSeam;
+    for (const auto &edge : other.edges)
+    {
+        if (isEdgeOnBounds(edge, other.bounds))
+        {
+            otherSeam.push_back(&edge);
+        }
+    }
+
+    int stitched = 0;
+    for (const NavEdge *edge : seam)
+    {
+        for (const NavEdge *otherEdge : otherSeam)
+        {
+            bool same_edge = pointsMatch(edge->start, otherEdge->start) &&
+                             pointsMatch(edge->end, otherEdge->end);
+            bool reversed_edge = pointsMatch(edge->start, otherEdge->end) &&
+                                 pointsMatch(edge->end, otherEdge->start);
+            if (!same_edge && !reversed_edge)
+            {
+                continue;
+            }
+
+            NavPortal portal;
+            portal.edge = *edge;
+            portal.neighbor = &other;
+            portal.neighbor_poly = otherEdge->poly_a;
+            portals.push_back(portal);
+
+            NavPortal otherPortal;
+            otherPortal.edge = *otherEdge;
+            otherPortal.neighbor = this;
+            otherPortal.neighbor_poly = edge->poly_a;
+            other.portals.push_back(otherPortal);
+
+            stitched++;
+            break;
+        }
+    }
+
+    return stitched;
+}
+
+void NavMesh::removePortalsTo(const NavMesh *other)
+{
+    portals.erase(std::remove_if(portals.begin(), portals.end(), [other](const NavPortal &portal)
+                                 { return portal.neighbor == other; }),
+                  portals.end());
+}
+
 void NavMesh::debugRender(const class CFNativeCamera &camera) const
 {
     // Render both polygons and edges with default colors
@@ -9,8 +9,11 @@
 #include "NavMeshPath.h"
 
 // Forward declarations
+class NavMesh;
 struct TMXLayer;
 class tmx;
+class LevelPackage;
+class LevelPackageWriter;
 
 // Enum for tile edges
 enum NavMeshCutEdge
@@ -55,12 +58,23 @@ struct NavEdge
         : start(s), end(e), poly_a(a), poly_b(b) {}
 };
 
+// Structure to represent an edge shared with a polygon of another navmesh (stitched world regions)
+struct NavPortal
+{
+    NavEdge edge;            // Edge on this mesh (poly_a = polygon on this mesh)
+    const NavMesh *neighbor; // Mesh on the other side
+    int neighbor_poly;       // Polygon on the other side
+
+    NavPortal() : neighbor(nullptr), neighbor_poly(-1) {}
+};
+
 // Main NavMesh class for pathfinding and navigation
 class NavMesh
 {
 private:
     std::vector<NavPoly> polygons;                   // Navigation polygons
     std::vector<NavEdge> edges;                      // All edges in the mesh
+    std::vector<NavPortal> portals;                  // Edges stitched to adjacent meshes
     std::vector<NavMeshPoint> points;                // Named points on the mesh
     std::vector<std::shared_ptr<NavMeshPath>> paths; // All paths generated on this mesh
     int next_path_id;                                // Next path ID to assign (starts at 1)
@@ -116,6 +130,19 @@ public:
     // edge: which edge of the tile to cut
     void applyCut(int tile_x, int tile_y, NavMeshCutEdge edge);
 
+    // Load a mesh that was built and cut ahead of time (e.g. from a cooked level package)
+    // Replaces the current polygons and edges, bounds are recomputed from the vertices
+    void loadBaked(std::vector<NavPoly> baked_polygons, std::vector<NavEdge> baked_edges,
+                   int tile_width, int tile_height, float world_x, float world_y,
+                   int grid_width, int grid_height);
+
+    // Add the built (and cut) mesh to a level package being cooked
+    void writeToPackage(LevelPackageWriter &writer) const;
+
+    // Load the baked mesh stored in a level package
+    // Returns false if the package has no navmesh
+    bool loadFromPackage(const LevelPackage &package);
+
     // Query functions
     int getPolygonCount() const { return static_cast<int>(polygons.size()); }
     int getEdgeCount() const { return static_cast<int>(edges.size()); }
@@ -124,6 +151,10 @@ public:
     CF_Aabb getBounds() const { return bounds; }
     int getTileWidth() const { return tile_width; }
     int getTileHeight() const { return tile_height; }
+    float getWorldX() const { return world_x; }
+    float getWorldY() const { return world_y; }
+    int getGridWidth() const { return grid_width; }
+    int getGridHeight() const { return grid_height; }
 
     // Find which polygon contains a given world point
     // Returns -1 if point is not in any polygon
@@ -134,8 +165,21 @@ public:
 
     // Check if a line segment crosses any boundary edge (including cut edges)
     // Returns true if the movement would cross an edge with no neighbor
+    // Portal edges do not count as boundary
     bool crossesBoundaryEdge(CF_V2 start, CF_V2 end) const;
 
+    // Stitch this mesh to an adjacent mesh (e.g. neighbouring streamed world regions)
+    // Tile edges lying on both meshes' outer bounds with matching endpoints become portals on both meshes
+    // Returns the number of portal edges created
+    int stitchPortals(NavMesh &other);
+
+    // Remove the portals leading to another mesh (on this mesh only)
+    void removePortalsTo(const NavMesh *other);
+
+    // Get the portals stitched to adjacent meshes
+    const std::vector<NavPortal> &getPortals() const { return portals; }
+    int getPortalCount() const { return static_cast<int>(portals.size()); }
+
     // NavMesh point management
     // Add a point to the mesh (automatically finds containing polygon)
     bool addPoint(const std::string &name, CF_V2 position);
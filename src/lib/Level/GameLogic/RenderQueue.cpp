@@ -0,0 +1,76 @@
+#include "RenderQueue.h"
+#include <cmath>
+#include <climits>
+
+void RenderQueue::clear()
+{
+    entries.clear();
+}
+
+void RenderQueue::push(float worldY, uint32_t type, uint32_t index)
+{
+    entries.push_back(RenderQueueEntry{makeDepthKey(worldY), type, index});
+}
+
+uint32_t RenderQueue::makeDepthKey(float worldY)
+{
+    // Quantize and clamp to the int32 range
+    double quantized = std::floor(static_cast<double>(worldY) * DEPTH_KEY_SCALE);
+    if (quantized < static_cast<double>(INT32_MIN))
+        quantized = static_cast<double>(INT32_MIN);
+    if (quantized > static_cast<double>(INT32_MAX))
+        quantized = static_cast<double>(INT32_MAX);
+
+    // Bias to unsigned so the bit order matches numeric order, then invert so higher Y comes first
+    uint32_t biased = static_cast<uint32_t>(static_cast<int32_t>(quantized)) ^ 0x80000000u;
+    return ~biased;
+}
+
+void RenderQueue::sort()
+{
+    size_t count = entries.size();
+    if (count < 2)
+    {
+        return;
+    }
+
+    scratch.resize(count);
+    std::vector<RenderQueueEntry> *source = &entries;
+    std::vector<RenderQueueEntry> *destination = &scratch;
+
+    // Four 8-bit passes, least significant byte first
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        size_t counts[256] = {};
+        for (const auto &entry : *source)
+        {
+            counts[(entry.key >> shift) & 0xFF]++;
+        }
+
+        // Every key shares this byte - the pass would not move anything
+        if (counts[((*source)[0].key >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t &bucket : counts)
+        {
+            size_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+
+        for (const auto &entry : *source)
+        {
+            (*destination)[counts[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+
+        std::swap(source, destination);
+    }
+
+    if (source != &entries)
+    {
+        entries.swap(scratch);
+    }
+}
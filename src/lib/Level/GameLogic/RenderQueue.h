@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * RenderQueueEntry - One draw record in the render queue
+ *
+ * Kept small and flat so the whole queue sorts and walks as a contiguous array.
+ */
+struct RenderQueueEntry
+{
+    uint32_t key;   // Quantized depth key (ascending key = draw order)
+    uint32_t type;  // Object type (see ObjectRenderedByWorldPosition::getType)
+    uint32_t index; // Index of the object in its owning list
+};
+
+/**
+ * RenderQueue - Per-frame depth sorted list of draw records
+ *
+ * Filled fresh every frame with only the visible objects, then ordered with a stable
+ * LSD radix sort on the quantized world Y key. Objects with a higher world Y are further
+ * "back" and are drawn first.
+ */
+class RenderQueue
+{
+public:
+    /**
+     * World Y is quantized to 1 / DEPTH_KEY_SCALE pixel steps
+     */
+    static constexpr float DEPTH_KEY_SCALE = 4.0f;
+
+    /**
+     * Remove all entries (keeps allocated memory for the next frame)
+     */
+    void clear();
+
+    /**
+     * Add a draw record
+     * @param worldY World Y position used for depth sorting
+     * @param type Object type
+     * @param index Index of the object in its owning list
+     */
+    void push(float worldY, uint32_t type, uint32_t index);
+
+    /**
+     * Sort entries into draw order (back to front); stable for equal keys
+     */
+    void sort();
+
+    /**
+     * Get the entries in their current order
+     * @return Reference to the entry array
+     */
+    const std::vector<RenderQueueEntry> &getEntries() const { return entries; }
+
+    /**
+     * Get the number of entries
+     * @return Number of entries
+     */
+    size_t size() const { return entries.size(); }
+
+    /**
+     * Convert a world Y position to a depth key where higher Y sorts first
+     * @param worldY World Y position
+     * @return Depth key
+     */
+    static uint32_t makeDepthKey(float worldY);
+
+private:
+    std::vector<RenderQueueEntry> entries;
+    std::vector<RenderQueueEntry> scratch; // Ping-pong buffer for the radix passes
+};
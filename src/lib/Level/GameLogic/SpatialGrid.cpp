@@ -34,18 +34,36 @@ SpatialGrid::CellKey SpatialGrid::positionToCell(v2 position) const
         static_cast<int>(std::floor(position.y / m_cellSize))};
 }
 
+SpatialGrid::CellRect SpatialGrid::getCellRect(CF_Aabb bounds) const
+{
+    CellRect rect;
+    rect.minX = static_cast<int>(std::floor(bounds.min.x / m_cellSize));
+    rect.maxX = static_cast<int>(std::floor(bounds.max.x / m_cellSize));
+    rect.minY = static_cast<int>(std::floor(bounds.min.y / m_cellSize));
+    rect.maxY = static_cast<int>(std::floor(bounds.max.y / m_cellSize));
+    return rect;
+}
+
+SpatialGrid::CellRect SpatialGrid::getCoveredCellRect(CF_Aabb bounds) const
+{
+    // Cell x spans [x * cellSize, (x + 1) * cellSize)
+    CellRect rect;
+    rect.minX = static_cast<int>(std::ceil(bounds.min.x / m_cellSize));
+    rect.maxX = static_cast<int>(std::floor(bounds.max.x / m_cellSize)) - 1;
+    rect.minY = static_cast<int>(std::ceil(bounds.min.y / m_cellSize));
+    rect.maxY = static_cast<int>(std::floor(bounds.max.y / m_cellSize)) - 1;
+    return rect;
+}
+
 std::vector<SpatialGrid::CellKey> SpatialGrid::getCellsForAABB(CF_Aabb bounds) const
 {
     std::vector<CellKey> cells;
 
-    int minX = static_cast<int>(std::floor(bounds.min.x / m_cellSize));
-    int maxX = static_cast<int>(std::floor(bounds.max.x / m_cellSize));
-    int minY = static_cast<int>(std::floor(bounds.min.y / m_cellSize));
-    int maxY = static_cast<int>(std::floor(bounds.max.y / m_cellSize));
+    CellRect rect = getCellRect(bounds);
 
-    for (int y = minY; y <= maxY; ++y)
+    for (int y = rect.minY; y <= rect.maxY; ++y)
     {
-        for (int x = minX; x <= maxX; ++x)
+        for (int x = rect.minX; x <= rect.maxX; ++x)
         {
             cells.push_back(CellKey{x, y});
         }
@@ -72,8 +90,20 @@ void SpatialGrid::insert(size_t entityIndex, v2 position, float halfSize)
     }
 }
 
-void SpatialGrid::update(size_t entityIndex, v2 oldPosition, v2 newPosition, float halfSize)
+bool SpatialGrid::update(size_t entityIndex, v2 oldPosition, v2 newPosition, float halfSize)
 {
+    // Fast path: most frames an entity stays inside the same cells
+    CellRect oldRect = getCellRect(cf_make_aabb(
+        cf_v2(oldPosition.x - halfSize, oldPosition.y - halfSize),
+        cf_v2(oldPosition.x + halfSize, oldPosition.y + halfSize)));
+    CellRect newRect = getCellRect(cf_make_aabb(
+        cf_v2(newPosition.x - halfSize, newPosition.y - halfSize),
+        cf_v2(newPosition.x + halfSize, newPosition.y + halfSize)));
+    if (oldRect == newRect)
+    {
+        return false;
+    }
+
     // Get old and new cells
     auto oldCells = getCellsForEntity(oldPosition, halfSize);
     auto newCells = getCellsForEntity(newPosition, halfSize);
@@ -123,6 +153,8 @@ void SpatialGrid::update(size_t entityIndex, v2 oldPosition, v2 newPosition, flo
             m_cells[newCell].insert(entityIndex);
         }
     }
+
+    return true;
 }
 
 void SpatialGrid::remove(size_t entityIndex, v2 position, float halfSize)
@@ -165,6 +197,16 @@ std::vector<size_t> SpatialGrid::queryAABB(CF_Aabb bounds) const
     return std::vector<size_t>(resultSet.begin(), resultSet.end());
 }
 
+void SpatialGrid::queryCell(int x, int y, std::vector<size_t> &out) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_cells.find(CellKey{x, y});
+    if (it != m_cells.end())
+    {
+        out.insert(out.end(), it->second.begin(), it->second.end());
+    }
+}
+
 std::vector<size_t> SpatialGrid::queryRadius(v2 center, float radius) const
 {
     // Query using AABB first, then caller can do precise distance check
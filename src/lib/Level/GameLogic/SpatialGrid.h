@@ -20,6 +20,26 @@ using namespace Cute;
 class SpatialGrid
 {
 public:
+    /**
+     * Inclusive rectangle of cell coordinates
+     * An empty rectangle has max < min on either axis
+     */
+    struct CellRect
+    {
+        int minX = 0;
+        int minY = 0;
+        int maxX = -1;
+        int maxY = -1;
+
+        bool isEmpty() const { return maxX < minX || maxY < minY; }
+        bool contains(int x, int y) const { return x >= minX && x <= maxX && y >= minY && y <= maxY; }
+        bool operator==(const CellRect &other) const
+        {
+            return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+        }
+        bool operator!=(const CellRect &other) const { return !(*this == other); }
+    };
+
     /**
      * Constructor
      * @param cellSize Size of each grid cell in world units (pixels)
@@ -56,8 +76,9 @@ public:
      * @param oldPosition Previous world position
      * @param newPosition New world position
      * @param halfSize Half-size of the entity's bounding box
+     * @return true if the entity moved into or out of any cell
      */
-    void update(size_t entityIndex, v2 oldPosition, v2 newPosition, float halfSize = 32.0f);
+    bool update(size_t entityIndex, v2 oldPosition, v2 newPosition, float halfSize = 32.0f);
 
     /**
      * Remove an entity from the grid
@@ -82,6 +103,27 @@ public:
      */
     std::vector<size_t> queryRadius(v2 center, float radius) const;
 
+    /**
+     * Get the rectangle of cells that an AABB overlaps
+     * @param bounds The AABB in world units
+     */
+    CellRect getCellRect(CF_Aabb bounds) const;
+
+    /**
+     * Get the rectangle of cells lying completely inside an AABB
+     * @param bounds The AABB in world units
+     * @return The covered cells (empty if no cell fits inside the bounds)
+     */
+    CellRect getCoveredCellRect(CF_Aabb bounds) const;
+
+    /**
+     * Append the entities of a single cell
+     * @param x Cell column
+     * @param y Cell row
+     * @param out Receives the entity indices (not cleared, may repeat entities of other cells)
+     */
+    void queryCell(int x, int y, std::vector<size_t> &out) const;
+
     /**
      * Get the number of occupied cells
      */
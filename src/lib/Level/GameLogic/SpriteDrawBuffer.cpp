@@ -0,0 +1,290 @@
+#include "SpriteDrawBuffer.h"
+#include "IVisualEffect.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace Cute;
+
+void SpriteDrawBuffer::beginCharacter(float worldY)
+{
+    // Characters arrive back to front, so bands only ever move towards lower Y
+    if (!hasBand || std::fabs(bandStartY - worldY) > DEPTH_BAND_HEIGHT)
+    {
+        if (hasBand)
+        {
+            currentBand++;
+        }
+        bandStartY = worldY;
+        hasBand = true;
+    }
+
+    characterBands.push_back(currentBand);
+    characterBounds.push_back(cf_make_aabb(cf_v2(0.0f, 0.0f), cf_v2(0.0f, 0.0f)));
+    characterHasBounds.push_back(0);
+}
+
+void SpriteDrawBuffer::push(SpriteDrawCommand &command)
+{
+    if (characterBands.empty())
+    {
+        // Submitted without beginCharacter, treat it as its own character
+        beginCharacter(command.position.y);
+    }
+
+    command.character = static_cast<uint32_t>(characterBands.size() - 1);
+    command.group = 0;
+    command.textureKey = command.sprite->easy_sprite_id;
+    command.sequence = static_cast<uint32_t>(commands.size());
+    commands.push_back(command);
+
+    // Sprites are drawn centered on their position
+    const CF_Sprite &sprite = *command.sprite;
+    float halfWidth = 0.5f * sprite.w * std::fabs(sprite.scale.x);
+    float halfHeight = 0.5f * sprite.h * std::fabs(sprite.scale.y);
+    CF_Aabb bounds = cf_make_aabb(cf_v2(command.position.x - halfWidth, command.position.y - halfHeight),
+                                  cf_v2(command.position.x + halfWidth, command.position.y + halfHeight));
+
+    CF_Aabb &characterBox = characterBounds[command.character];
+    if (!characterHasBounds[command.character])
+    {
+        characterBox = bounds;
+        characterHasBounds[command.character] = 1;
+    }
+    else
+    {
+        characterBox.min.x = std::min(characterBox.min.x, bounds.min.x);
+        characterBox.min.y = std::min(characterBox.min.y, bounds.min.y);
+        characterBox.max.x = std::max(characterBox.max.x, bounds.max.x);
+        characterBox.max.y = std::max(characterBox.max.y, bounds.max.y);
+    }
+}
+
+void SpriteDrawBuffer::submit(const CF_Sprite *sprite, CF_V2 position, uint32_t layer, IVisualEffect *effect, uint64_t effectKey)
+{
+    if (!sprite || sprite->w <= 0 || sprite->h <= 0)
+    {
+        return;
+    }
+
+    SpriteDrawCommand command;
+    command.sprite = sprite;
+    command.position = position;
+    command.effect = effect;
+    command.effectKey = effect ? effectKey : 0;
+    command.shader = INVALID_SHADER_HANDLE;
+    command.color = cf_color_white();
+    command.strength = 0.0f;
+    command.pass = 1;
+    command.layer = layer;
+    push(command);
+}
+
+void SpriteDrawBuffer::submitGhost(const CF_Sprite *sprite, CF_V2 position, uint32_t order, ShaderHandle shader, float alpha, float strength)
+{
+    if (!sprite || sprite->w <= 0 || sprite->h <= 0)
+    {
+        return;
+    }
+
+    SpriteDrawCommand command;
+    command.sprite = sprite;
+    command.position = position;
+    command.effect = nullptr;
+    command.effectKey = 0;
+    command.shader = shader;
+    // For premultiplied pipeline, scale rgb and a equally
+    command.color = make_color(alpha, alpha, alpha, alpha);
+    command.strength = strength;
+    command.pass = 0;
+    command.layer = order;
+    push(command);
+}
+
+void SpriteDrawBuffer::assignGroups()
+{
+    // Greedy in submission order: a character joins the current group unless it is in another
+    // band or overlaps a character already in the group
+    size_t characterCount = characterBands.size();
+    characterGroups.assign(characterCount, 0);
+
+    uint32_t group = 0;
+    size_t groupStart = 0;
+    CF_Aabb groupBounds = cf_make_aabb(cf_v2(0.0f, 0.0f), cf_v2(0.0f, 0.0f));
+    bool groupHasBounds = false;
+
+    for (size_t c = 0; c < characterCount; ++c)
+    {
+        bool startGroup = c > 0 && characterBands[c] != characterBands[groupStart];
+        if (!startGroup && characterHasBounds[c] && groupHasBounds && cf_overlaps(characterBounds[c], groupBounds))
+        {
+            // Only a member's own bounds decide, the group's union is just a quick reject
+            for (size_t member = groupStart; member < c; ++member)
+            {
+                if (characterHasBounds[member] && cf_overlaps(characterBounds[c], characterBounds[member]))
+                {
+                    startGroup = true;
+                    break;
+                }
+            }
+        }
+
+        if (startGroup)
+        {
+            group++;
+            groupStart = c;
+            groupHasBounds = false;
+        }
+
+        characterGroups[c] = group;
+        if (characterHasBounds[c])
+        {
+            const CF_Aabb &bounds = characterBounds[c];
+            if (!groupHasBounds)
+            {
+                groupBounds = bounds;
+                groupHasBounds = true;
+            }
+            else
+            {
+                groupBounds.min.x = std::min(groupBounds.min.x, bounds.min.x);
+                groupBounds.min.y = std::min(groupBounds.min.y, bounds.min.y);
+                groupBounds.max.x = std::max(groupBounds.max.x, bounds.max.x);
+                groupBounds.max.y = std::max(groupBounds.max.y, bounds.max.y);
+            }
+        }
+    }
+
+    for (SpriteDrawCommand &command : commands)
+    {
+        command.group = characterGroups[command.character];
+    }
+}
+
+void SpriteDrawBuffer::flush()
+{
+    if (commands.empty())
+    {
+        reset();
+        return;
+    }
+
+    assignGroups();
+
+    order.resize(commands.size());
+    for (uint32_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+
+    // Group first so depth order holds, then ghosts before sprites, state and layer to merge draws.
+    // Characters in one group never overlap, so only their own layers have to keep their order.
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+              {
+        const SpriteDrawCommand &ca = commands[a];
+        const SpriteDrawCommand &cb = commands[b];
+        if (ca.group != cb.group)
+            return ca.group < cb.group;
+        if (ca.pass != cb.pass)
+            return ca.pass < cb.pass;
+        if (ca.effectKey != cb.effectKey)
+            return ca.effectKey < cb.effectKey;
+        if (ca.shader != cb.shader)
+            return ca.shader < cb.shader;
+        if (ca.layer != cb.layer)
+            return ca.layer < cb.layer;
+        if (ca.textureKey != cb.textureKey)
+            return ca.textureKey < cb.textureKey;
+        return ca.sequence < cb.sequence; });
+
+    IVisualEffect *activeEffect = nullptr;
+    uint64_t activeEffectKey = 0;
+    ShaderHandle activeShader = INVALID_SHADER_HANDLE;
+    uint64_t activeTexture = 0;
+    bool first = true;
+
+    for (uint32_t index : order)
+    {
+        const SpriteDrawCommand &command = commands[index];
+
+        if (first || command.effectKey != activeEffectKey || command.effect != activeEffect || command.shader != activeShader)
+        {
+            if (activeEffect)
+            {
+                activeEffect->endDraw();
+            }
+            if (activeShader != INVALID_SHADER_HANDLE)
+            {
+                ShaderRegistry::popShader();
+            }
+
+            activeEffect = command.effect;
+            activeEffectKey = command.effectKey;
+            activeShader = command.shader;
+            if (activeShader != INVALID_SHADER_HANDLE && ShaderRegistry::get(activeShader).id == 0)
+            {
+                activeShader = INVALID_SHADER_HANDLE; // Not loaded, draw with the default shader
+            }
+
+            if (activeShader != INVALID_SHADER_HANDLE)
+            {
+                ShaderRegistry::pushShader(activeShader);
+            }
+            if (activeEffect)
+            {
+                activeEffect->beginDraw();
+            }
+            stateChangeCount++;
+        }
+        else if (command.textureKey != activeTexture)
+        {
+            stateChangeCount++;
+        }
+        activeTexture = command.textureKey;
+        first = false;
+
+        // Color and vertex attributes ride in the vertices and don't break the batch
+        bool tinted = command.pass == 0;
+        if (tinted)
+        {
+            cf_draw_push_color(command.color);
+            cf_draw_push_vertex_attributes(command.strength, 0.0f, 0.0f, 0.0f);
+        }
+        cf_draw_push();
+        cf_draw_translate_v2(command.position);
+        cf_draw_sprite(command.sprite);
+        cf_draw_pop();
+        if (tinted)
+        {
+            cf_draw_pop_vertex_attributes();
+            cf_draw_pop_color();
+        }
+    }
+
+    if (activeEffect)
+    {
+        activeEffect->endDraw();
+    }
+    if (activeShader != INVALID_SHADER_HANDLE)
+    {
+        ShaderRegistry::popShader();
+    }
+
+    drawnCount += commands.size();
+    reset();
+}
+
+void SpriteDrawBuffer::reset()
+{
+    commands.clear();
+    characterBands.clear();
+    characterBounds.clear();
+    characterHasBounds.clear();
+    hasBand = false;
+    currentBand = 0;
+}
+
+void SpriteDrawBuffer::resetStats()
+{
+    drawnCount = 0;
+    stateChangeCount = 0;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <cute.h>
+#include "ShaderRegistry.h"
+
+// Forward declarations
+class IVisualEffect;
+
+/**
+ * SpriteDrawCommand - One deferred sprite draw
+ */
+struct SpriteDrawCommand
+{
+    const CF_Sprite *sprite; // Sprite to draw (must outlive the flush)
+    CF_V2 position;          // World position to translate to
+    IVisualEffect *effect;   // Effect whose shader wraps the draw, nullptr for the default shader
+    uint64_t effectKey;      // Stable id of the effect (EffectHandle::getKey), 0 for none
+    ShaderHandle shader;     // Shader pushed around the draw (ghosts), INVALID_SHADER_HANDLE for none
+    CF_Color color;          // Draw color (premultiplied)
+    float strength;          // Vertex attribute x handed to the shader
+    uint64_t textureKey;     // Texture the sprite samples from
+    uint32_t character;      // Character that submitted it (submission order)
+    uint32_t group;          // Batch group of the character, assigned by flush
+    uint32_t pass;           // 0 = ghost trail, 1 = character sprites
+    uint32_t layer;          // Draw order within the character's pass (bottom to top)
+    uint32_t sequence;       // Submission order, keeps sorting stable
+};
+
+/**
+ * SpriteDrawBuffer - Collects character sprite draws and submits them grouped by state
+ *
+ * Characters emit commands instead of drawing directly. Characters within DEPTH_BAND_HEIGHT
+ * of each other in world Y share a depth band, and each band is split into batch groups of
+ * characters whose bounds (including ghost trails) do not overlap. Inside a group, commands
+ * are ordered by pass, effect, layer and texture so the renderer can merge them into as few
+ * draw calls as possible; groups are drawn in submission (back to front) order, so a
+ * character never interleaves with one it overlaps.
+ */
+class SpriteDrawBuffer
+{
+public:
+    /**
+     * Characters closer than this in world Y share a depth band
+     */
+    static constexpr float DEPTH_BAND_HEIGHT = 16.0f;
+
+    /**
+     * Start the next character, and a new depth band if worldY is outside the current one
+     * Call once per character, in back to front order, before submitting its sprites
+     * @param worldY Depth sort position of the character
+     */
+    void beginCharacter(float worldY);
+
+    /**
+     * Queue a sprite draw of the current character
+     * @param sprite Sprite to draw (must stay valid until flush)
+     * @param position World position
+     * @param layer Sprite layer index within the character
+     * @param effect Effect shader to draw with, nullptr for none
+     * @param effectKey Stable id of the effect (EffectHandle::getKey), sorts the effect's draws
+     */
+    void submit(const CF_Sprite *sprite, CF_V2 position, uint32_t layer, IVisualEffect *effect = nullptr, uint64_t effectKey = 0);
+
+    /**
+     * Queue a ghost trail sprite of the current character (drawn behind its sprites)
+     * @param sprite Sprite to draw (must stay valid until flush)
+     * @param position World position of the ghost
+     * @param order Draw order within the trail (oldest ghost's bottom layer first)
+     * @param shader Ghost shader, INVALID_SHADER_HANDLE for the default shader
+     * @param alpha Ghost opacity
+     * @param strength Per-ghost shader strength
+     */
+    void submitGhost(const CF_Sprite *sprite, CF_V2 position, uint32_t order, ShaderHandle shader, float alpha, float strength);
+
+    /**
+     * Sort and draw all queued commands, then clear the buffer
+     * Must be called before drawing anything that sorts between characters (structures, overlays)
+     */
+    void flush();
+
+    /**
+     * Get the number of queued commands
+     * @return Number of commands waiting for flush
+     */
+    size_t getCommandCount() const { return commands.size(); }
+
+    /**
+     * Get the number of sprites drawn since the last resetStats
+     * @return Sprite count
+     */
+    size_t getDrawnCount() const { return drawnCount; }
+
+    /**
+     * Get the number of shader/texture state changes since the last resetStats
+     * This is an upper bound on the draw calls issued for character sprites
+     * @return State change count
+     */
+    size_t getStateChangeCount() const { return stateChangeCount; }
+
+    /**
+     * Reset the drawn and state change counters (call once per frame)
+     */
+    void resetStats();
+
+private:
+    std::vector<SpriteDrawCommand> commands;
+    std::vector<uint32_t> order; // Sorted indices into commands
+
+    // Per character (indexed by SpriteDrawCommand::character)
+    std::vector<uint32_t> characterBands;
+    std::vector<CF_Aabb> characterBounds; // Union of the character's sprite bounds
+    std::vector<uint8_t> characterHasBounds;
+    std::vector<uint32_t> characterGroups; // Scratch for flush
+
+    uint32_t currentBand = 0;
+    float bandStartY = 0.0f;
+    bool hasBand = false;
+
+    // Append a command for the current character and grow its bounds
+    void push(SpriteDrawCommand &command);
+
+    // Split every band into groups of characters that do not overlap
+    void assignGroups();
+
+    // Forget all commands and characters
+    void reset();
+
+    size_t drawnCount = 0;
+    size_t stateChangeCount = 0;
+};
@@ -1,24 +1,19 @@
 #include "WorldPositionRenderedObjectsList.h"
 #include "LevelMap.h"
 #include "AnimatedDataCharacter.h"
-#include "AnimatedDataCharacterNavMeshAgent.h"
+#include "AgentComponents.h"
 #include "CFNativeCamera.h"
 #include "DataFile.h"
 #include <cstdio>
 
 // ObjectRenderedByWorldPosition implementation
 ObjectRenderedByWorldPosition::ObjectRenderedByWorldPosition(StructureLayer *layer)
-    : type(0), worldY(0.0f), structureLayer(layer), navMeshAgent(nullptr), playerCharacter(nullptr)
-{
-}
-
-ObjectRenderedByWorldPosition::ObjectRenderedByWorldPosition(AnimatedDataCharacterNavMeshAgent *agent)
-    : type(1), worldY(0.0f), structureLayer(nullptr), navMeshAgent(agent), playerCharacter(nullptr)
+    : type(0), worldY(0.0f), structureLayer(layer), playerCharacter(nullptr), structureSlice(nullptr), bounds(), hasBounds(false)
 {
 }
 
 ObjectRenderedByWorldPosition::ObjectRenderedByWorldPosition(AnimatedDataCharacter *player)
-    : type(2), worldY(0.0f), structureLayer(nullptr), navMeshAgent(nullptr), playerCharacter(player)
+    : type(2), worldY(0.0f), structureLayer(nullptr), playerCharacter(player), structureSlice(nullptr), bounds(), hasBounds(false)
 {
 }
 
@@ -37,14 +32,6 @@ void ObjectRenderedByWorldPosition::render(const CFNativeCamera &camera, const D
         }
         break;
 
-    case 1: // NavMeshAgent
-        if (navMeshAgent)
-        {
-            v2 agentPos = navMeshAgent->getPosition();
-            navMeshAgent->render(agentPos);
-        }
-        break;
-
     case 2: // PlayerCharacter
         if (playerCharacter)
         {
@@ -59,197 +46,151 @@ void ObjectRenderedByWorldPosition::render(const CFNativeCamera &camera, const D
     }
 }
 
-// WorldPositionRenderedObjectsList implementation
-WorldPositionRenderedObjectsList::WorldPositionRenderedObjectsList()
-    : head(nullptr), tail(nullptr), count(0)
+ObjectRenderedByWorldPosition::ObjectRenderedByWorldPosition(const StructureRowSlice *slice)
+    : type(3), worldY(0.0f), structureLayer(nullptr), playerCharacter(nullptr), structureSlice(slice), bounds(), hasBounds(false)
 {
+    if (slice)
+    {
+        setWorldY(slice->worldY);
+        setBounds(slice->bounds);
+    }
 }
 
-WorldPositionRenderedObjectsList::~WorldPositionRenderedObjectsList()
+bool ObjectRenderedByWorldPosition::isInView(const CFNativeCamera &camera, float worldX, float worldY) const
 {
-    clear();
+    if (!hasBounds)
+    {
+        return true;
+    }
+
+    CF_Aabb offsetBounds = bounds;
+    offsetBounds.min.x += worldX;
+    offsetBounds.min.y += worldY;
+    offsetBounds.max.x += worldX;
+    offsetBounds.max.y += worldY;
+    return camera.isVisible(offsetBounds);
 }
 
-void WorldPositionRenderedObjectsList::add(const ObjectRenderedByWorldPosition &object)
+bool ObjectRenderedByWorldPosition::refersToSameObject(const ObjectRenderedByWorldPosition &other) const
 {
-    Node *newNode = new Node(object);
-
-    if (!head)
+    if (type != other.type)
     {
-        // Empty list
-        head = tail = newNode;
+        return false;
     }
-    else
+
+    switch (type)
     {
-        // Add to end of list
-        tail->next = newNode;
-        newNode->prev = tail;
-        tail = newNode;
+    case 0: // StructureLayer
+        return structureLayer == other.structureLayer;
+    case 2: // PlayerCharacter
+        return playerCharacter == other.playerCharacter;
+    case 3: // StructureRowSlice
+        return structureSlice == other.structureSlice;
     }
+    return false;
+}
+
+// WorldPositionRenderedObjectsList implementation
+WorldPositionRenderedObjectsList::WorldPositionRenderedObjectsList()
+{
+}
 
-    count++;
+WorldPositionRenderedObjectsList::~WorldPositionRenderedObjectsList()
+{
+    clear();
 }
 
-bool WorldPositionRenderedObjectsList::remove(const ObjectRenderedByWorldPosition &object)
+void WorldPositionRenderedObjectsList::add(const ObjectRenderedByWorldPosition &object)
 {
-    Node *current = head;
+    objects.push_back(object);
+}
 
-    while (current)
+bool WorldPositionRenderedObjectsList::remove(const ObjectRenderedByWorldPosition &object)
+{
+    for (auto it = objects.begin(); it != objects.end(); ++it)
     {
-        // Compare based on type and pointer
-        bool match = false;
-        if (current->object.getType() == object.getType())
+        if (it->refersToSameObject(object))
         {
-            switch (object.getType())
-            {
-            case 0: // StructureLayer
-                match = (current->object.asStructureLayer() == object.asStructureLayer());
-                break;
-            case 1: // NavMeshAgent
-                match = (current->object.asNavMeshAgent() == object.asNavMeshAgent());
-                break;
-            case 2: // PlayerCharacter
-                match = (current->object.asPlayerCharacter() == object.asPlayerCharacter());
-                break;
-            }
-        }
-
-        if (match)
-        {
-            // Remove this node
-            if (current->prev)
-            {
-                current->prev->next = current->next;
-            }
-            else
-            {
-                // Removing head
-                head = current->next;
-            }
-
-            if (current->next)
-            {
-                current->next->prev = current->prev;
-            }
-            else
-            {
-                // Removing tail
-                tail = current->prev;
-            }
-
-            delete current;
-            count--;
+            // Erase (not swap) so equal depth keys keep a stable order between frames
+            objects.erase(it);
+            renderQueue.clear(); // Queued indices are stale now
             return true;
         }
-
-        current = current->next;
     }
 
     return false;
 }
 
-void WorldPositionRenderedObjectsList::sort()
+float WorldPositionRenderedObjectsList::getCharacterWorldY(CF_V2 position)
 {
-    // Calculate worldY for dynamic objects only (structures are calculated once when added)
-    Node *current = head;
-    int tileWidth = 32;  // TODO: Get actual tile width from somewhere
     int tileHeight = 32; // TODO: Get actual tile height from somewhere
 
-    while (current)
+    // WorldY = character's worldY - (tile_height/2)
+    return position.y - (tileHeight / 2.0f);
+}
+
+void WorldPositionRenderedObjectsList::buildRenderQueue(const CFNativeCamera &camera, float worldX, float worldY,
+                                                        const AgentComponents *agents)
+{
+    renderQueue.clear();
+
+    for (size_t i = 0; i < objects.size(); ++i)
     {
-        ObjectRenderedByWorldPosition &obj = current->object;
+        ObjectRenderedByWorldPosition &obj = objects[i];
 
         switch (obj.getType())
         {
         case 0: // StructureLayer
         {
-            // Skip - structure positions are calculated once when added since they never move
+            // Structure positions are calculated once when added since they never move
+            if (!obj.asStructureLayer() || !obj.isInView(camera, worldX, worldY))
+            {
+                continue;
+            }
             break;
         }
 
-        case 1: // NavMeshAgent
+        case 2: // PlayerCharacter
         {
-            AnimatedDataCharacterNavMeshAgent *agent = obj.asNavMeshAgent();
-            if (agent)
+            AnimatedDataCharacter *player = obj.asPlayerCharacter();
+            if (!player)
             {
-                v2 pos = agent->getPosition();
-                // WorldY = agent's worldY - (tile_height/2)
-                obj.setWorldY(pos.y - (tileHeight / 2.0f));
+                continue;
             }
+            obj.setWorldY(getCharacterWorldY(player->getPosition()));
             break;
         }
 
-        case 2: // PlayerCharacter
+        case 3: // StructureRowSlice
         {
-            AnimatedDataCharacter *player = obj.asPlayerCharacter();
-            if (player)
+            // Slice depth and bounds come from the row itself and never change
+            if (!obj.asStructureSlice() || !obj.isInView(camera, worldX, worldY))
             {
-                v2 pos = player->getPosition();
-                // WorldY = player's worldY - (tile_height/2)
-                obj.setWorldY(pos.y - (tileHeight / 2.0f));
+                continue;
             }
             break;
         }
-        }
 
-        current = current->next;
-    }
+        default:
+            continue;
+        }
 
-    // Now perform actual sorting using insertion sort
-    // (works well for linked lists and nearly-sorted data)
-    if (!head || !head->next)
-    {
-        return; // Already sorted (0 or 1 element)
+        renderQueue.push(obj.getWorldY(), static_cast<uint32_t>(obj.getType()), static_cast<uint32_t>(i));
     }
 
-    Node *sorted = nullptr;
-    current = head;
-
-    while (current)
+    // Off-screen and dying agents never enter the queue
+    if (agents)
     {
-        Node *next = current->next;
-
-        // Insert current node into sorted list
-        if (!sorted || sorted->object.getWorldY() <= current->object.getWorldY())
-        {
-            // Insert at beginning
-            current->next = sorted;
-            current->prev = nullptr;
-            if (sorted)
-            {
-                sorted->prev = current;
-            }
-            sorted = current;
-        }
-        else
+        for (size_t i = 0; i < agents->size(); ++i)
         {
-            // Find insertion point
-            Node *search = sorted;
-            while (search->next && search->next->object.getWorldY() > current->object.getWorldY())
-            {
-                search = search->next;
-            }
-
-            // Insert after search
-            current->next = search->next;
-            current->prev = search;
-            if (search->next)
+            if (agents->onScreen[i] && agents->stages[i] != StageOfLife::Dying)
             {
-                search->next->prev = current;
+                renderQueue.push(getCharacterWorldY(agents->positions[i]), 1, static_cast<uint32_t>(i));
             }
-            search->next = current;
         }
-
-        current = next;
     }
 
-    // Update head and tail
-    head = sorted;
-    tail = head;
-    while (tail && tail->next)
-    {
-        tail = tail->next;
-    }
+    renderQueue.sort();
 }
 
 void WorldPositionRenderedObjectsList::debugPrint() const
@@ -257,15 +198,12 @@ void WorldPositionRenderedObjectsList::debugPrint() const
     printf("\n╔══════════════════════════════════════════════════════════════════════╗\n");
     printf("║        World Position Rendered Objects List - Debug Output          ║\n");
     printf("╠══════════════════════════════════════════════════════════════════════╣\n");
-    printf("║ Total Objects: %-53zu ║\n", count);
+    printf("║ Total Objects: %-53zu ║\n", objects.size());
     printf("╚══════════════════════════════════════════════════════════════════════╝\n\n");
 
     int objectNum = 1;
-    Node *current = head;
-
-    while (current)
+    for (const ObjectRenderedByWorldPosition &obj : objects)
     {
-        const ObjectRenderedByWorldPosition &obj = current->object;
 
         printf("┌─ Object #%d ", objectNum++);
         for (int i = 0; i < 60; i++)
@@ -318,20 +256,6 @@ void WorldPositionRenderedObjectsList::debugPrint() const
             break;
         }
 
-        case 1: // NavMeshAgent
-        {
-            AnimatedDataCharacterNavMeshAgent *agent = obj.asNavMeshAgent();
-            if (agent)
-            {
-                v2 pos = agent->getPosition();
-                printf("│ Type: NavMeshAgent\n");
-                printf("│ Position: (%.2f, %.2f)\n", pos.x, pos.y);
-                printf("│ On Screen: %s\n", agent->getIsOnScreen() ? "Yes" : "No");
-                printf("│ Current Polygon: %d\n", agent->getCurrentPolygon());
-            }
-            break;
-        }
-
         case 2: // PlayerCharacter
         {
             AnimatedDataCharacter *player = obj.asPlayerCharacter();
@@ -345,6 +269,20 @@ void WorldPositionRenderedObjectsList::debugPrint() const
             break;
         }
 
+        case 3: // StructureRowSlice
+        {
+            const StructureRowSlice *slice = obj.asStructureSlice();
+            if (slice)
+            {
+                printf("│ Type: StructureRowSlice\n");
+                printf("│ Layer: %s\n", slice->layer ? slice->layer->name.c_str() : "(none)");
+                printf("│ Row: %d\n", slice->row);
+                printf("│ World Y: %.1f\n", slice->worldY);
+                printf("│ Tiles: %zu\n", slice->tiles.size());
+            }
+            break;
+        }
+
         default:
             printf("│ Type: Unknown (%d)\n", obj.getType());
             break;
@@ -354,8 +292,6 @@ void WorldPositionRenderedObjectsList::debugPrint() const
         for (int i = 0; i < 70; i++)
             printf("─");
         printf("\n\n");
-
-        current = current->next;
     }
 
     printf("═════════════════════════════════════════════════════════════════════════\n");
@@ -365,14 +301,6 @@ void WorldPositionRenderedObjectsList::debugPrint() const
 
 void WorldPositionRenderedObjectsList::clear()
 {
-    Node *current = head;
-    while (current)
-    {
-        Node *next = current->next;
-        delete current;
-        current = next;
-    }
-
-    head = tail = nullptr;
-    count = 0;
+    objects.clear();
+    renderQueue.clear();
 }
@@ -1,32 +1,42 @@
 #pragma once
 
 #include <cstddef>
+#include <vector>
+#include <cute.h>
+#include "RenderQueue.h"
 
 // Forward declarations
 class CFNativeCamera;
 class DataFile;
 class AnimatedDataCharacter;
-class AnimatedDataCharacterNavMeshAgent;
+struct AgentComponents;
 struct StructureLayer;
+struct StructureRowSlice;
 
 /**
  * ObjectRenderedByWorldPosition - Represents an object that can be rendered based on world Y position
  *
  * This class can hold one of three types:
  * - StructureLayer (type 0)
- * - NavMeshAgent (type 1)
  * - PlayerCharacter (type 2)
+ * - StructureRowSlice (type 3)
+ * Type 1 (NavMeshAgent) is used by render queue entries of level agents, which are queued
+ * straight from the level's AgentComponents and have no object in the list.
  */
 class ObjectRenderedByWorldPosition
 {
 private:
-    int type;     // 0 = StructureLayer, 1 = NavMeshAgent, 2 = PlayerCharacter
+    int type;     // 0 = StructureLayer, 2 = PlayerCharacter, 3 = StructureRowSlice
     float worldY; // World Y position for depth sorting
 
     // Storage for the different types (only one will be valid based on type)
     StructureLayer *structureLayer;
-    AnimatedDataCharacterNavMeshAgent *navMeshAgent;
     AnimatedDataCharacter *playerCharacter;
+    const StructureRowSlice *structureSlice;
+
+    // World bounds for camera culling of static objects
+    CF_Aabb bounds;
+    bool hasBounds;
 
 public:
     /**
@@ -35,18 +45,18 @@ public:
     explicit ObjectRenderedByWorldPosition(StructureLayer *layer);
 
     /**
-     * Constructor for NavMeshAgent
+     * Constructor for PlayerCharacter
      */
-    explicit ObjectRenderedByWorldPosition(AnimatedDataCharacterNavMeshAgent *agent);
+    explicit ObjectRenderedByWorldPosition(AnimatedDataCharacter *player);
 
     /**
-     * Constructor for PlayerCharacter
+     * Constructor for StructureRowSlice (takes its world Y and bounds from the slice)
      */
-    explicit ObjectRenderedByWorldPosition(AnimatedDataCharacter *player);
+    explicit ObjectRenderedByWorldPosition(const StructureRowSlice *slice);
 
     /**
      * Get the type of object
-     * @return 0 for StructureLayer, 1 for NavMeshAgent, 2 for PlayerCharacter
+     * @return 0 for StructureLayer, 2 for PlayerCharacter, 3 for StructureRowSlice
      */
     int getType() const { return type; }
 
@@ -56,14 +66,14 @@ public:
     StructureLayer *asStructureLayer() const { return structureLayer; }
 
     /**
-     * Get as NavMeshAgent (only valid if type == 1)
+     * Get as PlayerCharacter (only valid if type == 2)
      */
-    AnimatedDataCharacterNavMeshAgent *asNavMeshAgent() const { return navMeshAgent; }
+    AnimatedDataCharacter *asPlayerCharacter() const { return playerCharacter; }
 
     /**
-     * Get as PlayerCharacter (only valid if type == 2)
+     * Get as StructureRowSlice (only valid if type == 3)
      */
-    AnimatedDataCharacter *asPlayerCharacter() const { return playerCharacter; }
+    const StructureRowSlice *asStructureSlice() const { return structureSlice; }
 
     /**
      * Get the world Y position for depth sorting
@@ -75,6 +85,28 @@ public:
      */
     void setWorldY(float y) { worldY = y; }
 
+    /**
+     * Set the world bounds used to cull this object (static objects only)
+     */
+    void setBounds(CF_Aabb worldBounds)
+    {
+        bounds = worldBounds;
+        hasBounds = true;
+    }
+
+    /**
+     * Check if this object is inside the camera view (always true without bounds)
+     * @param camera Camera to test against
+     * @param worldX World X offset the object is rendered at
+     * @param worldY World Y offset the object is rendered at
+     */
+    bool isInView(const CFNativeCamera &camera, float worldX = 0.0f, float worldY = 0.0f) const;
+
+    /**
+     * Check if this object refers to the same thing as another (type and pointer)
+     */
+    bool refersToSameObject(const ObjectRenderedByWorldPosition &other) const;
+
     /**
      * Render the object using the appropriate render method based on type
      * @param camera Camera to use for rendering
@@ -87,27 +119,18 @@ public:
 };
 
 /**
- * WorldPositionRenderedObjectsList - Linked list for objects rendered by world Y position
+ * WorldPositionRenderedObjectsList - Registry of objects rendered by world Y position
  *
- * This class maintains a linked list of ObjectRenderedByWorldPosition nodes.
- * Objects can be added, removed, and sorted by their world Y position for proper depth ordering.
+ * Objects are kept in a flat array. Every frame buildRenderQueue() pushes only the
+ * visible ones into a RenderQueue and radix sorts it, so off-screen agents never
+ * take part in the sort. Level agents are not objects of the list: they are queued from
+ * the level's AgentComponents by index, so spawning and despawning them never touches it.
  */
 class WorldPositionRenderedObjectsList
 {
 private:
-    struct Node
-    {
-        ObjectRenderedByWorldPosition object;
-        Node *next;
-        Node *prev;
-
-        Node(const ObjectRenderedByWorldPosition &obj)
-            : object(obj), next(nullptr), prev(nullptr) {}
-    };
-
-    Node *head;
-    Node *tail;
-    size_t count;
+    std::vector<ObjectRenderedByWorldPosition> objects;
+    RenderQueue renderQueue;
 
 public:
     /**
@@ -116,7 +139,7 @@ public:
     WorldPositionRenderedObjectsList();
 
     /**
-     * Destructor - cleans up all nodes
+     * Destructor
      */
     ~WorldPositionRenderedObjectsList();
 
@@ -134,16 +157,33 @@ public:
     bool remove(const ObjectRenderedByWorldPosition &object);
 
     /**
-     * Sort the list by world Y position
-     * For now, this is a placeholder and does nothing
+     * Build this frame's render queue from the visible objects and sort it back to front
+     * Updates the world Y of the player first
+     * @param camera Camera used to cull objects
+     * @param worldX World X offset static objects are rendered at
+     * @param worldY World Y offset static objects are rendered at
+     * @param agents Agents to queue (type 1, indexed like the arrays), on screen and not dying
      */
-    void sort();
+    void buildRenderQueue(const CFNativeCamera &camera, float worldX = 0.0f, float worldY = 0.0f,
+                          const AgentComponents *agents = nullptr);
+
+    /**
+     * Get the depth sorting world Y of a character standing at a position
+     * @param position Character position
+     */
+    static float getCharacterWorldY(CF_V2 position);
 
     /**
      * Get the number of objects in the list
      * @return Number of objects
      */
-    size_t getCount() const { return count; }
+    size_t getCount() const { return objects.size(); }
+
+    /**
+     * Get the number of objects queued by the last buildRenderQueue call
+     * @return Number of queued objects
+     */
+    size_t getQueuedCount() const { return renderQueue.size(); }
 
     /**
      * Clear all objects from the list
@@ -157,17 +197,36 @@ public:
     void debugPrint() const;
 
     /**
-     * Iterate through all objects in the list and call a function on each
+     * Iterate through all objects in the list (unordered) and call a function on each
      * @param func Function to call for each ObjectRenderedByWorldPosition
      */
     template <typename Func>
     void forEach(Func func)
     {
-        Node *current = head;
-        while (current)
+        for (auto &object : objects)
+        {
+            func(object);
+        }
+    }
+
+    /**
+     * Iterate through the last built render queue in draw order
+     * @param objectFunc Function to call for each queued ObjectRenderedByWorldPosition
+     * @param agentFunc Function to call with the index of each queued agent
+     */
+    template <typename ObjectFunc, typename AgentFunc>
+    void forEachQueued(ObjectFunc objectFunc, AgentFunc agentFunc)
+    {
+        for (const auto &entry : renderQueue.getEntries())
         {
-            func(current->object);
-            current = current->next;
+            if (entry.type == 1)
+            {
+                agentFunc(static_cast<size_t>(entry.index));
+            }
+            else
+            {
+                objectFunc(objects[entry.index]);
+            }
         }
     }
 };
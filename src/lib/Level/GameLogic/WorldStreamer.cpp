@@ -0,0 +1,512 @@
+#include "WorldStreamer.h"
+#include "CFNativeCamera.h"
+#include "DataFile.h"
+#include "JobSystem.h"
+#include "AnimatedDataCharacter.h"
+#include <cstdio>
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <thread>
+
+// WorldStreamer implementation
+WorldStreamer::WorldStreamer()
+    : regionWidth(0), regionHeight(0), tileWidth(0), tileHeight(0), gridOriginX(0.0f), gridOriginY(0.0f), gridWidth(0), gridHeight(0),
+      baseNavMesh(nullptr)
+{
+}
+
+WorldStreamer::~WorldStreamer()
+{
+    // Load jobs only touch their PendingLoad, but may still be using the JobSystem
+    for (auto &region : regions)
+    {
+        while (region->pending && !region->pending->done.load())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool WorldStreamer::load(const std::string &directoryPath, int defaultTileWidth, int defaultTileHeight)
+{
+    levelDirectory = directoryPath;
+    std::string layoutPath = directoryPath + "/" + WORLD_LAYOUT_FILENAME;
+
+    DataFile layout;
+    try
+    {
+        layout = DataFile(layoutPath);
+    }
+    catch (const std::exception &e)
+    {
+        printf("WorldStreamer Error: Could not load world layout %s: %s\n", layoutPath.c_str(), e.what());
+        return false;
+    }
+
+    regionWidth = layout.value("region_width", 0);
+    regionHeight = layout.value("region_height", 0);
+    tileWidth = layout.value("tile_width", defaultTileWidth);
+    tileHeight = layout.value("tile_height", defaultTileHeight);
+    if (regionWidth <= 0 || regionHeight <= 0 || tileWidth <= 0 || tileHeight <= 0)
+    {
+        printf("WorldStreamer Error: World layout %s needs a positive region and tile size\n", layoutPath.c_str());
+        return false;
+    }
+    int originX = layout.value("origin_x", 0);
+    int originY = layout.value("origin_y", 0);
+
+    // Tiles are drawn centered on their position, so regions start half a tile before their first tile
+    gridOriginX = originX * static_cast<float>(tileWidth) - tileWidth / 2.0f;
+    gridOriginY = originY * static_cast<float>(tileHeight) - tileHeight / 2.0f;
+
+    config.loadRadius = layout.value("load_radius", config.loadRadius);
+    config.hysteresis = layout.value("hysteresis", config.hysteresis);
+    config.memoryBudget = static_cast<size_t>(layout.value("memory_budget_mb", static_cast<double>(config.memoryBudget) / (1024.0 * 1024.0)) * 1024.0 * 1024.0);
+    config.maxConcurrentLoads = layout.value("max_concurrent_loads", config.maxConcurrentLoads);
+
+    if (!layout.contains("regions") || !layout["regions"].is_array())
+    {
+        printf("WorldStreamer Error: World layout %s has no regions array\n", layoutPath.c_str());
+        return false;
+    }
+
+    regions.clear();
+    gridWidth = 0;
+    gridHeight = 0;
+    float regionPixelWidth = static_cast<float>(regionWidth * tileWidth);
+    float regionPixelHeight = static_cast<float>(regionHeight * tileHeight);
+    for (const auto &entry : layout["regions"])
+    {
+        if (!entry.contains("map") || !entry["map"].is_string())
+        {
+            printf("WorldStreamer Warning: Skipping region without a map in %s\n", layoutPath.c_str());
+            continue;
+        }
+
+        auto region = std::make_unique<WorldRegion>();
+        region->gridX = entry.value("x", 0);
+        region->gridY = entry.value("y", 0);
+        if (region->gridX < 0 || region->gridY < 0)
+        {
+            printf("WorldStreamer Warning: Skipping region at negative grid cell (%d, %d)\n", region->gridX, region->gridY);
+            continue;
+        }
+        region->mapPath = directoryPath + "/" + entry["map"].get<std::string>();
+        if (entry.contains("entities") && entry["entities"].is_string())
+        {
+            region->entitiesPath = directoryPath + "/" + entry["entities"].get<std::string>();
+        }
+
+        region->worldX = (originX + region->gridX * regionWidth) * static_cast<float>(tileWidth);
+        region->worldY = (originY + region->gridY * regionHeight) * static_cast<float>(tileHeight);
+        CF_V2 min = cf_v2(gridOriginX + region->gridX * regionPixelWidth, gridOriginY + region->gridY * regionPixelHeight);
+        region->bounds = cf_make_aabb(min, cf_v2(min.x + regionPixelWidth, min.y + regionPixelHeight));
+
+        gridWidth = std::max(gridWidth, region->gridX + 1);
+        gridHeight = std::max(gridHeight, region->gridY + 1);
+        regions.push_back(std::move(region));
+    }
+
+    regionGrid.assign(static_cast<size_t>(gridWidth) * gridHeight, -1);
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        int &cell = regionGrid[regions[i]->gridY * gridWidth + regions[i]->gridX];
+        if (cell >= 0)
+        {
+            printf("WorldStreamer Warning: Duplicate region at grid cell (%d, %d), using the first\n",
+                   regions[i]->gridX, regions[i]->gridY);
+            regions[i]->failed = true;
+            continue;
+        }
+        cell = static_cast<int>(i);
+    }
+
+    printf("WorldStreamer: Loaded world layout with %zu regions (%dx%d tiles each), load radius %.0f, hysteresis %.0f, budget %.1f MB\n",
+           regions.size(), regionWidth, regionHeight, config.loadRadius, config.hysteresis,
+           config.memoryBudget / (1024.0 * 1024.0));
+    return !regions.empty();
+}
+
+void WorldStreamer::setConfig(const WorldStreamingConfig &config)
+{
+    this->config = config;
+}
+
+void WorldStreamer::setBaseNavMesh(NavMesh *navmesh)
+{
+    baseNavMesh = navmesh;
+}
+
+WorldRegion *WorldStreamer::getRegionAt(int gridX, int gridY) const
+{
+    if (gridX < 0 || gridY < 0 || gridX >= gridWidth || gridY >= gridHeight)
+    {
+        return nullptr;
+    }
+
+    int index = regionGrid[gridY * gridWidth + gridX];
+    return index >= 0 ? regions[index].get() : nullptr;
+}
+
+float WorldStreamer::distanceToRegion(const WorldRegion &region, const std::vector<CF_V2> &focusPoints)
+{
+    float nearest = INFINITY;
+    for (CF_V2 point : focusPoints)
+    {
+        float dx = std::max({region.bounds.min.x - point.x, 0.0f, point.x - region.bounds.max.x});
+        float dy = std::max({region.bounds.min.y - point.y, 0.0f, point.y - region.bounds.max.y});
+        nearest = std::min(nearest, std::sqrt(dx * dx + dy * dy));
+    }
+    return nearest;
+}
+
+void WorldStreamer::update(const std::vector<CF_V2> &focusPoints, std::vector<WorldRegion *> &loaded, std::vector<WorldRegion *> &unloading)
+{
+    // Take over finished loads
+    for (auto &region : regions)
+    {
+        if (region->state == WorldRegionState::Loading && region->pending->done.load())
+        {
+            if (finishLoad(*region))
+            {
+                loaded.push_back(region.get());
+            }
+        }
+    }
+
+    std::vector<float> distances(regions.size());
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        distances[i] = distanceToRegion(*regions[i], focusPoints);
+    }
+
+    // Unload regions that left the hysteresis band
+    float unloadRadius = config.loadRadius + config.hysteresis;
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        if (regions[i]->state == WorldRegionState::Loaded && distances[i] > unloadRadius)
+        {
+            beginUnload(*regions[i]);
+            unloading.push_back(regions[i].get());
+        }
+    }
+
+    // Over budget: evict the farthest regions that are only kept by hysteresis
+    // Unloading regions are still resident until released but already on their way out
+    size_t retained = getResidentMemory();
+    for (const auto &region : regions)
+    {
+        if (region->state == WorldRegionState::Unloading)
+        {
+            retained -= region->memoryEstimate;
+        }
+    }
+    while (config.memoryBudget > 0 && retained > config.memoryBudget)
+    {
+        int farthest = -1;
+        for (size_t i = 0; i < regions.size(); i++)
+        {
+            if (regions[i]->state == WorldRegionState::Loaded && distances[i] > config.loadRadius &&
+                (farthest < 0 || distances[i] > distances[farthest]))
+            {
+                farthest = static_cast<int>(i);
+            }
+        }
+        if (farthest < 0)
+        {
+            break;
+        }
+
+        printf("WorldStreamer: Over memory budget, evicting region (%d, %d)\n", regions[farthest]->gridX, regions[farthest]->gridY);
+        beginUnload(*regions[farthest]);
+        unloading.push_back(regions[farthest].get());
+        retained -= regions[farthest]->memoryEstimate;
+    }
+
+    // Start loads nearest first, as long as they fit the budget
+    int running = static_cast<int>(getRegionCount(WorldRegionState::Loading));
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        if (regions[i]->state == WorldRegionState::Unloaded && !regions[i]->failed && distances[i] <= config.loadRadius)
+        {
+            candidates.push_back(i);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [&distances](size_t a, size_t b)
+              { return distances[a] < distances[b]; });
+
+    // Regions that were never loaded are assumed to cost as much as the average loaded one
+    size_t knownTotal = 0;
+    size_t knownCount = 0;
+    for (const auto &region : regions)
+    {
+        if (region->memoryEstimate > 0)
+        {
+            knownTotal += region->memoryEstimate;
+            knownCount++;
+        }
+    }
+    size_t averageEstimate = knownCount > 0 ? knownTotal / knownCount : 0;
+
+    size_t resident = getResidentMemory();
+    for (size_t index : candidates)
+    {
+        if (running >= config.maxConcurrentLoads)
+        {
+            break;
+        }
+
+        WorldRegion &region = *regions[index];
+        size_t estimate = region.memoryEstimate > 0 ? region.memoryEstimate : averageEstimate;
+        if (config.memoryBudget > 0 && resident + estimate > config.memoryBudget)
+        {
+            // Nearer regions come first, so nothing after this one should displace what is resident
+            break;
+        }
+
+        startLoad(region);
+        resident += estimate;
+        running++;
+    }
+}
+
+void WorldStreamer::startLoad(WorldRegion &region)
+{
+    printf("WorldStreamer: Loading region (%d, %d) from %s\n", region.gridX, region.gridY, region.mapPath.c_str());
+
+    region.state = WorldRegionState::Loading;
+    region.pending = std::make_shared<WorldRegion::PendingLoad>();
+
+    auto result = region.pending;
+    std::string mapPath = region.mapPath;
+    std::string entitiesPath = region.entitiesPath;
+    float worldX = region.worldX;
+    float worldY = region.worldY;
+    auto job = [result, mapPath, entitiesPath, worldX, worldY]()
+    {
+        loadRegion(mapPath, entitiesPath, worldX, worldY, *result);
+        result->done.store(true);
+    };
+
+    if (!JobSystem::isInitialized())
+    {
+        // No workers (e.g. tests) - load inline, update() takes it over next call
+        job();
+        return;
+    }
+
+    JobSystem::submitJob(job, "Load World Region", "general");
+    JobSystem::kick();
+}
+
+void WorldStreamer::loadRegion(const std::string &mapPath, const std::string &entitiesPath, float worldX, float worldY,
+                               WorldRegion::PendingLoad &result)
+{
+    try
+    {
+        result.map = std::make_unique<LevelMap>(mapPath);
+    }
+    catch (const std::exception &e)
+    {
+        printf("WorldStreamer Error: Could not load region map %s: %s\n", mapPath.c_str(), e.what());
+        return;
+    }
+
+    result.map->decodeTilesetImages();
+
+    result.navmesh = std::make_unique<NavMesh>();
+    result.map->buildNavMesh(*result.navmesh, worldX, worldY);
+
+    if (!entitiesPath.empty())
+    {
+        try
+        {
+            result.spawns = flattenEntitySpawns(DataFile(entitiesPath));
+        }
+        catch (const std::exception &e)
+        {
+            printf("WorldStreamer Warning: Could not load region entities %s: %s\n", entitiesPath.c_str(), e.what());
+        }
+    }
+
+    // Decode each entity type's sheets here so spawning on the main thread only slices frames
+    std::set<std::string> entityPaths;
+    for (const LevelEntitySpawn &spawn : result.spawns)
+    {
+        entityPaths.insert(spawn.path);
+    }
+    for (const std::string &path : entityPaths)
+    {
+        AnimatedDataCharacter::prefetchAssets(path);
+    }
+
+    result.memoryEstimate = estimateMemory(*result.map, *result.navmesh);
+    result.succeeded = true;
+}
+
+bool WorldStreamer::finishLoad(WorldRegion &region)
+{
+    std::shared_ptr<WorldRegion::PendingLoad> result = std::move(region.pending);
+    if (!result->succeeded)
+    {
+        printf("WorldStreamer Warning: Region (%d, %d) failed to load and will not be retried\n", region.gridX, region.gridY);
+        region.state = WorldRegionState::Unloaded;
+        region.failed = true;
+        return false;
+    }
+
+    if (result->map->getTileWidth() != tileWidth || result->map->getTileHeight() != tileHeight)
+    {
+        printf("WorldStreamer Warning: Region map %s uses %dx%d tiles, the world uses %dx%d\n", region.mapPath.c_str(),
+               result->map->getTileWidth(), result->map->getTileHeight(), tileWidth, tileHeight);
+    }
+
+    region.map = std::move(result->map);
+    region.navmesh = std::move(result->navmesh);
+    region.spawns = std::move(result->spawns);
+    region.memoryEstimate = result->memoryEstimate;
+
+    // GPU uploads, main thread only
+    region.map->createTileSprites();
+    region.map->buildStructureSlices(region.worldX, region.worldY);
+
+    // Stitch the navmesh to resident neighbours so movement can cross the seams
+    int portals = 0;
+    static const int NEIGHBOR_OFFSETS[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    for (const auto &offset : NEIGHBOR_OFFSETS)
+    {
+        WorldRegion *neighbor = getRegionAt(region.gridX + offset[0], region.gridY + offset[1]);
+        if (neighbor && neighbor->state == WorldRegionState::Loaded && neighbor->navmesh)
+        {
+            portals += region.navmesh->stitchPortals(*neighbor->navmesh);
+        }
+    }
+    if (baseNavMesh)
+    {
+        portals += region.navmesh->stitchPortals(*baseNavMesh);
+    }
+
+    region.state = WorldRegionState::Loaded;
+    printf("WorldStreamer: Region (%d, %d) loaded: %d polygons, %d portal edges, %zu spawns, ~%.1f MB (resident ~%.1f MB)\n",
+           region.gridX, region.gridY, region.navmesh->getPolygonCount(), portals, region.spawns.size(),
+           region.memoryEstimate / (1024.0 * 1024.0), getResidentMemory() / (1024.0 * 1024.0));
+    return true;
+}
+
+void WorldStreamer::beginUnload(WorldRegion &region)
+{
+    printf("WorldStreamer: Unloading region (%d, %d)\n", region.gridX, region.gridY);
+
+    for (auto &other : regions)
+    {
+        if (other.get() != &region && other->navmesh)
+        {
+            other->navmesh->removePortalsTo(region.navmesh.get());
+        }
+    }
+    if (baseNavMesh)
+    {
+        baseNavMesh->removePortalsTo(region.navmesh.get());
+    }
+
+    region.state = WorldRegionState::Unloading;
+}
+
+void WorldStreamer::releaseRegion(WorldRegion &region)
+{
+    if (region.state != WorldRegionState::Unloading)
+    {
+        return;
+    }
+
+    region.map.reset();
+    region.navmesh.reset();
+    region.spawns.clear();
+    region.state = WorldRegionState::Unloaded;
+    printf("WorldStreamer: Released region (%d, %d), resident ~%.1f MB\n", region.gridX, region.gridY,
+           getResidentMemory() / (1024.0 * 1024.0));
+}
+
+NavMesh *WorldStreamer::getNavMeshAt(CF_V2 point) const
+{
+    if (regionWidth <= 0 || regionHeight <= 0)
+    {
+        return nullptr;
+    }
+
+    int gridX = static_cast<int>(std::floor((point.x - gridOriginX) / (regionWidth * tileWidth)));
+    int gridY = static_cast<int>(std::floor((point.y - gridOriginY) / (regionHeight * tileHeight)));
+
+    WorldRegion *region = getRegionAt(gridX, gridY);
+    if (region && region->state == WorldRegionState::Loaded && region->navmesh->isWalkable(point))
+    {
+        return region->navmesh.get();
+    }
+    return nullptr;
+}
+
+void WorldStreamer::renderLayers(const CFNativeCamera &camera, const DataFile &config, float worldX, float worldY) const
+{
+    CF_Aabb viewBounds = camera.getViewBounds();
+    for (const auto &region : regions)
+    {
+        if (region->state == WorldRegionState::Loaded && cf_overlaps(viewBounds, region->bounds))
+        {
+            region->map->renderAllLayers(camera, config, worldX + region->worldX, worldY + region->worldY);
+        }
+    }
+}
+
+size_t WorldStreamer::estimateMemory(const LevelMap &map, const NavMesh &navmesh)
+{
+    size_t bytes = 0;
+
+    // Tile data of every layer kind
+    for (int i = 0; i < map.getLayerCount(); i++)
+    {
+        bytes += map.getLayer(i)->data.size() * sizeof(int);
+    }
+    for (int i = 0; i < map.getNavMeshLayerCount(); i++)
+    {
+        bytes += map.getNavMeshLayer(i)->data.size() * sizeof(int);
+    }
+    for (int i = 0; i < map.getStructureCount(); i++)
+    {
+        auto structure = map.getStructure(i);
+        bytes += structure->data.size() * sizeof(int) * 2; // Plus the rendering copy of the TMX layer
+    }
+
+    // Decoded tileset pixels, counted twice for the textures created from them
+    for (int i = 0; i < map.getTilesetCount(); i++)
+    {
+        auto tileset = map.getTileset(i);
+        bytes += static_cast<size_t>(tileset->baked_image_width) * tileset->baked_image_height * 4 * 2;
+    }
+
+    // Navmesh polygons (4 vertices and up to 4 neighbours each) and edges
+    bytes += static_cast<size_t>(navmesh.getPolygonCount()) * (sizeof(NavPoly) + 4 * sizeof(CF_V2) + 4 * sizeof(int));
+    bytes += static_cast<size_t>(navmesh.getEdgeCount()) * sizeof(NavEdge);
+
+    return bytes;
+}
+
+size_t WorldStreamer::getResidentMemory() const
+{
+    size_t bytes = 0;
+    for (const auto &region : regions)
+    {
+        if (region->state != WorldRegionState::Unloaded)
+        {
+            bytes += region->memoryEstimate;
+        }
+    }
+    return bytes;
+}
+
+size_t WorldStreamer::getRegionCount(WorldRegionState state) const
+{
+    return static_cast<size_t>(std::count_if(regions.begin(), regions.end(), [state](const std::unique_ptr<WorldRegion> &region)
+                                             { return region->state == state; }));
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <cute.h>
+#include "LevelMap.h"
+#include "NavMesh.h"
+#include "LevelPackage.h"
+
+// Forward declarations
+class CFNativeCamera;
+class DataFile;
+
+// File name of the world layout inside a level directory
+#define WORLD_LAYOUT_FILENAME "world.json"
+
+/**
+ * WorldStreamingConfig - Distances and limits for region streaming
+ */
+struct WorldStreamingConfig
+{
+    float loadRadius;         // Regions closer than this (pixels) to the camera or player are loaded
+    float hysteresis;         // Extra distance past loadRadius before a loaded region is unloaded
+    size_t memoryBudget;      // Hard cap on the estimated bytes of resident regions (0 = unlimited)
+    int maxConcurrentLoads;   // Region loads running on the JobSystem at once
+
+    WorldStreamingConfig() : loadRadius(1024.0f), hysteresis(512.0f), memoryBudget(256 * 1024 * 1024), maxConcurrentLoads(2) {}
+};
+
+/**
+ * Streaming state of a world region
+ */
+enum class WorldRegionState
+{
+    Unloaded,  // Nothing resident
+    Loading,   // Background job is parsing the map, decoding tilesets and building the navmesh
+    Loaded,    // Resident, rendered and its agents spawned
+    Unloading  // Agents are being removed, map and navmesh are released once none are left
+};
+
+/**
+ * WorldRegion - One streamed chunk of a world
+ *
+ * Each region is its own TMX map (regular, structure, navmesh and cut layers) placed on a
+ * grid of equally sized regions, with an optional entities file for the agents spawned
+ * while it is loaded (positions in region local tiles).
+ */
+struct WorldRegion
+{
+    int gridX;                // Region column (0 = leftmost)
+    int gridY;                // Region row (0 = bottom, rendering coordinates)
+    std::string mapPath;      // TMX map of the region
+    std::string entitiesPath; // entities.json style spawn list (may be empty)
+    float worldX;             // World position of the region's bottom-left tile center
+    float worldY;
+    CF_Aabb bounds;           // World bounds covered by the region
+
+    WorldRegionState state;
+    bool failed;           // Last load failed, the region is not retried
+    size_t memoryEstimate; // Estimated resident bytes (0 until loaded once)
+
+    // Resident data (set while Loaded or Unloading)
+    std::unique_ptr<LevelMap> map;
+    std::unique_ptr<NavMesh> navmesh;
+    std::vector<LevelEntitySpawn> spawns;
+
+    // Result of the in-flight background load (shared with the job)
+    struct PendingLoad
+    {
+        std::unique_ptr<LevelMap> map;
+        std::unique_ptr<NavMesh> navmesh;
+        std::vector<LevelEntitySpawn> spawns;
+        size_t memoryEstimate = 0;
+        bool succeeded = false;
+        std::atomic<bool> done{false};
+    };
+    std::shared_ptr<PendingLoad> pending;
+
+    WorldRegion() : gridX(0), gridY(0), worldX(0.0f), worldY(0.0f), bounds(cf_make_aabb(cf_v2(0, 0), cf_v2(0, 0))),
+                    state(WorldRegionState::Unloaded), failed(false), memoryEstimate(0) {}
+};
+
+/**
+ * WorldStreamer - Streams the regions of a chunked world in and out around focus points
+ *
+ * The world layout (world.json) lists the regions and the streaming settings:
+ * {
+ *   "region_width": 64, "region_height": 64,     // Region size in tiles
+ *   "origin_x": 0, "origin_y": 0,                // Tile offset of region (0, 0)
+ *   "load_radius": 1024, "hysteresis": 512,      // Pixels
+ *   "memory_budget_mb": 256, "max_concurrent_loads": 2,
+ *   "regions": [{"x": 0, "y": 0, "map": "region_0_0.tmx", "entities": "region_0_0_entities.json"}]
+ * }
+ * Paths are relative to the level directory.
+ *
+ * Regions are loaded on the JobSystem (map parsing, tileset decoding, navmesh building and
+ * entity asset decoding); tile sprites are created and neighbouring navmeshes are stitched
+ * through portal edges on the main thread in update(). Regions beyond loadRadius + hysteresis
+ * are unloaded, and when the resident estimate exceeds the memory budget the farthest regions
+ * outside loadRadius are evicted before any new load starts.
+ *
+ * The streamer only owns region data; LevelV1 spawns and removes the regions' agents.
+ */
+class WorldStreamer
+{
+private:
+    std::string levelDirectory;
+    WorldStreamingConfig config;
+
+    int regionWidth;  // Tiles
+    int regionHeight; // Tiles
+    int tileWidth;
+    int tileHeight;
+    float gridOriginX; // World position of the bottom-left corner of grid cell (0, 0)
+    float gridOriginY;
+
+    // Regions by index, regionGrid maps grid cells to indices (-1 = no region)
+    std::vector<std::unique_ptr<WorldRegion>> regions;
+    std::vector<int> regionGrid;
+    int gridWidth;
+    int gridHeight;
+
+    // Navmesh of the always resident base map (stitched to touching regions, non-owning)
+    NavMesh *baseNavMesh;
+
+    /**
+     * Get the region at a grid cell
+     * @return Region, or nullptr if the cell is empty or out of range
+     */
+    WorldRegion *getRegionAt(int gridX, int gridY) const;
+
+    /**
+     * Distance from the nearest focus point to a region's bounds (0 inside)
+     */
+    static float distanceToRegion(const WorldRegion &region, const std::vector<CF_V2> &focusPoints);
+
+    /**
+     * Start loading a region on the JobSystem (or inline without workers)
+     */
+    void startLoad(WorldRegion &region);
+
+    /**
+     * Load job body: parse the map, decode tilesets, build the navmesh and read the spawn list
+     */
+    static void loadRegion(const std::string &mapPath, const std::string &entitiesPath, float worldX, float worldY,
+                           WorldRegion::PendingLoad &result);
+
+    /**
+     * Take over a finished load on the main thread (tile sprites, structure slices, portals)
+     * @return true if the region is now Loaded
+     */
+    bool finishLoad(WorldRegion &region);
+
+    /**
+     * Start unloading a region: drop its portals, LevelV1 then removes its agents
+     */
+    void beginUnload(WorldRegion &region);
+
+    /**
+     * Estimate the bytes a loaded region keeps resident (tile data, tileset pixels, navmesh)
+     */
+    static size_t estimateMemory(const LevelMap &map, const NavMesh &navmesh);
+
+public:
+    WorldStreamer();
+
+    /**
+     * Destructor - waits for region loads still running on the JobSystem
+     */
+    ~WorldStreamer();
+
+    WorldStreamer(const WorldStreamer &) = delete;
+    WorldStreamer &operator=(const WorldStreamer &) = delete;
+
+    /**
+     * Read a world layout
+     * @param directoryPath Level directory holding world.json and the region maps
+     * @param defaultTileWidth Tile width used when the layout does not specify one
+     * @param defaultTileHeight Tile height used when the layout does not specify one
+     * @return true if the layout has at least one region
+     */
+    bool load(const std::string &directoryPath, int defaultTileWidth, int defaultTileHeight);
+
+    /**
+     * Set the streaming distances and memory budget
+     * @param config Streaming configuration
+     */
+    void setConfig(const WorldStreamingConfig &config);
+
+    /**
+     * Get the streaming configuration
+     * @return Reference to the current configuration
+     */
+    const WorldStreamingConfig &getConfig() const { return config; }
+
+    /**
+     * Set the navmesh of the always resident base map, regions touching it are stitched to it
+     * @param navmesh Base navmesh (non-owning, may be nullptr)
+     */
+    void setBaseNavMesh(NavMesh *navmesh);
+
+    /**
+     * Advance streaming: take over finished loads, unload far regions, enforce the memory
+     * budget and start new loads nearest first. Call once per frame on the main thread.
+     * @param focusPoints World positions to stream around (camera, player)
+     * @param loaded Receives regions that became Loaded (their agents need spawning)
+     * @param unloading Receives regions that started Unloading (their agents need removing)
+     */
+    void update(const std::vector<CF_V2> &focusPoints, std::vector<WorldRegion *> &loaded, std::vector<WorldRegion *> &unloading);
+
+    /**
+     * Release an Unloading region's map and navmesh once nothing references the navmesh anymore
+     * @param region Region to release
+     */
+    void releaseRegion(WorldRegion &region);
+
+    /**
+     * Find the navmesh of a loaded region that has walkable area at a world point
+     * @param point World position
+     * @return Navmesh, or nullptr if no loaded region is walkable there
+     */
+    NavMesh *getNavMeshAt(CF_V2 point) const;
+
+    /**
+     * Render the tile layers of every loaded region (structures are depth sorted by LevelV1)
+     * @param camera Camera to use for rendering
+     * @param config Configuration data file for layer highlighting
+     * @param worldX World X offset
+     * @param worldY World Y offset
+     */
+    void renderLayers(const CFNativeCamera &camera, const DataFile &config, float worldX = 0.0f, float worldY = 0.0f) const;
+
+    /**
+     * Get all regions
+     */
+    const std::vector<std::unique_ptr<WorldRegion>> &getRegions() const { return regions; }
+
+    /**
+     * Get the estimated bytes of all resident and loading regions
+     */
+    size_t getResidentMemory() const;
+
+    /**
+     * Get the number of regions in a state
+     */
+    size_t getRegionCount(WorldRegionState state) const;
+};
@@ -20,12 +20,14 @@
 #include "RealConfigFile.h"
 #include "LevelV1.h"
 #include "JobSystem.h"
+#include "AssetHotReloader.h"
 
 #include "CFNativeCamera.h"
 #include "NavMesh.h"
 #include "NavMeshPath.h"
 #include "AnimatedDataCharacterNavMeshPlayer.h"
 #include "ShaderRegistry.h"
+#include "EffectSystem.h"
 #include "HighlightTile.h"
 #include "AtlasLabelerWindow.h"
 #include "HudUI.h"
@@ -70,10 +72,17 @@ int main(int argc, char *argv[])
 	// Set up VFS for reading and writing (must be done after make_app)
 	mount_content_directory_as("/assets");
 
+	// Load JSON through MessagePack sidecars and keep parsed documents for repeated loads
+	// Sidecars go to the per-user directory, not into the asset tree
+	DataFile::setBinaryCacheDirectory(cf_fs_get_user_directory("yangep", "yangep"));
+	DataFile::setBinaryCacheEnabled(true);
+	DataFile::setDocumentCacheEnabled(true);
+
 	// Set shader directory for runtime-compiled draw shaders
 	cf_shader_directory("/assets/shaders");
 	// Register and compile shaders at boot
 	ShaderRegistry::registerAndLoadAll();
+	EffectSystem::initialize();
 
 	// Load window configuration again using VFS for viewport and debug windows
 	DataFile windowConfig("/assets/window-config.json");
@@ -389,6 +398,20 @@ int main(int argc, char *argv[])
 	// Set player reference in level for action hitbox checking
 	level.setPlayer(&playerCharacter);
 
+	// Simulation LOD tiers for off-screen agents
+	if (windowConfig.contains("SimulationLOD"))
+	{
+		auto &lodConfig = windowConfig["SimulationLOD"];
+		SimulationLODConfig simulationLOD;
+		simulationLOD.enabled = lodConfig.value("enabled", simulationLOD.enabled);
+		simulationLOD.nearDistance = lodConfig.value("nearDistance", simulationLOD.nearDistance);
+		simulationLOD.nearTickInterval = lodConfig.value("nearTickInterval", simulationLOD.nearTickInterval);
+		simulationLOD.farTickInterval = lodConfig.value("farTickInterval", simulationLOD.farTickInterval);
+		level.setSimulationLODConfig(simulationLOD);
+		printf("SimulationLOD: %s, near=%.0f, nearTick=%d, farTick=%d\n", simulationLOD.enabled ? "enabled" : "disabled",
+			   simulationLOD.nearDistance, simulationLOD.nearTickInterval, simulationLOD.farTickInterval);
+	}
+
 	// Connect player to navmesh for walkable area detection
 	playerCharacter.setNavMesh(&level.getNavMesh());
 
@@ -445,6 +468,15 @@ int main(int argc, char *argv[])
 
 	// Initialize and start on-screen checks worker
 	OnScreenChecks::initialize(&playerPosition, &cfCamera, &level, &playerCharacter);
+
+	// Size of the coordination grid around the player (N x N tiles, odd)
+	if (windowConfig.contains("Coordinator") && windowConfig["Coordinator"].contains("nearPlayerGridSize"))
+	{
+		int nearPlayerGridSize = windowConfig["Coordinator"]["nearPlayerGridSize"];
+		OnScreenChecks::getCoordinator()->setNearPlayerTileGridSize(nearPlayerGridSize);
+		printf("Coordinator nearPlayerGridSize: %d\n", nearPlayerGridSize);
+	}
+
 	OnScreenChecks::start();
 
 	// Create coordinator debug window if enabled (now that OnScreenChecks is initialized)
@@ -472,6 +504,11 @@ int main(int argc, char *argv[])
 	printf("  P - place/update navmesh point at player position\n");
 	printf("  L - pathfind to navmesh point from player\n");
 	printf("  ESC - quit\n");
+
+	// Reload edited data files, sheets and tilesets while running (file watching is Linux only)
+	AssetHotReloader assetReloader;
+	assetReloader.start(get_content_directory_path(), "/assets");
+
 	while (cf_app_is_running())
 	{
 		// Begin profiling the frame
@@ -479,6 +516,7 @@ int main(int argc, char *argv[])
 		{
 			fpsWindow->beginFrame();
 		}
+		ShaderRegistry::beginFrame();
 
 		// Update app to handle window events and input (proper CF pattern)
 		cf_app_update(NULL);
@@ -562,7 +600,7 @@ int main(int argc, char *argv[])
 							bool alreadyTracking = false;
 							for (const auto &window : characterInfoWindows)
 							{
-								if (window->isTracking(entity))
+								if (window->isTracking(entity->getHandle()))
 								{
 									alreadyTracking = true;
 									break;
@@ -573,7 +611,7 @@ int main(int argc, char *argv[])
 							if (!alreadyTracking)
 							{
 								std::string windowTitle = "Character Info: " + entity->getDataFilePath();
-								auto newWindow = std::make_unique<DebugCharacterInfoWindow>(windowTitle, entity, level);
+								auto newWindow = std::make_unique<DebugCharacterInfoWindow>(windowTitle, entity->getHandle(), level);
 								characterInfoWindows.push_back(std::move(newWindow));
 								printf("      Created debug window for entity\n");
 							}
@@ -856,24 +894,24 @@ int main(int argc, char *argv[])
 		// Trigger red flash effect on the player with 'F'
 		if (cf_key_just_pressed(CF_KEY_F))
 		{
-			playerCharacter.triggerEffect("red", 3, 2.0f, 0.85f);
+			playerCharacter.triggerEffect(EffectId::Red, 3, 2.0f, 0.85f);
 		}
 		// Trigger green flash effect on the player with 'G' (replace any current effect)
 		if (cf_key_just_pressed(CF_KEY_G))
 		{
-			playerCharacter.triggerEffect("green", 3, 2.0f, 0.85f);
+			playerCharacter.triggerEffect(EffectId::Green, 3, 2.0f, 0.85f);
 		}
 		// Trigger dissolve effect on the player with 'X'
 		if (cf_key_just_pressed(CF_KEY_X))
 		{
 			// flashes unused, duration ~1.0s, edgeWidth ~0.06
-			playerCharacter.triggerEffect("dissolve", 1, 1.0f, 0.06f);
+			playerCharacter.triggerEffect(EffectId::Dissolve, 1, 1.0f, 0.06f);
 		}
 		// Toggle trail ghost effect on the player with 'H'
 		if (cf_key_just_pressed(CF_KEY_H))
 		{
 			// Parameters: ghosts, duration, base alpha
-			playerCharacter.triggerEffect("trail", 8, 1.5f, 0.8f);
+			playerCharacter.triggerEffect(EffectId::Trail, 8, 1.5f, 0.8f);
 		}
 		// Toggle sample inventory window
 		if (cf_key_just_pressed(CF_KEY_I))
@@ -885,6 +923,12 @@ int main(int argc, char *argv[])
 		{
 			fpsWindow->markSection("Player Input");
 		}
+		// Swap in assets reloaded since the last frame before agents use them
+		assetReloader.update(level, {&playerCharacter});
+
+		// Stream world regions around the camera and player (no-op without world.json)
+		level.updateWorldStreaming(cfCamera.getPosition(), playerPosition);
+		level.updateAgentVisibility(cfCamera);
 		level.updateAgents(dt);
 
 		if (fpsWindow)
@@ -892,6 +936,18 @@ int main(int argc, char *argv[])
 			fpsWindow->markSection("Agent Update");
 		}
 
+		// Hand the player over to a streamed region's navmesh when stepping through a portal
+		if (level.hasWorldStreaming())
+		{
+			CF_Aabb feetBox = playerCharacter.getNavMeshCollisionBox();
+			v2 feetTarget = cf_v2((feetBox.min.x + feetBox.max.x) / 2.0f + moveVector.x * dt, feetBox.max.y + moveVector.y * dt);
+			NavMesh *targetNavMesh = level.getNavMeshAt(feetTarget);
+			if (targetNavMesh && targetNavMesh != playerCharacter.getNavMesh() && targetNavMesh->isWalkable(feetTarget))
+			{
+				playerCharacter.setNavMesh(targetNavMesh);
+			}
+		}
+
 		// Update playerCharacter animation with move vector
 		playerCharacter.update(dt, moveVector);
 
@@ -901,6 +957,14 @@ int main(int argc, char *argv[])
 		{
 			fpsWindow->markSection("Player Update");
 		}
+
+		// Advance all pooled visual effects and deliver their completion events
+		EffectSystem::update(dt);
+		if (fpsWindow)
+		{
+			fpsWindow->markSection("Effect Update");
+		}
+
 		// Update camera (handles following and smooth movement)
 		cfCamera.update(dt);
 
@@ -1141,6 +1205,9 @@ int main(int argc, char *argv[])
 	// Cleanup on-screen checks
 	OnScreenChecks::shutdown();
 
+	// Drop pooled effects
+	EffectSystem::shutdown();
+
 	// Close input log file if it was opened
 	if (inputLogFile.is_open())
 	{
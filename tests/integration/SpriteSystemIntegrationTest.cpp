@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <cute.h>
 #include "SpriteAnimationLoader.h"
+#include <chrono>
 
 using namespace Cute;
 
@@ -132,3 +133,44 @@ TEST_F(SpriteSystemIntegrationTest, SpriteCleanupDoesNotCorruptMemory)
     // If we get here without crashes, memory management is working
     EXPECT_TRUE(true);
 }
+
+// Benchmark: slicing a whole sheet from one decode vs decoding it once per frame
+TEST_F(SpriteSystemIntegrationTest, SheetDecodeBenchmark)
+{
+    const std::string png_path = "assets/Art/AnimationsSheets/walkcycle/BODY_skeleton.png";
+    const AnimationLayout &layout = AnimationLayouts::WALKCYCLE_4_DIRECTIONS_9_FRAMES;
+    using Clock = std::chrono::high_resolution_clock;
+
+    // One decode for the whole sheet
+    auto start = Clock::now();
+    std::vector<CF_Sprite> frames = loader.loadAnimationFrames(png_path, layout);
+    double sheet_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    if (frames.empty() || frames[0].w == 0)
+    {
+        GTEST_SKIP() << "Walkcycle sheet not available in this environment";
+    }
+
+    EXPECT_EQ(frames.size(), layout.directions.size() * layout.frames_per_row);
+    EXPECT_EQ(loader.getDecodeCount(), 1u);
+
+    // Per-frame decoding, the way frames used to be extracted
+    SpriteAnimationLoader perFrameLoader;
+    start = Clock::now();
+    for (int dir = 0; dir < static_cast<int>(layout.directions.size()); dir++)
+    {
+        for (int frame = 0; frame < layout.frames_per_row; frame++)
+        {
+            perFrameLoader.extractSpriteFrame(png_path, frame * layout.frame_width, dir * layout.frame_height,
+                                              layout.frame_width, layout.frame_height);
+        }
+    }
+    double per_frame_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    EXPECT_EQ(perFrameLoader.getDecodeCount(), frames.size());
+
+    RecordProperty("sheet_decode_ms", std::to_string(sheet_ms));
+    RecordProperty("per_frame_decode_ms", std::to_string(per_frame_ms));
+    printf("SheetDecodeBenchmark: %zu frames, one decode %.2fms, per-frame decodes %.2fms\n",
+           frames.size(), sheet_ms, per_frame_ms);
+}
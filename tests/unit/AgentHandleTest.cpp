@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "AgentHandle.h"
+
+TEST(AgentHandleTest, RemovedHandleStopsResolving)
+{
+    AgentHandleTable table;
+    AgentHandle first = table.create();
+    AgentHandle second = table.create();
+    AgentHandle third = table.create();
+
+    // Removing the first agent moves the last one into its place
+    table.remove(0);
+    EXPECT_FALSE(table.isValid(first));
+    EXPECT_EQ(table.getDenseIndex(first), SIZE_MAX);
+    EXPECT_EQ(table.getDenseIndex(second), 1u);
+    EXPECT_EQ(table.getDenseIndex(third), 0u);
+    EXPECT_EQ(table.getHandle(0), third);
+    EXPECT_EQ(table.size(), 2u);
+}
+
+TEST(AgentHandleTest, ReusedSlotGetsNewGeneration)
+{
+    AgentHandleTable table;
+    AgentHandle first = table.create();
+    table.remove(0);
+
+    AgentHandle reused = table.create();
+    EXPECT_EQ(reused.index, first.index);
+    EXPECT_NE(reused, first);
+    EXPECT_FALSE(table.isValid(first));
+    EXPECT_TRUE(table.isValid(reused));
+    EXPECT_EQ(table.getDenseIndexOfSlot(reused.index), 0u);
+}
+
+TEST(AgentHandleTest, ClearInvalidatesEveryHandle)
+{
+    AgentHandleTable table;
+    AgentHandle first = table.create();
+    AgentHandle second = table.create();
+    table.clear();
+
+    EXPECT_FALSE(table.isValid(first));
+    EXPECT_FALSE(table.isValid(second));
+    EXPECT_FALSE(table.isValid(AgentHandle()));
+    EXPECT_EQ(table.getDenseIndexOfSlot(first.index), SIZE_MAX);
+    EXPECT_EQ(table.size(), 0u);
+}
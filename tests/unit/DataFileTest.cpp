@@ -91,3 +91,30 @@ TEST_F(DataFileTest, LoadFromStoredpath)
     EXPECT_TRUE(df.load());
     EXPECT_TRUE(df.contains("test_key"));
 }
+
+TEST_F(DataFileTest, BinaryCacheRoundTrip)
+{
+    DataFile df("test_data.json");
+    std::vector<uint8_t> bytes = DataFile::encodeBinaryCache(df, 1234, 56);
+
+    nlohmann::json decoded;
+    EXPECT_TRUE(DataFile::decodeBinaryCache(bytes.data(), bytes.size(), 1234, 56, decoded));
+    EXPECT_EQ(decoded, static_cast<const nlohmann::json &>(df));
+}
+
+TEST_F(DataFileTest, BinaryCacheRejectsStaleSidecar)
+{
+    nlohmann::json document = {{"key", "value"}};
+    std::vector<uint8_t> bytes = DataFile::encodeBinaryCache(document, 1234, 56);
+
+    nlohmann::json decoded;
+    EXPECT_FALSE(DataFile::decodeBinaryCache(bytes.data(), bytes.size(), 1235, 56, decoded));
+    EXPECT_FALSE(DataFile::decodeBinaryCache(bytes.data(), bytes.size(), 1234, 57, decoded));
+    EXPECT_FALSE(DataFile::decodeBinaryCache(bytes.data(), bytes.size() / 2, 1234, 56, decoded));
+}
+
+TEST_F(DataFileTest, BinaryCachePath)
+{
+    EXPECT_EQ(DataFile::getBinaryCachePath("/assets/Levels/a/details.json"), "/cache/DataCache/Levels/a/details.json.ydfc");
+    EXPECT_EQ(DataFile::getBinaryCachePath("test_data.json"), "");
+}
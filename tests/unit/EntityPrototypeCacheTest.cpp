@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <cute.h>
+#include "EntityPrototypeCache.h"
+#include "AnimatedDataCharacter.h"
+#include "Action.h"
+#include "../fixtures/TestFixture.hpp"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace Cute;
+
+// assets/DataFiles/Entities/skeleton has one innate action (OneTile) with a hitbox
+class EntityPrototypeCacheTest : public TestFixture
+{
+protected:
+    const std::string skeletonPath = "/assets/DataFiles/Entities/skeleton";
+
+    void SetUp() override
+    {
+        TestFixture::SetUp();
+        mount_content_directory_as("/assets");
+        EntityPrototypeCache::clear();
+    }
+
+    void TearDown() override
+    {
+        EntityPrototypeCache::clear();
+        TestFixture::TearDown();
+    }
+};
+
+TEST_F(EntityPrototypeCacheTest, SecondGetIsCacheHit)
+{
+    std::shared_ptr<const EntityPrototype> first = EntityPrototypeCache::get(skeletonPath);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(EntityPrototypeCache::getMissCount(), 1u);
+    EXPECT_EQ(EntityPrototypeCache::getHitCount(), 0u);
+
+    std::shared_ptr<const EntityPrototype> second = EntityPrototypeCache::get(skeletonPath);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(EntityPrototypeCache::getMissCount(), 1u);
+    EXPECT_EQ(EntityPrototypeCache::getHitCount(), 1u);
+    EXPECT_EQ(EntityPrototypeCache::getPrototypeCount(), 1u);
+}
+
+TEST_F(EntityPrototypeCacheTest, ClonedActionsShareHitboxButNotRuntimeState)
+{
+    AnimatedDataCharacter first;
+    AnimatedDataCharacter second;
+    ASSERT_TRUE(first.init(skeletonPath));
+    ASSERT_TRUE(second.init(skeletonPath));
+    EXPECT_EQ(EntityPrototypeCache::getMissCount(), 1u);
+
+    Action *firstAction = first.getActionPointerA();
+    Action *secondAction = second.getActionPointerA();
+    ASSERT_NE(firstAction, nullptr);
+    ASSERT_NE(secondAction, nullptr);
+    ASSERT_NE(firstAction, secondAction);
+
+    // Geometry and hitbox data come from the prototype
+    ASSERT_NE(firstAction->getHitBox(), nullptr);
+    EXPECT_EQ(firstAction->getHitBox(), secondAction->getHitBox());
+    ASSERT_TRUE(firstAction->hasHitboxData());
+    EXPECT_EQ(&firstAction->getHitboxData(), &secondAction->getHitboxData());
+
+    // Timers, activity and owner stay per instance
+    firstAction->doAction();
+    firstAction->update(0.1f);
+    EXPECT_TRUE(firstAction->getIsActive());
+    EXPECT_GT(firstAction->getWarmupTimer(), 0.0f);
+    EXPECT_FALSE(secondAction->getIsActive());
+    EXPECT_EQ(secondAction->getWarmupTimer(), 0.0f);
+    EXPECT_EQ(firstAction->getCharacter(), &first);
+    EXPECT_EQ(secondAction->getCharacter(), &second);
+}
+
+// Benchmark: the first spawn builds the prototype, later spawns only create runtime state
+TEST_F(EntityPrototypeCacheTest, SpawnBenchmark)
+{
+    const size_t spawnCount = 32;
+    using Clock = std::chrono::high_resolution_clock;
+    std::vector<std::unique_ptr<AnimatedDataCharacter>> characters;
+
+    auto start = Clock::now();
+    characters.push_back(std::make_unique<AnimatedDataCharacter>());
+    ASSERT_TRUE(characters.back()->init(skeletonPath));
+    double cold_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (size_t i = 1; i < spawnCount; ++i)
+    {
+        characters.push_back(std::make_unique<AnimatedDataCharacter>());
+        ASSERT_TRUE(characters.back()->init(skeletonPath));
+    }
+    double cached_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    EXPECT_EQ(EntityPrototypeCache::getMissCount(), 1u);
+    EXPECT_EQ(EntityPrototypeCache::getHitCount(), spawnCount - 1);
+
+    double cached_per_spawn_ms = cached_ms / static_cast<double>(spawnCount - 1);
+    RecordProperty("cold_spawn_ms", std::to_string(cold_ms));
+    RecordProperty("cached_spawn_ms", std::to_string(cached_per_spawn_ms));
+    printf("SpawnBenchmark: first spawn %.2fms, %zu cached spawns %.2fms (%.3fms each)\n",
+           cold_ms, spawnCount - 1, cached_ms, cached_per_spawn_ms);
+}
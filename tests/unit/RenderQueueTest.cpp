@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "RenderQueue.h"
+
+TEST(RenderQueueTest, HigherWorldYDrawsFirst)
+{
+    RenderQueue queue;
+    queue.push(10.0f, 1, 0);
+    queue.push(-250.0f, 1, 1);
+    queue.push(512.5f, 0, 2);
+    queue.push(0.0f, 2, 3);
+    queue.sort();
+
+    const auto &entries = queue.getEntries();
+    ASSERT_EQ(entries.size(), 4u);
+    EXPECT_EQ(entries[0].index, 2u);
+    EXPECT_EQ(entries[1].index, 0u);
+    EXPECT_EQ(entries[2].index, 3u);
+    EXPECT_EQ(entries[3].index, 1u);
+}
+
+TEST(RenderQueueTest, EqualKeysKeepInsertionOrder)
+{
+    RenderQueue queue;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        queue.push(i % 2 == 0 ? 100.0f : 50.0f, 1, i);
+    }
+    queue.sort();
+
+    const auto &entries = queue.getEntries();
+    ASSERT_EQ(entries.size(), 8u);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(entries[i].index, i * 2);
+        EXPECT_EQ(entries[i + 4].index, i * 2 + 1);
+    }
+}
+
+TEST(RenderQueueTest, DepthKeyOrdersAcrossSignAndLargeValues)
+{
+    EXPECT_LT(RenderQueue::makeDepthKey(1.0e12f), RenderQueue::makeDepthKey(1000.0f));
+    EXPECT_LT(RenderQueue::makeDepthKey(1000.0f), RenderQueue::makeDepthKey(0.25f));
+    EXPECT_LT(RenderQueue::makeDepthKey(0.25f), RenderQueue::makeDepthKey(0.0f));
+    EXPECT_LT(RenderQueue::makeDepthKey(0.0f), RenderQueue::makeDepthKey(-0.25f));
+    EXPECT_LT(RenderQueue::makeDepthKey(-0.25f), RenderQueue::makeDepthKey(-1.0e12f));
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "SpriteAnimationLoader.h"
+#include "AnimationAssetCache.h"
 #include <cute.h>
 #include <cute_draw.h>
 #include <cute_math.h>
@@ -152,3 +153,64 @@ TEST_F(SpriteAnimationLoaderTest, AnimationFrameMethods)
     anim.calculateDuration();
     EXPECT_EQ(anim.totalDuration, 200.0f); // 100ms + 100ms
 }
+
+// Test that characters using the same sheets resolve to the same cached table
+TEST_F(SpriteAnimationLoaderTest, AnimationAssetCacheKey)
+{
+    std::vector<AnimationLayout> skeleton = {
+        AnimationLayout("idle", std::vector<std::string>{"BODY_skeleton.png"}, 64, 64, 1, 4,
+                        {Direction::UP, Direction::LEFT, Direction::DOWN, Direction::RIGHT})};
+    std::vector<AnimationLayout> sameSheets = skeleton;
+    std::vector<AnimationLayout> otherSheets = {
+        AnimationLayout("idle", std::vector<std::string>{"BODY_male.png"}, 64, 64, 1, 4,
+                        {Direction::UP, Direction::LEFT, Direction::DOWN, Direction::RIGHT})};
+
+    std::string base = "assets/Art/AnimationsSheets";
+    EXPECT_EQ(AnimationAssetCache::makeKey(base, skeleton), AnimationAssetCache::makeKey(base, sameSheets));
+    EXPECT_NE(AnimationAssetCache::makeKey(base, skeleton), AnimationAssetCache::makeKey(base, otherSheets));
+    EXPECT_EQ(AnimationAssetCache::find("assets/DataFiles/Characters/never_loaded"), nullptr);
+}
+
+// Test compiled [animation][direction][frame] lookup and batched playback
+TEST_F(SpriteAnimationLoaderTest, CompiledAnimationPlayback)
+{
+    Animation walk;
+    walk.name = "walkcycle";
+    for (Direction direction : {Direction::UP, Direction::DOWN})
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            AnimationFrame frame;
+            frame.frameIndex = i;
+            frame.direction = direction;
+            frame.delay = 100.0f;
+            walk.frames.push_back(frame);
+        }
+    }
+
+    AnimationTable table;
+    table.addAnimation("walkcycle", walk);
+    AnimationId walkId = table.getAnimationId("walkcycle");
+    ASSERT_NE(walkId, INVALID_ANIMATION_ID);
+    EXPECT_EQ(table.getAnimationId("missing"), INVALID_ANIMATION_ID);
+
+    const CompiledAnimation *compiled = table.getCompiled(walkId);
+    ASSERT_NE(compiled, nullptr);
+    EXPECT_EQ(compiled->framesPerDirection, 3);
+    EXPECT_EQ(compiled->getFrame(Direction::DOWN, 2), table.getAnimation("walkcycle")->getFrame(2, Direction::DOWN));
+    EXPECT_EQ(compiled->getFrame(Direction::LEFT, 0), nullptr);
+
+    // Copies must point at their own frames
+    AnimationTable copy = table;
+    EXPECT_EQ(copy.getCompiled(walkId)->getFrame(Direction::UP, 1), copy.getAnimation("walkcycle")->getFrame(1, Direction::UP));
+
+    // Advance two packed playback states together, frames wrap per direction
+    AnimationPlayback playbacks[2];
+    playbacks[0].play(walkId);
+    playbacks[1].play(walkId);
+    playbacks[1].direction = Direction::UP;
+    playbacks[1].frame = 2;
+    table.advance(playbacks, 2, 0.1f);
+    EXPECT_EQ(playbacks[0].frame, 1);
+    EXPECT_EQ(playbacks[1].frame, 0);
+}
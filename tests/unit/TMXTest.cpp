@@ -2,6 +2,8 @@
 #include <cute.h>
 #include "tmx.h"
 #include "tsx.h"
+#include "TileLayerData.h"
+#include "LevelPackage.h"
 #include "Utils.h"
 #include "../fixtures/TestFixture.hpp"
 
@@ -247,3 +249,82 @@ TEST_F(TMXTest, TSXStressTest)
 
     EXPECT_EQ(sprites.size(), stress_count) << "Should create all stress test sprites";
 }
+
+// Test the layer data decoders against the same four GIDs in each encoding
+TEST(TileLayerDataTest, DecodesAllEncodings)
+{
+    // GID 2147483649 carries Tiled's horizontal flip flag
+    const std::vector<int> expected = {1, 0, static_cast<int>(2147483649u), 7};
+    std::vector<int> tiles;
+
+    EXPECT_TRUE(TileLayerData::decode("\n1,0,\n2147483649,7\n", "csv", "", 4, tiles));
+    EXPECT_EQ(tiles, expected);
+
+    EXPECT_TRUE(TileLayerData::decode("\n   AQAAAAAAAAABAACABwAAAA==\n", "base64", "", 4, tiles));
+    EXPECT_EQ(tiles, expected);
+
+    EXPECT_TRUE(TileLayerData::decode("eJxjZIAARgaGBnYgDQACxACK", "base64", "zlib", 4, tiles));
+    EXPECT_EQ(tiles, expected);
+
+    EXPECT_TRUE(TileLayerData::decode("H4sIACaH1GoC/2NkgABGBoYGdiANAHFSSKIQAAAA", "base64", "gzip", 4, tiles));
+    EXPECT_EQ(tiles, expected);
+
+    EXPECT_FALSE(TileLayerData::decode("1,x,2", "csv", "", 3, tiles));
+    EXPECT_FALSE(TileLayerData::decode("AQ$A", "base64", "", 1, tiles));
+    EXPECT_FALSE(TileLayerData::decode("", "base64", "lz4", 0, tiles));
+}
+
+// Test that a cooked level package reads back what was written and rejects other versions
+TEST(LevelPackageTest, RoundTripsSections)
+{
+    LevelPackageWriter writer;
+    writer.setMapInfo("test_level", 2, 2, 32, 32);
+    writer.addLayer("navmesh", 3, 2, 2, true, 1.0f, {1, 0, 0, 1});
+    writer.addTileset("tiles", "tiles.tsx", 1, 32, 32, 1, 1, {10, 20, 30, 255});
+    writer.setNavMeshInfo(2, 2, 0.0f, 0.0f);
+    writer.addNavPolygon({{-16.0f, 16.0f}, {16.0f, 16.0f}, {16.0f, 48.0f}, {-16.0f, 48.0f}}, {1}, {0.0f, 32.0f});
+    writer.addNavEdge({-16.0f, 16.0f}, {16.0f, 16.0f}, 0, -1);
+
+    LevelEntitySpawn spawn;
+    spawn.path = "/assets/DataFiles/EntityFiles/skeleton.json";
+    spawn.name = "skeleton";
+    spawn.hasPosition = true;
+    spawn.tileX = 1.0f;
+    spawn.tileY = 2.0f;
+    writer.addEntity(spawn);
+
+    std::vector<uint8_t> bytes = writer.build();
+    LevelPackage package;
+    ASSERT_TRUE(package.openBuffer(bytes.data(), bytes.size()));
+    EXPECT_STREQ(package.getString(package.getHeader().levelNameOffset), "test_level");
+
+    size_t count = 0;
+    const PackedLayer *layers = package.getSection<PackedLayer>(LevelPackageSection::Layers, count);
+    ASSERT_EQ(count, 1u);
+    EXPECT_STREQ(package.getString(layers[0].nameOffset), "navmesh");
+    const int32_t *data = package.getLayerData(layers[0]);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(std::vector<int>(data, data + 4), std::vector<int>({1, 0, 0, 1}));
+
+    const PackedTileset *tilesets = package.getSection<PackedTileset>(LevelPackageSection::Tilesets, count);
+    ASSERT_EQ(count, 1u);
+    const uint8_t *pixels = package.getTilesetPixels(tilesets[0]);
+    ASSERT_NE(pixels, nullptr);
+    EXPECT_EQ(pixels[2], 30);
+
+    const PackedNavPoly *polys = package.getSection<PackedNavPoly>(LevelPackageSection::NavPolygons, count);
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(polys[0].vertexCount, 4u);
+    EXPECT_EQ(polys[0].neighborCount, 1u);
+
+    std::vector<LevelEntitySpawn> spawns = package.getEntitySpawns();
+    ASSERT_EQ(spawns.size(), 1u);
+    EXPECT_EQ(spawns[0].name, "skeleton");
+    EXPECT_TRUE(spawns[0].hasPosition);
+    EXPECT_FLOAT_EQ(spawns[0].tileY, 2.0f);
+
+    // Packages cooked for another layout version must be re-cooked
+    reinterpret_cast<LevelPackageHeader *>(bytes.data())->version = LEVEL_PACKAGE_VERSION + 1;
+    EXPECT_FALSE(package.openBuffer(bytes.data(), bytes.size()));
+    EXPECT_FALSE(package.isOpen());
+}
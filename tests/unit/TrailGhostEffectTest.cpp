@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "TrailGhostEffect.h"
+
+// Push one sample per call (the sampling timer is drained by update)
+static void pushSample(TrailGhostEffect &effect, float x)
+{
+    effect.update(0.05f);
+    effect.updateSubjectPosition(cf_v2(x, 0.0f));
+}
+
+TEST(TrailGhostEffectTest, FullTrailKeepsNewestSamplesInOrder)
+{
+    TrailGhostEffect effect(INVALID_SHADER_HANDLE);
+    effect.trigger(4, 100.0f, 1.0f);
+
+    // Far past the ghost count and the ring capacity, so the head wraps several times
+    for (int i = 1; i <= 70; ++i)
+    {
+        pushSample(effect, static_cast<float>(i));
+    }
+
+    ASSERT_EQ(effect.getGhostCount(), 4);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_FLOAT_EQ(effect.getGhostPosition(i).x, static_cast<float>(67 + i));
+    }
+}
+
+TEST(TrailGhostEffectTest, RetriggerDoesNotShowStaleSamples)
+{
+    TrailGhostEffect effect(INVALID_SHADER_HANDLE);
+    effect.trigger(8, 100.0f, 1.0f);
+    for (int i = 1; i <= 20; ++i)
+    {
+        pushSample(effect, static_cast<float>(i));
+    }
+
+    effect.trigger(3, 100.0f, 1.0f);
+    for (int i = 0; i < 5; ++i)
+    {
+        pushSample(effect, 1000.0f + i);
+    }
+
+    ASSERT_EQ(effect.getGhostCount(), 3);
+    EXPECT_FLOAT_EQ(effect.getGhostPosition(0).x, 1002.0f);
+    EXPECT_FLOAT_EQ(effect.getGhostPosition(1).x, 1003.0f);
+    EXPECT_FLOAT_EQ(effect.getGhostPosition(2).x, 1004.0f);
+}
@@ -63,3 +63,11 @@ TEST_F(UtilsTest, ReadDataFileInvalidFile)
     // Should handle invalid files gracefully
     EXPECT_TRUE(result.empty());
 }
+
+TEST_F(UtilsTest, NormalizeVirtualPath)
+{
+    EXPECT_EQ(normalize_virtual_path("/assets/DataFiles/a.json"), "assets/DataFiles/a.json");
+    EXPECT_EQ(normalize_virtual_path("assets/DataFiles/a.json"), "assets/DataFiles/a.json");
+    EXPECT_EQ(normalize_virtual_path("//assets"), "assets");
+    EXPECT_EQ(normalize_virtual_path("/"), "");
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <cute.h>
+#include "WorldStreamer.h"
+#include "Utils.h"
+#include "../fixtures/TestFixture.hpp"
+
+using namespace Cute;
+
+// assets/Levels/test_world: three 8x8 regions of 32 px tiles in a row, east of the base map
+class WorldStreamerTest : public TestFixture
+{
+protected:
+    WorldStreamer streamer;
+
+    void SetUp() override
+    {
+        TestFixture::SetUp();
+        mount_content_directory_as("/assets");
+        ASSERT_TRUE(streamer.load("assets/Levels/test_world", 32, 32));
+        ASSERT_EQ(streamer.getRegions().size(), 3u);
+
+        WorldStreamingConfig config;
+        config.loadRadius = 100.0f;
+        config.hysteresis = 200.0f;
+        config.memoryBudget = 0;
+        config.maxConcurrentLoads = 4;
+        streamer.setConfig(config);
+    }
+
+    WorldRegion &region(size_t index) { return *streamer.getRegions()[index]; }
+
+    // A point inside a region, offset along X from the region's left edge
+    CF_V2 pointInRegion(size_t index, float offsetX) const
+    {
+        const CF_Aabb &bounds = streamer.getRegions()[index]->bounds;
+        return cf_v2(bounds.min.x + offsetX, (bounds.min.y + bounds.max.y) * 0.5f);
+    }
+
+    // Without JobSystem workers loads run inline and are taken over on the following update
+    void pump(CF_V2 focus)
+    {
+        std::vector<WorldRegion *> loaded;
+        std::vector<WorldRegion *> unloading;
+        streamer.update({focus}, loaded, unloading);
+        streamer.update({focus}, loaded, unloading);
+
+        // Nothing references an unloading region's navmesh in this test
+        for (WorldRegion *released : unloading)
+        {
+            streamer.releaseRegion(*released);
+        }
+    }
+};
+
+TEST_F(WorldStreamerTest, LoadsOnlyRegionsWithinLoadRadius)
+{
+    pump(pointInRegion(0, 128.0f));
+
+    EXPECT_EQ(region(0).state, WorldRegionState::Loaded);
+    EXPECT_EQ(region(1).state, WorldRegionState::Unloaded);
+    EXPECT_EQ(region(2).state, WorldRegionState::Unloaded);
+    EXPECT_GT(region(0).memoryEstimate, 0u);
+    EXPECT_NE(streamer.getNavMeshAt(pointInRegion(0, 128.0f)), nullptr);
+}
+
+TEST_F(WorldStreamerTest, KeepsRegionsInsideHysteresisBand)
+{
+    pump(pointInRegion(0, 128.0f));
+    ASSERT_EQ(region(0).state, WorldRegionState::Loaded);
+
+    // 160 px past region 0: outside the load radius, inside load radius + hysteresis
+    pump(pointInRegion(1, 160.0f));
+    EXPECT_EQ(region(0).state, WorldRegionState::Loaded);
+    EXPECT_EQ(region(1).state, WorldRegionState::Loaded);
+
+    // Region 2 is more than 300 px past region 0
+    pump(pointInRegion(2, 128.0f));
+    EXPECT_EQ(region(0).state, WorldRegionState::Unloaded);
+    EXPECT_EQ(region(2).state, WorldRegionState::Loaded);
+}
+
+TEST_F(WorldStreamerTest, EvictsFarthestRegionOverMemoryBudget)
+{
+    // On the seam between regions 0 and 1, both load
+    pump(pointInRegion(1, 0.0f));
+    ASSERT_EQ(region(0).state, WorldRegionState::Loaded);
+    ASSERT_EQ(region(1).state, WorldRegionState::Loaded);
+
+    // Room for one and a half regions
+    WorldStreamingConfig config = streamer.getConfig();
+    config.memoryBudget = region(0).memoryEstimate + region(0).memoryEstimate / 2;
+    streamer.setConfig(config);
+
+    // Region 0 is only kept by hysteresis, region 2 is within the load radius but does not fit
+    std::vector<WorldRegion *> loaded;
+    std::vector<WorldRegion *> unloading;
+    streamer.update({pointInRegion(1, 160.0f)}, loaded, unloading);
+
+    ASSERT_EQ(unloading.size(), 1u);
+    EXPECT_EQ(unloading[0], &region(0));
+    EXPECT_EQ(region(0).state, WorldRegionState::Unloading);
+    EXPECT_EQ(region(1).state, WorldRegionState::Loaded);
+    EXPECT_EQ(region(2).state, WorldRegionState::Unloaded);
+}
@@ -0,0 +1,135 @@
+// level_cook - bakes a level directory into a single level package (level.ylpk)
+//
+// Usage: level_cook [level directory] [timing iterations]
+//   level directory: virtual path, default /assets/Levels/test_two
+//
+// The package holds the tile layers as raw arrays, the decoded tileset images, the navmesh
+// after cuts were applied and the flattened entity spawns. LevelV1 loads it in place of the
+// TMX / JSON files while it is newer than them. After cooking, both load paths are timed.
+#include <cute.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "DataFile.h"
+#include "Utils.h"
+#include "LevelMap.h"
+#include "LevelPackage.h"
+#include "NavMesh.h"
+
+using namespace Cute;
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Same name resolution as LevelV1: details.json "name", otherwise the directory name
+static std::string get_level_name(const std::string& dir)
+{
+	size_t last_slash = dir.find_last_of('/');
+	std::string name = last_slash != std::string::npos ? dir.substr(last_slash + 1) : dir;
+	try {
+		DataFile details(dir + "/details.json");
+		if (details.contains("name")) name = details["name"].get<std::string>();
+	} catch (const std::exception&) {
+	}
+	return name;
+}
+
+static DataFile load_entities(const std::string& dir)
+{
+	try {
+		return DataFile(dir + "/entities.json");
+	} catch (const std::exception& e) {
+		printf("level_cook: Could not load entities.json: %s\n", e.what());
+		return DataFile();
+	}
+}
+
+static bool cook(const std::string& dir, const std::string& level_name)
+{
+	LevelMap map(dir + "/" + level_name + ".tmx");
+	if (map.getLayerCount() == 0 && map.getNavMeshLayerCount() == 0 && map.getStructureCount() == 0) {
+		printf("level_cook: Failed to load TMX map for '%s'\n", dir.c_str());
+		return false;
+	}
+
+	LevelPackageWriter writer;
+	if (!map.writeToPackage(writer, level_name)) return false;
+
+	NavMesh navmesh;
+	if (map.buildNavMesh(navmesh)) navmesh.writeToPackage(writer);
+
+	for (const LevelEntitySpawn& spawn : flattenEntitySpawns(load_entities(dir))) writer.addEntity(spawn);
+
+	return writer.writeFile(dir + "/" + LEVEL_PACKAGE_FILENAME);
+}
+
+// XML path: what LevelV1 does without a package (minus agent creation)
+static double time_sources(const std::string& dir, const std::string& level_name)
+{
+	auto start = std::chrono::steady_clock::now();
+	LevelMap map(dir + "/" + level_name + ".tmx");
+	NavMesh navmesh;
+	map.buildNavMesh(navmesh);
+	std::vector<LevelEntitySpawn> spawns = flattenEntitySpawns(load_entities(dir));
+	return elapsed_ms(start);
+}
+
+// Package path: one mapped file, layers copied out, navmesh and spawns read in place
+static double time_package(const std::string& dir, const std::string& level_name)
+{
+	auto start = std::chrono::steady_clock::now();
+	auto package = std::make_shared<LevelPackage>();
+	if (!package->open(dir + "/" + LEVEL_PACKAGE_FILENAME)) return -1.0;
+	LevelMap map;
+	map.loadFromPackage(package, dir + "/" + level_name + ".tmx");
+	NavMesh navmesh;
+	navmesh.loadFromPackage(*package);
+	std::vector<LevelEntitySpawn> spawns = package->getEntitySpawns();
+	return elapsed_ms(start);
+}
+
+int main(int argc, char* argv[])
+{
+	std::string dir = argc > 1 ? argv[1] : "/assets/Levels/test_two";
+	int iterations = argc > 2 ? std::max(1, atoi(argv[2])) : 5;
+
+	// No window or GPU, only the VFS is needed
+	int options = CF_APP_OPTIONS_NO_GFX_BIT | CF_APP_OPTIONS_HIDDEN_BIT;
+	CF_Result result = make_app("level_cook", 0, 0, 0, 1, 1, options, argv[0]);
+	if (is_error(result)) {
+		printf("level_cook: Failed to create app\n");
+		return -1;
+	}
+	mount_content_directory_as("/assets");
+
+	std::string level_name = get_level_name(dir);
+	auto cook_start = std::chrono::steady_clock::now();
+	if (!cook(dir, level_name)) {
+		printf("level_cook: Cooking '%s' failed\n", dir.c_str());
+		destroy_app();
+		return 1;
+	}
+	double cook_ms = elapsed_ms(cook_start);
+
+	double sources_ms = 0.0;
+	double package_ms = 0.0;
+	for (int i = 0; i < iterations; ++i) {
+		sources_ms += time_sources(dir, level_name);
+		package_ms += time_package(dir, level_name);
+	}
+	sources_ms /= iterations;
+	package_ms /= iterations;
+
+	printf("\nlevel_cook: Cooked '%s' in %.2f ms\n", dir.c_str(), cook_ms);
+	printf("level_cook: Load time over %d runs: TMX/JSON %.2f ms, package %.2f ms (%.1fx)\n",
+		iterations, sources_ms, package_ms, package_ms > 0.0 ? sources_ms / package_ms : 0.0);
+
+	destroy_app();
+	return 0;
+}